@@ -0,0 +1,68 @@
+/*************************************
+
+@file ContactMonitor.h
+
+@brief Turns the dynamics world's contacts into begin and end events
+
+@Note the persistent manifolds built by the narrowphase are read once
+      per internal tick; only bodies with a user pointer are tracked,
+      so the rest of the table costs one pointer check per manifold
+
+*************************************/
+
+
+// Pre-compiler directives //////////////////
+#ifndef CONTACT_MONITOR_H
+#define CONTACT_MONITOR_H
+
+
+//Header files /////////////////////////////
+#include <utility>
+#include <vector>
+
+#include "graphics_headers.h"
+
+//Class definition ////////////////////////
+
+class ContactMonitor
+{
+	public:
+		struct ContactEvent
+		{
+			void* userPointerA;
+			void* userPointerB;
+			bool began; //false when the bodies separated
+
+			ContactEvent( ) : userPointerA( NULL ), userPointerB( NULL ), began( false ) { }
+
+			ContactEvent( void* pointerA, void* pointerB, bool newBegan ) :
+				userPointerA( pointerA ),
+				userPointerB( pointerB ),
+				began( newBegan )
+			{ }
+		};
+
+		ContactMonitor( );
+		ContactMonitor( const ContactMonitor& src );
+
+		~ContactMonitor( );
+
+		void scan( btDispatcher* dispatcherPtr );
+
+		const std::vector<ContactEvent>& getEvents( ) const;
+
+		void clearEvents( );
+
+	private:
+		typedef std::pair<void*, void*> ContactPair;
+
+		std::vector<ContactPair> touching; //sorted, as of the last scan
+		std::vector<ContactPair> scratch; //pairs found by the current scan
+
+		std::vector<ContactEvent> events;
+
+};
+
+
+
+#endif // !CONTACT_MONITOR_H
@@ -0,0 +1,83 @@
+/*************************************
+
+@file Flipper.h
+
+@brief Drives a pinball flipper through a hinge motor
+
+@Note the stroke is precomputed as angle against time; every internal
+      tick the motor is given the angular velocity that reaches the
+      next point of the table, so the solver sees the flipper's true
+      speed in every sub step instead of a jump once a frame
+
+*************************************/
+
+
+// Pre-compiler directives //////////////////
+#ifndef FLIPPER_H
+#define FLIPPER_H
+
+
+//Header files /////////////////////////////
+#include "graphics_headers.h"
+
+//Class definition ////////////////////////
+
+class FlipperController
+{
+	public:
+		static const int PROFILE_SAMPLES = 64; //table entries per stroke
+
+		static const float STROKE_ANGLE; //value defined in Flipper.cpp
+		static const float UP_STROKE_MS; //value defined in Flipper.cpp
+		static const float DOWN_STROKE_MS; //value defined in Flipper.cpp
+		static const float MAX_MOTOR_IMPULSE; //value defined in Flipper.cpp
+		static const float RESPONSE_SPEED; //value defined in Flipper.cpp
+
+		FlipperController( );
+		FlipperController( const FlipperController& src );
+
+		~FlipperController( );
+
+		bool Initialize( btDynamicsWorld* world, btRigidBody* body,
+						 float newDirection, float newTimeScale );
+
+		void Release( btDynamicsWorld* world );
+
+		void flip( btRigidBody* ballPtr );
+
+		void update( btScalar timeStep );
+
+	private:
+		enum StrokeState
+		{
+			RESTING,
+			RISING,
+			FALLING
+		};
+
+		static float sampleProfile( const float* profile, float progress );
+
+		btRigidBody* bodyPtr;
+		btHingeConstraint* hingePtr;
+
+		float direction; //1 turns counter clockwise seen from above, -1 clockwise
+		float timeScale; //simulated time per millisecond
+
+		//angle against stroke progress, from 0 to STROKE_ANGLE
+		float upProfile[ PROFILE_SAMPLES + 1 ];
+		float downProfile[ PROFILE_SAMPLES + 1 ];
+
+		StrokeState state;
+		float strokeTime; //milliseconds into the current stroke
+
+		//time from the press until the ball is moved
+		btRigidBody* responseBallPtr;
+		btVector3 responseStartVelocity;
+		float responseTime;
+		int responseTicks;
+
+};
+
+
+
+#endif // !FLIPPER_H
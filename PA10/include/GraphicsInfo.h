@@ -148,6 +148,39 @@ struct SpotLight
     }
 };
 
+//physics info
+
+struct PhysicsInfo
+{
+    float timeScale; //simulated time per millisecond of frame time
+    float fixedTimeStep; //length of one internal step in simulated time
+    int maxSubSteps; //internal steps allowed per frame before time is dropped
+
+    float ccdMotionThreshold; //motion per step before the ball is swept
+    float ccdSweptSphereRadius; //radius of the sphere the ball is swept as
+
+    int solverIterations; //constraint solver passes per internal step
+
+    //defaults step a sixtieth at a time, 9.6 steps per 16 ms frame at 60 fps
+    PhysicsInfo( ) :
+        timeScale( 0.01f ),
+        fixedTimeStep( 1.0f / 60.0f ),
+        maxSubSteps( 10 ),
+        ccdMotionThreshold( 0.0f ),
+        ccdSweptSphereRadius( 0.0f ),
+        solverIterations( 10 )
+    { }
+
+    PhysicsInfo( const PhysicsInfo& src ) :
+        timeScale( src.timeScale ),
+        fixedTimeStep( src.fixedTimeStep ),
+        maxSubSteps( src.maxSubSteps ),
+        ccdMotionThreshold( src.ccdMotionThreshold ),
+        ccdSweptSphereRadius( src.ccdSweptSphereRadius ),
+        solverIterations( src.solverIterations )
+    { }
+};
+
 struct GraphicsInfo
 {
     //members
@@ -158,15 +191,23 @@ struct GraphicsInfo
 
     std::vector<SpotLight> spotLight;
 
+    PhysicsInfo physics;
+
+    bool headless; //draw offscreen, unsynced, for a set number of frames
+    unsigned int benchmarkFrames; //frames a headless run draws
+
     //constructors
-    GraphicsInfo( ):spotLight( ) { }
+    GraphicsInfo( ):spotLight( ), headless( false ), benchmarkFrames( 1000 ) { }
 
     GraphicsInfo( const GraphicsInfo& src ): 
         shaderVector( src.shaderVector ),
         modelVector( src.modelVector ), 
         objectData( src.objectData ),
         lights( src.lights ),
-        spotLight( src.spotLight ){ }
+        spotLight( src.spotLight ),
+        physics( src.physics ),
+        headless( src.headless ),
+        benchmarkFrames( src.benchmarkFrames ){ }
 };
 
 #endif /* GRAPHICSINFO_H */
\ No newline at end of file
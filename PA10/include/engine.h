@@ -13,6 +13,7 @@
 
 #include "window.h"
 #include "graphics.h"
+#include "SimClock.h"
 
 struct Coord
 {
@@ -57,10 +58,12 @@ class Engine
         void Run();
         void Keyboard();
         void Mouse();
-        unsigned int getDT();
         long long GetCurrentTimeMillis();
     
     private:
+        bool clockKeys( );
+        void reportFrameTimes( );
+
         // Window related variables
         Window *m_window;        
         string m_WINDOW_NAME;
@@ -71,9 +74,14 @@ class Engine
 
         Graphics *m_graphics;
         unsigned int m_DT;
-        long long m_currentTimeMillis;
+        SimClock m_clock; //simulation time for Update
         bool m_running;
 
+        //headless benchmark
+        bool headless;
+        unsigned int benchmarkFrames;
+        std::vector<double> frameTimes; //real milliseconds per frame
+
         int trackingID;
 
         bool specularLight;
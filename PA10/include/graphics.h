@@ -10,6 +10,8 @@ using namespace std;
 #include "shader.h"
 #include "sound.h"
 #include "object.h"
+#include "ContactMonitor.h"
+#include "Flipper.h"
 
 #include "GraphicsInfo.h"
 #include "ObjectTable.h"
@@ -90,11 +92,12 @@ class Graphics
         glm::vec4 boxEdges;
 
 
-        bool rightPaddleUp;
-        bool leftPaddleUp;
+        FlipperController leftFlipper;
+        FlipperController rightFlipper;
 
-        void updateLeftPaddle( unsigned int dt );
-        void updateRightPaddle( unsigned int dt );
+        void processContactEvents( );
+
+        void stepPhysics( unsigned int dt );
 
         bool pauseNotifier;
 
@@ -130,6 +133,7 @@ class Graphics
         ObjectTable objectRegistry; //holds the scene's objects
  
         Sound objectCollidedSound;
+        int bumpSound;
 
         std::vector<Instance> modelRegistry;
 
@@ -141,6 +145,10 @@ class Graphics
         btSequentialImpulseConstraintSolver *solverPtr;
         btDiscreteDynamicsWorld *dynamicsWorldPtr;
 
+        ContactMonitor contactMonitor; //contacts of the ball, bumpers and ball return
+
+        PhysicsInfo physicsSettings;
+
         /////////////////////////////////////////////
 
           
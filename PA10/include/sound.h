@@ -5,39 +5,139 @@
 
 #include <SDL2/SDL.h>
 
+#include "graphics_headers.h"
+
+#include <atomic>
 #include <string>
-#include <thread>
-static Uint8 *soundPosition;
-static Uint32 soundRemaining;
-void myCallback( void *userData, Uint8 *stream, int length);
+#include <vector>
+
+/***************************************
+
+@brief Sound
+
+@details mixes up to MAX_VOICES clips inside the SDL audio callback
 
+@notes the game thread only pushes play commands into a single
+       producer single consumer queue; the callback owns the voices.
+       the device is paused whenever nothing is playing.
+       positional voices are attenuated and panned against the
+       nearest listener, one per camera, every callback
+
+***************************************/
 class Sound
 {
-    public:
+	public:
+		static const int MAX_VOICES = 16;
+		static const int QUEUE_SIZE = 64; //must be a power of two
+		static const int MIX_FREQUENCY = 44100;
+		static const int MIX_SAMPLES = 1024;
+		static const int MAX_LISTENERS = 2;
+
+		static const int LOW_PRIORITY = 0;
+		static const int NORMAL_PRIORITY = 1;
+		static const int HIGH_PRIORITY = 2;
+
+		static const float REFERENCE_DISTANCE; //value defined in sound.cpp
+		static const float MAX_DISTANCE; //value defined in sound.cpp
+		static const float AUDIBLE_GAIN; //value defined in sound.cpp
 
-        Sound();
-        ~Sound();
+		Sound();
+		~Sound();
 
-        void loadSound( std::string soundPath );
-        void playSound();
+		int loadSound( std::string soundPath );
+		bool playSound( int soundID, float gain = 1.0f, float pan = 0.0f,
+						int priority = NORMAL_PRIORITY );
+		bool playSoundAt( int soundID, const glm::vec3& position,
+						  int priority = NORMAL_PRIORITY, float gain = 1.0f );
+
+		void setListeners( const glm::mat4* views, int numberOfViews );
 
 		void launchSound( );
 
+		void Update( );
+
 		bool SoundPlaying( );
 
+		SDL_AudioDeviceID getDevice( ) const;
+
+		static void AudioCallback( void *userData, Uint8 *stream, int length );
+
+	private:
+		struct PlayCommand
+		{
+			int clip;
+			int priority;
+			bool positional;
+			glm::vec3 source; //world position of a positional sound
+			float gain;
+			float pan; //only used by sounds without a position
+
+			PlayCommand( ) : clip( -1 ), priority( 0 ), positional( false ),
+							 source( 0.0f ), gain( 0.0f ), pan( 0.0f ) { }
+		};
+
+		struct Voice
+		{
+			PlayCommand sound;
+			size_t position; //in samples, two per frame
+			float leftGain;
+			float rightGain;
+			float loudness; //gain after attenuation, used to pick voices to steal
+
+			Voice( ) : position( 0 ), leftGain( 0.0f ), rightGain( 0.0f ), loudness( 0.0f ) { }
+		};
+
+		struct Listener
+		{
+			glm::vec3 position;
+			glm::vec3 right;
+		};
+
+		struct ListenerSet
+		{
+			Listener listeners[ MAX_LISTENERS ];
+			int count;
+
+			ListenerSet( ) : count( 0 ) { }
+		};
+
+		bool openDevice( );
+
+		bool pushPlayCommand( const PlayCommand& command );
+		bool pushCommand( const PlayCommand& command );
+		bool popCommand( PlayCommand& command );
+
+		void spatialize( Voice& voice ) const;
+		void startVoice( const PlayCommand& command );
+		void mix( Sint16 *stream, int frames );
+
+		//converted to signed 16 bit stereo at the device rate
+		std::vector< std::vector<Sint16> > clips;
+
+		//owned by the audio callback
+		Voice voices[ MAX_VOICES ];
+		std::vector<float> mixBuffer;
+
+		//play command queue
+		PlayCommand commandQueue[ QUEUE_SIZE ];
+		std::atomic<unsigned int> queueHead; //advanced by the callback
+		std::atomic<unsigned int> queueTail; //advanced by the game thread
+
+		static const int NEW_LISTENERS = 4; //flag on listenerReady
+
+		//listener triple buffer, the game thread writes one set while the
+		//callback reads another and the third holds the newest finished set
+		ListenerSet listenerSets[ 3 ];
+		int listenerWrite; //owned by the game thread
+		int listenerRead; //owned by the callback
+		std::atomic<int> listenerReady; //index of the newest set, NEW_LISTENERS if unread
 
-    private:
+		std::atomic<bool> idle;
 
-		std::thread * threadManager;
-        
-        Uint32 soundLength;
-        Uint8 *soundBuffer;
-        SDL_AudioSpec soundSpec;
-        bool soundLoaded;
-		bool soundPlaying;
+		SDL_AudioDeviceID dev;
+		SDL_AudioSpec deviceSpec;
+		bool devicePaused;
 
-        friend void myCallback( void *userData, Uint8 *stream, int length);
- 
 };
 
 
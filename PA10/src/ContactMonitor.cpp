@@ -0,0 +1,117 @@
+#include "ContactMonitor.h"
+
+#include <algorithm>
+
+
+ContactMonitor::ContactMonitor( )
+{
+	//done by class members
+}
+
+ContactMonitor::ContactMonitor( const ContactMonitor & src ):
+	touching( src.touching ),
+	events( src.events )
+{
+	//done in initializer
+}
+
+ContactMonitor::~ContactMonitor( )
+{
+	//done by class members
+}
+
+// SCAN //////////////////
+/***************************************
+
+@brief scan
+
+@details finds the pairs that started or stopped touching
+
+@param in: dispatcherPtr: the dispatcher of the dynamics world
+
+@notes called once per internal tick. a pair touches while its
+       manifold holds a point at or below zero distance. the
+       new events are added to the end of the event list
+
+***************************************/
+void ContactMonitor::scan( btDispatcher* dispatcherPtr )
+{
+	int manifold, numberOfManifolds, point;
+	btPersistentManifold* manifoldPtr;
+	void* pointerA;
+	void* pointerB;
+	size_t index, previous;
+
+	scratch.clear( );
+
+	numberOfManifolds = dispatcherPtr->getNumManifolds( );
+
+	for( manifold = 0; manifold < numberOfManifolds; manifold++ )
+	{
+		manifoldPtr = dispatcherPtr->getManifoldByIndexInternal( manifold );
+
+		pointerA = manifoldPtr->getBody0( )->getUserPointer( );
+		pointerB = manifoldPtr->getBody1( )->getUserPointer( );
+
+		if( pointerA == NULL || pointerB == NULL )
+		{
+			continue;
+		}
+
+		for( point = 0; point < manifoldPtr->getNumContacts( ); point++ )
+		{
+			if( manifoldPtr->getContactPoint( point ).getDistance( ) <= 0.0f )
+			{
+				//same order whichever body the broadphase put first
+				if( pointerB < pointerA )
+				{
+					std::swap( pointerA, pointerB );
+				}
+
+				scratch.push_back( ContactPair( pointerA, pointerB ) );
+				break;
+			}
+		}
+	}
+
+	std::sort( scratch.begin( ), scratch.end( ) );
+	scratch.erase( std::unique( scratch.begin( ), scratch.end( ) ), scratch.end( ) );
+
+	//walk both sorted lists together
+	index = 0;
+	previous = 0;
+
+	while( index < scratch.size( ) || previous < touching.size( ) )
+	{
+		if( previous == touching.size( )
+			|| ( index < scratch.size( ) && scratch[ index ] < touching[ previous ] ) )
+		{
+			events.push_back( ContactEvent( scratch[ index ].first,
+											scratch[ index ].second, true ) );
+			index++;
+		}
+		else if( index == scratch.size( ) || touching[ previous ] < scratch[ index ] )
+		{
+			events.push_back( ContactEvent( touching[ previous ].first,
+											touching[ previous ].second, false ) );
+			previous++;
+		}
+		else
+		{
+			index++;
+			previous++;
+		}
+	}
+
+	touching.swap( scratch );
+}
+
+const std::vector<ContactMonitor::ContactEvent>& ContactMonitor::getEvents( ) const
+{
+	return events;
+}
+
+void ContactMonitor::clearEvents( )
+{
+	events.clear( );
+}
@@ -0,0 +1,266 @@
+#include "Flipper.h"
+#include "Logger.h"
+
+#include <algorithm>
+
+const float FlipperController::STROKE_ANGLE = 1.5f;
+const float FlipperController::UP_STROKE_MS = 60.0f;
+const float FlipperController::DOWN_STROKE_MS = 120.0f;
+const float FlipperController::MAX_MOTOR_IMPULSE = 1000000.0f;
+const float FlipperController::RESPONSE_SPEED = 10.0f;
+
+
+FlipperController::FlipperController( ):
+	bodyPtr( NULL ),
+	hingePtr( NULL ),
+	direction( 1.0f ),
+	timeScale( 1.0f ),
+	state( RESTING ),
+	strokeTime( 0.0f ),
+	responseBallPtr( NULL ),
+	responseStartVelocity( 0.0f, 0.0f, 0.0f ),
+	responseTime( 0.0f ),
+	responseTicks( 0 )
+{
+	std::fill( upProfile, upProfile + PROFILE_SAMPLES + 1, 0.0f );
+	std::fill( downProfile, downProfile + PROFILE_SAMPLES + 1, 0.0f );
+}
+
+FlipperController::FlipperController( const FlipperController & src ):
+	bodyPtr( src.bodyPtr ),
+	hingePtr( src.hingePtr ),
+	direction( src.direction ),
+	timeScale( src.timeScale ),
+	state( src.state ),
+	strokeTime( src.strokeTime ),
+	responseBallPtr( src.responseBallPtr ),
+	responseStartVelocity( src.responseStartVelocity ),
+	responseTime( src.responseTime ),
+	responseTicks( src.responseTicks )
+{
+	std::copy( src.upProfile, src.upProfile + PROFILE_SAMPLES + 1, upProfile );
+	std::copy( src.downProfile, src.downProfile + PROFILE_SAMPLES + 1, downProfile );
+}
+
+FlipperController::~FlipperController( )
+{
+	//the hinge is released with the world
+}
+
+// INITIALIZE //////////////////
+/***************************************
+
+@brief Initialize
+
+@details hinges a flipper's body at its origin and builds the stroke table
+
+@param in: world: the world the body is in
+
+@param in: body: the flipper's rigid body
+
+@param in: newDirection: 1 if the flipper turns counter clockwise
+                         seen from above when raised, -1 if clockwise
+
+@param in: newTimeScale: simulated time per millisecond of frame time
+
+@notes the body must already be in the world, since adding a body
+       resets its gravity. the up stroke leaves the rest position at
+       full speed and slows into the top, the down stroke starts
+       slowly and speeds up into the rest position
+
+***************************************/
+bool FlipperController::Initialize
+(
+	btDynamicsWorld* world,
+	btRigidBody* body,
+	float newDirection,
+	float newTimeScale
+)
+{
+	int sample;
+	float progress;
+
+	if( world == NULL || body == NULL || newTimeScale <= 0.0f )
+	{
+		return false;
+	}
+
+	bodyPtr = body;
+	direction = newDirection;
+	timeScale = newTimeScale;
+
+	for( sample = 0; sample <= PROFILE_SAMPLES; sample++ )
+	{
+		progress = ( float ) sample / PROFILE_SAMPLES;
+
+		upProfile[ sample ] = STROKE_ANGLE * ( 1.0f - ( ( 1.0f - progress ) * ( 1.0f - progress ) ) );
+		downProfile[ sample ] = STROKE_ANGLE * ( 1.0f - ( progress * progress ) );
+	}
+
+	//only the hinge holds the flipper up
+	bodyPtr->setGravity( btVector3( 0.0f, 0.0f, 0.0f ) );
+
+	hingePtr = new btHingeConstraint( *bodyPtr, btVector3( 0.0f, 0.0f, 0.0f ),
+									  btVector3( 0.0f, 1.0f, 0.0f ) );
+
+	if( direction > 0.0f )
+	{
+		hingePtr->setLimit( 0.0f, STROKE_ANGLE );
+	}
+	else
+	{
+		hingePtr->setLimit( -1.0f * STROKE_ANGLE, 0.0f );
+	}
+
+	hingePtr->enableAngularMotor( true, 0.0f, MAX_MOTOR_IMPULSE );
+
+	world->addConstraint( hingePtr, true );
+
+	state = RESTING;
+	strokeTime = 0.0f;
+
+	return true;
+}
+
+void FlipperController::Release( btDynamicsWorld* world )
+{
+	if( hingePtr != NULL )
+	{
+		world->removeConstraint( hingePtr );
+
+		delete hingePtr;
+		hingePtr = NULL;
+	}
+
+	bodyPtr = NULL;
+}
+
+// FLIP //////////////////
+/***************************************
+
+@brief flip
+
+@details starts an up stroke
+
+@param in: ballPtr: the ball, to time how long it takes to react
+
+@notes a flipper that is falling rises again from the angle it is
+       at; one that is rising ignores the press
+
+***************************************/
+void FlipperController::flip( btRigidBody* ballPtr )
+{
+	float angle;
+	int sample;
+
+	if( hingePtr == NULL || state == RISING )
+	{
+		return;
+	}
+
+	angle = direction * hingePtr->getHingeAngle( );
+
+	for( sample = 0; sample < PROFILE_SAMPLES && upProfile[ sample ] < angle; sample++ )
+	{
+		//find where the up stroke passes the current angle
+	}
+
+	state = RISING;
+	strokeTime = ( UP_STROKE_MS * sample ) / PROFILE_SAMPLES;
+
+	responseBallPtr = ballPtr;
+	responseTime = 0.0f;
+	responseTicks = 0;
+
+	if( responseBallPtr != NULL )
+	{
+		responseStartVelocity = responseBallPtr->getLinearVelocity( );
+	}
+}
+
+// UPDATE //////////////////
+/***************************************
+
+@brief update
+
+@details moves the stroke on by one internal tick and sets the motor
+
+@param in: timeStep: the length of the internal step
+
+@notes the motor is asked for the velocity that reaches the table's
+       angle at the end of the step, which also corrects for any
+       angle the ball pushed the flipper off by
+
+***************************************/
+void FlipperController::update( btScalar timeStep )
+{
+	float milliseconds = timeStep / timeScale;
+	float targetAngle = 0.0f;
+
+	if( hingePtr == NULL )
+	{
+		return;
+	}
+
+	if( state != RESTING )
+	{
+		strokeTime += milliseconds;
+
+		if( state == RISING && strokeTime >= UP_STROKE_MS )
+		{
+			state = FALLING;
+			strokeTime -= UP_STROKE_MS;
+		}
+
+		if( state == FALLING && strokeTime >= DOWN_STROKE_MS )
+		{
+			state = RESTING;
+			strokeTime = 0.0f;
+		}
+	}
+
+	if( state == RISING )
+	{
+		targetAngle = sampleProfile( upProfile, strokeTime / UP_STROKE_MS );
+	}
+	else if( state == FALLING )
+	{
+		targetAngle = sampleProfile( downProfile, strokeTime / DOWN_STROKE_MS );
+	}
+
+	hingePtr->setMotorTarget( direction * targetAngle, timeStep );
+
+	bodyPtr->activate( );
+
+	//ball response
+	if( responseBallPtr != NULL )
+	{
+		responseTime += milliseconds;
+		responseTicks++;
+
+		if( ( responseBallPtr->getLinearVelocity( ) - responseStartVelocity ).length( )
+			> RESPONSE_SPEED )
+		{
+			LOG_INFO( "Flipper moved the ball " << responseTime << " ms ( "
+					  << responseTicks << " ticks ) after the press" );
+
+			responseBallPtr = NULL;
+		}
+		else if( state != RISING )
+		{
+			//the ball was out of reach
+			responseBallPtr = NULL;
+		}
+	}
+}
+
+// private member functions
+
+float FlipperController::sampleProfile( const float* profile, float progress )
+{
+	float position = std::min( std::max( progress, 0.0f ), 1.0f ) * PROFILE_SAMPLES;
+	int sample = std::min( ( int ) position, PROFILE_SAMPLES - 1 );
+	float fraction = position - sample;
+
+	return profile[ sample ] + ( fraction * ( profile[ sample + 1 ] - profile[ sample ] ) );
+}
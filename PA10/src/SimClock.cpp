@@ -0,0 +1,253 @@
+#include "SimClock.h"
+#include <cmath>
+#include <algorithm>
+
+const double SimClock::MIN_SCALE = 0.001;
+const double SimClock::MAX_SCALE = 100000.0;
+const double SimClock::MAX_FRAME_SECONDS = 0.25;
+
+SimClock::SimClock( )
+{
+    frameSeconds = 0.0;
+    simSeconds = 0.0;
+
+    scale = 1.0;
+    paused = false;
+    stepPending = false;
+    fixedTick = false;
+
+    carryMillis = 0.0;
+    frameMillis = 0;
+    tickMillis = FIXED_TICK_MILLIS;
+    ticksLeft = 0;
+
+    lastFrame = Clock::now( );
+}
+
+SimClock::~SimClock( )
+{
+
+}
+
+// START //////////////////
+/***************************************
+
+@brief start
+
+@details starts timing from now
+
+@param None
+
+@notes called once the window and graphics are up, so the time spent
+       loading is not handed to the first update
+
+***************************************/
+void SimClock::start( )
+{
+    lastFrame = Clock::now( );
+
+    frameSeconds = 0.0;
+    carryMillis = 0.0;
+    ticksLeft = 0;
+}
+
+// BEGIN FRAME //////////////////
+/***************************************
+
+@brief beginFrame
+
+@details reads the time since the last frame and works out the ticks
+         this frame hands out
+
+@param None
+
+@notes a paused frame hands out one tick of 0, or one step, so the
+       camera and the input still update. a fixed tick frame may hand
+       out none, and when the scale would need more than
+       MAX_TICKS_PER_FRAME ticks, each tick is made a longer multiple of
+       FIXED_TICK_MILLIS so none of the scaled time is lost. a long
+       frame, such as a moved window, is cut to MAX_FRAME_SECONDS so it
+       does not jump the simulation
+
+***************************************/
+void SimClock::beginFrame( )
+{
+    Clock::time_point now = Clock::now( );
+    double scaledMillis;
+
+    frameSeconds = std::chrono::duration<double>( now - lastFrame ).count( );
+    lastFrame = now;
+
+    scaledMillis = std::min( frameSeconds, MAX_FRAME_SECONDS ) * 1000.0 * scale;
+
+    frameMillis = 0;
+    tickMillis = FIXED_TICK_MILLIS;
+    ticksLeft = 1;
+
+    if( paused )
+    {
+        //one tick of no time, or of one step
+        if( stepPending )
+        {
+            if( fixedTick )
+            {
+                frameMillis = FIXED_TICK_MILLIS;
+            }
+            else
+            {
+                frameMillis = ( unsigned int ) ( ( FIXED_TICK_MILLIS * scale ) + 0.5 );
+            }
+
+            stepPending = false;
+        }
+    }
+    else if( fixedTick )
+    {
+        carryMillis += scaledMillis;
+
+        //the fewest whole fixed ticks per tick that fit in the cap
+        if( carryMillis >= MAX_TICKS_PER_FRAME * FIXED_TICK_MILLIS )
+        {
+            tickMillis = FIXED_TICK_MILLIS
+                         * ( unsigned int ) ceil( carryMillis
+                                                  / ( MAX_TICKS_PER_FRAME * FIXED_TICK_MILLIS ) );
+        }
+
+        ticksLeft = ( unsigned int ) ( carryMillis / tickMillis );
+
+        carryMillis -= ticksLeft * ( double ) tickMillis;
+    }
+    else
+    {
+        //whole milliseconds, the fraction is carried to the next frame
+        carryMillis += scaledMillis;
+
+        frameMillis = ( unsigned int ) floor( carryMillis );
+
+        carryMillis -= frameMillis;
+    }
+}
+
+// NEXT TICK //////////////////
+/***************************************
+
+@brief nextTick
+
+@details hands out the next simulation step of this frame
+
+@param out: dt: the step in simulation milliseconds
+
+@notes returns false when the frame has no ticks left. loop on it
+       between beginFrame and the render
+
+***************************************/
+bool SimClock::nextTick( unsigned int& dt )
+{
+    if( ticksLeft == 0 )
+    {
+        return false;
+    }
+
+    ticksLeft--;
+
+    if( fixedTick && !paused )
+    {
+        dt = tickMillis;
+    }
+    else
+    {
+        dt = frameMillis;
+    }
+
+    simSeconds += dt / 1000.0;
+
+    return true;
+}
+
+// SET SCALE //////////////////
+/***************************************
+
+@brief setScale
+
+@details sets how many times faster than real time the simulation runs
+
+@param in: newScale: the time scale, kept between MIN_SCALE and MAX_SCALE
+
+@notes in the fixed tick mode the scale changes how many ticks a frame
+       gets, and only lengthens them past MAX_TICKS_PER_FRAME
+
+***************************************/
+void SimClock::setScale( double newScale )
+{
+    scale = std::max( MIN_SCALE, std::min( newScale, MAX_SCALE ) );
+}
+
+double SimClock::getScale( ) const
+{
+    return scale;
+}
+
+void SimClock::togglePaused( )
+{
+    paused = !paused;
+    stepPending = false;
+}
+
+bool SimClock::isPaused( ) const
+{
+    return paused;
+}
+
+// STEP //////////////////
+/***************************************
+
+@brief step
+
+@details moves a paused simulation on by one tick at the next frame
+
+@param None
+
+@notes does nothing unless paused
+
+***************************************/
+void SimClock::step( )
+{
+    if( paused )
+    {
+        stepPending = true;
+    }
+}
+
+// SET FIXED TICK //////////////////
+/***************************************
+
+@brief setFixedTick
+
+@details switches between one update per frame and updates of
+         FIXED_TICK_MILLIS each
+
+@param in: fixed: true for the fixed tick mode
+
+@notes the carried time is dropped so the modes do not mix
+
+***************************************/
+void SimClock::setFixedTick( bool fixed )
+{
+    fixedTick = fixed;
+    carryMillis = 0.0;
+}
+
+bool SimClock::isFixedTick( ) const
+{
+    return fixedTick;
+}
+
+double SimClock::getFrameSeconds( ) const
+{
+    return frameSeconds;
+}
+
+double SimClock::getSimSeconds( ) const
+{
+    return simSeconds;
+}
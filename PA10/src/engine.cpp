@@ -1,5 +1,8 @@
 
 #include "engine.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cmath>
 
 Engine::Engine(string name, int width, int height)
 {
@@ -10,6 +13,9 @@ Engine::Engine(string name, int width, int height)
 
     m_graphics = NULL;
     m_window = NULL;
+
+    headless = false;
+    benchmarkFrames = 0;
 }
 
 Engine::Engine(string name)
@@ -21,6 +27,9 @@ Engine::Engine(string name)
 
     m_graphics = NULL;
     m_window = NULL;
+
+    headless = false;
+    benchmarkFrames = 0;
 }
 
 Engine::~Engine()
@@ -38,14 +47,23 @@ Engine::~Engine()
     
     m_window = NULL;
     m_graphics = NULL;
+
+    Logger::stop( );
 }
 
 bool Engine::Initialize( const GraphicsInfo& progInfo )
 {
+    // Start the log writer
+
+    Logger::start( );
+
     // Start a window
     
+    headless = progInfo.headless;
+    benchmarkFrames = progInfo.benchmarkFrames;
+
     m_window = new Window();
-    if(!m_window->Initialize(m_WINDOW_NAME, &m_WINDOW_WIDTH, &m_WINDOW_HEIGHT))
+    if(!m_window->Initialize(m_WINDOW_NAME, &m_WINDOW_WIDTH, &m_WINDOW_HEIGHT, headless))
     {
         printf("The window failed to initialize.\n");
         return false;
@@ -70,20 +88,54 @@ bool Engine::Initialize( const GraphicsInfo& progInfo )
         return false;
     }
 
+    // Draw to a framebuffer when headless
+    if( !m_window->createOffscreenTarget( ) )
+    {
+        printf("The offscreen target failed to initialize.\n");
+        return false;
+    }
+
+    frameTimes.clear( );
+
+    if( headless )
+    {
+        frameTimes.reserve( benchmarkFrames );
+    }
+
     // Set the time
-    m_currentTimeMillis = GetCurrentTimeMillis();
+    m_clock.start( );
     // No errors
     return true;
 }
 
 void Engine::Run()
 {
+    unsigned int tickDT;
+    bool firstFrame = true;
+
     m_running = true;
 
     while(m_running)
     {
-        // Update the DT
-        m_DT = getDT();
+        // Start the frame on the simulation clock
+        m_clock.beginFrame( );
+
+        // A headless run times each frame as the next one starts
+        if( headless )
+        {
+            if( !firstFrame )
+            {
+                frameTimes.push_back( m_clock.getFrameSeconds( ) * 1000.0 );
+            }
+
+            firstFrame = false;
+
+            if( frameTimes.size( ) >= benchmarkFrames )
+            {
+                m_running = false;
+                break;
+            }
+        }
 
         // Check the keyboard input
 
@@ -94,13 +146,28 @@ void Engine::Run()
         }
 
 
-        // Update and render the graphics
-        m_graphics->Update(m_DT);
+        // Update once per tick the clock hands out for this frame, then render
+        m_DT = 0;
+
+        while( m_clock.nextTick( tickDT ) )
+        {
+            m_graphics->Update( tickDT );
+            m_DT += tickDT;
+        }
+
         m_graphics->Render();
 
         // Swap to the Window
         m_window->Swap();
     }
+
+    if( headless )
+    {
+        //the report follows the queued messages
+        Logger::flush( );
+
+        reportFrameTimes( );
+    }
 }
 
 void Engine::Keyboard()
@@ -117,6 +184,10 @@ void Engine::Keyboard()
         {
             m_running = false;
         }
+        else if( clockKeys( ) )
+        {
+            //the simulation clock took the key
+        }
         else if( m_event.key.keysym.sym == SDLK_UP )
         {
             if( m_graphics != NULL )
@@ -414,7 +485,7 @@ void Engine::Mouse( )
             {
                 if( SDL_SetRelativeMouseMode( SDL_TRUE ) )
                 {
-                    printf( "The mouse is in Relative Mode. \n" );
+                    LOG_INFO( "The mouse is in Relative Mode." );
                 }
             } 
         }
@@ -424,7 +495,7 @@ void Engine::Mouse( )
             {
                 if( SDL_SetRelativeMouseMode( SDL_FALSE ) )
                 {
-                    printf( "The mouse is in Relative Mode. \n" );
+                    LOG_INFO( "The mouse is in Relative Mode." );
                 }
             } 
         }
@@ -458,7 +529,7 @@ void Engine::Mouse( )
             {
                 if( SDL_SetRelativeMouseMode( SDL_TRUE ) )
                 {
-                    printf( "The mouse is in Relative Mode. \n" );
+                    LOG_INFO( "The mouse is in Relative Mode." );
                 }
 
                 mouse_initialized = true;
@@ -478,13 +549,111 @@ void Engine::Mouse( )
     
 }
 
-unsigned int Engine::getDT()
+// CLOCK KEYS //////////////////
+/***************************************
+
+@brief clockKeys
+
+@details handles the simulation clock's keys
+
+@param None
+
+@notes F5 pauses, F6 steps a paused simulation, F7 and F8 divide and
+       multiply the time scale by ten, F9 resets it and F10 switches
+       the fixed tick mode. returns true if the key was one of these
+
+***************************************/
+bool Engine::clockKeys( )
 {
-    long long TimeNowMillis = GetCurrentTimeMillis();
-    assert(TimeNowMillis >= m_currentTimeMillis);
-    unsigned int DeltaTimeMillis = (unsigned int)(TimeNowMillis - m_currentTimeMillis);
-    m_currentTimeMillis = TimeNowMillis;
-    return DeltaTimeMillis;
+    SDL_Keycode key = m_event.key.keysym.sym;
+
+    if( key == SDLK_F5 )
+    {
+        m_clock.togglePaused( );
+
+        LOG_INFO( ( m_clock.isPaused( ) ? "Simulation paused" : "Simulation running" ) );
+    }
+    else if( key == SDLK_F6 )
+    {
+        m_clock.step( );
+    }
+    else if( key == SDLK_F7 )
+    {
+        m_clock.setScale( m_clock.getScale( ) / 10.0 );
+
+        LOG_INFO( "Time scale: " << m_clock.getScale( ) << "x" );
+    }
+    else if( key == SDLK_F8 )
+    {
+        m_clock.setScale( m_clock.getScale( ) * 10.0 );
+
+        LOG_INFO( "Time scale: " << m_clock.getScale( ) << "x" );
+    }
+    else if( key == SDLK_F9 )
+    {
+        m_clock.setScale( 1.0 );
+
+        LOG_INFO( "Time scale: " << m_clock.getScale( ) << "x" );
+    }
+    else if( key == SDLK_F10 )
+    {
+        m_clock.setFixedTick( !m_clock.isFixedTick( ) );
+
+        LOG_INFO( ( m_clock.isFixedTick( ) ? "Fixed tick on" : "Fixed tick off" ) );
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+// REPORT FRAME TIMES //////////////////
+/***************************************
+
+@brief reportFrameTimes
+
+@details prints the percentiles of a headless run's frame times
+
+@param None
+
+@notes nearest rank percentiles, in milliseconds, so build machines
+       can track them from run to run
+
+***************************************/
+void Engine::reportFrameTimes( )
+{
+    const double PERCENTILES[ ] = { 50.0, 90.0, 95.0, 99.0 };
+    std::vector<double> sorted( frameTimes );
+    unsigned int index, rank;
+    double total = 0.0;
+
+    if( sorted.empty( ) )
+    {
+        std::cout << "No frames were timed." << std::endl;
+        return;
+    }
+
+    std::sort( sorted.begin( ), sorted.end( ) );
+
+    for( index = 0; index < sorted.size( ); index++ )
+    {
+        total += sorted[ index ];
+    }
+
+    std::cout << "Frames: " << sorted.size( ) << std::endl;
+    std::cout << "Mean: " << total / sorted.size( ) << " ms" << std::endl;
+
+    for( index = 0; index < sizeof( PERCENTILES ) / sizeof( PERCENTILES[ 0 ] ); index++ )
+    {
+        rank = ( unsigned int ) ceil( PERCENTILES[ index ] / 100.0 * sorted.size( ) );
+
+        std::cout << "P" << PERCENTILES[ index ] << ": "
+                  << sorted[ std::max( rank, 1u ) - 1 ] << " ms" << std::endl;
+    }
+
+    std::cout << "Max: " << sorted.back( ) << " ms" << std::endl;
 }
 
 long long Engine::GetCurrentTimeMillis()
@@ -1,4 +1,5 @@
 #include "graphics.h"
+#include "Logger.h"
 #include <algorithm>
 #include <sstream>
 
@@ -20,12 +21,42 @@ namespace ccb
 
     btScalar maxSpeed;
 
+    FlipperController* leftFlipperPtr;
+    FlipperController* rightFlipperPtr;
+
+    //moves the flippers along their strokes before every internal step
+    void PreTickCallback( btDynamicsWorld * world, btScalar timeStep )
+    {
+        if( leftFlipperPtr != NULL )
+        {
+            leftFlipperPtr->update( timeStep );
+        }
+
+        if( rightFlipperPtr != NULL )
+        {
+            rightFlipperPtr->update( timeStep );
+        }
+    }
+
+
+    //reads the tick's contacts for the monitor in the world's user info
+    void ContactTickCallback( btDynamicsWorld * world )
+    {
+        ContactMonitor * monitorPtr = static_cast<ContactMonitor *>( world->getWorldUserInfo( ) );
+
+        if( monitorPtr != NULL )
+        {
+            monitorPtr->scan( world->getDispatcher( ) );
+        }
+    }
 
     void TickCallback( btDynamicsWorld * world, btScalar timeStep )
     {
         btVector3 velocity, angularVelocity;
         btScalar speed;
 
+        ContactTickCallback( world );
+
         if( ballPtr == NULL )
         {
             return;
@@ -51,69 +82,6 @@ namespace ccb
         }
     }
 
-    struct ScoreContactResultCallback : public btCollisionWorld::ContactResultCallback
-    {
-
-        //functions
-        ScoreContactResultCallback( int * inPtr ) : scorePtr( inPtr ) { }
-
-        btScalar addSingleResult
-        (
-            btManifoldPoint& cp,
-            const btCollisionObjectWrapper * colObj0Wrap,
-            int partId0,
-            int index0,
-            const btCollisionObjectWrapper  * colObj1Wrap,
-            int partId1,
-            int index1
-        )
-        {
-            if( scorePtr != NULL )
-            {
-                *scorePtr += 1;
-
-                std::cout << "Score: " << *scorePtr << std::endl;
-            }
-
-            return 0;
-        }
-
-
-        //member
-        int * scorePtr;
-    };
-
-    struct TrapContactResultCallback : public btCollisionWorld::ContactResultCallback
-    {
-
-        //functions
-        TrapContactResultCallback( bool * inPtr ) : returnPtr( inPtr ) { }
-
-        btScalar addSingleResult
-        (
-            btManifoldPoint& cp,
-            const btCollisionObjectWrapper * colObj0Wrap,
-            int partId0,
-            int index0,
-            const btCollisionObjectWrapper  * colObj1Wrap,
-            int partId1,
-            int index1
-        )
-        {
-            if( returnPtr != NULL )
-            {
-                *returnPtr = true;
-            }
-
-            return 0;
-        }
-
-
-        //member
-        bool * returnPtr;
-    };
-
-
 };
 
 
@@ -127,6 +95,8 @@ Graphics::Graphics()
     dynamicsWorldPtr = NULL;
 
     ccb::ballPtr = NULL;
+    ccb::leftFlipperPtr = NULL;
+    ccb::rightFlipperPtr = NULL;
 
     boxIndex = -1;
     ballIndex = 0;
@@ -137,8 +107,6 @@ Graphics::Graphics()
     shaderSelect = 0;
     playingStateFlag = false;
     returnBall = false;
-    rightPaddleUp = false;
-    leftPaddleUp = false;
 
     rightPaddle = leftPaddle = 0;
 
@@ -146,6 +114,8 @@ Graphics::Graphics()
 
     pauseNotifier = false;
 
+    bumpSound = -1;
+
 	activeIdleState = true;
 
 	numberOfRightCalls = 0;
@@ -161,6 +131,15 @@ Graphics::~Graphics()
 {
     unsigned int index = 0;
 
+    if( dynamicsWorldPtr != NULL )
+    {
+        leftFlipper.Release( dynamicsWorldPtr );
+        rightFlipper.Release( dynamicsWorldPtr );
+    }
+
+    ccb::leftFlipperPtr = NULL;
+    ccb::rightFlipperPtr = NULL;
+
     for( index = 0; index < objectRegistry.getSize( ); index++ )
     {
         if( dynamicsWorldPtr != NULL )
@@ -235,11 +214,6 @@ Graphics::~Graphics()
 
         broadphasePtr = NULL;
     }
-
-	while( objectCollidedSound.SoundPlaying( ) )
-	{
-		//wait for sound to finish
-	}
 }
 
 bool Graphics::Initialize
@@ -299,7 +273,9 @@ bool Graphics::Initialize
 	
     score = 0;
 
-    objectCollidedSound.loadSound("sounds/bumpSound.wav");
+    bumpSound = objectCollidedSound.loadSound("sounds/bumpSound.wav");
+
+    physicsSettings = progInfo.physics;
 
     modelRegistry.clear( );
 
@@ -532,6 +508,10 @@ bool Graphics::Initialize
 
             tmpRigidBody->setLinearFactor( btVector3( 1, 0, 1 ) );
 
+            //sweep the ball once it moves far enough in one step to pass through a wall
+            tmpRigidBody->setCcdMotionThreshold( physicsSettings.ccdMotionThreshold );
+            tmpRigidBody->setCcdSweptSphereRadius( physicsSettings.ccdSweptSphereRadius );
+
             tmpRigidBody->setCollisionFlags( tmpRigidBody->getCollisionFlags( ) | btCollisionObject::CF_CUSTOM_MATERIAL_CALLBACK );
 
             ccb::ballPtr = tmpRigidBody;
@@ -641,7 +621,7 @@ bool Graphics::Initialize
 
             tmpRigidBody = new btRigidBody( rigidBodyConstruct );
 
-            tmpRigidBody->setCollisionFlags( tmpRigidBody->getCollisionFlags( ) | btCollisionObject::CF_KINEMATIC_OBJECT );
+            //turned by a hinge motor once it is in the world
             tmpRigidBody->setActivationState( DISABLE_DEACTIVATION );
         }
 
@@ -767,6 +747,14 @@ bool Graphics::Initialize
             objectRegistry[ index ].CollisionInfo( ).rigidBody = tmpRigidBody;
         }        
 
+        //only bodies with a user pointer raise contact events
+        if( objectRegistry[ index ].getName( ) == "ball"
+            || objectRegistry[ index ].getName( ) == "bumber"
+            || objectRegistry[ index ].getName( ) == "ballReturn" )
+        {
+            tmpRigidBody->setUserPointer( &objectRegistry[ index ] );
+        }
+
         dynamicsWorldPtr->addRigidBody( tmpRigidBody );
 
         tmpCompoundShape = NULL;
@@ -775,7 +763,39 @@ bool Graphics::Initialize
         tmpRigidBody = NULL;
     }
 
-    dynamicsWorldPtr->setInternalTickCallback( ccb::TickCallback );
+    dynamicsWorldPtr->setInternalTickCallback( ccb::TickCallback, &contactMonitor );
+    dynamicsWorldPtr->setInternalTickCallback( ccb::PreTickCallback, &contactMonitor, true );
+
+    dynamicsWorldPtr->getSolverInfo( ).m_numIterations = physicsSettings.solverIterations;
+
+    //hinge the paddles the table has
+    if( objectRegistry.getSize( ) > leftPaddle && objectRegistry[ leftPaddle ].getName( ) == "paddleL" )
+    {
+        if( !leftFlipper.Initialize( dynamicsWorldPtr, objectRegistry[ leftPaddle ].CollisionInfo( ).rigidBody,
+                                     1.0f, physicsSettings.timeScale ) )
+        {
+            std::cout << "Error: the left paddle could not be hinged!" << std::endl;
+            return false;
+        }
+
+        ccb::leftFlipperPtr = &leftFlipper;
+    }
+
+    if( objectRegistry.getSize( ) > rightPaddle && objectRegistry[ rightPaddle ].getName( ) == "paddleR" )
+    {
+        if( !rightFlipper.Initialize( dynamicsWorldPtr, objectRegistry[ rightPaddle ].CollisionInfo( ).rigidBody,
+                                      -1.0f, physicsSettings.timeScale ) )
+        {
+            std::cout << "Error: the right paddle could not be hinged!" << std::endl;
+            return false;
+        }
+
+        ccb::rightFlipperPtr = &rightFlipper;
+    }
+
+    std::cout << "Physics: step " << physicsSettings.fixedTimeStep << ", up to "
+              << physicsSettings.maxSubSteps << " steps per frame, "
+              << physicsSettings.solverIterations << " solver iterations" << std::endl;
 
     return true;
 }
@@ -783,27 +803,25 @@ bool Graphics::Initialize
 void Graphics::Update(unsigned int dt)
 {
     unsigned int index;
+    glm::mat4 listenerView;
+    bool stepWorld = false;
 
 	if( gameOverStep )
 	{
-		dynamicsWorldPtr->stepSimulation( dt, 10 );
+		stepWorld = true;
 		gameOverStep = false;
 	}
 
     if( returnBall )
     {
         resetBall( );
-        dynamicsWorldPtr->stepSimulation( dt, 10 );
+        stepWorld = true;
     }
 
     if( playingStateFlag )
     {
-        //put step rotation function here ////
-        updateLeftPaddle( dt );
-        updateRightPaddle( dt );
-        /////////////////////////////////////
-
-        dynamicsWorldPtr->stepSimulation( dt, 10 );
+        //the flippers are moved by the physics steps
+        stepWorld = true;
 
     }
 	else if( activeIdleState )
@@ -811,6 +829,14 @@ void Graphics::Update(unsigned int dt)
 		idleSplash( dt );
 	}
 
+    //one step per frame however many states asked for it
+    if( stepWorld )
+    {
+        stepPhysics( dt );
+    }
+
+    processContactEvents( );
+
     // Update the objects
     for( index = 0; index < objectRegistry.getSize( ); index++ )
     {
@@ -819,6 +845,14 @@ void Graphics::Update(unsigned int dt)
             updateChildren( index, dt );
         }        
     }
+
+    //hear the table from the camera
+    listenerView = m_camera->GetView( );
+
+    objectCollidedSound.setListeners( &listenerView, 1 );
+
+    //let the audio device sleep once the mixer is quiet
+    objectCollidedSound.Update( );
 }
 
 void Graphics::Render()
@@ -902,7 +936,7 @@ void Graphics::Render()
     if ( error != GL_NO_ERROR )
     {
         string val = ErrorString( error );
-        std::cout<< "Error initializing OpenGL! " << error << ", " << val << std::endl;
+        LOG_ERROR( "Error initializing OpenGL! " << error << ", " << val );
     }
 }
 
@@ -956,11 +990,6 @@ bool Graphics::updateList( unsigned int objectID, unsigned int dt )
 {
     btTransform trans;
     btScalar modTrans[ 16 ];
-    int tempScore = score;
-
-    ccb::ScoreContactResultCallback cylinderCallBack( &score );
-    ccb::TrapContactResultCallback returnBallCallBack( &returnBall );
-    
 
     if( ( objectID > objectRegistry.getSize( ) ) )
     {
@@ -984,27 +1013,7 @@ bool Graphics::updateList( unsigned int objectID, unsigned int dt )
         objectRegistry[ objectID ].setBulletTransform( glm::make_mat4( modTrans ) );
 
         objectRegistry[ objectID ].commitBulletTransform( );
-
-        if( ( objectRegistry[ objectID ].getName( ) == "bumber" )
-            && playingStateFlag )
-        {
-            dynamicsWorldPtr->contactPairTest( objectRegistry[ ballIndex ].CollisionInfo( ).rigidBody, 
-                                               objectRegistry[ objectID ].CollisionInfo( ).rigidBody, 
-                                               cylinderCallBack );
-        }
-
-        if( objectRegistry[ objectID ].getName( ) == "ballReturn" && playingStateFlag )
-        {
-            dynamicsWorldPtr->contactPairTest( objectRegistry[ ballIndex ].CollisionInfo( ).rigidBody,
-                                               objectRegistry[ objectID ].CollisionInfo( ).rigidBody,
-                                               returnBallCallBack );
-        }
     }    
-    if( tempScore != score )
-    {
-        objectCollidedSound.launchSound();
-    }
-    
 
     objectRegistry[ objectID ].Update( dt );
     //////////////////////////////////////////////////
@@ -1153,11 +1162,10 @@ void Graphics::moveBox( glm::vec3 pos )
         }
 
         pauseNotifier = true;
-        std::cout << std::endl;
-        std::cout << "The game is either paused or has not begun!" << std::endl;
-        std::cout << "Press the space bar to start the game." << std::endl;
-        std::cout << "Press p to unpause the game." << std::endl;
-        std::cout << std::endl;
+        LOG_INFO( std::endl
+                  << "The game is either paused or has not begun!" << std::endl
+                  << "Press the space bar to start the game." << std::endl
+                  << "Press p to unpause the game." << std::endl );
         return;
     }
 
@@ -1186,7 +1194,7 @@ void Graphics::cycleShaderProgram( )
         shaderSelect = 0;
     }
 
-    std::cout << "Shader Program " << shaderSelect + 1 << " selected." << std::endl;
+    LOG_INFO( "Shader Program " << shaderSelect + 1 << " selected." );
 
     linkToCurrentShaderProgram( );
 }
@@ -1243,10 +1251,10 @@ void Graphics::changeBrightness( std::string lightSelect, float redParam,
 
     else if( lightSelect == "specular" )
     {
-        std::cout << modelRegistry[ modelIndex ].modelPath << "'s specular: ";
-        std::cout << modelRegistry[ modelIndex ].objModel.getSpecular( ).r << ", ";
-        std::cout << modelRegistry[ modelIndex ].objModel.getSpecular( ).g << ", ";
-        std::cout << modelRegistry[ modelIndex ].objModel.getSpecular( ).b << "." << std::endl;
+        LOG_INFO( modelRegistry[ modelIndex ].modelPath << "'s specular: "
+                  << modelRegistry[ modelIndex ].objModel.getSpecular( ).r << ", "
+                  << modelRegistry[ modelIndex ].objModel.getSpecular( ).g << ", "
+                  << modelRegistry[ modelIndex ].objModel.getSpecular( ).b << "." );
 
         if( modelRegistry[ modelIndex ].objModel.getSpecular().r >= 0.95f && redParam > 0.0f )
         {
@@ -1295,10 +1303,10 @@ void Graphics::changeBrightness( std::string lightSelect, float redParam,
 
     else if( lightSelect == "spot"  && !spotLight.empty( ) )
     {
-        std::cout << "Spot Light Brightness: ";
-        std::cout << spotLight[ 0 ].ambient.r << ", ";
-        std::cout << spotLight[ 0 ].ambient.g << ", ";
-        std::cout << spotLight[ 0 ].ambient.b << "." << std::endl;
+        LOG_INFO( "Spot Light Brightness: "
+                  << spotLight[ 0 ].ambient.r << ", "
+                  << spotLight[ 0 ].ambient.g << ", "
+                  << spotLight[ 0 ].ambient.b << "." );
 
 
         if( spotLight[ 0 ].ambient.r >= 0.95f && redParam > 0.0f )
@@ -1360,7 +1368,7 @@ void Graphics::changeModelRegistryIndex( int i )
         modelIndex = modelRegistry.size() - 1;
     } 
 
-    std::cout << modelRegistry[ modelIndex ].modelPath << std::endl;
+    LOG_INFO( modelRegistry[ modelIndex ].modelPath );
 }
 
 void Graphics::chanceSpotLightSize( float increment )
@@ -1372,7 +1380,7 @@ void Graphics::chanceSpotLightSize( float increment )
 
     spotLight[ 0 ].coneAngle += increment;
 
-    std::cout << "Spot Light Angle: " << spotLight[ 0 ].coneAngle << std::endl;
+    LOG_INFO( "Spot Light Angle: " << spotLight[ 0 ].coneAngle );
 
     if( spotLight[ 0 ].coneAngle < 0.0f )
     {
@@ -1478,7 +1486,7 @@ bool Graphics::linkToCurrentShaderProgram( )
     m_shininess = shaderRegistry[ shaderSelect ].GetUniformLocation( "Shininess" );
     if( m_shininess == INVALID_UNIFORM_LOCATION )
     {
-        printf( "shininess not found\n" );
+        LOG_ERROR( "shininess not found" );
         return false;
     }
 
@@ -1513,7 +1521,7 @@ bool Graphics::linkToCurrentShaderProgram( )
     m_projectionMatrix = shaderRegistry[ shaderSelect ].GetUniformLocation( "projectionMatrix" );
     if( m_projectionMatrix == INVALID_UNIFORM_LOCATION )
     {
-        printf( "m_projectionMatrix not found\n" );
+        LOG_ERROR( "m_projectionMatrix not found" );
         return false;
     }
 
@@ -1521,7 +1529,7 @@ bool Graphics::linkToCurrentShaderProgram( )
     m_viewMatrix = shaderRegistry[ shaderSelect ].GetUniformLocation( "viewMatrix" );
     if( m_viewMatrix == INVALID_UNIFORM_LOCATION )
     {
-        printf( "m_viewMatrix not found\n" );
+        LOG_ERROR( "m_viewMatrix not found" );
         return false;
     }
 
@@ -1529,7 +1537,7 @@ bool Graphics::linkToCurrentShaderProgram( )
     m_modelMatrix = shaderRegistry[ shaderSelect ].GetUniformLocation( "modelMatrix" );
     if( m_modelMatrix == INVALID_UNIFORM_LOCATION )
     {
-        printf( "m_modelMatrix not found\n" );
+        LOG_ERROR( "m_modelMatrix not found" );
         return false;
     }
 
@@ -1580,6 +1588,84 @@ void Graphics::startGame( )
     }
 }
 
+// STEP PHYSICS //////////////////
+/***************************************
+
+@brief stepPhysics
+
+@details advances the dynamics world by one frame
+
+@param in: dt: the frame time in milliseconds
+
+@notes the world always runs at the configured fixed step; the
+       frame time only decides how many steps are taken
+
+***************************************/
+void Graphics::stepPhysics( unsigned int dt )
+{
+    dynamicsWorldPtr->stepSimulation( dt * physicsSettings.timeScale,
+                                      physicsSettings.maxSubSteps,
+                                      physicsSettings.fixedTimeStep );
+}
+
+// PROCESS CONTACT EVENTS //////////////////
+/***************************************
+
+@brief processContactEvents
+
+@details scores bumper hits and returns the ball from the contacts
+         found by the physics steps of this frame
+
+@param None
+
+@notes only the ball touching something raises an event here;
+       events are dropped while the game is not being played
+
+***************************************/
+void Graphics::processContactEvents( )
+{
+    const std::vector<ContactMonitor::ContactEvent>& events = contactMonitor.getEvents( );
+    Object * ballPtr = &objectRegistry[ ballIndex ];
+    Object * otherPtr;
+    unsigned int index;
+
+    for( index = 0; index < events.size( ) && playingStateFlag; index++ )
+    {
+        if( !events[ index ].began )
+        {
+            continue;
+        }
+
+        if( events[ index ].userPointerA == ballPtr )
+        {
+            otherPtr = static_cast<Object *>( events[ index ].userPointerB );
+        }
+        else if( events[ index ].userPointerB == ballPtr )
+        {
+            otherPtr = static_cast<Object *>( events[ index ].userPointerA );
+        }
+        else
+        {
+            continue;
+        }
+
+        if( otherPtr->getName( ) == "bumber" )
+        {
+            score++;
+
+            LOG_INFO( "Score: " << score );
+
+            objectCollidedSound.playSoundAt( bumpSound, glm::vec3( otherPtr->GetModel( )[ 3 ] ) );
+        }
+        else if( otherPtr->getName( ) == "ballReturn" )
+        {
+            returnBall = true;
+        }
+    }
+
+    contactMonitor.clearEvents( );
+}
+
 void Graphics::resetBall( )
 {
     btTransform currPos;
@@ -1593,8 +1679,8 @@ void Graphics::resetBall( )
         playingStateFlag = false;
 		activeIdleState = true;
 
-        std::cout << "Game over!" << std::endl;
-        std::cout << "Press space to restart the game." << std::endl;
+        LOG_INFO( "Game over!" << std::endl
+                  << "Press space to restart the game." );
 
 		gameOverStep = true;
         gameStarted = false;
@@ -1635,23 +1721,20 @@ void Graphics::turnPaddle( bool select )
         }
 
         pauseNotifier = true;
-        std::cout << std::endl;
-        std::cout << "The game is either paused or has not begun!" << std::endl;
-        std::cout << "Press the space bar to start the game." << std::endl;
-        std::cout << "Press p to unpause the game." << std::endl;
-        std::cout << std::endl;
+        LOG_INFO( std::endl
+                  << "The game is either paused or has not begun!" << std::endl
+                  << "Press the space bar to start the game." << std::endl
+                  << "Press p to unpause the game." << std::endl );
         return;
     }
 
     if( select == LEFT_PADDLE )
     {
-        leftPaddleUp = true; 
-
-
+        leftFlipper.flip( ccb::ballPtr );
     }
     else if( select == RIGHT_PADDLE )
     {
-        rightPaddleUp = true;
+        rightFlipper.flip( ccb::ballPtr );
     }
 }
 
@@ -1700,115 +1783,3 @@ void Graphics::turnOffSplash( )
 {
 	activeIdleState = false;
 }
-
-void Graphics::updateLeftPaddle( unsigned int dt )
-{
-    btTransform turn;
-    turn.setIdentity();
-    btQuaternion quat;  
-    btScalar x, y, z;
-
-    objectRegistry[ leftPaddle ].CollisionInfo( ).rigidBody->getWorldTransform().getBasis().getEulerZYX(z, y, x);
-    objectRegistry[ leftPaddle ].CollisionInfo( ).rigidBody->getMotionState()->getWorldTransform( turn );
-    //std::cout << "This is before: " << y << std::endl;
-    if( y >= 1.5f && leftPaddleUp )
-    {
-        leftPaddleUp = false;
-    }
-    else if( leftPaddleUp )
-    {
-        y += dt * M_PI/250;
-        //std::cout << "This is after: " << y << std::endl;
-        if( y > 1.55 )
-        {
-         y = 1.5;     
-        }
-        quat.setEulerZYX( 0, y , 0 );
-        turn.setRotation(quat);
-        
-        objectRegistry[ leftPaddle ].CollisionInfo( ).rigidBody->getMotionState( )->setWorldTransform( turn );
-
-    }
-    else if( y <= btRadians( 0 ) ) 
-    {
-        y = btRadians( 0 );
-        ///std::cout << "This is after: " << y << std::endl;
-        quat.setEulerZYX( 0, y , 0 );
-        turn.setRotation(quat);
-        
-        objectRegistry[ leftPaddle ].CollisionInfo( ).rigidBody->getMotionState( )->setWorldTransform( turn );
-     }
-     else
-     {
-        y -= dt * M_PI/250;
-        //std::cout << "This is after: " << y << std::endl;
-        quat.setEulerZYX( 0, y , 0 );
-        turn.setRotation(quat);
-        
-        objectRegistry[ leftPaddle ].CollisionInfo( ).rigidBody->getMotionState( )->setWorldTransform( turn );
-     }
-        
-
-    
-
-}
-
-void Graphics::updateRightPaddle( unsigned int dt )
-{
-    btTransform turn;
-    turn.setIdentity();
-    btQuaternion quat;  
-    btScalar x, y, z;
-
-    objectRegistry[ rightPaddle ].CollisionInfo( ).rigidBody->getWorldTransform().getBasis().getEulerZYX(z, y, x);
-    objectRegistry[ rightPaddle ].CollisionInfo( ).rigidBody->getMotionState()->getWorldTransform( turn );
-    //std::cout << "This is before: " << y << std::endl;
-    if( y <= -1.5f && rightPaddleUp )
-    {
-        rightPaddleUp = false;
-    }
-    else if( rightPaddleUp )
-    {
-        
-        y -= dt * M_PI/250;
-        //std::cout << "This is after: " << y << std::endl;
-        if( y < -1.55 )
-        {
-         y = -1.5;
-        }
-        quat.setEulerZYX( 0, y , 0 );
-        turn.setRotation(quat);
-        
-        objectRegistry[ rightPaddle ].CollisionInfo( ).rigidBody->getMotionState( )->setWorldTransform( turn );
-    }
-    else if( y >= btRadians( 0 ) ) 
-    {
-        y = btRadians( 0 );
-        //std::cout << "This is after: " << y << std::endl;
-        quat.setEulerZYX( 0, y , 0 );
-        turn.setRotation(quat);
-        
-        objectRegistry[ rightPaddle ].CollisionInfo( ).rigidBody->getMotionState( )->setWorldTransform( turn );
-     }
-     else
-     {
-        y += dt * M_PI/250;
-        //std::cout << "This is after: " << y << std::endl;
-        quat.setEulerZYX( 0, y , 0 );
-        turn.setRotation(quat);
-        
-        objectRegistry[ rightPaddle ].CollisionInfo( ).rigidBody->getMotionState( )->setWorldTransform( turn );
-     }
-        
-}
-
-
-
-
-
-
-
-
-
-
-
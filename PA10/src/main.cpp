@@ -4,6 +4,7 @@
 #include <string>
 #include <fstream>
 #include <sstream>
+#include <cstdlib>
 #include "rapidxml/rapidxml.hpp"
 #include "engine.h"
 
@@ -14,6 +15,10 @@ const string CONFIG_OPT = "-c";
 //help options
 const string HELP_OPT = "--h";
 
+//benchmark options
+const string HEADLESS_OPT = "--headless";
+const string FRAMES_OPT = "--frames";
+
 //general characters
 const char TAB_CHAR = '\t';
 
@@ -44,6 +49,13 @@ const string AMBIENT = "Ambient";
 const string CONE_ANGLE = "ConeAngle";
 const string SPOT_HEIGHT = "SpotHeight";
 const string FOLLOW_OBJ = "FollowMe";
+const string PHYSICS = "Physics";
+const string TIME_SCALE = "TimeScale";
+const string FIXED_TIME_STEP = "FixedTimeStep";
+const string MAX_SUB_STEPS = "MaxSubSteps";
+const string CCD_MOTION_THRESHOLD = "CcdMotionThreshold";
+const string CCD_SWEPT_SPHERE_RADIUS = "CcdSweptSphereRadius";
+const string SOLVER_ITERATIONS = "SolverIterations";
 
 // free function prototypes ////////////////
 bool ProcessCommandLineParameters( int argCount, char **argVector, 
@@ -59,6 +71,8 @@ bool ProcessConfigurationFileHelper( rapidxml::xml_node<> *parentNode,
 
 bool ProcessConfigShader( rapidxml::xml_node<> *parentNode, GraphicsInfo& progInfo );
 
+bool ProcessConfigPhysics( rapidxml::xml_node<> *parentNode, GraphicsInfo& progInfo );
+
 bool ProcessConfigLight( rapidxml::xml_node<> *parentNode, GraphicsInfo& progInfo, bool spotLight = false );
 
 bool ProcessConfigAmbient( rapidxml::xml_node<> *parentNode, GraphicsInfo& progInfo, bool spotLight = false );
@@ -151,6 +165,22 @@ bool ProcessCommandLineParameters
                 return false;
             }
         }
+        else if( tmpStr == HEADLESS_OPT )
+        {
+            progInfo.headless = true;
+        }
+        else if( tmpStr == FRAMES_OPT )
+        {
+            index++;
+
+            if( index >= argCount || atoi( argVector[ index ] ) <= 0 )
+            {
+                cout << FRAMES_OPT << " needs a number of frames above 0" << endl;
+                return false;
+            }
+
+            progInfo.benchmarkFrames = ( unsigned int ) atoi( argVector[ index ] );
+        }
         else if( tmpStr == HELP_OPT )
         {
             cout << endl << "Help selected." << endl << endl;
@@ -163,6 +193,10 @@ bool ProcessCommandLineParameters
             
             cout << "Options include: " <<endl;
             cout << CONFIG_OPT << " [CONFIG_FILE_PATH]" << endl <<endl;
+            cout << HEADLESS_OPT << ": draw offscreen without VSync and print the frame times"
+                 << endl << endl;
+            cout << FRAMES_OPT << " [NUMBER_OF_FRAMES]: frames a headless run draws, "
+                 << "1000 by default" << endl << endl;
 
             cout <<"Example usage: " << endl;
             cout <<"./Pinball -c config/Bullet.xml" << endl << endl;
@@ -269,6 +303,10 @@ bool ProcessConfigurationFile
         {
             noError = ( noError && ProcessConfigLight( parentNode, progInfo ) );
         }
+        else if( parentNode->name( ) == PHYSICS )
+        {
+            noError = ( noError && ProcessConfigPhysics( parentNode, progInfo ) );
+        }
         else if( parentNode->name( ) == SPOT_LIGHT )
         {           
 
@@ -637,3 +675,65 @@ bool ProcessConfigAmbient( rapidxml::xml_node<>* parentNode, GraphicsInfo & prog
 
     return lightX && lightY && lightZ;
 }
+
+// PROCESS CONFIG PHYSICS //////////
+/***************************************
+
+@brief ProcessConfigPhysics
+
+@details reads the step rate, solver and ball CCD settings
+
+@param in: parentNode: the Physics node in the xml doc
+
+@param out: progInfo: a struct containing program information
+
+@notes settings left out keep their defaults
+
+***************************************/
+bool ProcessConfigPhysics( rapidxml::xml_node<>* parentNode, GraphicsInfo & progInfo )
+{
+    rapidxml::xml_node<> *childNode;
+    string tempStr;
+
+    for( childNode = parentNode->first_node( 0 ); childNode;
+         childNode = childNode->next_sibling( ) )
+    {
+        tempStr = childNode->value( );
+
+        std::stringstream strStream( tempStr );
+
+        if( childNode->name( ) == TIME_SCALE )
+        {
+            strStream >> progInfo.physics.timeScale;
+        }
+        else if( childNode->name( ) == FIXED_TIME_STEP )
+        {
+            strStream >> progInfo.physics.fixedTimeStep;
+        }
+        else if( childNode->name( ) == MAX_SUB_STEPS )
+        {
+            strStream >> progInfo.physics.maxSubSteps;
+        }
+        else if( childNode->name( ) == CCD_MOTION_THRESHOLD )
+        {
+            strStream >> progInfo.physics.ccdMotionThreshold;
+        }
+        else if( childNode->name( ) == CCD_SWEPT_SPHERE_RADIUS )
+        {
+            strStream >> progInfo.physics.ccdSweptSphereRadius;
+        }
+        else if( childNode->name( ) == SOLVER_ITERATIONS )
+        {
+            strStream >> progInfo.physics.solverIterations;
+        }
+    }
+
+    if( progInfo.physics.fixedTimeStep <= 0.0f || progInfo.physics.maxSubSteps < 1
+        || progInfo.physics.solverIterations < 1 )
+    {
+        std::cout << "Invalid physics step settings!" << std::endl;
+        return false;
+    }
+
+    return true;
+}
@@ -1,22 +1,75 @@
 #include <window.h>
+#include "graphics_headers.h"
 
 Window::Window()
 {
     gWindow = NULL;
+
+    offscreen = false;
+    offscreenFBO = 0;
+    offscreenColor = 0;
+    offscreenDepth = 0;
+    offscreenWidth = 0;
+    offscreenHeight = 0;
 }
 
 Window::~Window()
 {
+    if( offscreenFBO != 0 )
+    {
+        glDeleteFramebuffers( 1, &offscreenFBO );
+        glDeleteRenderbuffers( 1, &offscreenColor );
+        glDeleteRenderbuffers( 1, &offscreenDepth );
+    }
+
     SDL_StopTextInput();
     SDL_DestroyWindow(gWindow);
     gWindow = NULL;
     SDL_Quit();
 }
 
-bool Window::Initialize(const string &name, int* width, int* height)
+// INITIALIZE //////////////////
+/***************************************
+
+@brief Initialize
+
+@details starts SDL and makes the window and its OpenGL context
+
+@param in: name: the window's title
+
+@param in/out: width: the window's width, 0 for the screen's
+
+@param in/out: height: the window's height, 0 for the screen's
+
+@param in: headless: true to keep the window hidden and run unsynced
+
+@notes with no display, a headless run uses SDL's offscreen video
+       driver, which makes an EGL context that Mesa can back without a
+       GPU. the sound goes to SDL's dummy driver
+
+***************************************/
+bool Window::Initialize(const string &name, int* width, int* height, bool headless)
 {
+    Uint32 windowFlags = SDL_WINDOW_OPENGL | SDL_WINDOW_SHOWN;
+
+    offscreen = headless;
+
+    if( offscreen )
+    {
+        windowFlags = SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN;
+
+        #if !defined( _WIN64 ) && !defined( _WIN32 ) && !defined( __APPLE__ )
+            if( SDL_getenv( "DISPLAY" ) == NULL && SDL_getenv( "WAYLAND_DISPLAY" ) == NULL )
+            {
+                SDL_setenv( "SDL_VIDEODRIVER", "offscreen", 0 );
+            }
+        #endif
+
+        SDL_setenv( "SDL_AUDIODRIVER", "dummy", 0 );
+    }
+
         // Start SDL
-    if(SDL_Init(SDL_INIT_VIDEO) < 0)
+    if(SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0)
     {
         printf("SDL failed to initialize: %s\n", SDL_GetError());
         return false;
@@ -42,7 +95,7 @@ bool Window::Initialize(const string &name, int* width, int* height)
         *width = current.w;
     }
 
-    gWindow = SDL_CreateWindow(name.c_str(), SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, *width, *height, SDL_WINDOW_OPENGL | SDL_WINDOW_SHOWN );
+    gWindow = SDL_CreateWindow(name.c_str(), SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, *width, *height, windowFlags );
     if(gWindow == NULL)
     {
         printf("Widow failed to create: %s\n", SDL_GetError());
@@ -57,6 +110,17 @@ bool Window::Initialize(const string &name, int* width, int* height)
         return false;
     }
 
+    // Headless runs are not synced, so the frame time is the render's
+    if( offscreen )
+    {
+        SDL_GL_SetSwapInterval( 0 );
+
+        offscreenWidth = *width;
+        offscreenHeight = *height;
+
+        return true;
+    }
+
     // Use VSync
     if(SDL_GL_SetSwapInterval(1) < 0)
     {
@@ -67,7 +131,69 @@ bool Window::Initialize(const string &name, int* width, int* height)
     return true;
 }
 
+// CREATE OFFSCREEN TARGET //////////////////
+/***************************************
+
+@brief createOffscreenTarget
+
+@details makes and binds the framebuffer a headless run draws to
+
+@param None
+
+@notes call after GLEW is started. nothing unbinds it, so every draw
+       after this goes to the framebuffer, at the window's size
+
+***************************************/
+bool Window::createOffscreenTarget( )
+{
+    if( !offscreen )
+    {
+        return true;
+    }
+
+    glGenRenderbuffers( 1, &offscreenColor );
+    glBindRenderbuffer( GL_RENDERBUFFER, offscreenColor );
+    glRenderbufferStorage( GL_RENDERBUFFER, GL_RGBA8, offscreenWidth, offscreenHeight );
+
+    glGenRenderbuffers( 1, &offscreenDepth );
+    glBindRenderbuffer( GL_RENDERBUFFER, offscreenDepth );
+    glRenderbufferStorage( GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, offscreenWidth, offscreenHeight );
+
+    glGenFramebuffers( 1, &offscreenFBO );
+    glBindFramebuffer( GL_FRAMEBUFFER, offscreenFBO );
+    glFramebufferRenderbuffer( GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, offscreenColor );
+    glFramebufferRenderbuffer( GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, offscreenDepth );
+
+    if( glCheckFramebufferStatus( GL_FRAMEBUFFER ) != GL_FRAMEBUFFER_COMPLETE )
+    {
+        printf( "The offscreen framebuffer is not complete.\n" );
+        return false;
+    }
+
+    glViewport( 0, 0, offscreenWidth, offscreenHeight );
+
+    return true;
+}
+
+// SWAP //////////////////
+/***************************************
+
+@brief Swap
+
+@details shows the frame, or in a headless run waits for it to finish
+
+@param None
+
+@notes the wait keeps the GPU's work inside the measured frame time
+
+***************************************/
 void Window::Swap()
 {
+    if( offscreen )
+    {
+        glFinish( );
+        return;
+    }
+
     SDL_GL_SwapWindow(gWindow);
 }
@@ -0,0 +1,384 @@
+// header files ///////////////////////////
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <btBulletDynamicsCommon.h>
+#include "PhysicsConfig.h"
+#include "Flipper.h"
+
+/***************************************
+
+@file FlipperTest.cpp
+
+@brief Times how fast a flipper moves a ball resting against it
+
+@note the test builds a world of its own with the game's ball, a flipper
+      and the Physics block of the configuration file, config/Bullet.xml
+      unless another is given. each row presses the flipper once with
+      the ball resting against its face near the tip, first with the
+      old kinematic paddle, whose transform jumped once a frame, then
+      with the hinge motor of FlipperController. a row prints the
+      internal ticks from the press until the ball moves, the ball's
+      speed at the end of the stroke and the solver iterations used.
+      the hinge failing to move the ball, or letting it through, with
+      the configuration's solver iterations fails
+
+***************************************/
+
+// global constants ///////////////////////
+
+//a 60 fps frame in milliseconds, as Graphics::stepPhysics is given it
+static const unsigned int FRAME_TIME = 16;
+static const unsigned int FRAMES_PER_STROKE = 30;
+
+//the turn per millisecond of the old updateLeftPaddle, and its top
+static const btScalar KINEMATIC_TURN = M_PI / 250.0f;
+static const btScalar KINEMATIC_TOP = 1.5f;
+
+//the ball of the game, its bounding scale of 10 plus one
+static const btScalar BALL_RADIUS = 6.0f;
+
+//a flipper as wide and tall as the game's, hinged at its centre
+static const btScalar FLIPPER_HALF_WIDTH = 26.0f;
+static const btScalar FLIPPER_HALF_HEIGHT = 8.0f;
+static const btScalar FLIPPER_HALF_THICKNESS = 2.0f;
+static const btScalar FLIPPER_MASS = 100.0f;
+
+//where the ball rests, along the flipper from the hinge and off its face
+static const btScalar BALL_REACH = 19.0f;
+static const btScalar BALL_GAP = 0.05f;
+
+// struct definitions /////////////////////
+
+//shared by the tick callbacks through the world's user info
+struct StrokeWatch
+{
+    FlipperController* flipper; //NULL for the kinematic paddle
+    btRigidBody* ball;
+    int ticks; //internal ticks since the press
+    int responseTicks; //ticks until the ball moved, -1 until it does
+};
+
+struct StrokeResult
+{
+    int responseTicks;
+    btScalar ballSpeed;
+    bool passedThrough;
+};
+
+// free function prototypes ///////////////
+
+static void PreTickCallback( btDynamicsWorld* world, btScalar timeStep );
+
+static void TickCallback( btDynamicsWorld* world, btScalar timeStep );
+
+static void RunStroke( const PhysicsInfo& physics, int iterations, bool hinged,
+                       StrokeResult& result );
+
+static void PrintResult( const char* name, const PhysicsInfo& physics,
+                         const StrokeResult& result );
+
+// main ///////////////////////////////////
+
+#if defined( _WIN64 ) || ( _WIN32 )
+    #undef main
+#endif
+
+int main(int argc, char **argv)
+{
+    std::string configFile = "config/Bullet.xml";
+    PhysicsInfo physics;
+    StrokeResult kinematic, hinged;
+    std::vector<int> iterations;
+    unsigned int index;
+    int count;
+    bool passed = true;
+
+    if( argc > 1 )
+    {
+        configFile = argv[ 1 ];
+    }
+
+    if( !ReadPhysics( configFile, physics ) )
+    {
+        std::cout << "This program is ran as follows: " << std::endl;
+        std::cout << "./FlipperTest [CONFIGURATION_FILE]" << std::endl;
+        std::cout << "config/Bullet.xml by default, its Physics block sets the steps"
+                  << std::endl;
+        return 1;
+    }
+
+    std::cout << "Flipper test: ball resting " << BALL_REACH << " units out on a "
+              << 2.0f * FLIPPER_HALF_WIDTH << " unit flipper, step "
+              << physics.fixedTimeStep << " ( " << physics.fixedTimeStep / physics.timeScale
+              << " ms ), up to " << physics.maxSubSteps << " steps per frame, from "
+              << configFile << std::endl;
+
+    //doubling up to the configuration's iterations, then twice them
+    for( count = 1; count < physics.solverIterations; count *= 2 )
+    {
+        iterations.push_back( count );
+    }
+
+    iterations.push_back( physics.solverIterations );
+    iterations.push_back( 2 * physics.solverIterations );
+
+    for( index = 0; index < iterations.size( ); index++ )
+    {
+        RunStroke( physics, iterations[ index ], false, kinematic );
+        RunStroke( physics, iterations[ index ], true, hinged );
+
+        std::cout << "  " << iterations[ index ] << " solver iterations" << std::endl;
+
+        PrintResult( "kinematic", physics, kinematic );
+        PrintResult( "hinge motor", physics, hinged );
+
+        if( iterations[ index ] == physics.solverIterations
+            && ( hinged.responseTicks < 0 || hinged.passedThrough ) )
+        {
+            passed = false;
+        }
+    }
+
+    std::cout << ( passed ? "The hinged flipper moved the ball"
+                          : "FAIL: the hinged flipper did not move the ball" )
+              << std::endl;
+
+    return passed ? 0 : 1;
+}
+
+// free function implementation /////////////
+// PRE TICK CALLBACK //////////
+/***************************************
+
+@brief PreTickCallback
+
+@details moves the hinged flipper along its stroke, as the game does
+
+@param in: world: the test's world
+
+@param in: timeStep: the length of the internal step
+
+@notes none
+
+***************************************/
+static void PreTickCallback( btDynamicsWorld* world, btScalar timeStep )
+{
+    StrokeWatch* watch = static_cast<StrokeWatch*>( world->getWorldUserInfo( ) );
+
+    if( watch->flipper != NULL )
+    {
+        watch->flipper->update( timeStep );
+    }
+}
+
+// TICK CALLBACK //////////
+/***************************************
+
+@brief TickCallback
+
+@details counts the ticks until the ball moves
+
+@param in: world: the test's world
+
+@param in: timeStep: the length of the internal step
+
+@notes the ball counts as moved at FlipperController::RESPONSE_SPEED,
+       the speed the game's own response log uses
+
+***************************************/
+static void TickCallback( btDynamicsWorld* world, btScalar timeStep )
+{
+    StrokeWatch* watch = static_cast<StrokeWatch*>( world->getWorldUserInfo( ) );
+
+    watch->ticks++;
+
+    if( watch->responseTicks < 0
+        && watch->ball->getLinearVelocity( ).length( ) > FlipperController::RESPONSE_SPEED )
+    {
+        watch->responseTicks = watch->ticks;
+    }
+}
+
+// RUN STROKE //////////
+/***************************************
+
+@brief RunStroke
+
+@details presses a flipper once with the ball resting against it
+
+@param in: physics: the step and CCD settings
+
+@param in: iterations: the solver iterations per internal step
+
+@param in: hinged: true for the hinge motor, false for the old
+               kinematic paddle
+
+@param out: result: the ticks until the ball moved, its final speed
+                and whether it ended up behind the flipper
+
+@notes each stroke gets a new world, so no contact carries over. the
+       kinematic paddle turns the way the old updateLeftPaddle did,
+       once a frame before the step, with the same steps as the hinge
+
+***************************************/
+static void RunStroke
+(
+    const PhysicsInfo& physics,
+    int iterations,
+    bool hinged,
+    StrokeResult& result
+)
+{
+    btDbvtBroadphase broadphase;
+    btDefaultCollisionConfiguration collisionConfig;
+    btCollisionDispatcher dispatcher( &collisionConfig );
+    btSequentialImpulseConstraintSolver solver;
+    btDiscreteDynamicsWorld world( &dispatcher, &broadphase, &solver, &collisionConfig );
+
+    btSphereShape ballShape( BALL_RADIUS );
+    btBoxShape flipperShape( btVector3( FLIPPER_HALF_WIDTH, FLIPPER_HALF_HEIGHT,
+                                        FLIPPER_HALF_THICKNESS ) );
+    btDefaultMotionState ballMotion( btTransform( btQuaternion( 0, 0, 0, 1 ),
+                                     btVector3( BALL_REACH, 0.0f,
+                                                -1.0f * ( FLIPPER_HALF_THICKNESS
+                                                          + BALL_RADIUS + BALL_GAP ) ) ) );
+    btDefaultMotionState flipperMotion;
+    btVector3 ballInertia( 0.0f, 0.0f, 0.0f ), flipperInertia( 0.0f, 0.0f, 0.0f );
+    btTransform turn;
+    btVector3 ballLocal;
+    FlipperController flipper;
+    StrokeWatch watch;
+    btScalar angle = 0.0f;
+    unsigned int frame;
+
+    //the ball rests, nothing but the flipper may move it
+    world.setGravity( btVector3( 0.0f, 0.0f, 0.0f ) );
+    world.getSolverInfo( ).m_numIterations = iterations;
+
+    ballShape.calculateLocalInertia( 1.0f, ballInertia );
+
+    btRigidBody::btRigidBodyConstructionInfo ballConstruct( 1.0f, &ballMotion,
+                                                            &ballShape, ballInertia );
+    ballConstruct.m_restitution = 1.0f;
+    ballConstruct.m_friction = 1.0f;
+
+    btRigidBody ball( ballConstruct );
+    ball.setActivationState( DISABLE_DEACTIVATION );
+    ball.setCcdMotionThreshold( physics.ccdMotionThreshold );
+    ball.setCcdSweptSphereRadius( physics.ccdSweptSphereRadius );
+
+    if( hinged )
+    {
+        flipperShape.calculateLocalInertia( FLIPPER_MASS, flipperInertia );
+    }
+
+    btRigidBody::btRigidBodyConstructionInfo flipperConstruct( hinged ? FLIPPER_MASS : 0.0f,
+                                                               &flipperMotion, &flipperShape,
+                                                               flipperInertia );
+    flipperConstruct.m_restitution = 1.0f;
+    flipperConstruct.m_friction = 1.0f;
+
+    btRigidBody flipperBody( flipperConstruct );
+    flipperBody.setActivationState( DISABLE_DEACTIVATION );
+
+    if( !hinged )
+    {
+        flipperBody.setCollisionFlags( flipperBody.getCollisionFlags( )
+                                       | btCollisionObject::CF_KINEMATIC_OBJECT );
+    }
+
+    world.addRigidBody( &flipperBody );
+    world.addRigidBody( &ball );
+
+    watch.flipper = NULL;
+    watch.ball = &ball;
+    watch.ticks = 0;
+    watch.responseTicks = -1;
+
+    if( hinged )
+    {
+        flipper.Initialize( &world, &flipperBody, 1.0f, physics.timeScale );
+
+        watch.flipper = &flipper;
+    }
+
+    world.setInternalTickCallback( TickCallback, &watch );
+    world.setInternalTickCallback( PreTickCallback, &watch, true );
+
+    //the press
+    if( hinged )
+    {
+        flipper.flip( NULL );
+    }
+
+    for( frame = 0; frame < FRAMES_PER_STROKE; frame++ )
+    {
+        if( !hinged && angle < KINEMATIC_TOP )
+        {
+            angle = std::min( angle + ( FRAME_TIME * KINEMATIC_TURN ), KINEMATIC_TOP );
+
+            turn.setIdentity( );
+            turn.setRotation( btQuaternion( btVector3( 0.0f, 1.0f, 0.0f ), angle ) );
+
+            flipperBody.getMotionState( )->setWorldTransform( turn );
+        }
+
+        world.stepSimulation( FRAME_TIME * physics.timeScale, physics.maxSubSteps,
+                              physics.fixedTimeStep );
+    }
+
+    //behind the flipper's face and over it means the ball went through
+    ballLocal = flipperBody.getWorldTransform( ).invXform( ball.getWorldTransform( ).getOrigin( ) );
+
+    result.responseTicks = watch.responseTicks;
+    result.ballSpeed = ball.getLinearVelocity( ).length( );
+    result.passedThrough = ballLocal.getZ( ) > 0.0f
+                           && std::fabs( ballLocal.getX( ) ) < FLIPPER_HALF_WIDTH;
+
+    if( hinged )
+    {
+        flipper.Release( &world );
+    }
+
+    world.removeRigidBody( &ball );
+    world.removeRigidBody( &flipperBody );
+}
+
+// PRINT RESULT //////////
+/***************************************
+
+@brief PrintResult
+
+@details prints one flipper's stroke
+
+@param in: name: the way the flipper was driven
+
+@param in: physics: the step settings, to turn ticks into milliseconds
+
+@param in: result: the stroke
+
+@notes none
+
+***************************************/
+static void PrintResult( const char* name, const PhysicsInfo& physics,
+                         const StrokeResult& result )
+{
+    std::cout << "    " << name << ": ";
+
+    if( result.responseTicks < 0 )
+    {
+        std::cout << "the ball never moved";
+    }
+    else
+    {
+        std::cout << "ball moved after " << result.responseTicks << " ticks ( "
+                  << result.responseTicks * physics.fixedTimeStep / physics.timeScale
+                  << " ms )";
+    }
+
+    std::cout << ", speed " << result.ballSpeed
+              << ( result.passedThrough ? ", passed through" : "" ) << std::endl;
+}
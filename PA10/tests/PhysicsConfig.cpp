@@ -0,0 +1,95 @@
+// header files ///////////////////////////
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include "PhysicsConfig.h"
+#include "rapidxml/rapidxml.hpp"
+
+// free function implementation /////////////
+// READ PHYSICS //////////
+/***************************************
+
+@brief ReadPhysics
+
+@details reads the Physics block of a configuration file
+
+@param in: fileName: the configuration file
+
+@param out: physics: the step and CCD settings
+
+@notes settings the block leaves out keep the game's defaults, and so
+       does a file with no Physics block. returns false if the file
+       cannot be read or a setting is out of range
+
+***************************************/
+bool ReadPhysics( const std::string& fileName, PhysicsInfo& physics )
+{
+    std::ifstream fileOpen( fileName.c_str( ) );
+    std::vector<char> buffer;
+    std::string name;
+
+    rapidxml::xml_document<> doc;
+    rapidxml::xml_node<> *rootNode, *physicsNode, *childNode;
+
+    if( fileOpen.fail( ) )
+    {
+        std::cout << "Failure reading in the file: " << fileName << "!!!" << std::endl;
+
+        return false;
+    }
+
+    buffer = std::vector<char>( std::istreambuf_iterator<char>( fileOpen ),
+                                std::istreambuf_iterator<char>( ) );
+
+    fileOpen.close( );
+
+    buffer.push_back( '\0' );
+
+    doc.parse<0>( &buffer[ 0 ] );
+
+    rootNode = doc.first_node( "Configuration" );
+    physicsNode = ( rootNode != NULL ) ? rootNode->first_node( "Physics" ) : NULL;
+
+    for( childNode = ( physicsNode != NULL ) ? physicsNode->first_node( 0 ) : NULL; childNode;
+         childNode = childNode->next_sibling( ) )
+    {
+        std::stringstream strStream( childNode->value( ) );
+
+        name = childNode->name( );
+
+        if( name == "TimeScale" )
+        {
+            strStream >> physics.timeScale;
+        }
+        else if( name == "FixedTimeStep" )
+        {
+            strStream >> physics.fixedTimeStep;
+        }
+        else if( name == "MaxSubSteps" )
+        {
+            strStream >> physics.maxSubSteps;
+        }
+        else if( name == "CcdMotionThreshold" )
+        {
+            strStream >> physics.ccdMotionThreshold;
+        }
+        else if( name == "CcdSweptSphereRadius" )
+        {
+            strStream >> physics.ccdSweptSphereRadius;
+        }
+        else if( name == "SolverIterations" )
+        {
+            strStream >> physics.solverIterations;
+        }
+    }
+
+    if( physics.fixedTimeStep <= 0.0f || physics.maxSubSteps < 1
+        || physics.solverIterations < 1 )
+    {
+        std::cout << "Invalid physics step settings!" << std::endl;
+        return false;
+    }
+
+    return true;
+}
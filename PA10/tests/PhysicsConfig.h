@@ -0,0 +1,23 @@
+/***************************************
+
+@file PhysicsConfig.h
+
+@brief Reads the Physics block of a configuration file for the tests
+
+@note the tests build worlds of their own, so they only need the step,
+      solver and CCD settings, not the whole table
+
+***************************************/
+
+#ifndef PHYSICS_CONFIG_H
+#define PHYSICS_CONFIG_H
+
+// header files ///////////////////////////
+#include <string>
+#include "GraphicsInfo.h"
+
+// free function prototypes ///////////////
+
+bool ReadPhysics( const std::string& fileName, PhysicsInfo& physics );
+
+#endif /* PHYSICS_CONFIG_H */
@@ -0,0 +1,253 @@
+// header files ///////////////////////////
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <btBulletDynamicsCommon.h>
+#include "PhysicsConfig.h"
+
+/***************************************
+
+@file TunnelingTest.cpp
+
+@brief Checks that a fast ball never passes through a thin flipper
+
+@note the test builds a world of its own with the ball and flipper
+      settings of the game and the Physics block of the configuration
+      file, config/Bullet.xml unless another is given, so it never
+      touches a running table. each row fires the ball straight at the
+      flipper from SHOTS points across its face, with CCD off and on,
+      and prints how many shots passed through and what a frame of
+      physics costs. any pass through with CCD on fails
+
+***************************************/
+
+// global constants ///////////////////////
+
+//a 60 fps frame in milliseconds, as Graphics::stepPhysics is given it
+static const unsigned int FRAME_TIME = 16;
+static const unsigned int FRAMES_PER_SHOT = 60;
+
+//the ball of the game, its bounding scale of 10 plus one
+static const btScalar BALL_RADIUS = 6.0f;
+
+//a flipper as wide and tall as the game's, but only 2 units thick
+static const btScalar FLIPPER_HALF_WIDTH = 26.0f;
+static const btScalar FLIPPER_HALF_HEIGHT = 8.0f;
+static const btScalar FLIPPER_HALF_THICKNESS = 1.0f;
+
+static const btScalar START_DISTANCE = 60.0f;
+static const unsigned int SHOTS = 9;
+
+// free function prototypes ///////////////
+
+static bool FireShot( btDiscreteDynamicsWorld& world, btRigidBody& ball,
+                      const PhysicsInfo& physics, btScalar offset, btScalar speed,
+                      double& stepMicroseconds, unsigned int& steppedFrames );
+
+// main ///////////////////////////////////
+
+#if defined( _WIN64 ) || ( _WIN32 )
+    #undef main
+#endif
+
+int main(int argc, char **argv)
+{
+    const btScalar speeds[ ] = { 50.0f, 100.0f, 200.0f, 400.0f, 800.0f, 1600.0f, 3200.0f };
+
+    btDbvtBroadphase broadphase;
+    btDefaultCollisionConfiguration collisionConfig;
+    btCollisionDispatcher dispatcher( &collisionConfig );
+    btSequentialImpulseConstraintSolver solver;
+    btDiscreteDynamicsWorld world( &dispatcher, &broadphase, &solver, &collisionConfig );
+
+    btSphereShape ballShape( BALL_RADIUS );
+    btBoxShape flipperShape( btVector3( FLIPPER_HALF_WIDTH, FLIPPER_HALF_HEIGHT,
+                                        FLIPPER_HALF_THICKNESS ) );
+    btDefaultMotionState ballMotion, flipperMotion;
+    btVector3 ballInertia( 0.0f, 0.0f, 0.0f );
+
+    std::string configFile = "config/Bullet.xml";
+    PhysicsInfo physics;
+    unsigned int speedIndex, shot, passes, steppedFrames;
+    btScalar offset;
+    double stepMicroseconds;
+    int useCcd;
+    bool passed = true;
+
+    if( argc > 1 )
+    {
+        configFile = argv[ 1 ];
+    }
+
+    if( !ReadPhysics( configFile, physics ) )
+    {
+        std::cout << "This program is ran as follows: " << std::endl;
+        std::cout << "./TunnelingTest [CONFIGURATION_FILE]" << std::endl;
+        std::cout << "config/Bullet.xml by default, its Physics block sets the steps and CCD"
+                  << std::endl;
+        return 1;
+    }
+
+    world.getSolverInfo( ).m_numIterations = physics.solverIterations;
+
+    //gravity would bend the shots away from the flipper
+    world.setGravity( btVector3( 0.0f, 0.0f, 0.0f ) );
+
+    ballShape.calculateLocalInertia( 1.0f, ballInertia );
+
+    btRigidBody::btRigidBodyConstructionInfo ballConstruct( 1.0f, &ballMotion,
+                                                            &ballShape, ballInertia );
+    ballConstruct.m_restitution = 1.0f;
+    ballConstruct.m_friction = 1.0f;
+
+    btRigidBody ball( ballConstruct );
+    ball.setActivationState( DISABLE_DEACTIVATION );
+
+    btRigidBody::btRigidBodyConstructionInfo flipperConstruct( 0.0f, &flipperMotion,
+                                                               &flipperShape );
+    flipperConstruct.m_restitution = 1.0f;
+    flipperConstruct.m_friction = 1.0f;
+
+    btRigidBody flipper( flipperConstruct );
+
+    world.addRigidBody( &flipper );
+    world.addRigidBody( &ball );
+
+    std::cout << "Tunneling test: " << SHOTS << " shots per row at a "
+              << 2.0f * FLIPPER_HALF_THICKNESS << " unit thick flipper, step "
+              << physics.fixedTimeStep << ", up to " << physics.maxSubSteps
+              << " steps per frame, from " << configFile << std::endl;
+
+    for( useCcd = 0; useCcd < 2; useCcd++ )
+    {
+        ball.setCcdMotionThreshold( useCcd ? physics.ccdMotionThreshold : 0.0f );
+        ball.setCcdSweptSphereRadius( useCcd ? physics.ccdSweptSphereRadius : 0.0f );
+
+        for( speedIndex = 0; speedIndex < sizeof( speeds ) / sizeof( speeds[ 0 ] ); speedIndex++ )
+        {
+            passes = 0;
+            stepMicroseconds = 0.0;
+            steppedFrames = 0;
+
+            for( shot = 0; shot < SHOTS; shot++ )
+            {
+                //keep the whole ball over the flipper's face
+                offset = ( FLIPPER_HALF_WIDTH - BALL_RADIUS )
+                         * ( ( 2.0f * shot / ( SHOTS - 1 ) ) - 1.0f );
+
+                if( !FireShot( world, ball, physics, offset, speeds[ speedIndex ],
+                               stepMicroseconds, steppedFrames ) )
+                {
+                    passes++;
+                }
+            }
+
+            std::cout << "  speed " << speeds[ speedIndex ]
+                      << ( useCcd ? ", CCD on: " : ", CCD off: " )
+                      << passes << "/" << SHOTS << " passed through, "
+                      << stepMicroseconds / steppedFrames << " us per frame"
+                      << std::endl;
+
+            if( useCcd && passes > 0 )
+            {
+                passed = false;
+            }
+        }
+    }
+
+    world.removeRigidBody( &ball );
+    world.removeRigidBody( &flipper );
+
+    std::cout << ( passed ? "No shot passed through with CCD on"
+                          : "FAIL: the ball passed through the flipper with CCD on" )
+              << std::endl;
+
+    return passed ? 0 : 1;
+}
+
+// free function implementation /////////////
+// FIRE SHOT //////////
+/***************************************
+
+@brief FireShot
+
+@details fires the ball at the flipper and steps the world as the
+         game does until the shot is over
+
+@param in: world: the test's world
+
+@param in/out: ball: the ball, moved back to the start first
+
+@param in: physics: the step settings
+
+@param in: offset: how far from the flipper's centre the shot is aimed
+
+@param in: speed: the speed of the shot
+
+@param in/out: stepMicroseconds: the time spent stepping the world
+
+@param in/out: steppedFrames: the frames stepped, which the shot ends
+               early once the ball passes through or bounces
+
+@notes returns false if the centre of the ball ever gets past the
+       middle of the flipper. the shot starts START_DISTANCE in front
+       of the flipper, so the ball is back in front of it once it
+       bounced
+
+***************************************/
+static bool FireShot
+(
+    btDiscreteDynamicsWorld& world,
+    btRigidBody& ball,
+    const PhysicsInfo& physics,
+    btScalar offset,
+    btScalar speed,
+    double& stepMicroseconds,
+    unsigned int& steppedFrames
+)
+{
+    btTransform start;
+    std::chrono::high_resolution_clock::time_point stepStart;
+    unsigned int frame;
+
+    start.setIdentity( );
+    start.setOrigin( btVector3( offset, 0.0f, -START_DISTANCE ) );
+
+    //forget the contacts of the last shot
+    world.getBroadphase( )->getOverlappingPairCache( )
+         ->cleanProxyFromPairs( ball.getBroadphaseHandle( ), world.getDispatcher( ) );
+
+    ball.setWorldTransform( start );
+    ball.getMotionState( )->setWorldTransform( start );
+    ball.setInterpolationWorldTransform( start );
+    ball.setLinearVelocity( btVector3( 0.0f, 0.0f, speed ) );
+    ball.setAngularVelocity( btVector3( 0.0f, 0.0f, 0.0f ) );
+    ball.setInterpolationLinearVelocity( btVector3( 0.0f, 0.0f, speed ) );
+    ball.setInterpolationAngularVelocity( btVector3( 0.0f, 0.0f, 0.0f ) );
+    ball.clearForces( );
+
+    for( frame = 0; frame < FRAMES_PER_SHOT; frame++ )
+    {
+        stepStart = std::chrono::high_resolution_clock::now( );
+
+        world.stepSimulation( FRAME_TIME * physics.timeScale, physics.maxSubSteps,
+                              physics.fixedTimeStep );
+
+        stepMicroseconds += std::chrono::duration<double, std::micro>(
+                                std::chrono::high_resolution_clock::now( ) - stepStart ).count( );
+        steppedFrames++;
+
+        if( ball.getWorldTransform( ).getOrigin( ).getZ( ) > 0.0f )
+        {
+            return false;
+        }
+
+        //bounced and on its way back
+        if( ball.getLinearVelocity( ).getZ( ) < 0.0f )
+        {
+            return true;
+        }
+    }
+
+    return true;
+}
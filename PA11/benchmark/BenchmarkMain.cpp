@@ -0,0 +1,95 @@
+// header files ///////////////////////////
+#include <iostream>
+#include <string>
+#include "engine.h"
+#include "BenchmarkRunner.h"
+
+// free function prototypes ///////////////
+
+//defined in main.cpp
+bool ReadConfigurationFile( const std::string& fileName, GraphicsInfo& progInfo );
+
+// main ///////////////////////////////////
+
+#if defined( _WIN64 ) || ( _WIN32 )
+    #undef main
+#endif
+
+int main(int argc, char **argv)
+{
+    Engine *engine = NULL;
+    GraphicsInfo progInfo;
+    BenchmarkRunner runner;
+    std::string tmpStr, configFile, scriptFile, outputFile = "benchmark.csv";
+    int index;
+
+    progInfo.windowName = "Benchmark";
+    progInfo.windowSize = glm::vec2( 1200, 760 );
+
+    for( index = 1; index < argc; index++ )
+    {
+        tmpStr = argv[ index ];
+
+        if( tmpStr == "-c" && index + 1 < argc )
+        {
+            configFile = argv[ ++index ];
+        }
+        else if( tmpStr == "-s" && index + 1 < argc )
+        {
+            scriptFile = argv[ ++index ];
+        }
+        else if( tmpStr == "-o" && index + 1 < argc )
+        {
+            outputFile = argv[ ++index ];
+        }
+        else if( tmpStr == "--headless" )
+        {
+            progInfo.headless = true;
+        }
+        else
+        {
+            std::cout << "Invalid command line parameter: " << tmpStr << std::endl;
+            configFile.clear( );
+            break;
+        }
+    }
+
+    if( configFile.empty( ) || scriptFile.empty( ) )
+    {
+        std::cout << "This program is ran as follows: " << std::endl;
+        std::cout << "./BroadsideBenchmark -c config/Bullet.xml"
+                  << " -s benchmark/scenes/battle.xml -o battle.csv [--headless]"
+                  << std::endl << std::endl;
+        std::cout << "The output is JSON if its name ends in .json." << std::endl;
+        return 1;
+    }
+
+    if( !ReadConfigurationFile( configFile, progInfo ) || !runner.loadScript( scriptFile ) )
+    {
+        std::cout << "Terminating the benchmark." << std::endl;
+        return 1;
+    }
+
+    if( runner.getSeed( ) != 0 )
+    {
+        progInfo.seed = runner.getSeed( );
+    }
+
+    //initialize engine and replay the script on it
+    engine = new Engine( progInfo.windowName, progInfo.windowSize.x, progInfo.windowSize.y );
+
+    if( !engine->Initialize( progInfo ) || !runner.run( *engine ) )
+    {
+        printf( "The benchmark failed to run.\n" );
+        delete engine;
+        engine = NULL;
+        return 1;
+    }
+
+    delete engine;
+    engine = NULL;
+
+    runner.printSummary( );
+
+    return runner.writeResults( outputFile ) ? 0 : 1;
+}
@@ -0,0 +1,568 @@
+#include "BenchmarkRunner.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <iomanip>
+#include "rapidxml/rapidxml.hpp"
+#include "RenderStats.h"
+
+// free function prototypes ///////////////
+
+static bool ReadVector( rapidxml::xml_node<> *node, glm::dvec3& vector );
+
+static bool CameraKeyBefore( const CameraKey& first, const CameraKey& second );
+
+static bool InputEventBefore( const InputEvent& first, const InputEvent& second );
+
+static double MillisecondsSince( std::chrono::steady_clock::time_point start );
+
+static std::string JsonString( const std::string& text );
+
+// class implementation ///////////////////
+
+BenchmarkRunner::BenchmarkRunner( )
+{
+    name = "benchmark";
+    frames = DEFAULT_FRAMES;
+    timeStep = DEFAULT_TIME_STEP;
+    seed = 0;
+
+    nextInput = 0;
+}
+
+BenchmarkRunner::~BenchmarkRunner( )
+{
+
+}
+
+// LOAD SCRIPT //////////////////
+/***************************************
+
+@brief loadScript
+
+@details reads a benchmark script: its name, frame count, time step,
+         ocean seed, camera keys and key presses
+
+@param in: fileName: the script's file name
+
+@notes the camera moves in a straight line between its keys and holds
+       at the first and last one. a script with no camera keys leaves
+       the camera to the ships. key names are SDL's, such as Space or G. a
+       script that is not XML, or a number that does not read, is
+       reported with the file and the field and fails the load
+
+***************************************/
+bool BenchmarkRunner::loadScript( const std::string& fileName )
+{
+    std::ifstream fileOpen( fileName.c_str( ) );
+    std::vector<char> buffer;
+
+    rapidxml::xml_document<> doc;
+    rapidxml::xml_node<> *rootNode, *node, *valueNode;
+
+    CameraKey cameraKey;
+    InputEvent inputEvent;
+
+    std::string field; //the field being read, for the errors
+
+    if( fileOpen.fail( ) )
+    {
+        std::cout << "Failure reading in the file: " << fileName << "!!!" << std::endl;
+        return false;
+    }
+
+    buffer = std::vector<char>( std::istreambuf_iterator<char>( fileOpen ),
+                                std::istreambuf_iterator<char>( ) );
+
+    fileOpen.close( );
+
+    buffer.push_back( '\0' );
+
+    try
+    {
+        doc.parse<0>( &buffer[ 0 ] );
+    }
+    catch( const rapidxml::parse_error& error )
+    {
+        std::cout << "Error parsing " << fileName << ": " << error.what( ) << std::endl;
+        return false;
+    }
+
+    rootNode = doc.first_node( "Benchmark" );
+
+    if( rootNode == NULL )
+    {
+        std::cout << "The benchmark script has no Benchmark node." << std::endl;
+        return false;
+    }
+
+    cameraPath.clear( );
+    inputs.clear( );
+
+    try
+    {
+        for( node = rootNode->first_node( ); node; node = node->next_sibling( ) )
+        {
+            if( std::string( node->name( ) ) == "Name" )
+            {
+                name = node->value( );
+            }
+            else if( std::string( node->name( ) ) == "Frames" )
+            {
+                field = "Frames";
+                frames = std::stoul( node->value( ) );
+            }
+            else if( std::string( node->name( ) ) == "TimeStep" )
+            {
+                field = "TimeStep";
+                timeStep = std::stoul( node->value( ) );
+            }
+            else if( std::string( node->name( ) ) == "Seed" )
+            {
+                field = "Seed";
+                seed = std::stoll( node->value( ) );
+            }
+            else if( std::string( node->name( ) ) == "Camera" )
+            {
+                valueNode = node->first_node( "Frame" );
+
+                if( valueNode == NULL
+                    || !ReadVector( node->first_node( "Eye" ), cameraKey.eye )
+                    || !ReadVector( node->first_node( "Focus" ), cameraKey.focus ) )
+                {
+                    std::cout << "A camera key needs a Frame, an Eye and a Focus." << std::endl;
+                    return false;
+                }
+
+                field = "Camera Frame";
+                cameraKey.frame = std::stoul( valueNode->value( ) );
+
+                cameraPath.push_back( cameraKey );
+            }
+            else if( std::string( node->name( ) ) == "Input" )
+            {
+                valueNode = node->first_node( "Frame" );
+
+                if( valueNode == NULL || node->first_node( "Key" ) == NULL )
+                {
+                    std::cout << "An input needs a Frame and a Key." << std::endl;
+                    return false;
+                }
+
+                field = "Input Frame";
+                inputEvent.frame = std::stoul( valueNode->value( ) );
+                inputEvent.key = SDL_GetKeyFromName( node->first_node( "Key" )->value( ) );
+                inputEvent.down = ( node->first_node( "State" ) == NULL )
+                                  || ( std::string( node->first_node( "State" )->value( ) ) != "up" );
+
+                if( inputEvent.key == SDLK_UNKNOWN )
+                {
+                    std::cout << "Unknown key: " << node->first_node( "Key" )->value( )
+                              << std::endl;
+                    return false;
+                }
+
+                inputs.push_back( inputEvent );
+            }
+        }
+    }
+    catch( const std::invalid_argument& )
+    {
+        std::cout << fileName << ": the " << field << " is not a number." << std::endl;
+        return false;
+    }
+    catch( const std::out_of_range& )
+    {
+        std::cout << fileName << ": the " << field << " is out of range." << std::endl;
+        return false;
+    }
+
+    if( frames == 0 || timeStep == 0 )
+    {
+        std::cout << "The benchmark needs at least one frame and a time step." << std::endl;
+        return false;
+    }
+
+    std::stable_sort( cameraPath.begin( ), cameraPath.end( ), CameraKeyBefore );
+    std::stable_sort( inputs.begin( ), inputs.end( ), InputEventBefore );
+
+    return true;
+}
+
+// RUN //////////////////
+/***************************************
+
+@brief run
+
+@details replays the script on an initialized engine, timing the
+         update, the render submission and the GPU of every frame
+
+@param in: engine: the engine to drive
+
+@notes the script's keys go through the engine's own Keyboard, so they
+       do what they do in play. the window's own events are dropped,
+       but closing it stops the run. vsync is turned off so the swap
+       does not hide the frame time
+
+***************************************/
+bool BenchmarkRunner::run( Engine& engine )
+{
+    unsigned int frame;
+    glm::dvec3 eye, focus;
+    std::chrono::steady_clock::time_point start;
+    FrameSample sample;
+
+    if( engine.m_graphics == NULL || engine.m_window == NULL )
+    {
+        std::cout << "The engine must be initialized before the benchmark." << std::endl;
+        return false;
+    }
+
+    SDL_GL_SetSwapInterval( 0 );
+
+    samples.clear( );
+    samples.reserve( frames );
+    nextInput = 0;
+
+    engine.m_running = true;
+
+    for( frame = 0; frame < frames && engine.m_running; frame++ )
+    {
+        while( SDL_PollEvent( &engine.m_event ) != 0 )
+        {
+            if( engine.m_event.type == SDL_QUIT )
+            {
+                engine.m_running = false;
+            }
+        }
+
+        sendInputs( engine, frame );
+
+        start = std::chrono::steady_clock::now( );
+        engine.m_graphics->Update( timeStep );
+        sample.updateTime = MillisecondsSince( start );
+
+        sample.physicsTime = engine.m_graphics->getPhysicsTime( );
+
+        if( !cameraPath.empty( ) )
+        {
+            cameraAt( frame, eye, focus );
+            engine.m_graphics->setCameraView( eye, focus );
+        }
+
+        RenderStats::reset( );
+
+        start = std::chrono::steady_clock::now( );
+        engine.m_graphics->Render( timeStep );
+        sample.submitTime = MillisecondsSince( start );
+
+        start = std::chrono::steady_clock::now( );
+        glFinish( );
+        sample.gpuTime = MillisecondsSince( start );
+
+        sample.drawCalls = RenderStats::drawCalls;
+        sample.triangles = RenderStats::triangles;
+
+        engine.m_window->Swap( );
+
+        samples.push_back( sample );
+    }
+
+    return !samples.empty( );
+}
+
+// WRITE RESULTS //////////////////
+/***************************************
+
+@brief writeResults
+
+@details writes one row per frame to a file
+
+@param in: fileName: the output file, JSON if it ends in .json and CSV
+                     otherwise
+
+@notes None
+
+***************************************/
+bool BenchmarkRunner::writeResults( const std::string& fileName ) const
+{
+    std::ofstream fileOut( fileName.c_str( ) );
+
+    if( fileOut.fail( ) )
+    {
+        std::cout << "Failure writing the file: " << fileName << "!!!" << std::endl;
+        return false;
+    }
+
+    if( fileName.size( ) >= 5 && fileName.compare( fileName.size( ) - 5, 5, ".json" ) == 0 )
+    {
+        writeJSON( fileOut );
+    }
+    else
+    {
+        writeCSV( fileOut );
+    }
+
+    return !fileOut.fail( );
+}
+
+// PRINT SUMMARY //////////////////
+/***************************************
+
+@brief printSummary
+
+@details prints the mean of every column of the run
+
+@param None
+
+@notes None
+
+***************************************/
+void BenchmarkRunner::printSummary( ) const
+{
+    unsigned int index;
+    FrameSample total;
+
+    if( samples.empty( ) )
+    {
+        std::cout << "No frames were timed." << std::endl;
+        return;
+    }
+
+    for( index = 0; index < samples.size( ); index++ )
+    {
+        total.updateTime += samples[ index ].updateTime;
+        total.submitTime += samples[ index ].submitTime;
+        total.gpuTime += samples[ index ].gpuTime;
+        total.physicsTime += samples[ index ].physicsTime;
+        total.drawCalls += samples[ index ].drawCalls;
+        total.triangles += samples[ index ].triangles;
+    }
+
+    std::cout << name << ": " << samples.size( ) << " frames of "
+              << timeStep << " ms" << std::endl;
+    std::cout << "  update:    " << total.updateTime / samples.size( ) << " ms" << std::endl;
+    std::cout << "  physics:   " << total.physicsTime / samples.size( ) << " ms" << std::endl;
+    std::cout << "  submit:    " << total.submitTime / samples.size( ) << " ms" << std::endl;
+    std::cout << "  gpu:       " << total.gpuTime / samples.size( ) << " ms" << std::endl;
+    std::cout << "  draws:     " << total.drawCalls / samples.size( ) << std::endl;
+    std::cout << "  triangles: " << total.triangles / samples.size( ) << std::endl;
+}
+
+long long BenchmarkRunner::getSeed( ) const
+{
+    return seed;
+}
+
+// private member functions
+
+// SEND INPUTS //////////////////
+/***************************************
+
+@brief sendInputs
+
+@details hands the engine every scripted key of a frame
+
+@param in: engine: the engine to drive
+
+@param in: frame: the frame about to be updated
+
+@notes None
+
+***************************************/
+void BenchmarkRunner::sendInputs( Engine& engine, unsigned int frame )
+{
+    while( nextInput < inputs.size( ) && inputs[ nextInput ].frame <= frame )
+    {
+        engine.m_event = SDL_Event( );
+
+        engine.m_event.type = inputs[ nextInput ].down ? SDL_KEYDOWN : SDL_KEYUP;
+        engine.m_event.key.keysym.sym = inputs[ nextInput ].key;
+
+        engine.Keyboard( );
+
+        nextInput++;
+    }
+}
+
+// CAMERA AT //////////////////
+/***************************************
+
+@brief cameraAt
+
+@details finds the camera of a frame on the scripted path
+
+@param in: frame: the frame
+
+@param out: eye: the eye position
+
+@param out: focus: the focus point
+
+@notes the path must not be empty
+
+***************************************/
+void BenchmarkRunner::cameraAt( unsigned int frame, glm::dvec3& eye, glm::dvec3& focus ) const
+{
+    unsigned int index = 0;
+    double blend;
+
+    while( index + 1 < cameraPath.size( ) && cameraPath[ index + 1 ].frame <= frame )
+    {
+        index++;
+    }
+
+    if( index + 1 == cameraPath.size( ) || frame <= cameraPath[ index ].frame )
+    {
+        eye = cameraPath[ index ].eye;
+        focus = cameraPath[ index ].focus;
+        return;
+    }
+
+    blend = ( double ) ( frame - cameraPath[ index ].frame )
+            / ( cameraPath[ index + 1 ].frame - cameraPath[ index ].frame );
+
+    eye = cameraPath[ index ].eye
+          + ( ( cameraPath[ index + 1 ].eye - cameraPath[ index ].eye ) * blend );
+    focus = cameraPath[ index ].focus
+            + ( ( cameraPath[ index + 1 ].focus - cameraPath[ index ].focus ) * blend );
+}
+
+void BenchmarkRunner::writeCSV( std::ostream& out ) const
+{
+    unsigned int index;
+
+    out << "frame,update_ms,physics_ms,submit_ms,gpu_ms,draw_calls,triangles" << std::endl;
+
+    for( index = 0; index < samples.size( ); index++ )
+    {
+        out << index << ','
+            << samples[ index ].updateTime << ','
+            << samples[ index ].physicsTime << ','
+            << samples[ index ].submitTime << ','
+            << samples[ index ].gpuTime << ','
+            << samples[ index ].drawCalls << ','
+            << samples[ index ].triangles << std::endl;
+    }
+}
+
+void BenchmarkRunner::writeJSON( std::ostream& out ) const
+{
+    unsigned int index;
+
+    out << "{" << std::endl;
+    out << "  \"name\": " << JsonString( name ) << "," << std::endl;
+    out << "  \"timeStep\": " << timeStep << "," << std::endl;
+    out << "  \"frames\": [" << std::endl;
+
+    for( index = 0; index < samples.size( ); index++ )
+    {
+        out << "    { \"frame\": " << index
+            << ", \"update_ms\": " << samples[ index ].updateTime
+            << ", \"physics_ms\": " << samples[ index ].physicsTime
+            << ", \"submit_ms\": " << samples[ index ].submitTime
+            << ", \"gpu_ms\": " << samples[ index ].gpuTime
+            << ", \"draw_calls\": " << samples[ index ].drawCalls
+            << ", \"triangles\": " << samples[ index ].triangles << " }";
+
+        if( index + 1 < samples.size( ) )
+        {
+            out << ",";
+        }
+
+        out << std::endl;
+    }
+
+    out << "  ]" << std::endl;
+    out << "}" << std::endl;
+}
+
+// free function implementation /////////////
+
+// READ VECTOR //////////////////
+/***************************************
+
+@brief ReadVector
+
+@details reads three numbers split by spaces from a node
+
+@param in: node: the node, may be NULL
+
+@param out: vector: the numbers read
+
+@notes returns false for a missing node or fewer than three numbers
+
+***************************************/
+static bool ReadVector( rapidxml::xml_node<> *node, glm::dvec3& vector )
+{
+    std::stringstream stream;
+
+    if( node == NULL )
+    {
+        return false;
+    }
+
+    stream << node->value( );
+    stream >> vector.x >> vector.y >> vector.z;
+
+    return !stream.fail( );
+}
+
+static bool CameraKeyBefore( const CameraKey& first, const CameraKey& second )
+{
+    return first.frame < second.frame;
+}
+
+static bool InputEventBefore( const InputEvent& first, const InputEvent& second )
+{
+    return first.frame < second.frame;
+}
+
+static double MillisecondsSince( std::chrono::steady_clock::time_point start )
+{
+    return std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now( )
+                                                      - start ).count( );
+}
+
+// JSON STRING //////////////////
+/***************************************
+
+@brief JsonString
+
+@details quotes text as a JSON string
+
+@param in: text: the text
+
+@notes quotes, backslashes and control characters are escaped
+
+***************************************/
+static std::string JsonString( const std::string& text )
+{
+    std::ostringstream out;
+    unsigned int index;
+
+    out << '"';
+
+    for( index = 0; index < text.size( ); index++ )
+    {
+        if( text[ index ] == '"' || text[ index ] == '\\' )
+        {
+            out << '\\' << text[ index ];
+        }
+        else if( ( unsigned char ) text[ index ] < 0x20 )
+        {
+            out << "\\u" << std::hex << std::setw( 4 ) << std::setfill( '0' )
+                << ( int ) ( unsigned char ) text[ index ] << std::dec;
+        }
+        else
+        {
+            out << text[ index ];
+        }
+    }
+
+    out << '"';
+
+    return out.str( );
+}
@@ -0,0 +1,109 @@
+/*************************************
+
+@file Buoyancy.h
+
+@brief Floats the ships on the ocean height field
+
+@Note each hull is sampled at a grid of points along the keel;
+      every sample acts as a damped spring pushing up by how far
+      it sits below the water. the samples of all ships are kept
+      in flat arrays so each stage of the solve is a single loop
+
+*************************************/
+
+
+// Pre-compiler directives //////////////////
+#ifndef BUOYANCY_H
+#define BUOYANCY_H
+
+
+//Header files /////////////////////////////
+#include <vector>
+
+#include "graphics_headers.h"
+#include "HeightMap.h"
+
+//Class definition ////////////////////////
+
+class BuoyancySolver
+{
+	public:
+		static const int HULL_ROWS = 4; //samples along the length of the hull
+		static const int HULL_COLUMNS = 2; //samples across the beam of the hull
+		static const int SAMPLES_PER_SHIP = HULL_ROWS * HULL_COLUMNS;
+
+		static const int REPORT_INTERVAL = 1000; //solves between timing reports
+
+		static const float REST_DRAFT; //value defined in Buoyancy.cpp
+		static const float MAX_DRAFT; //value defined in Buoyancy.cpp
+		static const float DAMPING_RATIO; //value defined in Buoyancy.cpp
+		static const float GRAVITY; //value defined in Buoyancy.cpp
+
+		BuoyancySolver( );
+		BuoyancySolver( const BuoyancySolver& src );
+
+		~BuoyancySolver( );
+
+		bool addShip( btRigidBody* body, const btVector3& halfExtents,
+					  float mass, float restHeight );
+
+		void setOcean( const HeightMap* heightMapPtr, float newSeaLevel );
+
+		void setTime( float newTime );
+
+		void solve( btScalar timeStep );
+
+		void clear( );
+
+		size_t getNumberOfShips( ) const;
+
+		static void PreTickCallback( btDynamicsWorld* world, btScalar timeStep );
+
+	private:
+		struct Hull
+		{
+			btRigidBody* body;
+			float stiffness; //per sample
+			float damping; //per sample
+
+			Hull( ) : body( NULL ), stiffness( 0.0f ), damping( 0.0f ) { }
+
+			Hull( const Hull& src ) :
+				body( src.body ),
+				stiffness( src.stiffness ),
+				damping( src.damping )
+			{ }
+		};
+
+		std::vector<Hull> hulls;
+
+		//hull samples in the ship's frame
+		std::vector<float> localX;
+		std::vector<float> localY;
+		std::vector<float> localZ;
+
+		//per step scratch, one entry per sample
+		std::vector<float> offsetX; //sample relative to the centre of mass
+		std::vector<float> offsetZ;
+		std::vector<float> worldX;
+		std::vector<float> worldY;
+		std::vector<float> worldZ;
+		std::vector<float> velocityY;
+		std::vector<float> waterY;
+		std::vector<float> sampleForce;
+
+		const HeightMap* oceanPtr;
+		float seaLevel;
+		float time;
+
+		//cost of the solve
+		double solveMicroseconds;
+		unsigned int solveCount;
+
+		void resizeScratch( );
+
+};
+
+
+
+#endif // !BUOYANCY_H
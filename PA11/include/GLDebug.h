@@ -0,0 +1,67 @@
+#ifndef GLDEBUG_H
+#define GLDEBUG_H
+
+/***************************************
+
+@file GLDebug.h
+
+@brief The OpenGL debug layer of debug builds
+
+@note built with GL_DEBUG the driver reports its errors and warnings
+      through a KHR_debug callback, and the buffers, textures and
+      programs carry labels naming what they hold. without KHR_debug the
+      errors are polled once a frame instead. built without GL_DEBUG the
+      macros are empty, so a release frame never asks the driver for
+      its errors
+
+***************************************/
+
+// headers ////////////////////////////////
+#include <string>
+#include "graphics_headers.h"
+
+// macros /////////////////////////////////
+
+#ifdef GL_DEBUG
+    //names a GL object in the driver's messages and in GL debuggers
+    #define GL_LABEL( identifier, name, text ) GLDebug::label( identifier, name, text )
+
+    //reports the errors since the last check, where names the caller
+    #define GL_CHECK_ERRORS( where ) GLDebug::checkErrors( where )
+#else
+    #define GL_LABEL( identifier, name, text )
+    #define GL_CHECK_ERRORS( where )
+#endif
+
+//the object identifiers of KHR_debug, missing from OpenGL 3.2's header
+#ifndef GL_BUFFER
+    #define GL_BUFFER 0x82E0
+#endif
+
+#ifndef GL_SHADER
+    #define GL_SHADER 0x82E1
+#endif
+
+#ifndef GL_PROGRAM
+    #define GL_PROGRAM 0x82E2
+#endif
+
+// class definitions //////////////////////
+
+class GLDebug
+{
+    public:
+        static const unsigned int MAX_REPEATS = 10; //times one message is printed
+
+        static bool Initialize( );
+
+        static bool hasCallback( );
+
+        static void label( GLenum identifier, GLuint name, const std::string& objectLabel );
+
+        static void checkErrors( const char *where );
+
+        static std::string ErrorString( GLenum error );
+};
+
+#endif /* GLDEBUG_H */
@@ -0,0 +1,82 @@
+#ifndef GPUTIMER_H
+#define GPUTIMER_H
+
+/***************************************
+
+@file GpuTimer.h
+
+@brief Times the render passes on the GPU with timestamp queries
+
+@note the queries of a frame are read FRAMES_IN_FLIGHT - 1 frames
+      later, when the GPU has long finished them, so reading never
+      stalls the pipeline. a frame whose results are still not ready is
+      dropped rather than waited on. without timer queries every call
+      does nothing and the times stay 0
+
+***************************************/
+
+// headers ////////////////////////////////
+#include <vector>
+#include "graphics_headers.h"
+
+// class definition ///////////////////////
+
+class GpuTimer
+{
+    public:
+        static const unsigned int VIEW_1 = 0; //the first camera's whole view
+        static const unsigned int VIEW_2 = 1; //the second camera's, split screen only
+        static const unsigned int OCEAN = 2;
+        static const unsigned int SKY = 3;
+        static const unsigned int OBJECTS = 4; //the object loop, the ocean and sky included
+        static const unsigned int HUD = 5;
+        static const unsigned int NUMBER_OF_PASSES = 6;
+
+        static const unsigned int FRAMES_IN_FLIGHT = 3; //query sets, one written per frame
+        static const unsigned int MAX_TIMESTAMPS = 64; //per frame, later passes go untimed
+
+        //contructors
+        GpuTimer( );
+
+        //destructor
+        ~GpuTimer( );
+
+        bool Initialize( );
+
+        bool isAvailable( ) const;
+
+        void beginFrame( );
+
+        void start( unsigned int pass );
+
+        void stop( unsigned int pass );
+
+        double getTime( unsigned int pass ) const;
+
+        static const char* getName( unsigned int pass );
+
+    private:
+        struct Measurement
+        {
+            unsigned int pass;
+            unsigned int startQuery; //index in the frame's queries
+            int stopQuery; //-1 until the pass stops
+        };
+
+        void readBack( unsigned int set );
+
+        bool available;
+
+        std::vector<GLuint> queries; //FRAMES_IN_FLIGHT sets of MAX_TIMESTAMPS
+        std::vector<Measurement> measurements[ FRAMES_IN_FLIGHT ];
+        unsigned int used[ FRAMES_IN_FLIGHT ]; //queries written in each set
+        unsigned int currentSet;
+
+        int open[ NUMBER_OF_PASSES ]; //measurement of a started pass, -1 if stopped
+
+        double times[ NUMBER_OF_PASSES ]; //milliseconds of the last frame read back
+
+        long long clockOffset; //adds to a GPU timestamp to give the profiler's clock
+};
+
+#endif /* GPUTIMER_H */
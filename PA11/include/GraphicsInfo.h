@@ -13,6 +13,7 @@
 
 #include <vector>
 #include <string>
+#include <utility>
 #include "graphics_headers.h"
 
 //global constants
@@ -60,6 +61,57 @@ struct ObjectInfo
         //nothing to do
     }
 
+    //moved when the object table grows, so the vectors and strings are not copied
+    ObjectInfo( ObjectInfo&& objInfo ) noexcept :
+        modelID( std::move( objInfo.modelID ) ),
+        childID( std::move( objInfo.childID ) ),
+        scale( objInfo.scale ),
+        bScale( objInfo.bScale ),
+        position( objInfo.position ),
+        rotationAxes( objInfo.rotationAxes ),
+        rotationAngles( objInfo.rotationAngles ),
+        name( std::move( objInfo.name ) ),
+		type( std::move( objInfo.type ) )
+    {
+        //nothing to do
+    }
+
+    const ObjectInfo& operator = ( const ObjectInfo& rh )
+    {
+        if( this != &rh )
+        {
+            modelID = rh.modelID;
+            childID = rh.childID;
+            scale = rh.scale;
+            bScale = rh.bScale;
+            position = rh.position;
+            rotationAxes = rh.rotationAxes;
+            rotationAngles = rh.rotationAngles;
+            name = rh.name;
+            type = rh.type;
+        }
+
+        return *this;
+    }
+
+    const ObjectInfo& operator = ( ObjectInfo&& rh ) noexcept
+    {
+        if( this != &rh )
+        {
+            modelID = std::move( rh.modelID );
+            childID = std::move( rh.childID );
+            scale = rh.scale;
+            bScale = rh.bScale;
+            position = rh.position;
+            rotationAxes = rh.rotationAxes;
+            rotationAngles = rh.rotationAngles;
+            name = std::move( rh.name );
+            type = std::move( rh.type );
+        }
+
+        return *this;
+    }
+
 };
 
 //lighting info
@@ -134,6 +186,22 @@ struct SpotLight
 
     }
 
+    SpotLight( SpotLight&& src ) noexcept :
+        incoming( src.incoming ),
+        ambient( src.ambient ),
+        coneAngle( src.coneAngle ),
+        cosine( src.cosine ),
+        spotHeight( src.spotHeight ),
+        objectToFollow( std::move( src.objectToFollow ) ),
+        oTFIndex( src.oTFIndex ),
+        incomingLoc( src.incomingLoc ),
+        ambientLoc( src.ambientLoc ),
+        cosineLoc( src.cosineLoc ), 
+        followLoc( src.followLoc )
+    {
+
+    }
+
     const SpotLight& operator = ( const SpotLight& rh )
     {
         if( this != &rh )
@@ -169,12 +237,25 @@ struct GraphicsInfo
 	std::string windowName;
 	glm::vec3 windDirection;
 	float windForce;
+    int depthMode; //one of Camera's DEPTH_ modes
+    bool headless; //draw offscreen, unsynced, for a set number of frames
+    unsigned int benchmarkFrames; //frames a headless run draws
+    long long seed; //seeds the ocean, 0 takes it from the clock
+    std::string profileFile; //profile the whole run to this trace file
+    std::string metricsFile; //write the metrics to this file as the run goes
+    std::string configFile; //the configuration file the scene was read from
+    bool watchFiles; //reload the scene's files when they change
 
     //constructors
 	GraphicsInfo( ) : spotLight( ) 
 	{
 		windDirection = glm::vec3( 1.0f, 0.0f, 1.0f ); 
 		windForce = 1.0f;
+        depthMode = 0;
+        headless = false;
+        benchmarkFrames = 1000;
+        seed = 0;
+        watchFiles = false;
 	}
 
     GraphicsInfo( const GraphicsInfo& src ): 
@@ -186,6 +267,69 @@ struct GraphicsInfo
 		windowSize( src.windowSize ),
 		windowName( src.windowName ), 
 		windDirection( src.windDirection ),
-		windForce( src.windForce ){ }
+		windForce( src.windForce ),
+        depthMode( src.depthMode ),
+        headless( src.headless ),
+        benchmarkFrames( src.benchmarkFrames ),
+        seed( src.seed ),
+        profileFile( src.profileFile ),
+        metricsFile( src.metricsFile ),
+        configFile( src.configFile ),
+        watchFiles( src.watchFiles ){ }
+
+    GraphicsInfo( GraphicsInfo&& src ) noexcept : 
+        shaderVector( std::move( src.shaderVector ) ),
+        modelVector( std::move( src.modelVector ) ), 
+        objectData( std::move( src.objectData ) ),
+        lights( std::move( src.lights ) ),
+        spotLight( std::move( src.spotLight ) ),
+		windowSize( src.windowSize ),
+		windowName( std::move( src.windowName ) ), 
+		windDirection( src.windDirection ),
+		windForce( src.windForce ),
+        depthMode( src.depthMode ),
+        headless( src.headless ),
+        benchmarkFrames( src.benchmarkFrames ),
+        seed( src.seed ),
+        profileFile( std::move( src.profileFile ) ),
+        metricsFile( std::move( src.metricsFile ) ),
+        configFile( std::move( src.configFile ) ),
+        watchFiles( src.watchFiles ){ }
+
+    const GraphicsInfo& operator = ( const GraphicsInfo& rh )
+    {
+        if( this != &rh )
+        {
+            *this = GraphicsInfo( rh );
+        }
+
+        return *this;
+    }
+
+    const GraphicsInfo& operator = ( GraphicsInfo&& rh ) noexcept
+    {
+        if( this != &rh )
+        {
+            shaderVector = std::move( rh.shaderVector );
+            modelVector = std::move( rh.modelVector );
+            objectData = std::move( rh.objectData );
+            lights = std::move( rh.lights );
+            spotLight = std::move( rh.spotLight );
+            windowSize = rh.windowSize;
+            windowName = std::move( rh.windowName );
+            windDirection = rh.windDirection;
+            windForce = rh.windForce;
+            depthMode = rh.depthMode;
+            headless = rh.headless;
+            benchmarkFrames = rh.benchmarkFrames;
+            seed = rh.seed;
+            profileFile = std::move( rh.profileFile );
+            metricsFile = std::move( rh.metricsFile );
+            configFile = std::move( rh.configFile );
+            watchFiles = rh.watchFiles;
+        }
+
+        return *this;
+    }
 };
 #endif /* GRAPHICSINFO_H */
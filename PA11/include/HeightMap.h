@@ -6,7 +6,11 @@
 
 @author Andrew Frost (12/03/2016)
 
-@Note none
+@Note the octave sums used by the ocean shader are baked
+      into the texture once, so the fragment shader only
+      needs a single fetch per pixel; the alpha channel holds
+      the swell that displaces the ocean grid, and a second
+      texture holds the slope of the swell for its normals
 
 *************************************/
 
@@ -17,6 +21,8 @@
 
 
 //Header files /////////////////////////////
+#include <vector>
+
 #include "graphics_headers.h"
 #include "OpenSimplexNoise.h"
 
@@ -25,6 +31,21 @@
 class HeightMap
 {
 	public:
+		//octave settings for each channel of the baked wave map
+		static const float X_PERSISTENCE; //value defined in HeightMap.cpp
+		static const float Y_PERSISTENCE; //value defined in HeightMap.cpp
+		static const float Z_PERSISTENCE; //value defined in HeightMap.cpp
+
+		static const int X_OCTAVES = 12;
+		static const int Y_OCTAVES = 5;
+		static const int Z_OCTAVES = 3;
+
+		//swell settings, shared with the ocean vertex shader
+		static const float WAVE_TILE_SIZE; //value defined in HeightMap.cpp
+		static const float WAVE_AMPLITUDE; //value defined in HeightMap.cpp
+		static const float WAVE_SCROLL_U; //value defined in HeightMap.cpp
+		static const float WAVE_SCROLL_V; //value defined in HeightMap.cpp
+
 		HeightMap( long seed = 0 );
 		HeightMap( const HeightMap& src );
 
@@ -33,16 +54,46 @@ class HeightMap
 		GLint& HeightMapUniform( );
 		GLuint HeightMapTexture( );
 
+		GLint& SlopeMapUniform( );
+		GLuint SlopeMapTexture( );
+
 		bool generateHeightMap( int xSize, int ySize );
 
+		glm::vec3 getWaveHeight( float u, float v ) const;
+
+		float getSwellHeight( float u, float v ) const;
+
+		float getOceanHeight( float x, float z, float time ) const;
+
+		void getOceanHeights( const float* x, const float* z, float* heights,
+							  size_t count, float time ) const;
+
+		glm::vec4 getWaveParameters( ) const;
+
 	private:
 		GLint uniformLoc;
 		GLuint texture;
+		GLint slopeUniformLoc;
+		GLuint slopeTexture;
 		OpenSimplexNoise noiseGen;
 
+		int width;
+		int height;
+
+		std::vector<float> noiseMap;
+		std::vector<float> waveMap;
+		std::vector<float> slopeMap;
+
+		float sampleMap( const std::vector<float>& map, int channels,
+						 int channel, float u, float v ) const;
+
+		float getOctave( float u, float v, float persistence, 
+						 int numberOfOctaves ) const;
+
+		void bakeWaveMap( );
+
 };
 
 
 
 #endif // !HEIGHTMAP_H
-
@@ -0,0 +1,107 @@
+#ifndef HOTRELOAD_H
+#define HOTRELOAD_H
+
+/***************************************
+
+@file HotReload.h
+
+@brief Watches the configuration, shader and model files and reads the
+       changed ones off the render thread
+
+@note inotify watches the files' directories on Linux, other systems poll
+      the files' modification times. once the changed files have been
+      quiet for SETTLE_TIME the watcher thread reads them into a batch:
+      the configuration is parsed, the programs using a changed shader
+      have their sources read and a changed model is read by Assimp and
+      OpenCV. the render thread takes the finished batch with one atomic
+      exchange and is left with only the GL work
+
+***************************************/
+
+// headers ////////////////////////////////
+#include <vector>
+#include <string>
+#include <atomic>
+#include <thread>
+#include "GraphicsInfo.h"
+#include "ObjectModel.h"
+
+// struct definitions /////////////////////
+
+//a shader program using a changed shader, read and ready to compile
+struct ReloadProgram
+{
+    unsigned int index; //the program's place in the shader registry
+    std::vector<std::pair<GLenum, std::string>> files;
+    std::vector<std::string> sources; //one per file
+};
+
+//a model read from a changed file, waiting for its buffers
+struct ReloadModel
+{
+    std::string path;
+    ObjectModel model;
+};
+
+struct ReloadBatch
+{
+    bool configChanged;
+    GraphicsInfo config; //the configuration file as it is now
+    std::vector<ReloadProgram> programs;
+    std::vector<ReloadModel> models;
+
+    ReloadBatch( ) : configChanged( false ){ }
+};
+
+// class definition ///////////////////////
+
+class HotReload
+{
+    public:
+        static const unsigned int SETTLE_TIME = 100; //quiet milliseconds before a change is read
+        static const unsigned int POLL_TIME = 250; //milliseconds between checks without inotify
+
+        //contructors
+        HotReload( );
+
+        //destructor
+        ~HotReload( );
+
+        bool start( const std::string& configFile,
+                    const std::vector<std::vector<std::pair<GLenum, std::string>>>& shaderFiles,
+                    const std::vector<std::string>& modelFiles );
+
+        void stop( );
+
+        bool isWatching( ) const;
+
+        bool hasBatch( ) const;
+
+        ReloadBatch* takeBatch( );
+
+    private:
+        void watchLoop( );
+
+        bool waitForChanges( std::vector<std::string>& changed );
+
+        ReloadBatch* readBatch( const std::vector<std::string>& changed );
+
+        bool isWatched( const std::string& fileName ) const;
+
+        std::string configFile;
+        std::vector<std::vector<std::pair<GLenum, std::string>>> shaderFiles;
+        std::vector<std::string> modelFiles;
+        std::vector<std::string> files; //all of the above, once each
+
+        std::vector<std::string> directories; //watched by inotify
+        std::vector<int> watchIds; //inotify's id for each directory
+        std::vector<long long> modifiedTimes; //one per file, when polling
+
+        int watchHandle; //the inotify instance, -1 when polling
+
+        std::atomic<ReloadBatch*> batch; //read, waiting for the render thread
+        std::atomic<bool> running;
+        std::thread watcher;
+};
+
+#endif /* HOTRELOAD_H */
@@ -0,0 +1,86 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+/***************************************
+
+@file Metrics.h
+
+@brief A registry of named counters, gauges and histograms
+
+@note a metric is added once and fed by its id, so the per frame calls
+      are an index and an add. a counter sums everything fed to it, a
+      gauge keeps the last value and a histogram keeps the last
+      HISTOGRAM_SIZE samples for its percentiles, which are only sorted
+      when the metrics are shown or written
+
+***************************************/
+
+// headers ////////////////////////////////
+#include <vector>
+#include <string>
+#include <fstream>
+
+// class definition ///////////////////////
+
+class Metrics
+{
+    public:
+        static const unsigned int COUNTER = 0;
+        static const unsigned int GAUGE = 1;
+        static const unsigned int HISTOGRAM = 2;
+
+        static const unsigned int HISTOGRAM_SIZE = 256; //samples kept per histogram
+
+        //contructors
+        Metrics( );
+
+        //destructor
+        ~Metrics( );
+
+        unsigned int addCounter( const std::string& name );
+
+        unsigned int addGauge( const std::string& name, unsigned int precision = 0 );
+
+        unsigned int addHistogram( const std::string& name, unsigned int precision = 2 );
+
+        void increment( unsigned int id, double amount = 1.0 );
+
+        void set( unsigned int id, double value );
+
+        void sample( unsigned int id, double value );
+
+        double getValue( unsigned int id ) const;
+
+        double getPercentile( unsigned int id, double percentile ) const;
+
+        unsigned int getSize( ) const;
+
+        std::string getText( ) const;
+
+        bool startDump( const std::string& fileName );
+
+        void dump( double seconds );
+
+    private:
+        struct Metric
+        {
+            std::string name;
+            unsigned int type;
+            unsigned int precision; //decimals shown
+            double value; //the sum, the last value or the last sample
+
+            std::vector<double> samples; //a histogram's ring
+            unsigned int next; //where the next sample goes
+        };
+
+        unsigned int addMetric( const std::string& name, unsigned int type,
+                                unsigned int precision );
+
+        std::vector<Metric> metrics;
+
+        std::ofstream dumpFile;
+        bool dumpHeader; //the column names are still to be written
+        unsigned int dumpColumns; //metrics in a row, set by the first row
+};
+
+#endif /* METRICS_H */
@@ -61,6 +61,14 @@ class ObjectModel
         bool loadModelFromFile( const std::string& fileName, 
                                 std::vector<TextureUnit> * const textureRegistry );
 
+        bool readModelFile( const std::string& fileName, 
+                            const std::vector<TextureUnit> * const textureRegistry );
+
+        bool uploadBuffers( const std::string& fileName, 
+                            std::vector<TextureUnit> * const textureRegistry );
+
+        void releaseBuffers( const std::vector<TextureUnit> * const textureRegistry );
+
         //clear
         void clear( );
 
@@ -88,6 +96,17 @@ class ObjectModel
         std::vector<GLuint> texture;
         GLint textUniLoc;       
 
+        //a texture read by readModelFile, waiting for uploadBuffers
+        struct TextureImage
+        {
+            std::string name;
+            int width;
+            int height;
+            std::vector<unsigned char> pixels; //BGRA, empty if the registry had it
+        };
+
+        std::vector<TextureImage> textureImages;
+
 };
 
 #endif
@@ -0,0 +1,68 @@
+/*************************************
+
+@file OceanGrid.h
+
+@brief A camera centered grid with rings of decreasing detail
+       that the ocean vertex shader displaces
+
+@Note the centre patch is the finest level; each ring around it
+      doubles the vertex spacing. the outer edge of every level
+      is collapsed onto the next level's spacing so the rings
+      meet without cracks
+
+*************************************/
+
+
+// Pre-compiler directives //////////////////
+#ifndef OCEANGRID_H
+#define OCEANGRID_H
+
+
+//Header files /////////////////////////////
+#include <vector>
+
+#include "graphics_headers.h"
+
+//Class definition ////////////////////////
+
+class OceanGrid
+{
+	public:
+		static const int NUMBER_OF_LEVELS = 6;
+		static const int HALF_CELLS = 64; //cells from the centre to an edge
+
+		static const float BASE_SPACING; //value defined in OceanGrid.cpp
+
+		OceanGrid( );
+		OceanGrid( const OceanGrid& src );
+
+		~OceanGrid( );
+
+		bool Initialize( float newSeaLevel );
+
+		void Render( );
+
+		glm::mat4 getModel( const glm::vec3& cameraPosition ) const;
+
+		float getSeaLevel( ) const;
+
+		unsigned int getNumberOfVertices( ) const;
+
+		unsigned int getNumberOfTriangles( ) const;
+
+	private:
+		GLuint VB;
+		GLuint IB;
+
+		std::vector<Vertex> vertices;
+		std::vector<unsigned int> indices;
+
+		float seaLevel;
+
+		void buildLevel( int level );
+
+};
+
+
+
+#endif // !OCEANGRID_H
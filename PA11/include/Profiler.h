@@ -0,0 +1,96 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+/***************************************
+
+@file Profiler.h
+
+@brief A scoped zone CPU profiler that writes a Chrome trace
+
+@note a zone times its scope in nanoseconds from the monotonic
+      steady_clock. each thread adds its zones to its own totals behind
+      its own lock, so the threads do not wait on each other, and the
+      totals are averaged every REPORT_FRAMES frames whether or not a
+      capture runs. while a capture runs the zones also go into the
+      thread's ring buffer and the averages are printed. GPU passes
+      read back by GpuTimer go on a track of their own. open the trace
+      in chrome://tracing or Perfetto. built without PROFILER the zone
+      macros are empty
+
+***************************************/
+
+// headers ////////////////////////////////
+#include <atomic>
+#include <string>
+
+// macros /////////////////////////////////
+
+#ifdef PROFILER
+    #define PROFILE_CONCAT_INNER( first, second ) first##second
+    #define PROFILE_CONCAT( first, second ) PROFILE_CONCAT_INNER( first, second )
+
+    //times the rest of the scope, the name must be a string literal
+    #define PROFILE_ZONE( name ) ProfileZone PROFILE_CONCAT( profileZone, __LINE__ )( name )
+
+    //once per frame, from the thread that runs the frames
+    #define PROFILE_FRAME( ) Profiler::endFrame( )
+#else
+    #define PROFILE_ZONE( name )
+    #define PROFILE_FRAME( )
+#endif
+
+// class definitions //////////////////////
+
+class Profiler
+{
+    public:
+        static const unsigned int RING_SIZE = 65536; //zones kept per thread, the oldest are dropped
+        static const unsigned int MAX_ZONES = 64; //names averaged per thread
+        static const unsigned int REPORT_FRAMES = 300; //frames per average report
+
+        static bool startCapture( const std::string& fileName );
+
+        static bool stopCapture( );
+
+        static bool toggleCapture( const std::string& fileName );
+
+        static bool isCapturing( )
+        {
+            return capturing.load( std::memory_order_relaxed );
+        }
+
+        static void endFrame( );
+
+        static long long now( );
+
+        static void record( const char *name, long long start, long long end );
+
+        static void recordGpu( const char *name, long long start, long long end );
+
+        static double getAverage( const char *name );
+
+    private:
+        static bool writeTrace( );
+
+        static void report( bool print );
+
+        static std::atomic<bool> capturing;
+};
+
+class ProfileZone
+{
+    public:
+        explicit ProfileZone( const char *zoneName ) : name( zoneName ),
+                                                        start( Profiler::now( ) ){ }
+
+        ~ProfileZone( )
+        {
+            Profiler::record( name, start, Profiler::now( ) );
+        }
+
+    private:
+        const char *name;
+        long long start;
+};
+
+#endif /* PROFILER_H */
@@ -0,0 +1,63 @@
+#ifndef PROGRAMVARIANT_H
+#define PROGRAMVARIANT_H
+
+/***************************************
+
+@file ProgramVariant.h
+
+@brief The uniform locations of a shader program, and a program
+       specialized for one type of object
+
+@note the lighting programs are built again with the object type and
+      the light counts defined, so a variant takes only its own branch,
+      loops over a fixed number of lights and passes only the varyings
+      it uses. a uniform the variant does not use is -1, which OpenGL
+      ignores
+
+***************************************/
+
+// headers ////////////////////////////////
+#include <vector>
+#include "shader.h"
+
+// struct definitions /////////////////////
+
+//every uniform Render sets
+struct ProgramLocations
+{
+    GLint projectionMatrix;
+    GLint viewMatrix;
+    GLint modelMatrix;
+    GLint specular;
+    GLint diffuse;
+    GLint shininess;
+    GLint numLights;
+    GLint numSpotLights;
+    GLint objectType;
+    GLint time;
+    GLint oceanWave;
+    GLint waveMap;
+    GLint slopeMap;
+    GLint worldOrigin;
+    GLint logDepth;
+    GLint textureSampler;
+
+    std::vector<GLint> lightAmbient; //one per light
+    std::vector<GLint> lightPosition;
+
+    std::vector<GLint> spotPosition; //one per spot light
+    std::vector<GLint> spotAmbient;
+    std::vector<GLint> spotDirection;
+    std::vector<GLint> spotClip;
+};
+
+struct ProgramVariant
+{
+    Shader *program; //owned by the program it specializes, NULL until used
+    ProgramLocations locations;
+    unsigned int viewPass; //the camera pass its view uniforms were set for
+
+    ProgramVariant( ) : program( NULL ), viewPass( 0 ){ }
+};
+
+#endif /* PROGRAMVARIANT_H */
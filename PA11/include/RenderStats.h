@@ -0,0 +1,32 @@
+#ifndef RENDERSTATS_H
+#define RENDERSTATS_H
+
+/***************************************
+
+@file RenderStats.h
+
+@brief Counts the draw calls and triangles sent to OpenGL
+
+@note every draw in the engine adds itself here, so a frame's totals
+      can be read after Render and cleared before the next one. an
+      object that is hidden counts as culled, there is no frustum
+      culling
+
+***************************************/
+
+// struct definition //////////////////////
+
+struct RenderStats
+{
+    static unsigned long drawCalls;
+    static unsigned long triangles;
+    static unsigned long culledObjects;
+
+    static void reset( );
+
+    static void addDraw( unsigned long indexCount, unsigned long instances = 1 );
+
+    static void addCulled( );
+};
+
+#endif /* RENDERSTATS_H */
@@ -0,0 +1,42 @@
+#ifndef SCENEFILE_H
+#define SCENEFILE_H
+
+/***************************************
+
+@file SceneFile.h
+
+@brief Writes and reads the compiled, binary form of a configuration file
+
+@note the scene compiler writes a configuration file's shaders, models,
+      objects, lights and wind as flat tables of fixed size records with
+      a string table at the end. the engine maps the file and copies the
+      records into a GraphicsInfo, nothing is parsed. the file keeps the
+      name of the configuration file it came from, so a file of another
+      version or byte order can be replaced by its XML
+
+***************************************/
+
+// headers ////////////////////////////////
+#include <string>
+#include "GraphicsInfo.h"
+
+// class definition ///////////////////////
+
+class SceneFile
+{
+    public:
+        static const unsigned int MAGIC = 0x4E435342; //"BSCN" read as a little endian word
+        static const unsigned int VERSION = 1; //raised whenever a record changes
+        static const unsigned int ENDIAN_CHECK = 0x01020304; //reads back swapped on the wrong machine
+        static const unsigned int SOURCE_SIZE = 256; //bytes kept for the configuration file's name
+
+        static bool IsScene( const std::string& fileName );
+
+        static bool Write( const std::string& fileName, const GraphicsInfo& progInfo,
+                           const std::string& sourceName );
+
+        static bool Read( const std::string& fileName, GraphicsInfo& progInfo,
+                          std::string& sourceName );
+};
+
+#endif /* SCENEFILE_H */
@@ -49,10 +49,6 @@ struct ShipController
     bool lookingLeft;
     bool lookingRight;
 
-    float waveCycle;
-
-    bool waveUp;
-
     float cameraHeight;
 
     float cameraDistance;
@@ -81,8 +77,6 @@ struct ShipController
         cameraPosition( 0, 0, 0 ),
         lookingLeft( false ),
         lookingRight( false),
-        waveCycle( 0 ),
-        waveUp( true ),
         cameraHeight( 25 ),
         cameraDistance( 60 ),
         skyIndex( -1 )
@@ -110,8 +104,6 @@ struct ShipController
         cameraPosition( 0, 0, 0 ),
         lookingLeft( false ),
         lookingRight( false),
-        waveCycle( 0 ),
-        waveUp( true ),
         cameraHeight( 25 ),
         cameraDistance( 60 ),
         skyIndex( -1 )
@@ -140,8 +132,6 @@ struct ShipController
         cameraPosition( src.cameraPosition ),
         lookingLeft( src.lookingLeft ),
         lookingRight( src.lookingRight ),
-        waveCycle( src.waveCycle ),
-        waveUp( src.waveUp ),
         cameraHeight( src.cameraHeight ),
         cameraDistance( src.cameraDistance ),
         skyIndex( src.skyIndex )
@@ -172,8 +162,6 @@ struct ShipController
             cameraPosition = src.cameraPosition;
             lookingLeft = src.lookingLeft;
             lookingRight = src.lookingRight;
-            waveCycle = src.waveCycle;
-            waveUp = src.waveUp;
             cameraHeight = src.cameraHeight;
             cameraDistance = src.cameraDistance;
             skyIndex = src.skyIndex;
@@ -0,0 +1,59 @@
+#ifndef TEXTOVERLAY_H
+#define TEXTOVERLAY_H
+
+/***************************************
+
+@file TextOverlay.h
+
+@brief Lines of text drawn over the top left corner of the window
+
+@note the text is drawn into an image with OpenCV and uploaded to a
+      texture only when it changes. the quad is drawn on the HUD path
+      with the unlit object shader, the caller sets the matrices from
+      getModel
+
+***************************************/
+
+// headers ////////////////////////////////
+#include <string>
+#include "graphics_headers.h"
+
+// class definition ///////////////////////
+
+class TextOverlay
+{
+    public:
+        static const int TEXTURE_WIDTH = 320; //pixels on screen
+        static const int TEXTURE_HEIGHT = 192;
+        static const int LINE_HEIGHT = 16;
+
+        //contructors
+        TextOverlay( );
+
+        //destructor
+        ~TextOverlay( );
+
+        bool Initialize( );
+
+        void setText( const std::string& text );
+
+        void Render( );
+
+        glm::mat4 getModel( int screenWidth, int screenHeight ) const;
+
+        GLint& TextureUniformLocation( );
+
+        void toggleShown( );
+
+        bool isShown( ) const;
+
+    private:
+        GLuint VB;
+        GLuint IB;
+        GLuint texture;
+        GLint textUniLoc;
+
+        bool shown;
+};
+
+#endif /* TEXTOVERLAY_H */
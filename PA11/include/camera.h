@@ -11,9 +11,16 @@ class Camera
 		static const int LOOK_LEFT = 1;
 		static const int LOOK_RIGHT = 2;
 
+        static const int DEPTH_STANDARD = 0; //depth from the projection
+        static const int DEPTH_REVERSED = 1; //1 at the near plane, 0 at infinity
+        static const int DEPTH_LOGARITHMIC = 2; //written by the shaders
+
+        static const float NEAR_PLANE; //value defined in camera.cpp
+        static const float FAR_PLANE; //value defined in camera.cpp
+
         Camera();
         ~Camera();
-        bool Initialize(int w, int h);
+        bool Initialize(int w, int h, int depth = DEPTH_STANDARD);
 	void LookTopDown();
 	void LookSideToSide();
 	void moveLeft();
@@ -35,8 +42,18 @@ class Camera
 
         glm::mat4 GetProjection();
         glm::mat4 GetView();
+        glm::mat4 GetRelativeView();
+        glm::dvec3 GetEyePosition();
+
+        void lookAt( const glm::dvec3& eye, const glm::dvec3& focus );
+
+        int getDepthMode();
+        float getLogDepthCoefficient();
 
     private:
+        void setView( const glm::dvec3& eye, const glm::dvec3& focus,
+                      const glm::vec3& up );
+
 	bool topDown;
 	float upDown;
 	float leftRight;
@@ -44,6 +61,12 @@ class Camera
 
         glm::mat4 projection;
         glm::mat4 view;
+
+        //the view with the eye at the origin, for camera relative drawing
+        glm::mat4 relativeView;
+        glm::dvec3 eyePosition;
+
+        int depthMode;
 };
 
 #endif /* CAMERA_H */
@@ -13,6 +13,8 @@
 
 #include "window.h"
 #include "graphics.h"
+#include "SimClock.h"
+#include "Profiler.h"
 
 struct Coord
 {
@@ -57,10 +59,15 @@ class Engine
         void Run();
         void Keyboard();
         void Mouse();
-        unsigned int getDT();
         long long GetCurrentTimeMillis();
+
+        //drives the window, input and graphics from a script
+        friend class BenchmarkRunner;
     
     private:
+        bool clockKeys( );
+        void reportFrameTimes( );
+
         // Window related variables
         Window *m_window;        
         string m_WINDOW_NAME;
@@ -71,9 +78,20 @@ class Engine
 
         Graphics *m_graphics;
         unsigned int m_DT;
-        long long m_currentTimeMillis;
+        SimClock m_clock; //simulation time for Update
         bool m_running;
 
+        //headless benchmark
+        bool headless;
+        unsigned int benchmarkFrames;
+        std::vector<double> frameTimes; //real milliseconds per frame
+
+        std::string profileFile; //trace written by a capture
+
+        //frame time report
+        unsigned int frameTimeTotal;
+        unsigned int frameCount;
+
         int trackingID;
 
         bool specularLight;
@@ -8,16 +8,27 @@ using namespace std;
 #include "graphics_headers.h"
 #include "camera.h"
 #include "shader.h"
+#include "ProgramVariant.h"
 #include "sound.h"
 #include "object.h"
 
 #include "GraphicsInfo.h"
 #include "ObjectTable.h"
+#include "Profiler.h"
+#include "GpuTimer.h"
+#include "GLDebug.h"
+#include "Metrics.h"
+#include "TextOverlay.h"
+#include "HotReload.h"
 
 #include"Instance.h"
 
 #include"HeightMap.h"
 
+#include"OceanGrid.h"
+
+#include"Buoyancy.h"
+
 #include "ShipController.h"
 
 #include"TextureUnit.h"
@@ -28,6 +39,8 @@ class Graphics
         static const int MAX_NUM_LIGHTS = 8;
         static const bool LEFT_PADDLE = true;
         static const bool RIGHT_PADDLE = false;
+        static const float IMPACT_GAIN; //value defined in graphics.cpp
+        static const unsigned int METRICS_PERIOD = 500; //real milliseconds between overlay updates
 
         Graphics();
         ~Graphics();
@@ -73,6 +86,16 @@ class Graphics
 
         void resetView( );
 
+        void setCameraView( const glm::dvec3& eye, const glm::dvec3& focus );
+
+        double getPhysicsTime( ) const;
+
+        void updateMetrics( double frameMillis );
+
+        void toggleOverlay( );
+
+        void applyReload( );
+
 		void idleSplash( unsigned int dt );
 
 		void turnOffSplash( );
@@ -101,6 +124,8 @@ class Graphics
 
         bool isPlaying( );
 
+        float getOceanHeight( float x, float z ) const;
+
     private:
 		//helper functions
 		void applyShipForces( unsigned int dt );
@@ -111,13 +136,50 @@ class Graphics
 
 		bool sameSign( float first, float second );
 
+		void setProgramDefines( Shader& program ) const;
+		bool findUniforms( Shader& program, ProgramLocations& locations, bool required );
+		void useUniforms( const ProgramLocations& locations );
+		void useProgramVariant( int objectType, int cameraIndex );
+		void setViewUniforms( int cameraIndex );
+
+		void reloadPrograms( const ReloadBatch& batch );
+
+		void reloadModels( ReloadBatch& batch );
+
+		void reloadConfig( const GraphicsInfo& config );
+
 		//Broadside specific members
 		std::vector<ShipController> shipRegistry;
 		btVector3 windDirection;
 		btScalar windForce;
 		HeightMap oceanHeightMap;
+		OceanGrid oceanGrid;
+		BuoyancySolver buoyancy;
+
+		double physicsTime; //real milliseconds of the last Update's Bullet step
+
+		GpuTimer gpuTimer;
+
+		//frame statistics, drawn by the overlay and dumped to a file
+		Metrics metrics;
+		TextOverlay overlay;
+		double metricsMillis; //real time since the overlay was updated
+		double metricsSeconds; //real time since the metrics started
+
+		unsigned int frameMetric;
+		unsigned int drawCallMetric;
+		unsigned int triangleMetric;
+		unsigned int culledMetric;
+		unsigned int contactMetric;
+		unsigned int substepMetric;
+		unsigned int physicsMetric;
+		unsigned int gpuMetric;
+		unsigned int updateMetric; //the profiler's averages, with PROFILER
+		unsigned int renderMetric;
+		unsigned int hitMetric;
 
 		unsigned int cumultiveTime;
+		float waveTime; //cumultiveTime normalized for the shaders
 
         bool splitScreen;
         int screenWidth;
@@ -167,8 +229,6 @@ class Graphics
         unsigned int numberOfSpotLights;
 
 
-        std::string ErrorString(GLenum error);
-	
         bool cameraTracking;
 
         float savedSpotLightSize;
@@ -188,13 +248,30 @@ class Graphics
         GLint m_numSpotLights;
 		GLint m_objectType;
 		GLint m_time;
+		GLint m_oceanWave;
+        GLint m_worldOrigin;
+        GLint m_logDepth;
+
+        ProgramLocations programLocations; //the selected program's
+        std::vector<ProgramVariant> programVariants; //the selected program's, one per object type
+        int variantSelect; //the object type of the variant in use, -1 for none
+        unsigned int viewPassCount; //camera passes drawn, the variants' view uniforms are set once in each
+
+        int depthMode; //the Camera DEPTH_ mode in use
 
         ObjectTable objectRegistry; //holds the scene's objects
  
         Sound objectCollidedSound;
+        int cannonSound;
 
         std::vector<Instance> modelRegistry;
 
+        std::vector<TextureUnit> textureRegistry; //textures shared by name between models
+
+        //reloads the scene's files as they change
+        HotReload hotReload;
+        GraphicsInfo sceneConfig; //the configuration the scene was last built from
+
 
         //bullet members /////////////////////////////
         btBroadphaseInterface *broadphasePtr;
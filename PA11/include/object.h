@@ -89,6 +89,7 @@ class Object
         void Render();
 
         glm::mat4 GetModel();
+        glm::mat4 GetModel( const glm::dvec3& origin );
 
         Origin getOrigin( );
 
@@ -4,6 +4,8 @@
 #include <vector>
 #include<fstream>
 #include <string>
+#include <cstdint>
+#include <utility>
 
 #include "graphics_headers.h"
 
@@ -13,22 +15,63 @@ class Shader
         Shader();
         ~Shader();
         bool Initialize();
+        void SetDefines( const std::vector<std::pair<std::string, int>>& defines );
         void Enable( );
 		void Disable( );
         bool AddShader(GLenum ShaderType, const std::string& fileName); 
+        bool AddShaderSource(GLenum ShaderType, const std::string& srcStr,
+                             const std::string& fileName);
+        bool Link( );
         bool Finalize();
+        void Swap( Shader& other );
+        Shader* GetVariant( const std::vector<std::pair<std::string, int>>& defines );
         GLint GetUniformLocation(const char* pUniformName);
 
+        static bool InitializeCache( const std::string& directory );
+
     private:
+        static const uint32_t CACHE_MAGIC = 0x48535042; //"BPSH"
+        static const uint32_t CACHE_VERSION = 1;
+
         GLuint m_shaderProg;        
         std::vector<GLuint> m_shaderObjList;
 
+        //the shaders added, compiled by Link
+        std::vector<std::pair<GLenum, std::string>> m_sources;
+        std::vector<std::string> m_sourceFiles;
+
+        std::string programLabel; //the shader files, for the debug layer
+
+        std::string m_defines; //added to every source, and so to every variant
+
 		bool inUse;
+        bool linkStarted; //Link has been called
+        bool fromCache; //the program was loaded from its binary
+
+        //the programs built from these sources with #defines added
+        struct Variant
+        {
+            std::string defines;
+            Shader *program; //NULL if it failed to build
+        };
+
+        std::vector<Variant> m_variants;
+
+        static std::string cacheDirectory; //empty when binaries are not cached
+        static std::string driverName; //a binary is only loaded by the driver that wrote it
 
         // private member functions
 
         bool loadShaderSource( const std::string& fileName,
                                  std::string& shaderSrcStr );
+
+        bool loadBinary( );
+
+        void saveBinary( );
+
+        uint64_t sourceHash( ) const;
+
+        std::string cacheFileName( ) const;
 };
 
 #endif    /* SHADER_H */
@@ -10,12 +10,21 @@ class Window
     public:
         Window();
         ~Window();
-        bool Initialize(const string &name, int* width, int* height);
+        bool Initialize(const string &name, int* width, int* height, bool headless = false);
+        bool createOffscreenTarget( );
         void Swap();
 
     private:
         SDL_Window* gWindow;
         SDL_GLContext gContext;
+
+        //headless mode, drawn to a framebuffer instead of the window
+        bool offscreen;
+        unsigned int offscreenFBO;
+        unsigned int offscreenColor;
+        unsigned int offscreenDepth;
+        int offscreenWidth;
+        int offscreenHeight;
 };
 
 #endif /* WINDOW_H */
@@ -6,6 +6,37 @@
 #define NO_LIGHTING_TYPE 1
 #define WAVE_TYPE 2
 
+//a variant is built with OBJECT_TYPE, NUM_LIGHTS and NUM_SPOT_LIGHTS
+//defined: it keeps only its type's code, loops over fixed light counts
+//and passes only the varyings it uses. the program built without them
+//branches and loops on the uniforms
+#ifdef OBJECT_TYPE
+	#define TYPE_OF_OBJECT OBJECT_TYPE
+	#define LIT_OBJECT ( OBJECT_TYPE != NO_LIGHTING_TYPE )
+	#define LIGHT_COUNT NUM_LIGHTS
+	#define SPOT_LIGHT_COUNT NUM_SPOT_LIGHTS
+
+	//an array holds at least one
+	#if NUM_LIGHTS > 0
+		#define LIGHT_SLOTS NUM_LIGHTS
+	#else
+		#define LIGHT_SLOTS 1
+	#endif
+
+	#if NUM_SPOT_LIGHTS > 0
+		#define SPOT_LIGHT_SLOTS NUM_SPOT_LIGHTS
+	#else
+		#define SPOT_LIGHT_SLOTS 1
+	#endif
+#else
+	#define TYPE_OF_OBJECT typeOfObject
+	#define LIT_OBJECT 1
+	#define LIGHT_COUNT min( numberOfLights, MAX_NUM_LIGHTS )
+	#define SPOT_LIGHT_COUNT min( numberOfSpotLights, MAX_NUM_LIGHTS )
+	#define LIGHT_SLOTS MAX_NUM_LIGHTS
+	#define SPOT_LIGHT_SLOTS MAX_NUM_LIGHTS
+#endif
+
 #define STEP_NUMBER 8
 
 struct SpotLightInfo
@@ -15,15 +46,21 @@ struct SpotLightInfo
 };
 
 smooth in vec2 uv;
+
+#if LIT_OBJECT
 smooth in vec3 fN;
 smooth in vec3 fE;
-smooth in vec3 fL[ MAX_NUM_LIGHTS ];
-smooth in SpotLightInfo sLInfo[ MAX_NUM_LIGHTS ];
+smooth in vec3 fL[ LIGHT_SLOTS ];
+smooth in SpotLightInfo sLInfo[ SPOT_LIGHT_SLOTS ];
+#endif
+
+smooth in float logDepth;
 
 
 out vec4 frag_color;
 
 uniform sampler2D textureSampler;
+uniform float logDepthCoefficient;
 
 //light info
 struct Light
@@ -71,17 +108,16 @@ vec4 getSpotLight( vec3 incoming, vec3 halfway, vec3 normal, int index );
 
 vec3 getWaveHeight( vec2 hmPos );
 
-float getOctave( vec2 coord, float persistence, int numberOfOctaves );
-
 void main(void)
 {
 	
 
-	if( typeOfObject == NO_LIGHTING_TYPE )
+	if( TYPE_OF_OBJECT == NO_LIGHTING_TYPE )
 	{
 		ProcessUnlitObject( );
 	}
-	else if( typeOfObject == WAVE_TYPE )
+#if LIT_OBJECT
+	else if( TYPE_OF_OBJECT == WAVE_TYPE )
 	{
 		//ProcessWave( );
 		//ProcessLitObject( );		
@@ -91,8 +127,14 @@ void main(void)
 	{
 		ProcessLitObject( );
 	}
+#endif
+
+#ifdef LOG_DEPTH
+	gl_FragDepth = log2( logDepth ) * 0.5 * logDepthCoefficient;
+#endif
 }
 
+#if LIT_OBJECT
 void ProcessLitObject( )
 {
 	int index, numLights, numSpotLights;
@@ -104,23 +146,8 @@ void ProcessLitObject( )
 	vec3 normedSL;
 	vec3 halfVec;
 
-	if( numberOfLights > MAX_NUM_LIGHTS )
-	{
-		numLights = MAX_NUM_LIGHTS;
-	}
-	else
-	{
-		numLights = numberOfLights;
-	}
-
-	if( numberOfSpotLights > MAX_NUM_LIGHTS )
-	{
-		numSpotLights = MAX_NUM_LIGHTS;
-	}
-	else
-	{
-		numSpotLights = numberOfSpotLights;
-	}
+	numLights = LIGHT_COUNT;
+	numSpotLights = SPOT_LIGHT_COUNT;
 
 	for( index = 0; index < numLights; index++ )
 	{
@@ -141,12 +168,14 @@ void ProcessLitObject( )
 
 	frag_color = finalLight * texture2D( textureSampler, uv.xy );
 }
+#endif
 
 void ProcessUnlitObject( )
 {
 	frag_color = texture2D( textureSampler, uv.xy );
 }
 
+#if LIT_OBJECT
 /************************
 
 @brief ProcessOcean
@@ -203,23 +232,8 @@ void ProcessOcean( )
 
 	normedNormal = waveRise;
 
-	if( numberOfLights > MAX_NUM_LIGHTS )
-	{
-		numLights = MAX_NUM_LIGHTS;
-	}
-	else
-	{
-		numLights = numberOfLights;
-	}
-
-	if( numberOfSpotLights > MAX_NUM_LIGHTS )
-	{
-		numSpotLights = MAX_NUM_LIGHTS;
-	}
-	else
-	{
-		numSpotLights = numberOfSpotLights;
-	}
+	numLights = LIGHT_COUNT;
+	numSpotLights = SPOT_LIGHT_COUNT;
 
 	for( index = 0; index < numLights; index++ )
 	{
@@ -319,58 +333,22 @@ vec4 getSpotLight( vec3 incoming, vec3 halfway, vec3 normal, int index )
     return finalColor;
 
 }
-
-vec3 getWaveHeight( vec2 hmPos )
-{
-    vec3 retWaveHeight;    
-    retWaveHeight.y = getOctave( hmPos, 1.245, 5 );
-    retWaveHeight.x = getOctave( hmPos, 6.9997, 12 );
-    retWaveHeight.z = getOctave( hmPos, 9.75, 3 );
-
-    return retWaveHeight;
-}
+#endif
 
 /**********************
 
-@brief getOctave
-
-@details an implementation of a perlin noise octave
-
-@param in: coord: the coordinate to use
+@brief getWaveHeight
 
-@param in: persistence: the level of persistence of the noise
+@details looks up the wave perturbation for a coordinate
 
-@param in: numberOfOctaves: the number of octaves to run
+@param in: hmPos: the coordinate to use
 
-@Note based on the description of perlin noise by Hugo Elias
+@Note the octave sums are baked into waveMap by HeightMap,
+      so one fetch replaces the per pixel octave loops
 
 ***********************/
 
-float getOctave( vec2 coord, float persistence, int numberOfOctaves )
+vec3 getWaveHeight( vec2 hmPos )
 {
-    int index;
-    float maxV;
-    float totalV;
-    float amp;
-    float freq;
-    vec2 sampleCoord;
-    vec4 rawWaveHeight;
-
-    maxV = totalV = 0;
-    amp = freq = 1;
-
-    for( index = 0; index < numberOfOctaves; index++ )
-    {
-        sampleCoord = freq * coord;
-
-        rawWaveHeight = texture2D( waveMap, sampleCoord );
-
-        totalV += rawWaveHeight.x * amp;
-
-        maxV += amp;
-        freq *= 2;
-        amp *= persistence;
-    }
-
-    return ( totalV / maxV );
+    return texture2D( waveMap, hmPos ).xyz;
 }
@@ -6,6 +6,40 @@
 #define NO_LIGHTING_TYPE 1
 #define WAVE_TYPE 2
 
+//a variant is built with OBJECT_TYPE, NUM_LIGHTS and NUM_SPOT_LIGHTS
+//defined: it keeps only its type's code, loops over fixed light counts
+//and passes only the varyings it uses. the program built without them
+//branches and loops on the uniforms
+#ifdef OBJECT_TYPE
+	#define TYPE_OF_OBJECT OBJECT_TYPE
+	#define LIT_OBJECT ( OBJECT_TYPE != NO_LIGHTING_TYPE )
+	#define LIGHT_COUNT NUM_LIGHTS
+	#define SPOT_LIGHT_COUNT NUM_SPOT_LIGHTS
+
+	//an array holds at least one
+	#if NUM_LIGHTS > 0
+		#define LIGHT_SLOTS NUM_LIGHTS
+	#else
+		#define LIGHT_SLOTS 1
+	#endif
+
+	#if NUM_SPOT_LIGHTS > 0
+		#define SPOT_LIGHT_SLOTS NUM_SPOT_LIGHTS
+	#else
+		#define SPOT_LIGHT_SLOTS 1
+	#endif
+#else
+	#define TYPE_OF_OBJECT typeOfObject
+	#define LIT_OBJECT 1
+	#define LIGHT_COUNT min( numberOfLights, MAX_NUM_LIGHTS )
+	#define SPOT_LIGHT_COUNT min( numberOfSpotLights, MAX_NUM_LIGHTS )
+	#define LIGHT_SLOTS MAX_NUM_LIGHTS
+	#define SPOT_LIGHT_SLOTS MAX_NUM_LIGHTS
+#endif
+
+//world width covered by the ocean texture ( 700 x 50 unit ocean.obj )
+#define OCEAN_UV_SPAN 35000.0
+
 layout (location = 0) in vec3 v_position;
 layout (location = 1) in vec2 v_UV;
 layout (location = 2) in vec3 vNormal;
@@ -18,11 +52,16 @@ struct SpotLightInfo
 };
 
 smooth out vec2 uv;
+
+#if LIT_OBJECT
 smooth out vec3 fN;
 smooth out vec3 fE;
 
-smooth out vec3 fL[ MAX_NUM_LIGHTS ];
-smooth out SpotLightInfo sLInfo[ MAX_NUM_LIGHTS ];
+smooth out vec3 fL[ LIGHT_SLOTS ];
+smooth out SpotLightInfo sLInfo[ SPOT_LIGHT_SLOTS ];
+#endif
+
+smooth out float logDepth;
 
 //uniforms
 
@@ -30,6 +69,12 @@ uniform mat4 projectionMatrix;
 uniform mat4 viewMatrix;
 uniform mat4 modelMatrix;
 
+//the world position of the eye, the matrices are relative to it
+uniform vec3 worldOrigin;
+
+// 0 for the normal depth, else 2 / log2( far + 1 )
+uniform float logDepthCoefficient;
+
 //lighting information
 struct Light
 {
@@ -57,22 +102,42 @@ uniform int numberOfSpotLights;
 //type of object
 uniform int typeOfObject;
 
+//swell information, x: tile size, y: amplitude, zw: scroll rate
+uniform sampler2D waveMap;
+uniform sampler2D slopeMap;
+uniform float time;
+uniform vec4 oceanWave;
+
 void ProcessLitObject( );
 void ProcessUnlitObject( );
+void ProcessOcean( );
+
+float getSwellHeight( vec2 position, float lod );
+vec3 getSwellNormal( vec2 position, float lod );
+void setLightVectors( vec4 worldPos, vec3 normal );
 
 void main(void)
 {
 
-	if( typeOfObject == NO_LIGHTING_TYPE )
+	if( TYPE_OF_OBJECT == NO_LIGHTING_TYPE )
 	{
 		ProcessUnlitObject( );
 	}
+#if LIT_OBJECT
+	else if( TYPE_OF_OBJECT == WAVE_TYPE )
+	{
+		ProcessOcean( );
+	}
 	else
 	{
 		ProcessLitObject( );
 	}
+#endif
+
+	logDepth = 1.0 + gl_Position.w;
 }
 
+#if LIT_OBJECT
 void ProcessLitObject( )
 {
 	int index, numLights, numSpotLights;
@@ -89,23 +154,8 @@ void ProcessLitObject( )
 
 	uv = v_UV;
 
-	if( numberOfLights > MAX_NUM_LIGHTS )
-	{
-		numLights = MAX_NUM_LIGHTS;
-	}
-	else
-	{
-		numLights = numberOfLights;
-	}
-
-	if( numberOfSpotLights > MAX_NUM_LIGHTS )
-	{
-		numSpotLights = MAX_NUM_LIGHTS;
-	}
-	else
-	{
-		numSpotLights = numberOfSpotLights;
-	}
+	numLights = LIGHT_COUNT;
+	numSpotLights = SPOT_LIGHT_COUNT;
 
 	//general light information
 
@@ -128,10 +178,11 @@ void ProcessLitObject( )
 	for( index = 0; index < numSpotLights; index++ )
 	{
 		//spot information
-		sLInfo[ index ].spotPosition = ( modelMatrix * vPos ).xyz;
+		sLInfo[ index ].spotPosition = ( modelMatrix * vPos ).xyz + worldOrigin;
 		sLInfo[ index ].sFL = spotLight[ index ].position.xyz;
 	}
 }
+#endif
 
 void ProcessUnlitObject( )
 {
@@ -145,3 +196,78 @@ void ProcessUnlitObject( )
 
 	uv = v_UV;
 }
+
+#if LIT_OBJECT
+/************************
+
+@brief ProcessOcean
+
+@details displaces an ocean grid vertex by the swell and
+         reads its normal from the baked slope of the swell
+
+@note v_UV holds the mip level and spacing of the grid vertex;
+      HeightMap::getOceanHeight evaluates the same swell on the cpu
+
+*************************/
+
+void ProcessOcean( )
+{
+	vec4 worldPos = modelMatrix * vec4( v_position, 1.0 );
+	vec2 oceanPos = worldPos.xz + worldOrigin.xz;
+	float lod = v_UV.x;
+	vec3 normal;
+
+	worldPos.y += getSwellHeight( oceanPos, lod );
+
+	normal = getSwellNormal( oceanPos, lod );
+
+	gl_Position = projectionMatrix * viewMatrix * worldPos;
+
+	uv = ( oceanPos / OCEAN_UV_SPAN ) + 0.5;
+
+	setLightVectors( worldPos, normalize( normal ) );
+}
+
+float getSwellHeight( vec2 position, float lod )
+{
+	vec2 swellUV = ( position / oceanWave.x ) + ( oceanWave.zw * time );
+
+	return oceanWave.y * textureLod( waveMap, swellUV, lod ).w;
+}
+
+vec3 getSwellNormal( vec2 position, float lod )
+{
+	vec2 swellUV = ( position / oceanWave.x ) + ( oceanWave.zw * time );
+	vec2 slope = ( oceanWave.y / oceanWave.x ) * textureLod( slopeMap, swellUV, lod ).xy;
+
+	return normalize( vec3( -slope.x, 1.0, -slope.y ) );
+}
+
+void setLightVectors( vec4 worldPos, vec3 normal )
+{
+	int index, numLights, numSpotLights;
+	vec4 adjustedPos = viewMatrix * worldPos;
+
+	numLights = LIGHT_COUNT;
+	numSpotLights = SPOT_LIGHT_COUNT;
+
+	fN = ( viewMatrix * vec4( normal, 0.0 ) ).xyz;
+	fE = adjustedPos.xyz;
+
+	for( index = 0; index < numLights; index++ )
+	{
+		fL[ index ] = (viewMatrix * light[ index ].position).xyz;
+
+		if( light[ index ].position.w != 0.0 )
+		{
+			fL[ index ] = fL[ index ].xyz - adjustedPos.xyz;
+		}
+	}
+
+	for( index = 0; index < numSpotLights; index++ )
+	{
+		sLInfo[ index ].spotPosition = worldPos.xyz + worldOrigin;
+		sLInfo[ index ].sFL = spotLight[ index ].position.xyz;
+	}
+}
+#endif
@@ -4,19 +4,28 @@
 #define NO_LIGHTING_TYPE 1
 #define WAVE_TYPE 2
 
+//OBJECT_TYPE is defined in a variant built for one type of object
+#ifdef OBJECT_TYPE
+	#define TYPE_OF_OBJECT OBJECT_TYPE
+#else
+	#define TYPE_OF_OBJECT typeOfObject
+#endif
+
 smooth in vec2 uv;
 smooth in vec4 color;
+smooth in float logDepth;
 
 out vec4 frag_color;
 
 uniform sampler2D textureSampler;
+uniform float logDepthCoefficient;
 
 uniform int typeOfObject;
 
 
 void main(void)
 {
-	if( typeOfObject == WAVE_TYPE )
+	if( TYPE_OF_OBJECT == WAVE_TYPE )
 	{
 		frag_color = color * mix( vec4( 0.0, 0.53, 0.658, 1.0 ), 
 								  texture2D( textureSampler, uv.xy ), 
@@ -26,5 +35,8 @@ void main(void)
 	{
 		frag_color = color * texture2D( textureSampler, uv.xy );
 	}
-    
+
+#ifdef LOG_DEPTH
+	gl_FragDepth = log2( logDepth ) * 0.5 * logDepthCoefficient;
+#endif
 }
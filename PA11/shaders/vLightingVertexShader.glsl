@@ -6,6 +6,23 @@
 #define NO_LIGHTING_TYPE 1
 #define WAVE_TYPE 2
 
+//a variant is built with OBJECT_TYPE, NUM_LIGHTS and NUM_SPOT_LIGHTS
+//defined: it keeps only its type's branch and loops over fixed light
+//counts. the program built without them branches and loops on the
+//uniforms
+#ifdef OBJECT_TYPE
+	#define TYPE_OF_OBJECT OBJECT_TYPE
+	#define LIGHT_COUNT NUM_LIGHTS
+	#define SPOT_LIGHT_COUNT NUM_SPOT_LIGHTS
+#else
+	#define TYPE_OF_OBJECT typeOfObject
+	#define LIGHT_COUNT min( numberOfLights, MAX_NUM_LIGHTS )
+	#define SPOT_LIGHT_COUNT min( numberOfSpotLights, MAX_NUM_LIGHTS )
+#endif
+
+//world width covered by the ocean texture ( 700 x 50 unit ocean.obj )
+#define OCEAN_UV_SPAN 35000.0
+
 //vertex buffer information
 layout (location = 0) in vec3 v_position;
 layout (location = 1) in vec2 v_UV;
@@ -14,12 +31,19 @@ layout (location = 2) in vec3 vNormal;
 //outgoing
 smooth out vec2 uv;
 smooth out vec4 color;
+smooth out float logDepth;
 
 //uniform object information
 uniform mat4 projectionMatrix;
 uniform mat4 viewMatrix;
 uniform mat4 modelMatrix;
 
+//the world position of the eye, the matrices are relative to it
+uniform vec3 worldOrigin;
+
+// 0 for the normal depth, else 2 / log2( far + 1 )
+uniform float logDepthCoefficient;
+
 uniform sampler2D textureSampler;
 
 //light info
@@ -54,8 +78,12 @@ uniform int typeOfObject;
 
 //heightmap for waves
 uniform sampler2D waveMap;
+uniform sampler2D slopeMap;
 uniform float time;
 
+//swell information, x: tile size, y: amplitude, zw: scroll rate
+uniform vec4 oceanWave;
+
 void ProcessLitObject( );
 void ProcessUnlitObject( );
 void ProcessOcean( );
@@ -64,14 +92,17 @@ void ProcessOcean( );
 vec4 getLight( vec3 incoming, vec3 halfway, vec3 normal, vec4 ambient );
 vec4 getSpotLight( vec3 incoming, vec3 halfway, vec3 normal, vec4 vPosition, int index );
 
+float getSwellHeight( vec2 position, float lod );
+vec3 getSwellNormal( vec2 position, float lod );
+
 void main(void)
 {
 
-	if( typeOfObject == NO_LIGHTING_TYPE )
+	if( TYPE_OF_OBJECT == NO_LIGHTING_TYPE )
 	{
 		ProcessUnlitObject( );
 	}
-	else if( typeOfObject == WAVE_TYPE )
+	else if( TYPE_OF_OBJECT == WAVE_TYPE )
 	{
 			ProcessOcean( );
 	}
@@ -79,6 +110,8 @@ void main(void)
 	{
 		ProcessLitObject( );
 	}
+
+	logDepth = 1.0 + gl_Position.w;
 }
 
 void ProcessLitObject( )
@@ -86,6 +119,7 @@ void ProcessLitObject( )
 	int index, numLights, numSpotLights;
 
 	vec4 vPos = vec4( v_position, 1.0 );
+	vec4 worldVertex = ( modelMatrix * vPos ) + vec4( worldOrigin, 0.0 );
 	mat4 modelView = viewMatrix * modelMatrix;
 	vec3 pos = ( modelView * vPos ).xyz;
 	vec3 normedNormal = normalize( modelView * vec4( vNormal, 0.0 ) ).xyz;
@@ -97,29 +131,14 @@ void ProcessLitObject( )
 	gl_Position = ( projectionMatrix * viewMatrix * modelMatrix ) * vPos;
 	uv = v_UV;
 
-	if( numberOfLights > MAX_NUM_LIGHTS )
-	{
-		numLights = MAX_NUM_LIGHTS;
-	}
-	else
-	{
-		numLights = numberOfLights;
-	}
-
-	if( numberOfSpotLights > MAX_NUM_LIGHTS )
-	{
-		numSpotLights = MAX_NUM_LIGHTS;
-	}
-	else
-	{
-		numSpotLights = numberOfSpotLights;
-	}
+	numLights = LIGHT_COUNT;
+	numSpotLights = SPOT_LIGHT_COUNT;
 
 	color = vec4( 0.0f, 0.0f, 0.0f, 1.0f );
 
 	for( index = 0; index < numLights; index++ )
 	{
-		normedL = normalize( light[ index ].position.xyz - pos );
+		normedL = normalize( ( viewMatrix * light[ index ].position ).xyz - pos );
 		halfVec = normalize( normedL + normedE );
 
 		color += getLight( normedL, halfVec, normedNormal, light[ index ].ambient );
@@ -129,8 +148,8 @@ void ProcessLitObject( )
 	{
 		color += getSpotLight( normalize( spotLight[ index ].position.xyz ),
 							   normalize( spotLight[ index ].position.xyz
-										  + ( modelMatrix * vPos ).xyz ),
-							   normedNormal, modelMatrix * vPos, index );
+										  + worldVertex.xyz ),
+							   normedNormal, worldVertex, index );
 	}
 }
 
@@ -175,17 +194,27 @@ void ProcessOcean( )
 
 	int index, numLights, numSpotLights;
 
-	vec4 vPos = vec4( v_position, 1.0 );
-	mat4 modelView = viewMatrix * modelMatrix;
-	vec3 pos = ( modelView * vPos ).xyz;
-	vec3 normedNormal = normalize( modelView * vec4( vNormal, 0.0 ) ).xyz;
-	vec3 normedE = normalize( -pos );
+	vec4 worldPos = modelMatrix * vec4( v_position, 1.0 );
+	vec2 oceanPos = worldPos.xz + worldOrigin.xz;
+	float lod = v_UV.x;
+	vec3 normal;
+	vec3 pos;
+	vec3 normedNormal;
+	vec3 normedE;
 	vec3 normedL;
 	vec3 halfVec;
 
+	//displace the grid by the swell, v_UV holds the mip level and spacing
+	worldPos.y += getSwellHeight( oceanPos, lod );
 
-	gl_Position = ( projectionMatrix * viewMatrix * modelMatrix ) * vPos;
-	uv = v_UV;
+	normal = getSwellNormal( oceanPos, lod );
+
+	pos = ( viewMatrix * worldPos ).xyz;
+	normedNormal = normalize( viewMatrix * vec4( normalize( normal ), 0.0 ) ).xyz;
+	normedE = normalize( -pos );
+
+	gl_Position = projectionMatrix * viewMatrix * worldPos;
+	uv = ( oceanPos / OCEAN_UV_SPAN ) + 0.5;
 
 	//waves ///////////////////////////////////////////////////////
 	vec2 waveUV;
@@ -195,7 +224,9 @@ void ProcessOcean( )
 	waveUV = vec2( uv.x + 0.13 * time, uv.y + 0.18 * time );
 	waveHeight = texture2D( waveMap, waveUV );
 
-	waveRise.y = waveHeight.x;
+	//the map used to be the raw noise; the five octave sum is the
+	//smoothest of the baked channels and the closest stand in for it
+	waveRise.y = waveHeight.y;
 	waveRise.x = waveRise.y;
 
 	uv.x += waveRise.x;
@@ -204,23 +235,8 @@ void ProcessOcean( )
 	// end waves /////////////////////////////////////////////////////////	
 
 	//lighting////////////////////////////////////////////////////////////
-	if( numberOfLights > MAX_NUM_LIGHTS )
-	{
-		numLights = MAX_NUM_LIGHTS;
-	}
-	else
-	{
-		numLights = numberOfLights;
-	}
-
-	if( numberOfSpotLights > MAX_NUM_LIGHTS )
-	{
-		numSpotLights = MAX_NUM_LIGHTS;
-	}
-	else
-	{
-		numSpotLights = numberOfSpotLights;
-	}
+	numLights = LIGHT_COUNT;
+	numSpotLights = SPOT_LIGHT_COUNT;
 
 	color = vec4( 0.0f, 0.0f, 0.0f, 1.0f );
 
@@ -236,8 +252,8 @@ void ProcessOcean( )
 	{
 		color += getSpotLight( normalize( spotLight[ index ].position.xyz ),
 							   normalize( spotLight[ index ].position.xyz
-										  + ( modelMatrix * vPos ).xyz ),
-							   normedNormal, modelMatrix * vPos, index );
+										  + worldPos.xyz + worldOrigin ),
+							   normedNormal, worldPos + vec4( worldOrigin, 0.0 ), index );
 	}
 
 	//end lighting///////////////////////////////////////////////////////
@@ -291,3 +307,18 @@ vec4 getSpotLight( vec3 incoming, vec3 halfway, vec3 normal, vec4 vPosition, int
     return finalColor;
     
 }
+
+float getSwellHeight( vec2 position, float lod )
+{
+	vec2 swellUV = ( position / oceanWave.x ) + ( oceanWave.zw * time );
+
+	return oceanWave.y * textureLod( waveMap, swellUV, lod ).w;
+}
+
+vec3 getSwellNormal( vec2 position, float lod )
+{
+	vec2 swellUV = ( position / oceanWave.x ) + ( oceanWave.zw * time );
+	vec2 slope = ( oceanWave.y / oceanWave.x ) * textureLod( slopeMap, swellUV, lod ).xy;
+
+	return normalize( vec3( -slope.x, 1.0, -slope.y ) );
+}
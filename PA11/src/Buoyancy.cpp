@@ -0,0 +1,285 @@
+#include "Buoyancy.h"
+#include "Logger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+const float BuoyancySolver::REST_DRAFT = 1.5f;
+const float BuoyancySolver::MAX_DRAFT = 4.5f;
+const float BuoyancySolver::DAMPING_RATIO = 0.5f;
+const float BuoyancySolver::GRAVITY = 9.8f;
+
+
+BuoyancySolver::BuoyancySolver( ):
+	oceanPtr( NULL ),
+	seaLevel( 0.0f ),
+	time( 0.0f ),
+	solveMicroseconds( 0.0 ),
+	solveCount( 0 )
+{
+	//done in initializer
+}
+
+BuoyancySolver::BuoyancySolver( const BuoyancySolver & src ):
+	hulls( src.hulls ),
+	localX( src.localX ),
+	localY( src.localY ),
+	localZ( src.localZ ),
+	oceanPtr( src.oceanPtr ),
+	seaLevel( src.seaLevel ),
+	time( src.time ),
+	solveMicroseconds( 0.0 ),
+	solveCount( 0 )
+{
+	resizeScratch( );
+}
+
+BuoyancySolver::~BuoyancySolver( )
+{
+	//done by class members
+}
+
+// ADD SHIP //////////////////
+/***************************************
+
+@brief addShip
+
+@details registers a rigid body and lays out its hull samples
+
+@param in: body: the ship's rigid body
+
+@param in: halfExtents: the half extents of the ship's box
+
+@param in: mass: the mass of the ship
+
+@param in: restHeight: how far the ship's origin sits above the
+                       water when floating in a calm sea
+
+@notes the springs are tuned so the ship rests at REST_DRAFT
+       with the given mass
+
+***************************************/
+bool BuoyancySolver::addShip
+(
+	btRigidBody* body,
+	const btVector3& halfExtents,
+	float mass,
+	float restHeight
+)
+{
+	int row, col;
+	Hull hull;
+
+	if( body == NULL || mass <= 0.0f )
+	{
+		return false;
+	}
+
+	hull.body = body;
+	hull.stiffness = ( mass * GRAVITY ) / ( SAMPLES_PER_SHIP * REST_DRAFT );
+	hull.damping = ( 2.0f * DAMPING_RATIO
+					 * std::sqrt( hull.stiffness * SAMPLES_PER_SHIP * mass ) )
+				   / SAMPLES_PER_SHIP;
+
+	hulls.push_back( hull );
+
+	for( row = 0; row < HULL_ROWS; row++ )
+	{
+		for( col = 0; col < HULL_COLUMNS; col++ )
+		{
+			localX.push_back( halfExtents.getX( )
+							  * ( ( ( 2.0f * row + 1.0f ) / HULL_ROWS ) - 1.0f ) );
+			localY.push_back( -1.0f * ( restHeight + REST_DRAFT ) );
+			localZ.push_back( halfExtents.getZ( )
+							  * ( ( ( 2.0f * col + 1.0f ) / HULL_COLUMNS ) - 1.0f ) );
+		}
+	}
+
+	resizeScratch( );
+
+	return true;
+}
+
+void BuoyancySolver::setOcean( const HeightMap* heightMapPtr, float newSeaLevel )
+{
+	oceanPtr = heightMapPtr;
+	seaLevel = newSeaLevel;
+}
+
+void BuoyancySolver::setTime( float newTime )
+{
+	time = newTime;
+}
+
+// SOLVE //////////////////
+/***************************************
+
+@brief solve
+
+@details applies one step of buoyancy to every registered ship
+
+@param in: timeStep: the length of the physics step in seconds
+
+@notes runs in four passes: place the samples in the world,
+       look up the water under all of them at once, turn the
+       depths into spring forces, then sum each ship's forces
+       into one impulse and one torque impulse
+
+***************************************/
+void BuoyancySolver::solve( btScalar timeStep )
+{
+	std::chrono::high_resolution_clock::time_point start;
+	size_t ship, sample, first;
+	float depth, totalForce, torqueX, torqueZ;
+	btVector3 offset, linearVelocity, angularVelocity;
+
+	if( oceanPtr == NULL || hulls.empty( ) )
+	{
+		return;
+	}
+
+	start = std::chrono::high_resolution_clock::now( );
+
+	//place the samples
+	for( ship = 0; ship < hulls.size( ); ship++ )
+	{
+		const btTransform& transform = hulls[ ship ].body->getCenterOfMassTransform( );
+
+		linearVelocity = hulls[ ship ].body->getLinearVelocity( );
+		angularVelocity = hulls[ ship ].body->getAngularVelocity( );
+
+		first = ship * SAMPLES_PER_SHIP;
+
+		for( sample = first; sample < first + SAMPLES_PER_SHIP; sample++ )
+		{
+			offset = transform.getBasis( )
+					 * btVector3( localX[ sample ], localY[ sample ], localZ[ sample ] );
+
+			offsetX[ sample ] = offset.getX( );
+			offsetZ[ sample ] = offset.getZ( );
+
+			worldX[ sample ] = transform.getOrigin( ).getX( ) + offset.getX( );
+			worldY[ sample ] = transform.getOrigin( ).getY( ) + offset.getY( );
+			worldZ[ sample ] = transform.getOrigin( ).getZ( ) + offset.getZ( );
+
+			//vertical part of v + w x r
+			velocityY[ sample ] = linearVelocity.getY( )
+								  + ( angularVelocity.getZ( ) * offset.getX( ) )
+								  - ( angularVelocity.getX( ) * offset.getZ( ) );
+		}
+	}
+
+	//the water under every sample
+	oceanPtr->getOceanHeights( &worldX[ 0 ], &worldZ[ 0 ], &waterY[ 0 ],
+							   worldX.size( ), time );
+
+	//spring forces
+	for( ship = 0; ship < hulls.size( ); ship++ )
+	{
+		first = ship * SAMPLES_PER_SHIP;
+
+		for( sample = first; sample < first + SAMPLES_PER_SHIP; sample++ )
+		{
+			depth = std::min( std::max( seaLevel + waterY[ sample ] - worldY[ sample ], 0.0f ),
+							  MAX_DRAFT );
+
+			sampleForce[ sample ] = std::max( ( hulls[ ship ].stiffness * depth )
+											  - ( hulls[ ship ].damping * velocityY[ sample ]
+												  * ( depth > 0.0f ? 1.0f : 0.0f ) ),
+											  0.0f );
+		}
+	}
+
+	//sum and apply
+	for( ship = 0; ship < hulls.size( ); ship++ )
+	{
+		first = ship * SAMPLES_PER_SHIP;
+
+		totalForce = 0.0f;
+		torqueX = 0.0f;
+		torqueZ = 0.0f;
+
+		//r x ( 0, f, 0 ) = ( -r.z * f, 0, r.x * f )
+		for( sample = first; sample < first + SAMPLES_PER_SHIP; sample++ )
+		{
+			totalForce += sampleForce[ sample ];
+			torqueX -= offsetZ[ sample ] * sampleForce[ sample ];
+			torqueZ += offsetX[ sample ] * sampleForce[ sample ];
+		}
+
+		hulls[ ship ].body->applyCentralImpulse( btVector3( 0.0f, totalForce * timeStep, 0.0f ) );
+		hulls[ ship ].body->applyTorqueImpulse( btVector3( torqueX * timeStep,
+														   0.0f,
+														   torqueZ * timeStep ) );
+	}
+
+	solveMicroseconds += std::chrono::duration<double, std::micro>(
+							std::chrono::high_resolution_clock::now( ) - start ).count( );
+	solveCount++;
+
+	if( solveCount >= REPORT_INTERVAL )
+	{
+		LOG_DEBUG( "Buoyancy: " << solveMicroseconds / ( solveCount * hulls.size( ) )
+				   << " us per ship per step ( " << hulls.size( ) << " ships, "
+				   << worldX.size( ) << " samples )" );
+
+		solveMicroseconds = 0.0;
+		solveCount = 0;
+	}
+}
+
+void BuoyancySolver::clear( )
+{
+	hulls.clear( );
+	localX.clear( );
+	localY.clear( );
+	localZ.clear( );
+
+	resizeScratch( );
+}
+
+size_t BuoyancySolver::getNumberOfShips( ) const
+{
+	return hulls.size( );
+}
+
+// PRE TICK CALLBACK //////////////////
+/***************************************
+
+@brief PreTickCallback
+
+@details runs the solver before every internal physics step
+
+@param in: world: the dynamics world, its user info is the solver
+
+@param in: timeStep: the length of the internal step
+
+@notes forces applied once per frame would be stale for the
+       remaining sub steps, so the solve happens per sub step
+       and uses impulses
+
+***************************************/
+void BuoyancySolver::PreTickCallback( btDynamicsWorld* world, btScalar timeStep )
+{
+	BuoyancySolver* solverPtr = static_cast<BuoyancySolver*>( world->getWorldUserInfo( ) );
+
+	if( solverPtr != NULL )
+	{
+		solverPtr->solve( timeStep );
+	}
+}
+
+// private member functions
+
+void BuoyancySolver::resizeScratch( )
+{
+	offsetX.resize( localX.size( ) );
+	offsetZ.resize( localX.size( ) );
+	worldX.resize( localX.size( ) );
+	worldY.resize( localX.size( ) );
+	worldZ.resize( localX.size( ) );
+	velocityY.resize( localX.size( ) );
+	waterY.resize( localX.size( ) );
+	sampleForce.resize( localX.size( ) );
+}
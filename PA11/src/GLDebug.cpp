@@ -0,0 +1,238 @@
+#include "GLDebug.h"
+#include <map>
+#include <iostream>
+
+// free function prototypes ///////////////
+
+#if !defined(__APPLE__) && !defined(MACOSX)
+static void GLAPIENTRY DebugCallback( GLenum source, GLenum type, GLuint id,
+                                      GLenum severity, GLsizei length,
+                                      const GLchar *message, const void *userParam );
+
+static const char* EnumName( GLenum value );
+#endif
+
+// file data //////////////////////////////
+
+static bool callbackActive = false;
+static GLint maxLabelLength = 0;
+static std::map<GLuint, unsigned int> repeats; //times each message id was seen
+
+// INITIALIZE //////////////////
+/***************************************
+
+@brief Initialize
+
+@details registers the debug callback and drops the driver's
+         notifications
+
+@param None
+
+@notes returns false without KHR_debug or when built without GL_DEBUG.
+       the output is synchronous, so a message comes from inside the call
+       that caused it and a breakpoint in the callback shows who made it
+
+***************************************/
+bool GLDebug::Initialize( )
+{
+#ifndef GL_DEBUG
+    return false;
+#endif
+
+    callbackActive = false;
+
+#if !defined(__APPLE__) && !defined(MACOSX)
+    if( GLEW_KHR_debug )
+    {
+        glEnable( GL_DEBUG_OUTPUT );
+        glEnable( GL_DEBUG_OUTPUT_SYNCHRONOUS );
+
+        glDebugMessageCallback( ( GLDEBUGPROC ) DebugCallback, NULL );
+
+        //everything but the notifications, which name every buffer upload
+        glDebugMessageControl( GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, NULL, GL_TRUE );
+        glDebugMessageControl( GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION,
+                               0, NULL, GL_FALSE );
+
+        glGetIntegerv( GL_MAX_LABEL_LENGTH, &maxLabelLength );
+
+        callbackActive = true;
+    }
+#endif
+
+    if( !callbackActive )
+    {
+        std::cout << "KHR_debug is not available, the GL errors are polled each frame."
+                  << std::endl;
+    }
+
+    return callbackActive;
+}
+
+bool GLDebug::hasCallback( )
+{
+    return callbackActive;
+}
+
+// LABEL //////////////////
+/***************************************
+
+@brief label
+
+@details names a GL object
+
+@param in: identifier: the kind of object, GL_BUFFER, GL_TEXTURE, ...
+
+@param in: name: the object
+
+@param in: objectLabel: what it holds
+
+@notes a label longer than the driver keeps is cut from the front, the
+       end of a file path says the most
+
+***************************************/
+void GLDebug::label( GLenum identifier, GLuint name, const std::string& objectLabel )
+{
+    std::string text = objectLabel;
+
+    if( !callbackActive )
+    {
+        return;
+    }
+
+    if( maxLabelLength > 0 && text.size( ) >= ( unsigned int ) maxLabelLength )
+    {
+        text = text.substr( text.size( ) - maxLabelLength + 1 );
+    }
+
+#if !defined(__APPLE__) && !defined(MACOSX)
+    glObjectLabel( identifier, name, -1, text.c_str( ) );
+#endif
+}
+
+// CHECK ERRORS //////////////////
+/***************************************
+
+@brief checkErrors
+
+@details prints every error raised since the last check
+
+@param in: where: the caller, for the message
+
+@notes does nothing while the callback runs, it already printed them
+
+***************************************/
+void GLDebug::checkErrors( const char *where )
+{
+    GLenum error;
+
+    if( callbackActive )
+    {
+        return;
+    }
+
+    for( error = glGetError( ); error != GL_NO_ERROR; error = glGetError( ) )
+    {
+        std::cout << "OpenGL error in " << where << "! " << error << ", "
+                  << ErrorString( error ) << std::endl;
+    }
+}
+
+std::string GLDebug::ErrorString( GLenum error )
+{
+    if( error == GL_INVALID_ENUM )
+    {
+        return "GL_INVALID_ENUM: An unacceptable value is specified for an enumerated argument.";
+    }
+    else if( error == GL_INVALID_VALUE )
+    {
+        return "GL_INVALID_VALUE: A numeric argument is out of range.";
+    }
+    else if( error == GL_INVALID_OPERATION )
+    {
+        return "GL_INVALID_OPERATION: The specified operation is not allowed in the current state.";
+    }
+    else if( error == GL_INVALID_FRAMEBUFFER_OPERATION )
+    {
+        return "GL_INVALID_FRAMEBUFFER_OPERATION: The framebuffer object is not complete.";
+    }
+    else if( error == GL_OUT_OF_MEMORY )
+    {
+        return "GL_OUT_OF_MEMORY: There is not enough memory left to execute the command.";
+    }
+
+    return "None";
+}
+
+// free function implementation /////////////
+
+#if !defined(__APPLE__) && !defined(MACOSX)
+// DEBUG CALLBACK //////////////////
+/***************************************
+
+@brief DebugCallback
+
+@details prints a message of the driver
+
+@param in: source: the part of GL that sent it
+
+@param in: type: error, performance, ...
+
+@param in: id: the message's id
+
+@param in: severity: high, medium or low
+
+@param in: length: the message's length
+
+@param in: message: the text
+
+@param in: userParam: unused
+
+@notes a message id is printed MAX_REPEATS times, then muted so a bad
+       call in the frame loop does not flood the console
+
+***************************************/
+static void GLAPIENTRY DebugCallback( GLenum source, GLenum type, GLuint id,
+                                      GLenum severity, GLsizei length,
+                                      const GLchar *message, const void *userParam )
+{
+    unsigned int& count = repeats[ id ];
+
+    count++;
+
+    if( count > GLDebug::MAX_REPEATS )
+    {
+        return;
+    }
+
+    std::cout << "GL " << EnumName( severity ) << " " << EnumName( type )
+              << " from the " << EnumName( source ) << " ( " << id << " ): "
+              << std::string( message, length > 0 ? length : 0 ) << std::endl;
+
+    if( count == GLDebug::MAX_REPEATS )
+    {
+        std::cout << "GL message " << id << " is muted from here." << std::endl;
+    }
+}
+
+static const char* EnumName( GLenum value )
+{
+    switch( value )
+    {
+        case GL_DEBUG_SOURCE_API: return "API";
+        case GL_DEBUG_SOURCE_WINDOW_SYSTEM: return "window system";
+        case GL_DEBUG_SOURCE_SHADER_COMPILER: return "shader compiler";
+        case GL_DEBUG_SOURCE_THIRD_PARTY: return "third party";
+        case GL_DEBUG_SOURCE_APPLICATION: return "application";
+        case GL_DEBUG_TYPE_ERROR: return "error";
+        case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR: return "deprecated behavior";
+        case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR: return "undefined behavior";
+        case GL_DEBUG_TYPE_PORTABILITY: return "portability";
+        case GL_DEBUG_TYPE_PERFORMANCE: return "performance";
+        case GL_DEBUG_SEVERITY_HIGH: return "high";
+        case GL_DEBUG_SEVERITY_MEDIUM: return "medium";
+        case GL_DEBUG_SEVERITY_LOW: return "low";
+        default: return "other";
+    }
+}
+#endif
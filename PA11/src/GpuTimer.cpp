@@ -0,0 +1,257 @@
+#include "GpuTimer.h"
+#include "Profiler.h"
+#include <iostream>
+
+GpuTimer::GpuTimer( )
+{
+    unsigned int index;
+
+    available = false;
+    currentSet = 0;
+    clockOffset = 0;
+
+    for( index = 0; index < FRAMES_IN_FLIGHT; index++ )
+    {
+        used[ index ] = 0;
+    }
+
+    for( index = 0; index < NUMBER_OF_PASSES; index++ )
+    {
+        open[ index ] = -1;
+        times[ index ] = 0.0;
+    }
+}
+
+GpuTimer::~GpuTimer( )
+{
+    if( !queries.empty( ) )
+    {
+        glDeleteQueries( queries.size( ), &queries[ 0 ] );
+    }
+}
+
+// INITIALIZE //////////////////
+/***************************************
+
+@brief Initialize
+
+@details makes the query objects if the context has timer queries
+
+@param None
+
+@notes returns false, and leaves the timer off, without them. also
+       lines the GPU clock up with the profiler's so the passes can go
+       in its trace
+
+***************************************/
+bool GpuTimer::Initialize( )
+{
+    GLint64 gpuNow = 0;
+
+    if( !GLEW_ARB_timer_query )
+    {
+        std::cout << "Timer queries are not available, the GPU times are off." << std::endl;
+
+        available = false;
+        return false;
+    }
+
+    queries.resize( FRAMES_IN_FLIGHT * MAX_TIMESTAMPS );
+    glGenQueries( queries.size( ), &queries[ 0 ] );
+
+    glGetInteger64v( GL_TIMESTAMP, &gpuNow );
+    clockOffset = Profiler::now( ) - gpuNow;
+
+    available = true;
+
+    return true;
+}
+
+bool GpuTimer::isAvailable( ) const
+{
+    return available;
+}
+
+// BEGIN FRAME //////////////////
+/***************************************
+
+@brief beginFrame
+
+@details reads back the oldest set of queries and starts writing it
+         again for this frame
+
+@param None
+
+@notes call once at the start of Render
+
+***************************************/
+void GpuTimer::beginFrame( )
+{
+    unsigned int index;
+
+    if( !available )
+    {
+        return;
+    }
+
+    currentSet = ( currentSet + 1 ) % FRAMES_IN_FLIGHT;
+
+    readBack( currentSet );
+
+    measurements[ currentSet ].clear( );
+    used[ currentSet ] = 0;
+
+    for( index = 0; index < NUMBER_OF_PASSES; index++ )
+    {
+        open[ index ] = -1;
+    }
+}
+
+// START //////////////////
+/***************************************
+
+@brief start
+
+@details writes the GPU time a pass begins at
+
+@param in: pass: one of the pass constants
+
+@notes a pass may be timed more than once a frame, its times are added
+
+***************************************/
+void GpuTimer::start( unsigned int pass )
+{
+    Measurement measurement;
+
+    if( !available || pass >= NUMBER_OF_PASSES || open[ pass ] != -1
+        || used[ currentSet ] + 2 > MAX_TIMESTAMPS )
+    {
+        return;
+    }
+
+    measurement.pass = pass;
+    measurement.startQuery = used[ currentSet ]++;
+    measurement.stopQuery = -1;
+
+    glQueryCounter( queries[ ( currentSet * MAX_TIMESTAMPS ) + measurement.startQuery ],
+                    GL_TIMESTAMP );
+
+    open[ pass ] = measurements[ currentSet ].size( );
+    measurements[ currentSet ].push_back( measurement );
+}
+
+void GpuTimer::stop( unsigned int pass )
+{
+    Measurement *measurement;
+
+    if( !available || pass >= NUMBER_OF_PASSES || open[ pass ] == -1 )
+    {
+        return;
+    }
+
+    measurement = &measurements[ currentSet ][ open[ pass ] ];
+    measurement->stopQuery = used[ currentSet ]++;
+
+    glQueryCounter( queries[ ( currentSet * MAX_TIMESTAMPS ) + measurement->stopQuery ],
+                    GL_TIMESTAMP );
+
+    open[ pass ] = -1;
+}
+
+// GET TIME //////////////////
+/***************************************
+
+@brief getTime
+
+@details returns a pass's GPU milliseconds in the last frame read back
+
+@param in: pass: one of the pass constants
+
+@notes that frame is FRAMES_IN_FLIGHT - 1 frames old
+
+***************************************/
+double GpuTimer::getTime( unsigned int pass ) const
+{
+    if( pass >= NUMBER_OF_PASSES )
+    {
+        return 0.0;
+    }
+
+    return times[ pass ];
+}
+
+const char* GpuTimer::getName( unsigned int pass )
+{
+    static const char* NAMES[ NUMBER_OF_PASSES ] = { "GPU view 1", "GPU view 2",
+                                                     "GPU ocean", "GPU sky",
+                                                     "GPU objects", "GPU HUD" };
+
+    if( pass >= NUMBER_OF_PASSES )
+    {
+        return "GPU";
+    }
+
+    return NAMES[ pass ];
+}
+
+// private member functions
+
+// READ BACK //////////////////
+/***************************************
+
+@brief readBack
+
+@details adds up the passes of a set of queries
+
+@param in: set: the set to read
+
+@notes the set is dropped if its last query is not ready, so the CPU
+       never waits. the passes go to the profiler while it captures
+
+***************************************/
+void GpuTimer::readBack( unsigned int set )
+{
+    unsigned int index;
+    GLint ready = 0;
+    GLuint64 startTime, stopTime;
+    double frameTimes[ NUMBER_OF_PASSES ] = { 0.0 };
+
+    if( used[ set ] == 0 )
+    {
+        return;
+    }
+
+    glGetQueryObjectiv( queries[ ( set * MAX_TIMESTAMPS ) + used[ set ] - 1 ],
+                        GL_QUERY_RESULT_AVAILABLE, &ready );
+
+    if( !ready )
+    {
+        return;
+    }
+
+    for( index = 0; index < measurements[ set ].size( ); index++ )
+    {
+        if( measurements[ set ][ index ].stopQuery == -1 )
+        {
+            continue;
+        }
+
+        glGetQueryObjectui64v( queries[ ( set * MAX_TIMESTAMPS ) + measurements[ set ][ index ].startQuery ],
+                               GL_QUERY_RESULT, &startTime );
+        glGetQueryObjectui64v( queries[ ( set * MAX_TIMESTAMPS ) + measurements[ set ][ index ].stopQuery ],
+                               GL_QUERY_RESULT, &stopTime );
+
+        frameTimes[ measurements[ set ][ index ].pass ] += ( stopTime - startTime ) / 1000000.0;
+
+#ifdef PROFILER
+        Profiler::recordGpu( getName( measurements[ set ][ index ].pass ),
+                             ( long long ) startTime + clockOffset,
+                             ( long long ) stopTime + clockOffset );
+#endif
+    }
+
+    for( index = 0; index < NUMBER_OF_PASSES; index++ )
+    {
+        times[ index ] = frameTimes[ index ];
+    }
+}
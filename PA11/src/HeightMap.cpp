@@ -1,11 +1,27 @@
+
 #include "HeightMap.h"
+#include "GLDebug.h"
+
+#include <cmath>
+
+const float HeightMap::X_PERSISTENCE = 6.9997f;
+const float HeightMap::Y_PERSISTENCE = 1.245f;
+const float HeightMap::Z_PERSISTENCE = 9.75f;
 
-#include <opencv2/core/core.hpp>
-#include <opencv2/opencv.hpp>
-#include <opencv2/imgproc/imgproc.hpp>
+const float HeightMap::WAVE_TILE_SIZE = 1024.0f;
+const float HeightMap::WAVE_AMPLITUDE = 3.0f;
+const float HeightMap::WAVE_SCROLL_U = 20.0f;
+const float HeightMap::WAVE_SCROLL_V = 12.0f;
 
 
-HeightMap::HeightMap( long seed ): uniformLoc( 0 ), texture( 0 ), noiseGen( seed )
+HeightMap::HeightMap( long seed ): 
+	uniformLoc( 0 ), 
+	texture( 0 ), 
+	slopeUniformLoc( 0 ), 
+	slopeTexture( 0 ), 
+	noiseGen( seed ),
+	width( 0 ),
+	height( 0 )
 {
 	//done in initializer
 }
@@ -13,7 +29,14 @@ HeightMap::HeightMap( long seed ): uniformLoc( 0 ), texture( 0 ), noiseGen( seed
 HeightMap::HeightMap( const HeightMap & src ): 
 	uniformLoc( src.uniformLoc ), 
 	texture( src.texture ), 
-	noiseGen( src.noiseGen )
+	slopeUniformLoc( src.slopeUniformLoc ), 
+	slopeTexture( src.slopeTexture ), 
+	noiseGen( src.noiseGen ),
+	width( src.width ),
+	height( src.height ),
+	noiseMap( src.noiseMap ),
+	waveMap( src.waveMap ),
+	slopeMap( src.slopeMap )
 {
 	//done in initializer
 }
@@ -33,10 +56,18 @@ GLuint HeightMap::HeightMapTexture( )
 	return texture;
 }
 
-bool HeightMap::generateHeightMap( int xSize, int ySize )
+GLint& HeightMap::SlopeMapUniform( )
+{
+	return slopeUniformLoc;
+}
+
+GLuint HeightMap::SlopeMapTexture( )
 {
-	cv::Mat map;
+	return slopeTexture;
+}
 
+bool HeightMap::generateHeightMap( int xSize, int ySize )
+{
 	int row, col;
 
 	if( xSize <= 0 || ySize <= 0 )
@@ -44,31 +75,383 @@ bool HeightMap::generateHeightMap( int xSize, int ySize )
 		return false;
 	}
 
+	width = xSize;
+	height = ySize;
+
 	//allocate buffer to generate map in
-	map = cv::Mat( xSize, ySize, CV_32FC1 );
+	noiseMap.resize( width * height );
 
-	for( row = 0; row < map.size( ).width; row++ )
+	for( row = 0; row < height; row++ )
 	{
-		for( col = 0; col < map.size( ).height; col++ )
+		for( col = 0; col < width; col++ )
 		{
-			map.at<float>( cv::Point( row, col ) ) = noiseGen.getNoise( row, col );
+			noiseMap[ ( row * width ) + col ] = noiseGen.getNoise( col, row );
 		}
 	}
 
+	bakeWaveMap( );
+
 	glGenTextures( 1, &texture );
 
-	glBindTexture( GL_TEXTURE_2D, texture );
-
-	glTexImage2D( GL_TEXTURE_2D, 0, GL_R32F,
-				  map.size( ).width,
-				  map.size( ).height, 0,
-				  GL_RED, GL_FLOAT, map.data );
-
-	glTexParameterf( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR );
-
-	glTexParameterf( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
-
-	map.release( );
+	glBindTexture( GL_TEXTURE_2D, texture );
+
+	glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA32F,
+				  width, height, 0,
+				  GL_RGBA, GL_FLOAT, &waveMap[ 0 ] );
+
+	glGenerateMipmap( GL_TEXTURE_2D );
+
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT );
+
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT );
+
+	glTexParameterf( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR );
+
+	glTexParameterf( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
+
+	GL_LABEL( GL_TEXTURE, texture, "Ocean height map" );
+
+	glGenTextures( 1, &slopeTexture );
+
+	glBindTexture( GL_TEXTURE_2D, slopeTexture );
+
+	glTexImage2D( GL_TEXTURE_2D, 0, GL_RG32F,
+				  width, height, 0,
+				  GL_RG, GL_FLOAT, &slopeMap[ 0 ] );
+
+	glGenerateMipmap( GL_TEXTURE_2D );
+
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT );
+
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT );
+
+	glTexParameterf( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR );
+
+	glTexParameterf( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
+
+	GL_LABEL( GL_TEXTURE, slopeTexture, "Ocean slope map" );
 
 	return true;
 }
+
+// GET WAVE HEIGHT //////////////////
+/***************************************
+
+@brief getWaveHeight
+
+@details returns the baked octave sums at a texture coordinate
+
+@param in: u: the horizontal texture coordinate
+
+@param in: v: the vertical texture coordinate
+
+@notes matches a nearest texel lookup of the wave map texture
+
+***************************************/
+glm::vec3 HeightMap::getWaveHeight( float u, float v ) const
+{
+	int s, t, index;
+
+	if( waveMap.empty( ) )
+	{
+		return glm::vec3( 0.0f );
+	}
+
+	s = ( int ) std::floor( ( u - std::floor( u ) ) * width ) % width;
+	t = ( int ) std::floor( ( v - std::floor( v ) ) * height ) % height;
+
+	index = 4 * ( ( t * width ) + s );
+
+	return glm::vec3( waveMap[ index ], waveMap[ index + 1 ], waveMap[ index + 2 ] );
+}
+
+// GET SWELL HEIGHT //////////////////
+/***************************************
+
+@brief getSwellHeight
+
+@details returns the normalized swell height at a texture coordinate
+
+@param in: u: the horizontal texture coordinate
+
+@param in: v: the vertical texture coordinate
+
+@notes matches a GL_LINEAR lookup of the alpha channel at mip 0
+
+***************************************/
+float HeightMap::getSwellHeight( float u, float v ) const
+{
+	if( waveMap.empty( ) )
+	{
+		return 0.0f;
+	}
+
+	return sampleMap( waveMap, 4, 3, u, v );
+}
+
+// GET OCEAN HEIGHT //////////////////
+/***************************************
+
+@brief getOceanHeight
+
+@details returns the displacement of the ocean surface above
+         sea level at a world position
+
+@param in: x: the world x coordinate
+
+@param in: z: the world z coordinate
+
+@param in: time: the normalized time sent to the shaders
+
+@notes the ocean vertex shader evaluates the same function, so
+       the physics sees the surface that is drawn near the ships
+
+***************************************/
+float HeightMap::getOceanHeight( float x, float z, float time ) const
+{
+	return WAVE_AMPLITUDE * getSwellHeight( ( x / WAVE_TILE_SIZE ) + ( WAVE_SCROLL_U * time ),
+											( z / WAVE_TILE_SIZE ) + ( WAVE_SCROLL_V * time ) );
+}
+
+// GET OCEAN HEIGHTS //////////////////
+/***************************************
+
+@brief getOceanHeights
+
+@details evaluates getOceanHeight for a batch of positions
+
+@param in: x: the world x coordinates
+
+@param in: z: the world z coordinates
+
+@param out: heights: the displacement above sea level at each position
+
+@param in: count: the number of positions
+
+@param in: time: the normalized time sent to the shaders
+
+@notes used by the buoyancy solver so every hull sample of
+       every ship is looked up in one pass
+
+***************************************/
+void HeightMap::getOceanHeights
+( 
+	const float* x, 
+	const float* z, 
+	float* heights, 
+	size_t count, 
+	float time 
+) const
+{
+	size_t index;
+	float uOffset = WAVE_SCROLL_U * time;
+	float vOffset = WAVE_SCROLL_V * time;
+
+	if( waveMap.empty( ) )
+	{
+		for( index = 0; index < count; index++ )
+		{
+			heights[ index ] = 0.0f;
+		}
+
+		return;
+	}
+
+	for( index = 0; index < count; index++ )
+	{
+		heights[ index ] = WAVE_AMPLITUDE 
+						   * sampleMap( waveMap, 4, 3, 
+										( x[ index ] / WAVE_TILE_SIZE ) + uOffset,
+										( z[ index ] / WAVE_TILE_SIZE ) + vOffset );
+	}
+}
+
+// GET WAVE PARAMETERS //////////////////
+/***************************************
+
+@brief getWaveParameters
+
+@details packs the swell settings for the oceanWave uniform
+
+@param None
+
+@notes x: tile size, y: amplitude, zw: scroll rate
+
+***************************************/
+glm::vec4 HeightMap::getWaveParameters( ) const
+{
+	return glm::vec4( WAVE_TILE_SIZE, WAVE_AMPLITUDE, WAVE_SCROLL_U, WAVE_SCROLL_V );
+}
+
+// private member functions
+
+// SAMPLE MAP //////////////////
+/***************************************
+
+@brief sampleMap
+
+@details bilinearly samples one channel of a map with wrapping
+
+@param in: map: the interleaved map to sample
+
+@param in: channels: the number of channels per texel
+
+@param in: channel: the channel to read
+
+@param in: u: the horizontal texture coordinate
+
+@param in: v: the vertical texture coordinate
+
+@notes mirrors GL_LINEAR with GL_REPEAT so the CPU results 
+       match what the shaders fetch
+
+***************************************/
+float HeightMap::sampleMap
+( 
+	const std::vector<float>& map, 
+	int channels, 
+	int channel, 
+	float u, 
+	float v 
+) const
+{
+	float x, y, fx, fy;
+	int x0, y0, x1, y1;
+
+	x = ( u * width ) - 0.5f;
+	y = ( v * height ) - 0.5f;
+
+	fx = x - std::floor( x );
+	fy = y - std::floor( y );
+
+	x0 = ( ( int ) std::floor( x ) % width + width ) % width;
+	y0 = ( ( int ) std::floor( y ) % height + height ) % height;
+	x1 = ( x0 + 1 ) % width;
+	y1 = ( y0 + 1 ) % height;
+
+	return ( 1.0f - fy ) * ( ( 1.0f - fx ) * map[ channels * ( ( y0 * width ) + x0 ) + channel ] 
+							 + fx * map[ channels * ( ( y0 * width ) + x1 ) + channel ] )
+		   + fy * ( ( 1.0f - fx ) * map[ channels * ( ( y1 * width ) + x0 ) + channel ] 
+					+ fx * map[ channels * ( ( y1 * width ) + x1 ) + channel ] );
+}
+
+// GET OCTAVE //////////////////
+/***************************************
+
+@brief getOctave
+
+@details an implementation of a perlin noise octave
+
+@param in: u, v: the coordinate to use
+
+@param in: persistence: the level of persistence of the noise
+
+@param in: numberOfOctaves: the number of octaves to run
+
+@notes based on the description of perlin noise by Hugo Elias;
+       used to live in the ocean fragment shader
+
+***************************************/
+float HeightMap::getOctave
+( 
+	float u, 
+	float v, 
+	float persistence, 
+	int numberOfOctaves 
+) const
+{
+	int index;
+	float maxV = 0.0f, totalV = 0.0f;
+	float amp = 1.0f, freq = 1.0f;
+
+	for( index = 0; index < numberOfOctaves; index++ )
+	{
+		totalV += sampleMap( noiseMap, 1, 0, freq * u, freq * v ) * amp;
+
+		maxV += amp;
+		freq *= 2.0f;
+		amp *= persistence;
+	}
+
+	return ( totalV / maxV );
+}
+
+// BAKE WAVE MAP //////////////////
+/***************************************
+
+@brief bakeWaveMap
+
+@details precomputes the wave perturbation, the swell and the
+         slope of the swell for every texel
+
+@param None
+
+@notes every octave frequency is a power of two, so the sum
+       tiles with the same period as the noise itself and
+       only has to be computed once; time just scrolls the uv.
+       the swell is a sum of sines with whole wave numbers so
+       it tiles as well and stays smooth enough to displace 
+       vertices with. its slope is the exact derivative of the
+       sines, so the ocean normals take one fetch instead of 
+       four neighbouring heights
+
+***************************************/
+void HeightMap::bakeWaveMap( )
+{
+	//wave number ( u, v ), amplitude, phase; amplitudes sum to one
+	static const float swell[ 6 ][ 4 ] = 
+	{
+		{ 2.0f, 1.0f, 0.40f, 0.0f },
+		{ -1.0f, 3.0f, 0.25f, 1.3f },
+		{ 4.0f, -2.0f, 0.15f, 2.1f },
+		{ 5.0f, 6.0f, 0.10f, 0.7f },
+		{ -7.0f, 4.0f, 0.06f, 4.0f },
+		{ 9.0f, 11.0f, 0.04f, 5.2f }
+	};
+
+	int row, col, index, wave;
+	float u, v, swellHeight, slopeU, slopeV, phase, rate;
+
+	waveMap.resize( 4 * width * height );
+	slopeMap.resize( 2 * width * height );
+
+	for( row = 0; row < height; row++ )
+	{
+		v = ( row + 0.5f ) / height;
+
+		for( col = 0; col < width; col++ )
+		{
+			u = ( col + 0.5f ) / width;
+
+			index = 4 * ( ( row * width ) + col );
+
+			waveMap[ index ] = getOctave( u, v, X_PERSISTENCE, X_OCTAVES );
+			waveMap[ index + 1 ] = getOctave( u, v, Y_PERSISTENCE, Y_OCTAVES );
+			waveMap[ index + 2 ] = getOctave( u, v, Z_PERSISTENCE, Z_OCTAVES );
+
+			swellHeight = 0.0f;
+			slopeU = 0.0f;
+			slopeV = 0.0f;
+
+			for( wave = 0; wave < 6; wave++ )
+			{
+				phase = ( 2.0f * ( float ) M_PI 
+						  * ( ( swell[ wave ][ 0 ] * u ) + ( swell[ wave ][ 1 ] * v ) ) ) 
+						+ swell[ wave ][ 3 ];
+
+				swellHeight += swell[ wave ][ 2 ] * std::sin( phase );
+
+				//d/du and d/dv of the sine, per unit of texture coordinate
+				rate = 2.0f * ( float ) M_PI * swell[ wave ][ 2 ] * std::cos( phase );
+
+				slopeU += rate * swell[ wave ][ 0 ];
+				slopeV += rate * swell[ wave ][ 1 ];
+			}
+
+			waveMap[ index + 3 ] = swellHeight;
+
+			slopeMap[ ( 2 * ( ( row * width ) + col ) ) ] = slopeU;
+			slopeMap[ ( 2 * ( ( row * width ) + col ) ) + 1 ] = slopeV;
+		}
+	}
+}
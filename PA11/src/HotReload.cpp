@@ -0,0 +1,478 @@
+#include "HotReload.h"
+#include "Logger.h"
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#if defined( __linux__ )
+    #include <sys/inotify.h>
+    #include <poll.h>
+    #include <unistd.h>
+#endif
+
+// free function prototypes ///////////////
+
+//defined in main.cpp
+bool ReadConfigurationFile( const std::string& fileName, GraphicsInfo& progInfo );
+
+static long long GetModifiedTime( const std::string& fileName );
+
+// class implementation ///////////////////
+
+HotReload::HotReload( ) : watchHandle( -1 ), batch( NULL ), running( false )
+{
+
+}
+
+HotReload::~HotReload( )
+{
+    stop( );
+}
+
+// START //////////////////
+/***************************************
+
+@brief start
+
+@details starts watching the files on the watcher thread
+
+@param in: configFile: the configuration file the scene came from
+
+@param in: shaderFiles: the files of each shader program, in the order of
+           the shader registry
+
+@param in: modelFiles: the model files, in the order of the model registry
+
+@notes a directory inotify cannot watch is only warned about. without
+       inotify the files are polled
+
+***************************************/
+bool HotReload::start
+(
+    const std::string& newConfigFile,
+    const std::vector<std::vector<std::pair<GLenum, std::string>>>& newShaderFiles,
+    const std::vector<std::string>& newModelFiles
+)
+{
+    unsigned int index, sIndex;
+    std::string directory;
+
+    if( running.load( ) )
+    {
+        return false;
+    }
+
+    configFile = newConfigFile;
+    shaderFiles = newShaderFiles;
+    modelFiles = newModelFiles;
+
+    files.clear( );
+
+    if( !configFile.empty( ) )
+    {
+        files.push_back( configFile );
+    }
+
+    for( index = 0; index < shaderFiles.size( ); index++ )
+    {
+        for( sIndex = 0; sIndex < shaderFiles[ index ].size( ); sIndex++ )
+        {
+            files.push_back( shaderFiles[ index ][ sIndex ].second );
+        }
+    }
+
+    files.insert( files.end( ), modelFiles.begin( ), modelFiles.end( ) );
+
+    std::sort( files.begin( ), files.end( ) );
+    files.erase( std::unique( files.begin( ), files.end( ) ), files.end( ) );
+
+    directories.clear( );
+    watchIds.clear( );
+    modifiedTimes.clear( );
+
+#if defined( __linux__ )
+    //the directories are watched, an editor often saves by renaming a new file
+    watchHandle = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+
+    for( index = 0; index < files.size( ) && watchHandle != -1; index++ )
+    {
+        directory = files[ index ].find( '/' ) == std::string::npos
+                    ? "." : files[ index ].substr( 0, files[ index ].find_last_of( '/' ) );
+
+        if( std::find( directories.begin( ), directories.end( ), directory ) == directories.end( ) )
+        {
+            watchIds.push_back( inotify_add_watch( watchHandle, directory.c_str( ),
+                                                   IN_CLOSE_WRITE | IN_MOVED_TO ) );
+            directories.push_back( directory );
+
+            if( watchIds.back( ) == -1 )
+            {
+                LOG_WARNING( "Changes in " << directory << " are not watched" );
+            }
+        }
+    }
+#endif
+
+    if( watchHandle == -1 )
+    {
+        for( index = 0; index < files.size( ); index++ )
+        {
+            modifiedTimes.push_back( GetModifiedTime( files[ index ] ) );
+        }
+    }
+
+    running.store( true );
+
+    watcher = std::thread( &HotReload::watchLoop, this );
+
+    LOG_INFO( "Watching " << files.size( ) << " files for changes" );
+
+    return true;
+}
+
+// STOP //////////////////
+/***************************************
+
+@brief stop
+
+@details stops the watcher thread and drops a batch that was not taken
+
+@param None
+
+@notes waits for a batch being read to finish
+
+***************************************/
+void HotReload::stop( )
+{
+    if( !running.exchange( false ) )
+    {
+        return;
+    }
+
+    watcher.join( );
+
+#if defined( __linux__ )
+    if( watchHandle != -1 )
+    {
+        close( watchHandle );
+    }
+#endif
+
+    watchHandle = -1;
+
+    delete batch.exchange( NULL );
+}
+
+bool HotReload::isWatching( ) const
+{
+    return running.load( );
+}
+
+// HAS BATCH //////////////////
+/***************************************
+
+@brief hasBatch
+
+@details returns true if a batch is read and waiting
+
+@param None
+
+@notes one atomic load, cheap enough for every frame
+
+***************************************/
+bool HotReload::hasBatch( ) const
+{
+    return batch.load( std::memory_order_acquire ) != NULL;
+}
+
+// TAKE BATCH //////////////////
+/***************************************
+
+@brief takeBatch
+
+@details hands the waiting batch to the render thread
+
+@param None
+
+@notes the caller deletes the batch. returns NULL if there is none
+
+***************************************/
+ReloadBatch* HotReload::takeBatch( )
+{
+    return batch.exchange( NULL, std::memory_order_acq_rel );
+}
+
+// private member functions
+
+// WATCH LOOP //////////////////
+/***************************************
+
+@brief watchLoop
+
+@details collects the changed files and reads them once they are quiet
+
+@param None
+
+@notes only one batch waits at a time, the changes made while it waits
+       go into the next one
+
+***************************************/
+void HotReload::watchLoop( )
+{
+    std::vector<std::string> changed;
+    ReloadBatch *newBatch;
+
+    while( running.load( ) )
+    {
+        //a wait without changes means the files have settled
+        if( waitForChanges( changed ) || changed.empty( )
+            || batch.load( std::memory_order_acquire ) != NULL )
+        {
+            continue;
+        }
+
+        newBatch = readBatch( changed );
+
+        changed.clear( );
+
+        if( newBatch != NULL )
+        {
+            batch.store( newBatch, std::memory_order_release );
+        }
+    }
+}
+
+// WAIT FOR CHANGES //////////////////
+/***************************************
+
+@brief waitForChanges
+
+@details waits up to SETTLE_TIME for changes, or POLL_TIME when polling
+
+@param out: changed: the changed files are added, once each
+
+@notes returns true if a watched file changed
+
+***************************************/
+bool HotReload::waitForChanges( std::vector<std::string>& changed )
+{
+    unsigned int index;
+    long long modified;
+    std::string fileName;
+    bool found = false;
+
+#if defined( __linux__ )
+    alignas( struct inotify_event ) char buffer[ 4096 ];
+    const struct inotify_event *event;
+    struct pollfd pollInfo;
+    ssize_t length, offset;
+
+    if( watchHandle != -1 )
+    {
+        pollInfo.fd = watchHandle;
+        pollInfo.events = POLLIN;
+        pollInfo.revents = 0;
+
+        if( poll( &pollInfo, 1, SETTLE_TIME ) <= 0 )
+        {
+            return false;
+        }
+
+        while( ( length = read( watchHandle, buffer, sizeof( buffer ) ) ) > 0 )
+        {
+            for( offset = 0; offset < length; offset += sizeof( struct inotify_event ) + event->len )
+            {
+                event = ( const struct inotify_event * ) ( buffer + offset );
+
+                index = std::find( watchIds.begin( ), watchIds.end( ), event->wd ) - watchIds.begin( );
+
+                if( event->len == 0 || index >= directories.size( ) )
+                {
+                    continue;
+                }
+
+                fileName = directories[ index ] == "."
+                           ? std::string( event->name ) : directories[ index ] + "/" + event->name;
+
+                if( isWatched( fileName ) )
+                {
+                    if( std::find( changed.begin( ), changed.end( ), fileName ) == changed.end( ) )
+                    {
+                        changed.push_back( fileName );
+                    }
+
+                    found = true;
+                }
+            }
+        }
+
+        return found;
+    }
+#endif
+
+    std::this_thread::sleep_for( std::chrono::milliseconds( ( long long ) POLL_TIME ) );
+
+    for( index = 0; index < files.size( ); index++ )
+    {
+        modified = GetModifiedTime( files[ index ] );
+
+        if( modified != modifiedTimes[ index ] )
+        {
+            modifiedTimes[ index ] = modified;
+
+            if( std::find( changed.begin( ), changed.end( ), files[ index ] ) == changed.end( ) )
+            {
+                changed.push_back( files[ index ] );
+            }
+
+            found = true;
+        }
+    }
+
+    return found;
+}
+
+// READ BATCH //////////////////
+/***************************************
+
+@brief readBatch
+
+@details reads the changed files into a batch for the render thread
+
+@param in: changed: the files that changed
+
+@notes a file that fails to read is left out, so the render thread keeps
+       what it had. returns NULL if nothing was read
+
+***************************************/
+ReloadBatch* HotReload::readBatch( const std::vector<std::string>& changed )
+{
+    ReloadBatch *newBatch = new ReloadBatch( );
+    ReloadProgram program;
+    unsigned int index, sIndex;
+    bool affected, readAll;
+
+    //no reallocation, the models are not copied once read
+    newBatch->models.reserve( changed.size( ) );
+
+    for( index = 0; index < changed.size( ); index++ )
+    {
+        if( changed[ index ] == configFile )
+        {
+            newBatch->configChanged = ReadConfigurationFile( configFile, newBatch->config );
+
+            if( !newBatch->configChanged )
+            {
+                LOG_ERROR( "Failure reloading " << configFile << ", the scene is left as it was" );
+            }
+        }
+
+        if( std::find( modelFiles.begin( ), modelFiles.end( ), changed[ index ] ) != modelFiles.end( ) )
+        {
+            newBatch->models.push_back( ReloadModel( ) );
+            newBatch->models.back( ).path = changed[ index ];
+
+            //the render thread's texture registry is not read here
+            if( !newBatch->models.back( ).model.readModelFile( changed[ index ], NULL ) )
+            {
+                LOG_ERROR( "Failure reloading " << changed[ index ] << ", the model is left as it was" );
+
+                newBatch->models.pop_back( );
+            }
+        }
+    }
+
+    //every program using a changed shader is rebuilt from all of its files
+    for( index = 0; index < shaderFiles.size( ); index++ )
+    {
+        affected = false;
+
+        for( sIndex = 0; sIndex < shaderFiles[ index ].size( ); sIndex++ )
+        {
+            affected = affected || std::find( changed.begin( ), changed.end( ),
+                                              shaderFiles[ index ][ sIndex ].second ) != changed.end( );
+        }
+
+        if( !affected )
+        {
+            continue;
+        }
+
+        program.index = index;
+        program.files = shaderFiles[ index ];
+        program.sources.clear( );
+
+        readAll = true;
+
+        for( sIndex = 0; sIndex < program.files.size( ) && readAll; sIndex++ )
+        {
+            std::ifstream fileIn( program.files[ sIndex ].second.c_str( ) );
+
+            program.sources.push_back( std::string( std::istreambuf_iterator<char>( fileIn ),
+                                                    std::istreambuf_iterator<char>( ) ) );
+
+            readAll = !fileIn.fail( ) && !program.sources.back( ).empty( );
+
+            if( !readAll )
+            {
+                LOG_ERROR( "Failure reloading " << program.files[ sIndex ].second
+                           << ", shader program " << index + 1 << " is left as it was" );
+            }
+        }
+
+        if( readAll )
+        {
+            newBatch->programs.push_back( program );
+        }
+    }
+
+    if( !newBatch->configChanged && newBatch->programs.empty( ) && newBatch->models.empty( ) )
+    {
+        delete newBatch;
+
+        return NULL;
+    }
+
+    return newBatch;
+}
+
+bool HotReload::isWatched( const std::string& fileName ) const
+{
+    return std::binary_search( files.begin( ), files.end( ), fileName );
+}
+
+// free function implementation /////////////
+
+// GET MODIFIED TIME //////////
+/***************************************
+
+@brief GetModifiedTime
+
+@details returns when the file was last written, -1 if it is missing
+
+@param in: fileName: the file
+
+@notes in nanoseconds where the system keeps them, since two saves in one
+       second would otherwise look the same. Windows keeps seconds
+
+***************************************/
+static long long GetModifiedTime( const std::string& fileName )
+{
+    struct stat fileInfo;
+
+    if( stat( fileName.c_str( ), &fileInfo ) != 0 )
+    {
+        return -1;
+    }
+
+#if defined( _WIN64 ) || defined( _WIN32 )
+    return ( long long ) fileInfo.st_mtime;
+#elif defined( __APPLE__ ) || defined( MACOSX )
+    return ( long long ) fileInfo.st_mtimespec.tv_sec * 1000000000LL + fileInfo.st_mtimespec.tv_nsec;
+#else
+    return ( long long ) fileInfo.st_mtim.tv_sec * 1000000000LL + fileInfo.st_mtim.tv_nsec;
+#endif
+}
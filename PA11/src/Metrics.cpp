@@ -0,0 +1,294 @@
+#include "Metrics.h"
+#include <algorithm>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+
+Metrics::Metrics( )
+{
+    dumpHeader = false;
+    dumpColumns = 0;
+}
+
+Metrics::~Metrics( )
+{
+
+}
+
+// ADD COUNTER //////////////////
+/***************************************
+
+@brief addCounter
+
+@details adds a metric that sums everything fed to it
+
+@param in: name: the name shown and written
+
+@notes returns the id the metric is fed by
+
+***************************************/
+unsigned int Metrics::addCounter( const std::string& name )
+{
+    return addMetric( name, COUNTER, 0 );
+}
+
+unsigned int Metrics::addGauge( const std::string& name, unsigned int precision )
+{
+    return addMetric( name, GAUGE, precision );
+}
+
+unsigned int Metrics::addHistogram( const std::string& name, unsigned int precision )
+{
+    return addMetric( name, HISTOGRAM, precision );
+}
+
+void Metrics::increment( unsigned int id, double amount )
+{
+    if( id < metrics.size( ) )
+    {
+        metrics[ id ].value += amount;
+    }
+}
+
+void Metrics::set( unsigned int id, double value )
+{
+    if( id < metrics.size( ) )
+    {
+        metrics[ id ].value = value;
+    }
+}
+
+// SAMPLE //////////////////
+/***************************************
+
+@brief sample
+
+@details adds a sample to a histogram
+
+@param in: id: the histogram
+
+@param in: value: the sample
+
+@notes the oldest sample is dropped once HISTOGRAM_SIZE are kept
+
+***************************************/
+void Metrics::sample( unsigned int id, double value )
+{
+    if( id >= metrics.size( ) || metrics[ id ].type != HISTOGRAM )
+    {
+        return;
+    }
+
+    if( metrics[ id ].samples.size( ) < HISTOGRAM_SIZE )
+    {
+        metrics[ id ].samples.push_back( value );
+    }
+    else
+    {
+        metrics[ id ].samples[ metrics[ id ].next ] = value;
+    }
+
+    metrics[ id ].next = ( metrics[ id ].next + 1 ) % HISTOGRAM_SIZE;
+    metrics[ id ].value = value;
+}
+
+double Metrics::getValue( unsigned int id ) const
+{
+    if( id >= metrics.size( ) )
+    {
+        return 0.0;
+    }
+
+    return metrics[ id ].value;
+}
+
+// GET PERCENTILE //////////////////
+/***************************************
+
+@brief getPercentile
+
+@details returns a percentile of a histogram's kept samples
+
+@param in: id: the histogram
+
+@param in: percentile: from 0 to 100
+
+@notes sorts a copy of the samples, so it is meant for a report, not
+       for every frame
+
+***************************************/
+double Metrics::getPercentile( unsigned int id, double percentile ) const
+{
+    std::vector<double> sorted;
+    unsigned int rank;
+
+    if( id >= metrics.size( ) || metrics[ id ].samples.empty( ) )
+    {
+        return 0.0;
+    }
+
+    sorted = metrics[ id ].samples;
+
+    percentile = std::min( std::max( percentile, 0.0 ), 100.0 );
+    rank = ( unsigned int ) ( ( percentile / 100.0 ) * ( sorted.size( ) - 1 ) + 0.5 );
+
+    std::nth_element( sorted.begin( ), sorted.begin( ) + rank, sorted.end( ) );
+
+    return sorted[ rank ];
+}
+
+unsigned int Metrics::getSize( ) const
+{
+    return metrics.size( );
+}
+
+// GET TEXT //////////////////
+/***************************************
+
+@brief getText
+
+@details returns a line per metric, a histogram's line gives its median
+         and 99th percentile
+
+@param None
+
+@notes None
+
+***************************************/
+std::string Metrics::getText( ) const
+{
+    unsigned int index;
+    std::stringstream text;
+
+    text << std::fixed;
+
+    for( index = 0; index < metrics.size( ); index++ )
+    {
+        text << std::setprecision( metrics[ index ].precision ) << metrics[ index ].name << ": ";
+
+        if( metrics[ index ].type == HISTOGRAM )
+        {
+            text << "p50 " << getPercentile( index, 50.0 )
+                 << "  p99 " << getPercentile( index, 99.0 );
+        }
+        else
+        {
+            text << metrics[ index ].value;
+        }
+
+        text << std::endl;
+    }
+
+    return text.str( );
+}
+
+// START DUMP //////////////////
+/***************************************
+
+@brief startDump
+
+@details opens the file dump writes its rows to
+
+@param in: fileName: the file, replaced if it is there
+
+@notes the rows are comma separated, a histogram gives two columns
+
+***************************************/
+bool Metrics::startDump( const std::string& fileName )
+{
+    dumpFile.open( fileName.c_str( ) );
+
+    if( dumpFile.fail( ) )
+    {
+        std::cout << "Failure writing the file: " << fileName << "!!!" << std::endl;
+        return false;
+    }
+
+    dumpHeader = true;
+
+    std::cout << "Writing the metrics to " << fileName << std::endl;
+
+    return true;
+}
+
+// DUMP //////////////////
+/***************************************
+
+@brief dump
+
+@details writes a row of every metric to the dump file
+
+@param in: seconds: the time of the row
+
+@notes does nothing unless startDump opened a file. the metrics added
+       after the first row are left out, the columns do not change
+
+***************************************/
+void Metrics::dump( double seconds )
+{
+    unsigned int index;
+
+    if( !dumpFile.is_open( ) )
+    {
+        return;
+    }
+
+    if( dumpHeader )
+    {
+        dumpColumns = metrics.size( );
+
+        dumpFile << "seconds";
+
+        for( index = 0; index < dumpColumns; index++ )
+        {
+            if( metrics[ index ].type == HISTOGRAM )
+            {
+                dumpFile << "," << metrics[ index ].name << " p50,"
+                         << metrics[ index ].name << " p99";
+            }
+            else
+            {
+                dumpFile << "," << metrics[ index ].name;
+            }
+        }
+
+        dumpFile << "\n";
+
+        dumpHeader = false;
+    }
+
+    dumpFile << std::fixed << std::setprecision( 3 ) << seconds;
+
+    for( index = 0; index < dumpColumns; index++ )
+    {
+        if( metrics[ index ].type == HISTOGRAM )
+        {
+            dumpFile << "," << getPercentile( index, 50.0 ) << "," << getPercentile( index, 99.0 );
+        }
+        else
+        {
+            dumpFile << "," << metrics[ index ].value;
+        }
+    }
+
+    //one flush a row, the rows are far apart
+    dumpFile << std::endl;
+}
+
+// private member functions
+
+unsigned int Metrics::addMetric( const std::string& name, unsigned int type,
+                                 unsigned int precision )
+{
+    Metric metric;
+
+    metric.name = name;
+    metric.type = type;
+    metric.precision = precision;
+    metric.value = 0.0;
+    metric.next = 0;
+
+    metrics.push_back( metric );
+
+    return metrics.size( ) - 1;
+}
@@ -10,6 +10,7 @@
 
 //header files
 #include "ObjectModel.h"
+#include "GLDebug.h"
 #include <algorithm>
 
 //assimp
@@ -82,7 +83,8 @@ ObjectModel::ObjectModel
     const ObjectModel & src //the ObjectModel to copy
 ):  diffuse(src.diffuse), specular(src.specular ), shininess( src.shininess),
     reference( 0 ), Vertices( src.Vertices ), Indices( src.Indices ), 
-    VB( src.VB ), IB( src.IB ),  texture( src.texture ), textUniLoc( src.textUniLoc )
+    VB( src.VB ), IB( src.IB ),  texture( src.texture ), textUniLoc( src.textUniLoc ),
+    textureImages( src.textureImages )
 {
     //nothing to do
 }
@@ -396,6 +398,32 @@ bool ObjectModel::loadModelFromFile
     const std::string& fileName,
     std::vector<TextureUnit> * const textureRegistry 
 )
+{
+    return readModelFile( fileName, textureRegistry ) 
+           && uploadBuffers( fileName, textureRegistry );
+}
+
+// READ MODEL FILE //////////////////
+/***************************************
+
+@brief readModelFile
+
+@details reads a model and its textures from file, without touching GL
+
+@param in: fileName: the file name of the object we are loading.
+
+@param in: textureRegistry: the textures already loaded, they are not
+           read again. may be NULL
+
+@notes File must have triangular faces. needs no GL context, so a model
+       can be read on another thread and uploaded by the render thread
+
+***************************************/
+bool ObjectModel::readModelFile
+( 
+    const std::string& fileName,
+    const std::vector<TextureUnit> * const textureRegistry 
+)
 {
     //assimp
     Assimp::Importer importer;
@@ -423,7 +451,6 @@ bool ObjectModel::loadModelFromFile
 
     //image container using opencv
     cv::Mat tmpImg;
-    std::vector<cv::Mat> textureImg; //image matrix
     std::vector<std::string> textureFileNames;
 
     double addedValue = 0.0, multipliedValue= 1.0;
@@ -441,6 +468,7 @@ bool ObjectModel::loadModelFromFile
     //clear old vertices content
     Vertices.clear( );
     Indices.clear( );
+    textureImages.clear( );
 
     //load vertices and faces
     for( mIndex = 0; mIndex < scene->mNumMeshes; mIndex++ )
@@ -671,11 +699,45 @@ bool ObjectModel::loadModelFromFile
             }
         }
 
-        textureImg.push_back( tmpImg.clone( ) );
+        //kept as BGRA bytes until uploadBuffers
+        textureImages.push_back( TextureImage( ) );
+        textureImages.back( ).name = textureFileNames[ tIndex ];
+        textureImages.back( ).width = tmpImg.size( ).width;
+        textureImages.back( ).height = tmpImg.size( ).height;
+        textureImages.back( ).pixels.assign( tmpImg.data, 
+                                             tmpImg.data + tmpImg.total( ) * tmpImg.elemSize( ) );
 
         tmpImg.release( );
     }
 
+    return true;
+}
+
+// UPLOAD BUFFERS //////////////////
+/***************************************
+
+@brief uploadBuffers
+
+@details creates the model's buffers and textures from what readModelFile
+         read
+
+@param in: fileName: the file the model was read from, for the labels
+
+@param in: textureRegistry: the textures already loaded, new textures are
+           added to it. may be NULL
+
+@notes needs the GL context. the texture bytes are freed once uploaded
+
+***************************************/
+bool ObjectModel::uploadBuffers
+( 
+    const std::string& fileName,
+    std::vector<TextureUnit> * const textureRegistry 
+)
+{
+    unsigned int iIndex, tIndex, nIndex;
+    int registryIndex;
+
     glGenBuffers( 1, &VB );
     glBindBuffer( GL_ARRAY_BUFFER, VB );
     glBufferData( GL_ARRAY_BUFFER, //buffer type
@@ -683,6 +745,8 @@ bool ObjectModel::loadModelFromFile
                   &Vertices[ 0 ], //data
                   GL_STATIC_DRAW ); //draw mode
 
+    GL_LABEL( GL_BUFFER, VB, fileName + " vertices" );
+
     IB.resize( Indices.size( ) );   
 
     for( iIndex = 0; iIndex < IB.size( ); iIndex++ )
@@ -693,46 +757,110 @@ bool ObjectModel::loadModelFromFile
                       sizeof( unsigned int ) * Indices[ iIndex ].size( ), //size
                       &Indices[iIndex][ 0 ], //data
                       GL_STATIC_DRAW ); //draw mode
+
+        GL_LABEL( GL_BUFFER, IB[ iIndex ], fileName + " indices " + std::to_string( iIndex ) );
     }
 
-    texture.resize( textureImg.size( ) );
+    texture.resize( textureImages.size( ) );
 
     for( tIndex = 0; tIndex < texture.size( ); tIndex++ )
     {
-        if( textureIsAlreadyLoaded[ tIndex ] == -1 /* Not Already Loaded */ )
+        registryIndex = -1;
+
+        if( textureRegistry != NULL )
+        {
+            for( nIndex = 0; nIndex < textureRegistry->size( ); nIndex++ )
+            {
+                if( textureImages[ tIndex ].name == textureRegistry[ 0 ][ nIndex ].name )
+                {
+                    registryIndex = nIndex;
+                }
+            }
+        }
+
+        if( registryIndex == -1 /* Not Already Loaded */ )
         {
             glGenTextures( 1, &texture[ tIndex ] );
 
             glBindTexture( GL_TEXTURE_2D, texture[ tIndex ] );
 
             glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA,
-                          textureImg[ tIndex ].size( ).width,
-                          textureImg[ tIndex ].size( ).height, 0,
-                          GL_BGRA, GL_UNSIGNED_BYTE, textureImg[ tIndex ].data );
+                          textureImages[ tIndex ].width,
+                          textureImages[ tIndex ].height, 0,
+                          GL_BGRA, GL_UNSIGNED_BYTE, 
+                          textureImages[ tIndex ].pixels.empty( ) ? NULL : &textureImages[ tIndex ].pixels[ 0 ] );
 
             glTexParameterf( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR );
 
             glTexParameterf( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
 
-            if( textureRegistry != NULL && textureFileNames[ tIndex ] != "No Texture" )
+            GL_LABEL( GL_TEXTURE, texture[ tIndex ], textureImages[ tIndex ].name );
+
+            if( textureRegistry != NULL && textureImages[ tIndex ].name != "No Texture" )
             {
                 textureRegistry->push_back( TextureUnit( ) );
-                textureRegistry[ 0 ][ textureRegistry->size( ) - 1 ].name = textureFileNames[ tIndex ];
+                textureRegistry[ 0 ][ textureRegistry->size( ) - 1 ].name = textureImages[ tIndex ].name;
                 textureRegistry[ 0 ][ textureRegistry->size( ) - 1 ].texture = texture[ tIndex ];
             }
         }
         else
         {
-            if( textureRegistry != NULL )
+            texture[ tIndex ] = textureRegistry[ 0 ][ registryIndex ].texture;
+        }
+    }
+
+    textureImages.clear( );
+
+    return true;
+}
+
+// RELEASE BUFFERS //////////////////
+/***************************************
+
+@brief releaseBuffers
+
+@details deletes the model's buffers and the textures it does not share
+
+@param in: textureRegistry: the shared textures, which are kept. may be
+           NULL
+
+@notes a copy of the model holds the same names, so only one of them is
+       released
+
+***************************************/
+void ObjectModel::releaseBuffers( const std::vector<TextureUnit> * const textureRegistry )
+{
+    unsigned int tIndex, nIndex;
+    bool shared;
+
+    glDeleteBuffers( 1, &VB );
+
+    if( !IB.empty( ) )
+    {
+        glDeleteBuffers( IB.size( ), &IB[ 0 ] );
+    }
+
+    for( tIndex = 0; tIndex < texture.size( ); tIndex++ )
+    {
+        shared = false;
+
+        if( textureRegistry != NULL )
+        {
+            for( nIndex = 0; nIndex < textureRegistry->size( ) && !shared; nIndex++ )
             {
-                texture[ tIndex ] = textureRegistry[ 0 ][ textureIsAlreadyLoaded[ tIndex ] ].texture;
-            }            
+                shared = ( texture[ tIndex ] == textureRegistry[ 0 ][ nIndex ].texture );
+            }
         }
 
-        textureImg[ tIndex ].release( );
+        if( !shared )
+        {
+            glDeleteTextures( 1, &texture[ tIndex ] );
+        }
     }
 
-    return true;
+    VB = 0;
+    IB.clear( );
+    texture.clear( );
 }
 
 
@@ -779,6 +907,7 @@ const ObjectModel & ObjectModel::operator=( const ObjectModel & rhObjModel )
         IB = rhObjModel.IB;
         texture = rhObjModel.texture;
         textUniLoc = rhObjModel.textUniLoc;
+        textureImages = rhObjModel.textureImages;
     }
 
     return *this;
@@ -0,0 +1,273 @@
+#include "OceanGrid.h"
+
+#include <cmath>
+
+#include "RenderStats.h"
+#include "GLDebug.h"
+#include "Logger.h"
+
+const float OceanGrid::BASE_SPACING = 4.0f;
+
+
+OceanGrid::OceanGrid( ):
+	VB( 0 ),
+	IB( 0 ),
+	seaLevel( 0.0f )
+{
+	//done in initializer
+}
+
+OceanGrid::OceanGrid( const OceanGrid & src ):
+	VB( src.VB ),
+	IB( src.IB ),
+	vertices( src.vertices ),
+	indices( src.indices ),
+	seaLevel( src.seaLevel )
+{
+	//done in initializer
+}
+
+OceanGrid::~OceanGrid( )
+{
+	//done by class members
+}
+
+// INITIALIZE //////////////////
+/***************************************
+
+@brief Initialize
+
+@details builds every level of the grid and uploads it
+
+@param in: newSeaLevel: the world height of the undisturbed surface
+
+@notes logs the vertex and triangle count of each ring at debug level
+
+***************************************/
+bool OceanGrid::Initialize( float newSeaLevel )
+{
+	int level;
+	size_t startVertex, startIndex;
+
+	seaLevel = newSeaLevel;
+
+	vertices.clear( );
+	indices.clear( );
+
+	for( level = 0; level < NUMBER_OF_LEVELS; level++ )
+	{
+		startVertex = vertices.size( );
+		startIndex = indices.size( );
+
+		buildLevel( level );
+
+		LOG_DEBUG( "Ocean grid ring " << level << ": spacing "
+				   << BASE_SPACING * ( float ) ( 1 << level ) << ", "
+				   << vertices.size( ) - startVertex << " vertices, "
+				   << ( indices.size( ) - startIndex ) / 3 << " triangles" );
+	}
+
+	LOG_DEBUG( "Ocean grid total: " << getNumberOfVertices( ) << " vertices, "
+			   << getNumberOfTriangles( ) << " triangles" );
+
+	glGenBuffers( 1, &VB );
+	glBindBuffer( GL_ARRAY_BUFFER, VB );
+	glBufferData( GL_ARRAY_BUFFER, sizeof( Vertex ) * vertices.size( ),
+				  &vertices[ 0 ], GL_STATIC_DRAW );
+
+	GL_LABEL( GL_BUFFER, VB, "Ocean grid vertices" );
+
+	glGenBuffers( 1, &IB );
+	glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, IB );
+	glBufferData( GL_ELEMENT_ARRAY_BUFFER, sizeof( unsigned int ) * indices.size( ),
+				  &indices[ 0 ], GL_STATIC_DRAW );
+
+	GL_LABEL( GL_BUFFER, IB, "Ocean grid indices" );
+
+	return true;
+}
+
+// RENDER //////////////////
+/***************************************
+
+@brief Render
+
+@details draws every ring with a single call
+
+@param None
+
+@notes the caller sets the model matrix from getModel and binds
+       the ocean's textures
+
+***************************************/
+void OceanGrid::Render( )
+{
+	if( indices.empty( ) )
+	{
+		return;
+	}
+
+	glEnableVertexAttribArray( 0 );
+	glEnableVertexAttribArray( 1 );
+	glEnableVertexAttribArray( 2 );
+
+	glBindBuffer( GL_ARRAY_BUFFER, VB );
+	glVertexAttribPointer( 0, 3, GL_FLOAT, GL_FALSE, sizeof( Vertex ), 0 );
+	glVertexAttribPointer( 1, 2, GL_FLOAT, GL_FALSE, sizeof( Vertex ),
+						   ( void* ) offsetof( Vertex, uv ) );
+	glVertexAttribPointer( 2, 3, GL_FLOAT, GL_FALSE, sizeof( Vertex ),
+						   ( void* ) offsetof( Vertex, normal ) );
+
+	glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, IB );
+
+	glDrawElements( GL_TRIANGLES, indices.size( ), GL_UNSIGNED_INT, 0 );
+
+	RenderStats::addDraw( indices.size( ) );
+
+	glDisableVertexAttribArray( 0 );
+	glDisableVertexAttribArray( 1 );
+	glDisableVertexAttribArray( 2 );
+}
+
+// GET MODEL //////////////////
+/***************************************
+
+@brief getModel
+
+@details returns the transform that centres the grid under a camera
+
+@param in: cameraPosition: the world position of the camera
+
+@notes the centre is snapped to the coarsest spacing so every
+       vertex stays on its level's lattice and the waves do not
+       swim as the camera moves
+
+***************************************/
+glm::mat4 OceanGrid::getModel( const glm::vec3& cameraPosition ) const
+{
+	float snap = BASE_SPACING * ( float ) ( 1 << ( NUMBER_OF_LEVELS - 1 ) );
+
+	return glm::translate( glm::mat4( 1.0f ),
+						   glm::vec3( snap * std::floor( ( cameraPosition.x / snap ) + 0.5f ),
+									  seaLevel,
+									  snap * std::floor( ( cameraPosition.z / snap ) + 0.5f ) ) );
+}
+
+float OceanGrid::getSeaLevel( ) const
+{
+	return seaLevel;
+}
+
+unsigned int OceanGrid::getNumberOfVertices( ) const
+{
+	return vertices.size( );
+}
+
+unsigned int OceanGrid::getNumberOfTriangles( ) const
+{
+	return indices.size( ) / 3;
+}
+
+// private member functions
+
+// BUILD LEVEL //////////////////
+/***************************************
+
+@brief buildLevel
+
+@details appends one level of the grid to the buffers
+
+@param in: level: the level to build, 0 is the centre patch
+
+@notes every level but the first leaves out the area covered by
+       the previous one. each vertex stores the mip level to
+       sample the swell at and its spacing in the uv attribute;
+       vertices on the outer edge use the next level's values
+       and odd edge vertices are moved onto even ones so they
+       match the coarser ring exactly
+
+***************************************/
+void OceanGrid::buildLevel( int level )
+{
+	const int side = ( 2 * HALF_CELLS ) + 1;
+	const int hole = HALF_CELLS / 2;
+	const bool outerLevel = ( level == NUMBER_OF_LEVELS - 1 );
+
+	//corner offsets in counter clockwise order seen from above
+	const int cornerCol[ 4 ] = { 0, 0, 1, 1 };
+	const int cornerRow[ 4 ] = { 0, 1, 1, 0 };
+
+	float spacing = BASE_SPACING * ( float ) ( 1 << level );
+	std::vector<int> vertexIndex( side * side, -1 );
+	int cellRow, cellCol, gridRow, gridCol, row, col, corner, key;
+	int corners[ 4 ];
+	bool edge;
+	Vertex vertex;
+
+	for( cellRow = -HALF_CELLS; cellRow < HALF_CELLS; cellRow++ )
+	{
+		for( cellCol = -HALF_CELLS; cellCol < HALF_CELLS; cellCol++ )
+		{
+			//already covered by the finer level
+			if( level > 0
+				&& cellRow >= -hole && cellRow < hole
+				&& cellCol >= -hole && cellCol < hole )
+			{
+				continue;
+			}
+
+			for( corner = 0; corner < 4; corner++ )
+			{
+				gridCol = cellCol + cornerCol[ corner ];
+				gridRow = cellRow + cornerRow[ corner ];
+
+				key = ( ( gridRow + HALF_CELLS ) * side ) + gridCol + HALF_CELLS;
+
+				if( vertexIndex[ key ] == -1 )
+				{
+					edge = !outerLevel
+						   && ( std::abs( gridRow ) == HALF_CELLS
+								|| std::abs( gridCol ) == HALF_CELLS );
+
+					col = gridCol;
+					row = gridRow;
+
+					if( edge && std::abs( gridRow ) == HALF_CELLS && ( gridCol & 1 ) )
+					{
+						col--;
+					}
+
+					if( edge && std::abs( gridCol ) == HALF_CELLS && ( gridRow & 1 ) )
+					{
+						row--;
+					}
+
+					vertex.vertex = glm::vec3( col * spacing, 0.0f, row * spacing );
+					vertex.normal = glm::vec3( 0.0f, 1.0f, 0.0f );
+
+					if( edge )
+					{
+						vertex.uv = glm::vec2( ( float ) ( level + 1 ), 2.0f * spacing );
+					}
+					else
+					{
+						vertex.uv = glm::vec2( ( float ) level, spacing );
+					}
+
+					vertexIndex[ key ] = vertices.size( );
+					vertices.push_back( vertex );
+				}
+
+				corners[ corner ] = vertexIndex[ key ];
+			}
+
+			indices.push_back( corners[ 0 ] );
+			indices.push_back( corners[ 1 ] );
+			indices.push_back( corners[ 2 ] );
+
+			indices.push_back( corners[ 0 ] );
+			indices.push_back( corners[ 2 ] );
+			indices.push_back( corners[ 3 ] );
+		}
+	}
+}
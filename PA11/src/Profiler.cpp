@@ -0,0 +1,526 @@
+#include "Profiler.h"
+#include <chrono>
+#include <vector>
+#include <mutex>
+#include <memory>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+
+// struct definitions /////////////////////
+
+struct ProfileEvent
+{
+    const char *name;
+    long long start; //steady_clock nanoseconds
+    long long duration; //nanoseconds
+};
+
+struct ZoneTotal
+{
+    const char *name;
+    long long total; //nanoseconds since the last report
+    unsigned int calls;
+    double average; //milliseconds per frame over the last report
+};
+
+struct ThreadBuffer
+{
+    std::mutex lock; //only contended while a report, an average or a trace reads it
+    unsigned int id; //the trace's thread id, in the order the threads first record
+    bool gpu; //the GPU's track instead of a thread
+
+    std::vector<ProfileEvent> events; //the ring
+    unsigned int next; //where the next zone goes
+    unsigned int count; //zones in the ring
+
+    std::vector<ZoneTotal> totals;
+
+    ThreadBuffer( ) : id( 0 ), gpu( false ), next( 0 ), count( 0 ) { }
+};
+
+// free function prototypes ///////////////
+
+static ThreadBuffer& GetThreadBuffer( );
+
+static ThreadBuffer& GetGpuBuffer( );
+
+static void AddZone( ThreadBuffer& buffer, const char *name, long long start, long long end );
+
+// file data //////////////////////////////
+
+static std::mutex registryLock;
+static std::vector<std::unique_ptr<ThreadBuffer>> registry;
+static thread_local ThreadBuffer *localBuffer = NULL;
+static ThreadBuffer *gpuBuffer = NULL;
+
+static std::string traceFile;
+static long long captureStart = 0;
+static unsigned int reportFrames = 0;
+
+std::atomic<bool> Profiler::capturing( false );
+
+// START CAPTURE //////////////////
+/***************************************
+
+@brief startCapture
+
+@details clears every thread's ring and starts recording
+
+@param in: fileName: the trace file stopCapture writes
+
+@notes returns false if a capture is running or the profiler was
+       compiled out. the totals are kept, they are averaged with or
+       without a capture
+
+***************************************/
+bool Profiler::startCapture( const std::string& fileName )
+{
+    unsigned int index;
+
+#ifndef PROFILER
+    std::cout << "The profiler was compiled out, build with PROFILER." << std::endl;
+    return false;
+#endif
+
+    if( isCapturing( ) )
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> registryGuard( registryLock );
+
+    for( index = 0; index < registry.size( ); index++ )
+    {
+        std::lock_guard<std::mutex> guard( registry[ index ]->lock );
+
+        registry[ index ]->next = 0;
+        registry[ index ]->count = 0;
+    }
+
+    traceFile = fileName;
+    captureStart = now( );
+
+    capturing.store( true );
+
+    std::cout << "Profiling to " << traceFile << std::endl;
+
+    return true;
+}
+
+// STOP CAPTURE //////////////////
+/***************************************
+
+@brief stopCapture
+
+@details stops recording, prints the last averages and writes the trace
+
+@param None
+
+@notes returns false if no capture was running or the trace could not
+       be written
+
+***************************************/
+bool Profiler::stopCapture( )
+{
+    if( !isCapturing( ) )
+    {
+        return false;
+    }
+
+    capturing.store( false );
+
+    report( true );
+
+    return writeTrace( );
+}
+
+bool Profiler::toggleCapture( const std::string& fileName )
+{
+    if( isCapturing( ) )
+    {
+        return stopCapture( );
+    }
+
+    return startCapture( fileName );
+}
+
+// END FRAME //////////////////
+/***************************************
+
+@brief endFrame
+
+@details counts a frame and averages the zones every REPORT_FRAMES
+         frames
+
+@param None
+
+@notes the averages are only printed while a capture runs
+
+***************************************/
+void Profiler::endFrame( )
+{
+    reportFrames++;
+
+    if( reportFrames >= REPORT_FRAMES )
+    {
+        report( isCapturing( ) );
+    }
+}
+
+long long Profiler::now( )
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now( ).time_since_epoch( ) ).count( );
+}
+
+// RECORD //////////////////
+/***************************************
+
+@brief record
+
+@details adds a finished zone to the calling thread's ring and totals
+
+@param in: name: the zone's name
+
+@param in: start: when it began, from now
+
+@param in: end: when it ended, from now
+
+@notes the ring is made on the thread's first zone
+
+***************************************/
+void Profiler::record( const char *name, long long start, long long end )
+{
+    AddZone( GetThreadBuffer( ), name, start, end );
+}
+
+// RECORD GPU //////////////////
+/***************************************
+
+@brief recordGpu
+
+@details adds a GPU pass to the GPU's track
+
+@param in: name: the pass's name
+
+@param in: start: when it began, on the clock of now
+
+@param in: end: when it ended, on the clock of now
+
+@notes the passes come in frames after they ran, so the averages
+       printed at a report are of a few frames earlier
+
+***************************************/
+void Profiler::recordGpu( const char *name, long long start, long long end )
+{
+    AddZone( GetGpuBuffer( ), name, start, end );
+}
+
+// GET AVERAGE //////////////////
+/***************************************
+
+@brief getAverage
+
+@details returns a zone's milliseconds per frame over the last
+         REPORT_FRAMES frames
+
+@param in: name: the zone's name
+
+@notes a zone on several threads is summed. 0 for a zone that did not
+       run, or when the profiler was compiled out
+
+***************************************/
+double Profiler::getAverage( const char *name )
+{
+    unsigned int index, zone;
+    double average = 0.0;
+
+    std::lock_guard<std::mutex> registryGuard( registryLock );
+
+    for( index = 0; index < registry.size( ); index++ )
+    {
+        ThreadBuffer& buffer = *registry[ index ];
+        std::lock_guard<std::mutex> guard( buffer.lock );
+
+        for( zone = 0; zone < buffer.totals.size( ); zone++ )
+        {
+            if( strcmp( buffer.totals[ zone ].name, name ) == 0 )
+            {
+                average += buffer.totals[ zone ].average;
+            }
+        }
+    }
+
+    return average;
+}
+
+// private member functions
+
+// WRITE TRACE //////////////////
+/***************************************
+
+@brief writeTrace
+
+@details writes the rings as complete events of a Chrome trace_event
+         file
+
+@param None
+
+@notes the times are in microseconds from the start of the capture, as
+       the format expects
+
+***************************************/
+bool Profiler::writeTrace( )
+{
+    unsigned int index, event, slot;
+    bool first = true;
+    std::ofstream fileOut( traceFile.c_str( ) );
+
+    if( fileOut.fail( ) )
+    {
+        std::cout << "Failure writing the file: " << traceFile << "!!!" << std::endl;
+        return false;
+    }
+
+    fileOut << std::fixed << std::setprecision( 3 );
+    fileOut << "{\"traceEvents\":[" << std::endl;
+
+    std::lock_guard<std::mutex> registryGuard( registryLock );
+
+    for( index = 0; index < registry.size( ); index++ )
+    {
+        ThreadBuffer& buffer = *registry[ index ];
+        std::lock_guard<std::mutex> guard( buffer.lock );
+
+        fileOut << ( first ? "" : ",\n" )
+                << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer.id
+                << ",\"args\":{\"name\":\"";
+
+        if( buffer.gpu )
+        {
+            fileOut << "GPU\"}}";
+        }
+        else
+        {
+            fileOut << "Thread " << buffer.id << "\"}}";
+        }
+
+        first = false;
+
+        //oldest first
+        slot = ( buffer.next + RING_SIZE - buffer.count ) % RING_SIZE;
+
+        for( event = 0; event < buffer.count; event++ )
+        {
+            if( buffer.events[ slot ].start >= captureStart )
+            {
+                fileOut << ",\n{\"name\":\"" << buffer.events[ slot ].name
+                        << "\",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer.id
+                        << ",\"ts\":" << ( buffer.events[ slot ].start - captureStart ) / 1000.0
+                        << ",\"dur\":" << buffer.events[ slot ].duration / 1000.0 << "}";
+            }
+
+            slot = ( slot + 1 ) % RING_SIZE;
+        }
+    }
+
+    fileOut << std::endl << "],\"displayTimeUnit\":\"ns\"}" << std::endl;
+
+    std::cout << "Wrote the profile to " << traceFile << std::endl;
+
+    return !fileOut.fail( );
+}
+
+// REPORT //////////////////
+/***************************************
+
+@brief report
+
+@details works out each zone's time per frame since the last report,
+         prints it with the time per call, then clears the totals
+
+@param in: print: false to only update the averages
+
+@notes zones on other threads are still divided by the main loop's
+       frames
+
+***************************************/
+void Profiler::report( bool print )
+{
+    unsigned int index, zone;
+    std::ios::fmtflags flags = std::cout.flags( );
+    std::streamsize precision = std::cout.precision( );
+
+    if( reportFrames == 0 )
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> registryGuard( registryLock );
+
+    if( print )
+    {
+        std::cout << std::fixed << std::setprecision( 3 );
+
+        std::cout << "Profile over " << reportFrames << " frames ( ms per frame, ms per call ):"
+                  << std::endl;
+    }
+
+    for( index = 0; index < registry.size( ); index++ )
+    {
+        ThreadBuffer& buffer = *registry[ index ];
+        std::lock_guard<std::mutex> guard( buffer.lock );
+
+        for( zone = 0; zone < buffer.totals.size( ); zone++ )
+        {
+            buffer.totals[ zone ].average = buffer.totals[ zone ].total / 1000000.0 / reportFrames;
+
+            if( print && buffer.totals[ zone ].calls > 0 )
+            {
+                std::cout << "  [" << ( buffer.gpu ? "GPU" : std::to_string( buffer.id ) ) << "] "
+                          << std::left << std::setw( 24 )
+                          << buffer.totals[ zone ].name << std::right
+                          << std::setw( 10 ) << buffer.totals[ zone ].average
+                          << std::setw( 10 ) << buffer.totals[ zone ].total / 1000000.0
+                                                / buffer.totals[ zone ].calls
+                          << std::endl;
+            }
+
+            //the names stay, so a zone keeps its slot and its average
+            buffer.totals[ zone ].total = 0;
+            buffer.totals[ zone ].calls = 0;
+        }
+    }
+
+    std::cout.flags( flags );
+    std::cout.precision( precision );
+
+    reportFrames = 0;
+}
+
+// free function implementation /////////////
+
+// GET THREAD BUFFER //////////////////
+/***************************************
+
+@brief GetThreadBuffer
+
+@details returns the calling thread's buffer, making it on first use
+
+@param None
+
+@notes the buffers live as long as the program, so a trace can still
+       read the zones of a thread that has ended
+
+***************************************/
+static ThreadBuffer& GetThreadBuffer( )
+{
+    if( localBuffer == NULL )
+    {
+        std::lock_guard<std::mutex> registryGuard( registryLock );
+
+        registry.push_back( std::unique_ptr<ThreadBuffer>( new ThreadBuffer( ) ) );
+
+        localBuffer = registry.back( ).get( );
+        localBuffer->id = registry.size( ) - 1;
+    }
+
+    return *localBuffer;
+}
+
+// GET GPU BUFFER //////////////////
+/***************************************
+
+@brief GetGpuBuffer
+
+@details returns the GPU's track, making it on first use
+
+@param None
+
+@notes only the thread that renders records to it
+
+***************************************/
+static ThreadBuffer& GetGpuBuffer( )
+{
+    if( gpuBuffer == NULL )
+    {
+        std::lock_guard<std::mutex> registryGuard( registryLock );
+
+        registry.push_back( std::unique_ptr<ThreadBuffer>( new ThreadBuffer( ) ) );
+
+        gpuBuffer = registry.back( ).get( );
+        gpuBuffer->id = registry.size( ) - 1;
+        gpuBuffer->gpu = true;
+    }
+
+    return *gpuBuffer;
+}
+
+// ADD ZONE //////////////////
+/***************************************
+
+@brief AddZone
+
+@details adds a finished zone to a buffer's totals, and to its ring
+         while a capture runs
+
+@param in: buffer: the thread's or the GPU's buffer
+
+@param in: name: the zone's name
+
+@param in: start: when it began
+
+@param in: end: when it ended
+
+@notes a name past MAX_ZONES is traced but not averaged
+
+***************************************/
+static void AddZone( ThreadBuffer& buffer, const char *name, long long start, long long end )
+{
+    unsigned int index;
+    ZoneTotal total;
+
+    std::lock_guard<std::mutex> guard( buffer.lock );
+
+    if( Profiler::isCapturing( ) )
+    {
+        if( buffer.events.empty( ) )
+        {
+            buffer.events.resize( Profiler::RING_SIZE );
+        }
+
+        buffer.events[ buffer.next ].name = name;
+        buffer.events[ buffer.next ].start = start;
+        buffer.events[ buffer.next ].duration = end - start;
+
+        buffer.next = ( buffer.next + 1 ) % Profiler::RING_SIZE;
+
+        if( buffer.count < Profiler::RING_SIZE )
+        {
+            buffer.count++;
+        }
+    }
+
+    for( index = 0; index < buffer.totals.size( ); index++ )
+    {
+        if( buffer.totals[ index ].name == name
+            || strcmp( buffer.totals[ index ].name, name ) == 0 )
+        {
+            buffer.totals[ index ].total += end - start;
+            buffer.totals[ index ].calls++;
+            return;
+        }
+    }
+
+    if( buffer.totals.size( ) < Profiler::MAX_ZONES )
+    {
+        total.name = name;
+        total.total = end - start;
+        total.calls = 1;
+        total.average = 0.0;
+
+        buffer.totals.push_back( total );
+    }
+}
@@ -0,0 +1,720 @@
+#include "SceneFile.h"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#if defined( _WIN64 ) || defined( _WIN32 )
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+// file data //////////////////////////////
+
+//the records are written as they are laid out in memory, every field is
+//four bytes so no record has padding
+
+struct SceneString
+{
+    uint32_t offset; //from the start of the string table
+    uint32_t length;
+};
+
+struct ScenePrefix
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t endianCheck;
+    char source[ SceneFile::SOURCE_SIZE ]; //the configuration file, null terminated
+};
+
+struct SceneHeader
+{
+    uint32_t fileSize;
+
+    uint32_t programCount;
+    uint32_t programOffset;
+    uint32_t stageCount;
+    uint32_t stageOffset;
+    uint32_t modelCount;
+    uint32_t modelOffset;
+    uint32_t objectCount;
+    uint32_t objectOffset;
+    uint32_t modelIDCount;
+    uint32_t modelIDOffset;
+    uint32_t childIDCount;
+    uint32_t childIDOffset;
+    uint32_t lightCount;
+    uint32_t lightOffset;
+    uint32_t spotLightCount;
+    uint32_t spotLightOffset;
+    uint32_t stringSize;
+    uint32_t stringOffset;
+
+    float windowSize[ 2 ]; //0 keeps the size given on the command line
+    SceneString windowName; //empty keeps the name given on the command line
+    float windDirection[ 3 ];
+    float windForce;
+    int32_t depthMode;
+};
+
+struct SceneProgram
+{
+    uint32_t firstStage;
+    uint32_t stageCount;
+};
+
+struct SceneStage
+{
+    uint32_t type; //GL_VERTEX_SHADER or GL_FRAGMENT_SHADER
+    SceneString path;
+};
+
+struct SceneObject
+{
+    SceneString name;
+    SceneString type;
+
+    uint32_t firstModel; //into the model ID table
+    uint32_t modelCount;
+    uint32_t firstChild; //into the child ID table
+    uint32_t childCount;
+
+    float scale[ 3 ];
+    float bScale[ 3 ];
+    float position[ 3 ];
+    float rotationAxes[ 3 ];
+    float rotationAngles[ 3 ];
+};
+
+struct SceneLight
+{
+    float incoming[ 4 ];
+    float ambient[ 4 ];
+};
+
+struct SceneSpotLight
+{
+    float incoming[ 4 ];
+    float ambient[ 4 ];
+    float coneAngle;
+    float spotHeight;
+    SceneString objectToFollow;
+};
+
+//a read only view of a whole file, unmapped when it goes out of scope
+class MappedFile
+{
+    public:
+        MappedFile( ) : data( NULL ), size( 0 )
+        {
+        #if defined( _WIN64 ) || defined( _WIN32 )
+            file = INVALID_HANDLE_VALUE;
+            mapping = NULL;
+        #endif
+        }
+
+        ~MappedFile( )
+        {
+            close( );
+        }
+
+        bool open( const std::string& fileName );
+
+        void close( );
+
+        const char *data;
+        size_t size;
+
+    private:
+    #if defined( _WIN64 ) || defined( _WIN32 )
+        HANDLE file;
+        HANDLE mapping;
+    #endif
+};
+
+// free function prototypes ///////////////
+
+static SceneString AddString( std::string& strings, const std::string& text );
+
+static bool InFile( const SceneHeader& header, uint32_t offset, uint32_t count,
+                    size_t recordSize );
+
+static bool GetString( const char *strings, const SceneHeader& header,
+                       const SceneString& text, std::string& out );
+
+template <typename Record>
+static void AppendRecords( std::string& file, const std::vector<Record>& records );
+
+// IS SCENE //////////////////
+/***************************************
+
+@brief IsScene
+
+@details returns true if the file starts as a compiled scene does
+
+@param in: fileName: the file to check
+
+@notes only the first word is read, the rest is checked by Read
+
+***************************************/
+bool SceneFile::IsScene( const std::string& fileName )
+{
+    std::ifstream file( fileName.c_str( ), std::ios::binary );
+    uint32_t magic = 0;
+
+    if( !file.read( ( char* ) &magic, sizeof( magic ) ) )
+    {
+        return false;
+    }
+
+    return magic == MAGIC;
+}
+
+// WRITE //////////////////
+/***************************************
+
+@brief Write
+
+@details writes the scene in progInfo to a compiled scene file
+
+@param in: fileName: the file, replaced if it is there
+
+@param in: progInfo: the scene read from the configuration file
+
+@param in: sourceName: the configuration file, kept for the fallback
+
+@notes the tables are laid out in the order of the header, each starts
+       on a four byte boundary since every record is made of four byte
+       fields
+
+***************************************/
+bool SceneFile::Write( const std::string& fileName, const GraphicsInfo& progInfo,
+                       const std::string& sourceName )
+{
+    ScenePrefix prefix;
+    SceneHeader header;
+    std::vector<SceneProgram> programs;
+    std::vector<SceneStage> stages;
+    std::vector<SceneString> models;
+    std::vector<SceneObject> objects;
+    std::vector<uint32_t> modelIDs;
+    std::vector<uint32_t> childIDs;
+    std::vector<SceneLight> lights;
+    std::vector<SceneSpotLight> spotLights;
+    std::string strings;
+    std::string file;
+    std::ofstream output;
+    unsigned int index, stage;
+
+    if( sourceName.size( ) >= SOURCE_SIZE )
+    {
+        std::cout << "The configuration file's name is too long to keep: "
+                  << sourceName << std::endl;
+        return false;
+    }
+
+    std::memset( &prefix, 0, sizeof( prefix ) );
+    std::memset( &header, 0, sizeof( header ) );
+
+    prefix.magic = MAGIC;
+    prefix.version = VERSION;
+    prefix.endianCheck = ENDIAN_CHECK;
+    std::strncpy( prefix.source, sourceName.c_str( ), SOURCE_SIZE - 1 );
+
+    for( index = 0; index < progInfo.shaderVector.size( ); index++ )
+    {
+        SceneProgram program;
+
+        program.firstStage = stages.size( );
+        program.stageCount = progInfo.shaderVector[ index ].size( );
+
+        for( stage = 0; stage < progInfo.shaderVector[ index ].size( ); stage++ )
+        {
+            SceneStage record;
+
+            record.type = progInfo.shaderVector[ index ][ stage ].first;
+            record.path = AddString( strings, progInfo.shaderVector[ index ][ stage ].second );
+
+            stages.push_back( record );
+        }
+
+        programs.push_back( program );
+    }
+
+    for( index = 0; index < progInfo.modelVector.size( ); index++ )
+    {
+        models.push_back( AddString( strings, progInfo.modelVector[ index ] ) );
+    }
+
+    for( index = 0; index < progInfo.objectData.size( ); index++ )
+    {
+        const ObjectInfo& objInfo = progInfo.objectData[ index ];
+        SceneObject record;
+
+        record.name = AddString( strings, objInfo.name );
+        record.type = AddString( strings, objInfo.type );
+
+        record.firstModel = modelIDs.size( );
+        record.modelCount = objInfo.modelID.size( );
+        modelIDs.insert( modelIDs.end( ), objInfo.modelID.begin( ), objInfo.modelID.end( ) );
+
+        record.firstChild = childIDs.size( );
+        record.childCount = objInfo.childID.size( );
+        childIDs.insert( childIDs.end( ), objInfo.childID.begin( ), objInfo.childID.end( ) );
+
+        std::memcpy( record.scale, glm::value_ptr( objInfo.scale ), sizeof( record.scale ) );
+        std::memcpy( record.bScale, glm::value_ptr( objInfo.bScale ), sizeof( record.bScale ) );
+        std::memcpy( record.position, glm::value_ptr( objInfo.position ), sizeof( record.position ) );
+        std::memcpy( record.rotationAxes, glm::value_ptr( objInfo.rotationAxes ),
+                     sizeof( record.rotationAxes ) );
+        std::memcpy( record.rotationAngles, glm::value_ptr( objInfo.rotationAngles ),
+                     sizeof( record.rotationAngles ) );
+
+        objects.push_back( record );
+    }
+
+    for( index = 0; index < progInfo.lights.size( ); index++ )
+    {
+        SceneLight record;
+
+        std::memcpy( record.incoming, glm::value_ptr( progInfo.lights[ index ].incoming ),
+                     sizeof( record.incoming ) );
+        std::memcpy( record.ambient, glm::value_ptr( progInfo.lights[ index ].ambient ),
+                     sizeof( record.ambient ) );
+
+        lights.push_back( record );
+    }
+
+    for( index = 0; index < progInfo.spotLight.size( ); index++ )
+    {
+        SceneSpotLight record;
+
+        std::memcpy( record.incoming, glm::value_ptr( progInfo.spotLight[ index ].incoming ),
+                     sizeof( record.incoming ) );
+        std::memcpy( record.ambient, glm::value_ptr( progInfo.spotLight[ index ].ambient ),
+                     sizeof( record.ambient ) );
+        record.coneAngle = progInfo.spotLight[ index ].coneAngle;
+        record.spotHeight = progInfo.spotLight[ index ].spotHeight;
+        record.objectToFollow = AddString( strings, progInfo.spotLight[ index ].objectToFollow );
+
+        spotLights.push_back( record );
+    }
+
+    header.windowSize[ 0 ] = progInfo.windowSize.x;
+    header.windowSize[ 1 ] = progInfo.windowSize.y;
+    header.windowName = AddString( strings, progInfo.windowName );
+    std::memcpy( header.windDirection, glm::value_ptr( progInfo.windDirection ),
+                 sizeof( header.windDirection ) );
+    header.windForce = progInfo.windForce;
+    header.depthMode = progInfo.depthMode;
+
+    //lay the tables out behind the prefix and the header
+    file.assign( sizeof( prefix ) + sizeof( header ), '\0' );
+
+    header.programCount = programs.size( );
+    header.programOffset = file.size( );
+    AppendRecords( file, programs );
+
+    header.stageCount = stages.size( );
+    header.stageOffset = file.size( );
+    AppendRecords( file, stages );
+
+    header.modelCount = models.size( );
+    header.modelOffset = file.size( );
+    AppendRecords( file, models );
+
+    header.objectCount = objects.size( );
+    header.objectOffset = file.size( );
+    AppendRecords( file, objects );
+
+    header.modelIDCount = modelIDs.size( );
+    header.modelIDOffset = file.size( );
+    AppendRecords( file, modelIDs );
+
+    header.childIDCount = childIDs.size( );
+    header.childIDOffset = file.size( );
+    AppendRecords( file, childIDs );
+
+    header.lightCount = lights.size( );
+    header.lightOffset = file.size( );
+    AppendRecords( file, lights );
+
+    header.spotLightCount = spotLights.size( );
+    header.spotLightOffset = file.size( );
+    AppendRecords( file, spotLights );
+
+    header.stringSize = strings.size( );
+    header.stringOffset = file.size( );
+    file.append( strings );
+
+    header.fileSize = file.size( );
+
+    std::memcpy( &file[ 0 ], &prefix, sizeof( prefix ) );
+    std::memcpy( &file[ sizeof( prefix ) ], &header, sizeof( header ) );
+
+    output.open( fileName.c_str( ), std::ios::binary );
+
+    if( output.fail( ) || !output.write( file.data( ), file.size( ) ) )
+    {
+        std::cout << "Failure writing the file: " << fileName << "!!!" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+// READ //////////////////
+/***************************************
+
+@brief Read
+
+@details maps a compiled scene file and copies its tables into progInfo
+
+@param in: fileName: the compiled scene
+
+@param out: progInfo: the scene, left as it was if the file is rejected
+
+@param out: sourceName: the configuration file the scene came from, set
+            when the file is of another version or byte order
+
+@notes every offset, count and index is checked against the file before
+       anything is copied
+
+***************************************/
+bool SceneFile::Read( const std::string& fileName, GraphicsInfo& progInfo,
+                      std::string& sourceName )
+{
+    MappedFile file;
+    const ScenePrefix *prefix;
+    const SceneHeader *header;
+    const SceneProgram *programs;
+    const SceneStage *stages;
+    const SceneString *models;
+    const SceneObject *objects;
+    const uint32_t *modelIDs;
+    const uint32_t *childIDs;
+    const SceneLight *lights;
+    const SceneSpotLight *spotLights;
+    const char *strings;
+
+    std::vector<std::vector<std::pair<GLenum, std::string>>> shaderVector;
+    std::vector<std::string> modelVector;
+    std::vector<ObjectInfo> objectData;
+    std::vector<Light> lightVector;
+    std::vector<SpotLight> spotLightVector;
+    std::string windowName, text;
+    unsigned int index, stage;
+    bool noError = true;
+
+    sourceName.clear( );
+
+    if( !file.open( fileName ) )
+    {
+        std::cout << "Failure reading in the file: " << fileName << "!!!" << std::endl;
+        return false;
+    }
+
+    if( file.size < sizeof( ScenePrefix ) )
+    {
+        std::cout << fileName << " is too short to be a scene" << std::endl;
+        return false;
+    }
+
+    prefix = ( const ScenePrefix* ) file.data;
+
+    if( prefix->magic != MAGIC || prefix->version != VERSION || prefix->endianCheck != ENDIAN_CHECK )
+    {
+        sourceName.assign( prefix->source, strnlen( prefix->source, SOURCE_SIZE ) );
+
+        std::cout << fileName << " was compiled by another version of the scene compiler"
+                  << " or on a machine of another byte order" << std::endl;
+        return false;
+    }
+
+    header = ( const SceneHeader* ) ( file.data + sizeof( ScenePrefix ) );
+
+    if( file.size < sizeof( ScenePrefix ) + sizeof( SceneHeader ) || header->fileSize != file.size ||
+        !InFile( *header, header->programOffset, header->programCount, sizeof( SceneProgram ) ) ||
+        !InFile( *header, header->stageOffset, header->stageCount, sizeof( SceneStage ) ) ||
+        !InFile( *header, header->modelOffset, header->modelCount, sizeof( SceneString ) ) ||
+        !InFile( *header, header->objectOffset, header->objectCount, sizeof( SceneObject ) ) ||
+        !InFile( *header, header->modelIDOffset, header->modelIDCount, sizeof( uint32_t ) ) ||
+        !InFile( *header, header->childIDOffset, header->childIDCount, sizeof( uint32_t ) ) ||
+        !InFile( *header, header->lightOffset, header->lightCount, sizeof( SceneLight ) ) ||
+        !InFile( *header, header->spotLightOffset, header->spotLightCount, sizeof( SceneSpotLight ) ) ||
+        !InFile( *header, header->stringOffset, header->stringSize, 1 ) )
+    {
+        std::cout << fileName << " is cut short or damaged" << std::endl;
+        return false;
+    }
+
+    programs = ( const SceneProgram* ) ( file.data + header->programOffset );
+    stages = ( const SceneStage* ) ( file.data + header->stageOffset );
+    models = ( const SceneString* ) ( file.data + header->modelOffset );
+    objects = ( const SceneObject* ) ( file.data + header->objectOffset );
+    modelIDs = ( const uint32_t* ) ( file.data + header->modelIDOffset );
+    childIDs = ( const uint32_t* ) ( file.data + header->childIDOffset );
+    lights = ( const SceneLight* ) ( file.data + header->lightOffset );
+    spotLights = ( const SceneSpotLight* ) ( file.data + header->spotLightOffset );
+    strings = file.data + header->stringOffset;
+
+    shaderVector.resize( header->programCount );
+
+    for( index = 0; index < header->programCount && noError; index++ )
+    {
+        noError = ( ( uint64_t ) programs[ index ].firstStage + programs[ index ].stageCount
+                    <= header->stageCount );
+
+        for( stage = 0; stage < programs[ index ].stageCount && noError; stage++ )
+        {
+            const SceneStage& record = stages[ programs[ index ].firstStage + stage ];
+
+            noError = GetString( strings, *header, record.path, text );
+
+            shaderVector[ index ].push_back( std::pair<GLenum, std::string>( record.type, text ) );
+        }
+    }
+
+    modelVector.resize( header->modelCount );
+
+    for( index = 0; index < header->modelCount && noError; index++ )
+    {
+        noError = GetString( strings, *header, models[ index ], modelVector[ index ] );
+    }
+
+    objectData.resize( header->objectCount );
+
+    for( index = 0; index < header->objectCount && noError; index++ )
+    {
+        const SceneObject& record = objects[ index ];
+        ObjectInfo& objInfo = objectData[ index ];
+
+        noError = GetString( strings, *header, record.name, objInfo.name ) &&
+                  GetString( strings, *header, record.type, objInfo.type ) &&
+                  ( uint64_t ) record.firstModel + record.modelCount <= header->modelIDCount &&
+                  ( uint64_t ) record.firstChild + record.childCount <= header->childIDCount;
+
+        if( noError )
+        {
+            objInfo.modelID.assign( modelIDs + record.firstModel,
+                                    modelIDs + record.firstModel + record.modelCount );
+            objInfo.childID.assign( childIDs + record.firstChild,
+                                    childIDs + record.firstChild + record.childCount );
+        }
+
+        for( stage = 0; stage < objInfo.modelID.size( ) && noError; stage++ )
+        {
+            noError = ( objInfo.modelID[ stage ] < header->modelCount );
+        }
+
+        for( stage = 0; stage < objInfo.childID.size( ) && noError; stage++ )
+        {
+            noError = ( objInfo.childID[ stage ] < header->objectCount );
+        }
+
+        objInfo.scale = glm::vec3( record.scale[ 0 ], record.scale[ 1 ], record.scale[ 2 ] );
+        objInfo.bScale = glm::vec3( record.bScale[ 0 ], record.bScale[ 1 ], record.bScale[ 2 ] );
+        objInfo.position = glm::vec3( record.position[ 0 ], record.position[ 1 ], record.position[ 2 ] );
+        objInfo.rotationAxes = glm::vec3( record.rotationAxes[ 0 ], record.rotationAxes[ 1 ],
+                                          record.rotationAxes[ 2 ] );
+        objInfo.rotationAngles = glm::vec3( record.rotationAngles[ 0 ], record.rotationAngles[ 1 ],
+                                            record.rotationAngles[ 2 ] );
+    }
+
+    lightVector.resize( header->lightCount );
+
+    for( index = 0; index < header->lightCount; index++ )
+    {
+        std::memcpy( glm::value_ptr( lightVector[ index ].incoming ), lights[ index ].incoming,
+                     sizeof( lights[ index ].incoming ) );
+        std::memcpy( glm::value_ptr( lightVector[ index ].ambient ), lights[ index ].ambient,
+                     sizeof( lights[ index ].ambient ) );
+    }
+
+    spotLightVector.resize( header->spotLightCount );
+
+    for( index = 0; index < header->spotLightCount && noError; index++ )
+    {
+        std::memcpy( glm::value_ptr( spotLightVector[ index ].incoming ), spotLights[ index ].incoming,
+                     sizeof( spotLights[ index ].incoming ) );
+        std::memcpy( glm::value_ptr( spotLightVector[ index ].ambient ), spotLights[ index ].ambient,
+                     sizeof( spotLights[ index ].ambient ) );
+        spotLightVector[ index ].coneAngle = spotLights[ index ].coneAngle;
+        spotLightVector[ index ].spotHeight = spotLights[ index ].spotHeight;
+
+        noError = GetString( strings, *header, spotLights[ index ].objectToFollow,
+                             spotLightVector[ index ].objectToFollow );
+    }
+
+    noError = noError && GetString( strings, *header, header->windowName, windowName );
+
+    if( !noError )
+    {
+        std::cout << fileName << " has a record that points outside of its tables" << std::endl;
+        return false;
+    }
+
+    //the file is whole, hand the tables over
+    progInfo.shaderVector.swap( shaderVector );
+    progInfo.modelVector.swap( modelVector );
+    progInfo.objectData.swap( objectData );
+    progInfo.lights.swap( lightVector );
+    progInfo.spotLight.swap( spotLightVector );
+
+    if( header->windowSize[ 0 ] > 0.0f && header->windowSize[ 1 ] > 0.0f )
+    {
+        progInfo.windowSize = glm::vec2( header->windowSize[ 0 ], header->windowSize[ 1 ] );
+    }
+
+    if( !windowName.empty( ) )
+    {
+        progInfo.windowName = windowName;
+    }
+
+    progInfo.windDirection = glm::vec3( header->windDirection[ 0 ], header->windDirection[ 1 ],
+                                        header->windDirection[ 2 ] );
+    progInfo.windForce = header->windForce;
+    progInfo.depthMode = header->depthMode;
+
+    return !progInfo.modelVector.empty( );
+}
+
+// free function implementation /////////////
+
+static SceneString AddString( std::string& strings, const std::string& text )
+{
+    SceneString record;
+
+    record.offset = strings.size( );
+    record.length = text.size( );
+
+    strings.append( text );
+
+    return record;
+}
+
+static bool InFile( const SceneHeader& header, uint32_t offset, uint32_t count,
+                    size_t recordSize )
+{
+    return offset >= sizeof( ScenePrefix ) + sizeof( SceneHeader ) && offset % 4 == 0 &&
+           ( uint64_t ) offset + ( uint64_t ) count * recordSize <= header.fileSize;
+}
+
+static bool GetString( const char *strings, const SceneHeader& header,
+                       const SceneString& text, std::string& out )
+{
+    if( ( uint64_t ) text.offset + text.length > header.stringSize )
+    {
+        return false;
+    }
+
+    out.assign( strings + text.offset, text.length );
+
+    return true;
+}
+
+template <typename Record>
+static void AppendRecords( std::string& file, const std::vector<Record>& records )
+{
+    if( !records.empty( ) )
+    {
+        file.append( ( const char* ) &records[ 0 ], records.size( ) * sizeof( Record ) );
+    }
+}
+
+// mapped file implementation /////////////
+
+bool MappedFile::open( const std::string& fileName )
+{
+    close( );
+
+#if defined( _WIN64 ) || defined( _WIN32 )
+    LARGE_INTEGER fileSize;
+
+    file = CreateFileA( fileName.c_str( ), GENERIC_READ, FILE_SHARE_READ, NULL,
+                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+
+    if( file == INVALID_HANDLE_VALUE || !GetFileSizeEx( file, &fileSize ) || fileSize.QuadPart == 0 )
+    {
+        close( );
+        return false;
+    }
+
+    mapping = CreateFileMappingA( file, NULL, PAGE_READONLY, 0, 0, NULL );
+
+    if( mapping == NULL )
+    {
+        close( );
+        return false;
+    }
+
+    data = ( const char* ) MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+    size = ( size_t ) fileSize.QuadPart;
+#else
+    struct stat fileInfo;
+    void *view;
+    int descriptor;
+
+    descriptor = ::open( fileName.c_str( ), O_RDONLY );
+
+    if( descriptor < 0 )
+    {
+        return false;
+    }
+
+    if( fstat( descriptor, &fileInfo ) != 0 || fileInfo.st_size == 0 )
+    {
+        ::close( descriptor );
+        return false;
+    }
+
+    view = mmap( NULL, fileInfo.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0 );
+
+    //the mapping keeps the file open
+    ::close( descriptor );
+
+    if( view != MAP_FAILED )
+    {
+        data = ( const char* ) view;
+        size = fileInfo.st_size;
+    }
+#endif
+
+    return data != NULL;
+}
+
+void MappedFile::close( )
+{
+#if defined( _WIN64 ) || defined( _WIN32 )
+    if( data != NULL )
+    {
+        UnmapViewOfFile( data );
+    }
+
+    if( mapping != NULL )
+    {
+        CloseHandle( mapping );
+    }
+
+    if( file != INVALID_HANDLE_VALUE )
+    {
+        CloseHandle( file );
+    }
+
+    file = INVALID_HANDLE_VALUE;
+    mapping = NULL;
+#else
+    if( data != NULL )
+    {
+        munmap( ( void* ) data, size );
+    }
+#endif
+
+    data = NULL;
+    size = 0;
+}
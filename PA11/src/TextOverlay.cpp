@@ -0,0 +1,212 @@
+#include "TextOverlay.h"
+#include "RenderStats.h"
+#include "GLDebug.h"
+#include <algorithm>
+#include <sstream>
+
+//opencv
+#include <opencv2/core/core.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+TextOverlay::TextOverlay( )
+{
+    VB = 0;
+    IB = 0;
+    texture = 0;
+    textUniLoc = -1;
+
+    shown = false;
+}
+
+TextOverlay::~TextOverlay( )
+{
+    if( VB != 0 )
+    {
+        glDeleteBuffers( 1, &VB );
+        glDeleteBuffers( 1, &IB );
+        glDeleteTextures( 1, &texture );
+    }
+}
+
+// INITIALIZE //////////////////
+/***************************************
+
+@brief Initialize
+
+@details makes the quad's buffers and the empty texture
+
+@param None
+
+@notes the quad spans 0 to 1 across and 0 to -1 down, so its corner
+       sits at the window's top left once getModel places it
+
+***************************************/
+bool TextOverlay::Initialize( )
+{
+    Vertex vertices[ 4 ] = { Vertex( glm::vec3( 0.0f, 0.0f, 0.0f ), glm::vec2( 0.0f, 0.0f ), glm::vec3( 0.0f, 0.0f, 1.0f ) ),
+                             Vertex( glm::vec3( 0.0f, -1.0f, 0.0f ), glm::vec2( 0.0f, 1.0f ), glm::vec3( 0.0f, 0.0f, 1.0f ) ),
+                             Vertex( glm::vec3( 1.0f, -1.0f, 0.0f ), glm::vec2( 1.0f, 1.0f ), glm::vec3( 0.0f, 0.0f, 1.0f ) ),
+                             Vertex( glm::vec3( 1.0f, 0.0f, 0.0f ), glm::vec2( 1.0f, 0.0f ), glm::vec3( 0.0f, 0.0f, 1.0f ) ) };
+    unsigned int indices[ 6 ] = { 0, 1, 2, 0, 2, 3 };
+
+    glGenBuffers( 1, &VB );
+    glBindBuffer( GL_ARRAY_BUFFER, VB );
+    glBufferData( GL_ARRAY_BUFFER, sizeof( vertices ), vertices, GL_STATIC_DRAW );
+
+    GL_LABEL( GL_BUFFER, VB, "Text overlay vertices" );
+
+    glGenBuffers( 1, &IB );
+    glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, IB );
+    glBufferData( GL_ELEMENT_ARRAY_BUFFER, sizeof( indices ), indices, GL_STATIC_DRAW );
+
+    GL_LABEL( GL_BUFFER, IB, "Text overlay indices" );
+
+    glGenTextures( 1, &texture );
+
+    glBindTexture( GL_TEXTURE_2D, texture );
+
+    glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA, TEXTURE_WIDTH, TEXTURE_HEIGHT, 0,
+                  GL_BGRA, GL_UNSIGNED_BYTE, NULL );
+
+    //drawn a texel to a pixel
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
+
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
+
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+
+    GL_LABEL( GL_TEXTURE, texture, "Text overlay" );
+
+    setText( "" );
+
+    return true;
+}
+
+// SET TEXT //////////////////
+/***************************************
+
+@brief setText
+
+@details draws the lines of the text and uploads them
+
+@param in: text: lines split by newlines
+
+@notes the lines that do not fit are left out
+
+***************************************/
+void TextOverlay::setText( const std::string& text )
+{
+    std::stringstream lines( text );
+    std::string line;
+    int row = 0;
+
+    //a dark, see through backing in BGRA
+    cv::Mat image( TEXTURE_HEIGHT, TEXTURE_WIDTH, CV_8UC4, cv::Scalar( 0, 0, 0, 160 ) );
+
+    if( texture == 0 )
+    {
+        return;
+    }
+
+    while( std::getline( lines, line ) && ( row + 1 ) * LINE_HEIGHT <= TEXTURE_HEIGHT )
+    {
+        cv::putText( image, line, cv::Point( 6, ( ( row + 1 ) * LINE_HEIGHT ) - 2 ),
+                     cv::FONT_HERSHEY_PLAIN, 1.0, cv::Scalar( 255, 255, 255, 255 ) );
+
+        row++;
+    }
+
+    glBindTexture( GL_TEXTURE_2D, texture );
+
+    glTexSubImage2D( GL_TEXTURE_2D, 0, 0, 0, TEXTURE_WIDTH, TEXTURE_HEIGHT,
+                     GL_BGRA, GL_UNSIGNED_BYTE, image.data );
+}
+
+// RENDER //////////////////
+/***************************************
+
+@brief Render
+
+@details draws the quad with the text
+
+@param None
+
+@notes the caller sets the model matrix from getModel, identity view
+       and projection matrices and the unlit object type
+
+***************************************/
+void TextOverlay::Render( )
+{
+    if( VB == 0 )
+    {
+        return;
+    }
+
+    glEnableVertexAttribArray( 0 );
+    glEnableVertexAttribArray( 1 );
+    glEnableVertexAttribArray( 2 );
+
+    glBindBuffer( GL_ARRAY_BUFFER, VB );
+    glVertexAttribPointer( 0, 3, GL_FLOAT, GL_FALSE, sizeof( Vertex ), 0 );
+    glVertexAttribPointer( 1, 2, GL_FLOAT, GL_FALSE, sizeof( Vertex ),
+                           ( void* ) offsetof( Vertex, uv ) );
+    glVertexAttribPointer( 2, 3, GL_FLOAT, GL_FALSE, sizeof( Vertex ),
+                           ( void* ) offsetof( Vertex, normal ) );
+
+    glUniform1i( textUniLoc, 0 );
+    glActiveTexture( GL_TEXTURE0 );
+    glBindTexture( GL_TEXTURE_2D, texture );
+
+    glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, IB );
+
+    glDrawElements( GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0 );
+
+    RenderStats::addDraw( 6 );
+
+    glDisableVertexAttribArray( 0 );
+    glDisableVertexAttribArray( 1 );
+    glDisableVertexAttribArray( 2 );
+}
+
+// GET MODEL //////////////////
+/***************************************
+
+@brief getModel
+
+@details returns the matrix that puts the quad in the window's top left
+         corner at a texel per pixel
+
+@param in: screenWidth: the viewport's width in pixels
+
+@param in: screenHeight: the viewport's height in pixels
+
+@notes the matrix goes straight to clip space
+
+***************************************/
+glm::mat4 TextOverlay::getModel( int screenWidth, int screenHeight ) const
+{
+    glm::mat4 model;
+
+    model = glm::translate( glm::mat4( 1.0f ), glm::vec3( -1.0f, 1.0f, 0.0f ) );
+
+    return glm::scale( model, glm::vec3( 2.0f * TEXTURE_WIDTH / ( float ) std::max( screenWidth, 1 ),
+                                         2.0f * TEXTURE_HEIGHT / ( float ) std::max( screenHeight, 1 ),
+                                         1.0f ) );
+}
+
+GLint& TextOverlay::TextureUniformLocation( )
+{
+    return textUniLoc;
+}
+
+void TextOverlay::toggleShown( )
+{
+    shown = !shown;
+}
+
+bool TextOverlay::isShown( ) const
+{
+    return shown;
+}
@@ -1,4 +1,8 @@
 #include "camera.h"
+#include <cmath>
+
+const float Camera::NEAR_PLANE = 0.015f;
+const float Camera::FAR_PLANE = 6000.0f;
 
 Camera::Camera()
 {
@@ -7,6 +11,7 @@ Camera::Camera()
 	zoom = 150.0;
 	upDown = 0.0;
 	
+    depthMode = DEPTH_STANDARD;
 }
 
 Camera::~Camera()
@@ -14,7 +19,7 @@ Camera::~Camera()
 
 }
 
-bool Camera::Initialize(int w, int h)
+bool Camera::Initialize(int w, int h, int depth)
 {
     //--Init the view and projection matrices
     //    if you will be having a moving camera the view matrix will need to more dynamic
@@ -25,14 +30,14 @@ bool Camera::Initialize(int w, int h)
     upDown = 0.0;
     zoom = 255.0;
     topDown = false;
-    view = glm::lookAt( glm::vec3( leftRight, 40  + upDown, zoom ), //Eye Position
-                        glm::vec3( 0.0, 0.0, 0.0 ), //Focus point
-                        glm::vec3( 0.0, 1.0, 0.0 ) ); //Positive Y is up
+    setView( glm::dvec3( leftRight, 40  + upDown, zoom ), //Eye Position
+             glm::dvec3( 0.0, 0.0, 0.0 ), //Focus point
+             glm::vec3( 0.0, 1.0, 0.0 ) ); //Positive Y is up
+
+    depthMode = depth;
+
+    changePerspective( w, h );
 
-    projection = glm::perspective( 45.0f, //the FoV typically 90 degrees is good which is what this is set to
-                                   float(w)/float(h), //Aspect Ratio, so Circles stay Circular
-                                   0.015f, //Distance to the near plane, normally a small value like this
-                                   6000.0f); //Distance to the far plane, 
     return true;
 }
 
@@ -43,9 +48,9 @@ void Camera::LookTopDown()
     upDown = 0.0;
     zoom = 150.0;
     topDown = true;
-    view = glm::lookAt( glm::vec3( 0.0, zoom, 0.0), //Eye Position
-                                   glm::vec3( leftRight, 0.0, upDown), //Focus point
-                                   glm::vec3(0.0, 0.0, 1.0)); //Positive Y is up
+    setView( glm::dvec3( 0.0, zoom, 0.0), //Eye Position
+             glm::dvec3( leftRight, 0.0, upDown), //Focus point
+             glm::vec3(0.0, 0.0, 1.0)); //Positive Y is up
 
 }
 
@@ -55,9 +60,9 @@ void Camera::LookSideToSide()
     upDown = 0.0;
     zoom = 255.0;
     topDown = false;
-    view = glm::lookAt( glm::vec3( 0.0, 147.22, zoom), //Eye Position
-                                   glm::vec3( leftRight, upDown, 0.0), //Focus point
-                                   glm::vec3(0.0, 1.0, 0.0)); //Positive Y is up
+    setView( glm::dvec3( 0.0, 147.22, zoom), //Eye Position
+             glm::dvec3( leftRight, upDown, 0.0), //Focus point
+             glm::vec3(0.0, 1.0, 0.0)); //Positive Y is up
 
 }
 
@@ -72,9 +77,9 @@ void Camera::moveLeft()
       leftRight = leftRight - 1.0;
    }
 
-   view = glm::lookAt( glm::vec3( leftRight, 40 + upDown, 255 ), //Eye Position
-                       glm::vec3( 0.0, 0.0, 0.0 ), //Focus point
-                       glm::vec3( 0.0, 1.0, 0.0 ) ); //Positive Y is up
+   setView( glm::dvec3( leftRight, 40 + upDown, 255 ), //Eye Position
+            glm::dvec3( 0.0, 0.0, 0.0 ), //Focus point
+            glm::vec3( 0.0, 1.0, 0.0 ) ); //Positive Y is up
 }
 void Camera::moveRight()
 {
@@ -87,23 +92,23 @@ void Camera::moveRight()
       leftRight = leftRight + 1.0;
    }
 
-   view = glm::lookAt( glm::vec3( leftRight, 40 + upDown, 255 ), //Eye Position
-                       glm::vec3( 0.0, 0.0, 0.0 ), //Focus point
-                       glm::vec3( 0.0, 1.0, 0.0 ) ); //Positive Y is up
+   setView( glm::dvec3( leftRight, 40 + upDown, 255 ), //Eye Position
+            glm::dvec3( 0.0, 0.0, 0.0 ), //Focus point
+            glm::vec3( 0.0, 1.0, 0.0 ) ); //Positive Y is up
 }
 void Camera::moveUp()
 {
    upDown = upDown + 1.0;
-   view = glm::lookAt( glm::vec3( leftRight, 40 + upDown, zoom ), //Eye Position
-                       glm::vec3( 0.0, 0.0, 0.0 ), //Focus point
-                       glm::vec3( 0.0, 1.0, 0.0 ) ); //Positive Y is up
+   setView( glm::dvec3( leftRight, 40 + upDown, zoom ), //Eye Position
+            glm::dvec3( 0.0, 0.0, 0.0 ), //Focus point
+            glm::vec3( 0.0, 1.0, 0.0 ) ); //Positive Y is up
 }
 void Camera::moveDown()
 {
    upDown = upDown - 1.0;
-   view = glm::lookAt( glm::vec3( leftRight, 40 + upDown, zoom ), //Eye Position
-                       glm::vec3( 0.0, 0.0, 0.0 ), //Focus point
-                       glm::vec3( 0.0, 1.0, 0.0 ) ); //Positive Y is up
+   setView( glm::dvec3( leftRight, 40 + upDown, zoom ), //Eye Position
+            glm::dvec3( 0.0, 0.0, 0.0 ), //Focus point
+            glm::vec3( 0.0, 1.0, 0.0 ) ); //Positive Y is up
 }
 
 void Camera::zoomIn()
@@ -127,9 +132,9 @@ void Camera::resetView( )
 {
     upDown = 0.0f;
     leftRight = 0.0f;
-    view = glm::lookAt( glm::vec3( leftRight, 147.22 + upDown, zoom ), //Eye Position
-                        glm::vec3( 0.0, 0.0, 0.0 ), //Focus point
-                        glm::vec3( 0.0, 1.0, 0.0 ) ); //Positive Y is up
+    setView( glm::dvec3( leftRight, 147.22 + upDown, zoom ), //Eye Position
+             glm::dvec3( 0.0, 0.0, 0.0 ), //Focus point
+             glm::vec3( 0.0, 1.0, 0.0 ) ); //Positive Y is up
 }
 
 void Camera::followShip( glm::vec3 shipPosition, glm::vec3 cameraPosition, glm::vec3 leftView, glm::vec3 rightView, int viewSelect )
@@ -149,24 +154,24 @@ void Camera::followShip( glm::vec3 shipPosition, glm::vec3 cameraPosition, glm::
 		focalPoint = shipPosition;
 	}
 
-	view = glm::lookAt( cameraPosition, //Eye Position
-						focalPoint, //Focus point
-						glm::vec3( 0.0, 1.0, 0.0 ) ); //Positive Y is up
+	setView( glm::dvec3( cameraPosition ), //Eye Position
+			 glm::dvec3( focalPoint ), //Focus point
+			 glm::vec3( 0.0, 1.0, 0.0 ) ); //Positive Y is up
 }
 
 void Camera::updateLookAt()
 {
    if( topDown )
    {
-      view = glm::lookAt( glm::vec3( leftRight, zoom, upDown), //Eye Position
-                                   glm::vec3( leftRight, 0.0, upDown), //Focus point
-                                   glm::vec3(0.0, 0.0, 1.0)); //Positive Y is up
+      setView( glm::dvec3( leftRight, zoom, upDown), //Eye Position
+               glm::dvec3( leftRight, 0.0, upDown), //Focus point
+               glm::vec3(0.0, 0.0, 1.0)); //Positive Y is up
    }
    else
    {
-      view = glm::lookAt( glm::vec3( leftRight, 8.0 + upDown, zoom), //Eye Position
-                                   glm::vec3( leftRight, upDown, 0.0), //Focus point
-                                   glm::vec3(0.0, 1.0, 0.0)); //Positive Y is up
+      setView( glm::dvec3( leftRight, 8.0 + upDown, zoom), //Eye Position
+               glm::dvec3( leftRight, upDown, 0.0), //Focus point
+               glm::vec3(0.0, 1.0, 0.0)); //Positive Y is up
    }
 
 }
@@ -181,18 +186,18 @@ void Camera::updateCamera( bool isOn, glm::vec3 planet )
 	    leftRight = planet.x;
 	    newZoom = planet.y + zoom;
 	    upDown = planet.z;
-	     view = glm::lookAt( glm::vec3( leftRight, newZoom, upDown), //Eye Position
-                                  planet, //Focus point
-                                   glm::vec3(0.0, 0.0, 1.0)); //Positive Y is up
+	     setView( glm::dvec3( leftRight, newZoom, upDown), //Eye Position
+                  glm::dvec3( planet ), //Focus point
+                  glm::vec3(0.0, 0.0, 1.0)); //Positive Y is up
 	}
 	else
 	{
 	    leftRight = planet.x;
         upDown = planet.y + 50;
 	    newZoom = planet.z + 160;
-   	    view = glm::lookAt( glm::vec3( leftRight, upDown, newZoom), //Eye Position
-                                   planet, //Focus point
-                                   glm::vec3(0.0, 1.0, 0.0)); //Positive Y is up
+   	    setView( glm::dvec3( leftRight, upDown, newZoom), //Eye Position
+                 glm::dvec3( planet ), //Focus point
+                 glm::vec3(0.0, 1.0, 0.0)); //Positive Y is up
 	}
 
    }
@@ -212,17 +217,126 @@ glm::mat4 Camera::GetView()
 void Camera::rotate( glm::vec3 position, glm::vec4 whereToLook )
 {
    
-   view = glm::lookAt( glm::vec3( whereToLook.x + position.x, position.y, whereToLook.z + position.z), //Eye Position
-                       glm::vec3( whereToLook.x , whereToLook.y, whereToLook.z ), //Focus point
-                       glm::vec3( 0.0, 1.0, 0.0 ) ); //Positive Y is up
+   setView( glm::dvec3( whereToLook.x + position.x, position.y, whereToLook.z + position.z), //Eye Position
+            glm::dvec3( whereToLook.x , whereToLook.y, whereToLook.z ), //Focus point
+            glm::vec3( 0.0, 1.0, 0.0 ) ); //Positive Y is up
 }
 
 void Camera::changePerspective( int width, int height )
 {
     projection = glm::perspective( 45.0f, //the FoV typically 90 degrees is good which is what this is set to
                                    float(width)/float(height), //Aspect Ratio, so Circles stay Circular
-                                   0.015f, //Distance to the near plane, normally a small value like this
-                                   6000.0f); //Distance to the far plane, 
+                                   NEAR_PLANE, //Distance to the near plane, normally a small value like this
+                                   FAR_PLANE); //Distance to the far plane, 
+
+    //reversed z with no far plane, for a [0,1] clip range:
+    //depth = near / distance, so the precision follows the float's
+    if( depthMode == DEPTH_REVERSED )
+    {
+        projection[ 2 ] = glm::vec4( 0.0f, 0.0f, 0.0f, -1.0f );
+        projection[ 3 ] = glm::vec4( 0.0f, 0.0f, NEAR_PLANE, 0.0f );
+    }
+}
+
+// GET RELATIVE VIEW //////////////////
+/***************************************
+
+@brief GetRelativeView
+
+@details returns the view with the eye moved to the origin
+
+@param None
+
+@notes used with models rebased on GetEyePosition, so the large
+       translations stay out of the float matrices
+
+***************************************/
+glm::mat4 Camera::GetRelativeView()
+{
+    return relativeView;
+}
+
+glm::dvec3 Camera::GetEyePosition()
+{
+    return eyePosition;
+}
+
+// LOOK AT //////////////////
+/***************************************
+
+@brief lookAt
+
+@details points the camera from an eye position at a focus point
+
+@param in: eye: the eye position in the world
+
+@param in: focus: the focus point in the world
+
+@notes positive y is up
+
+***************************************/
+void Camera::lookAt( const glm::dvec3& eye, const glm::dvec3& focus )
+{
+    setView( eye, focus, glm::vec3( 0.0f, 1.0f, 0.0f ) );
+}
+
+int Camera::getDepthMode()
+{
+    return depthMode;
+}
+
+// GET LOG DEPTH COEFFICIENT //////////////////
+/***************************************
+
+@brief getLogDepthCoefficient
+
+@details returns the scale the shaders use for a logarithmic depth
+
+@param None
+
+@notes 0 unless the depth mode is DEPTH_LOGARITHMIC, which the shaders
+       take to mean the normal depth
+
+***************************************/
+float Camera::getLogDepthCoefficient()
+{
+    if( depthMode != DEPTH_LOGARITHMIC )
+    {
+        return 0.0f;
+    }
+
+    return 2.0f / log2( FAR_PLANE + 1.0f );
 }
 
+// SET VIEW //////////////////
+/***************************************
+
+@brief setView
+
+@details sets the view and the camera relative view from one look at
+
+@param in: eye: the eye position in the world
+
+@param in: focus: the focus point in the world
+
+@param in: up: the up direction
 
+@notes the direction is taken in double precision, so the relative
+       view does not lose the eye's offset from the focus
+
+***************************************/
+void Camera::setView( const glm::dvec3& eye, const glm::dvec3& focus, const glm::vec3& up )
+{
+    glm::dvec3 direction = focus - eye;
+
+    eyePosition = eye;
+
+    relativeView = glm::lookAt( glm::vec3( 0.0f ),
+                                glm::vec3( ( float ) direction.x, ( float ) direction.y,
+                                           ( float ) direction.z ),
+                                up );
+
+    view = glm::lookAt( glm::vec3( ( float ) eye.x, ( float ) eye.y, ( float ) eye.z ),
+                        glm::vec3( ( float ) focus.x, ( float ) focus.y, ( float ) focus.z ),
+                        up );
+}
@@ -1,7 +1,10 @@
 #include "graphics.h"
+#include "RenderStats.h"
+#include "Logger.h"
 #include <algorithm>
 #include <sstream>
 #include <random>
+#include <chrono>
 
 const float ShipController::MAX_SPEED = 4.11f;
 const float ShipController::MAX_ROT = 2.5f;
@@ -11,6 +14,8 @@ const float ShipController::STD_TORQUE = 1.05f;
 const float ShipController::CAMERA_FOLLOW_DISTANCE = 60;
 const float ShipController::CAMERA_FOLLOW_HEIGHT = 25;
 
+const float Graphics::IMPACT_GAIN = 0.6f;
+
 
 //physics related callbacks
 namespace ccb
@@ -51,29 +56,32 @@ namespace ccb
         btScalar speed;
         btScalar angSpeed;
 
+        //only the sailing motion is limited, the buoyancy moves the ships freely
+        //up and down and lets them pitch and roll
         for( index = 0; index < shipReg.size( ); index++ )
         {
             if( shipReg[ index ].shipPtr != NULL )
             {
                 velocity = shipReg[ index ].shipPtr->getLinearVelocity( );
 
-                speed = velocity.length( );
+                speed = btVector3( velocity.getX( ), 0.0f, velocity.getZ( ) ).length( );
 
                 if( speed > shipReg[ index ].maxSpeed 
                     && shipReg[ index ].maxSpeed >= 0.0f )
                 {
-                    velocity *= shipReg[ index ].maxSpeed / speed;
+                    velocity.setX( velocity.getX( ) * shipReg[ index ].maxSpeed / speed );
+                    velocity.setZ( velocity.getZ( ) * shipReg[ index ].maxSpeed / speed );
                     shipReg[ index ].shipPtr->setLinearVelocity( velocity );
                 }
 
                 angVelocity = shipReg[ index ].shipPtr->getAngularVelocity( );
 
-                angSpeed = angVelocity.length( );
+                angSpeed = btFabs( angVelocity.getY( ) );
 
                 if( angSpeed > shipReg[ index ].maxAngSpeed 
                     && shipReg[ index ].maxAngSpeed >= 0.0f )
                 {
-                    angVelocity *= shipReg[ index ].maxAngSpeed / angSpeed;
+                    angVelocity.setY( angVelocity.getY( ) * shipReg[ index ].maxAngSpeed / angSpeed );
                     shipReg[ index ].shipPtr->setAngularVelocity( angVelocity );
                 }
             }			
@@ -103,7 +111,7 @@ namespace ccb
             {
                 *scorePtr += 1;
 
-                std::cout << "Score: " << *scorePtr << std::endl;
+                LOG_INFO( "Score: " << *scorePtr );
             }
 
             return 0;
@@ -157,13 +165,18 @@ Graphics::Graphics()
     solverPtr = NULL;
     dynamicsWorldPtr = NULL;
 
-    
+    physicsTime = 0.0;
+
+    metricsMillis = 0.0;
+    metricsSeconds = 0.0;
 
     boxIndex = -1;
     ballIndex = 0;
     modelIndex = 0;
 
     shaderSelect = 0;
+    variantSelect = -1;
+    viewPassCount = 0;
     playingStateFlag = false;
     returnBall = false;
     rightPaddleUp = false;
@@ -186,12 +199,22 @@ Graphics::Graphics()
     gameStarted = false;
 
     splitScreen = false;
+
+    cannonSound = -1;
+
+    cumultiveTime = 0;
+    waveTime = 0.0f;
+
+    depthMode = Camera::DEPTH_STANDARD;
 }
 
 Graphics::~Graphics()
 {
     unsigned int index = 0;
 
+    //a model being read is finished first
+    hotReload.stop( );
+
     if( dynamicsWorldPtr != NULL )
     {
         for( index = 0; index < objectRegistry.getSize( ); index++ )
@@ -269,11 +292,6 @@ Graphics::~Graphics()
 
         broadphasePtr = NULL;
     }
-
-    while( objectCollidedSound.SoundPlaying( ) )
-    {
-        //wait for sound to finish
-    }
 }
 
 bool Graphics::Initialize
@@ -302,11 +320,22 @@ bool Graphics::Initialize
         }
     #endif
 
+    //debug builds only, release builds do not check for GL errors
+    GLDebug::Initialize( );
+
     // For OpenGL 3
     GLuint vao;
     glGenVertexArrays(1, &vao);
     glBindVertexArray(vao);
 
+    GL_LABEL( GL_VERTEX_ARRAY, vao, "Graphics VAO" );
+
+    //the GPU times stay 0 without timer queries
+    gpuTimer.Initialize( );
+
+    //without program binaries every program is compiled each run
+    Shader::InitializeCache( "shadercache" );
+
     bool successFlag;
     unsigned int index, pIndex, sIndex;
 
@@ -324,8 +353,6 @@ bool Graphics::Initialize
     btVector3 inertia;
     btTransform transform;
 
-    std::vector<TextureUnit> textReg;
-
     btTriangleMesh* trimesh = NULL;
     glm::vec3 tmpVec;
 
@@ -367,9 +394,24 @@ bool Graphics::Initialize
     m_camera.resize( 2 );
     cameraTracking = false;
 
+    depthMode = progInfo.depthMode;
+
+    //reversed z needs the [0,1] clip range of GL 4.5
+    #if defined(__APPLE__) || defined(MACOSX)
+        if( depthMode == Camera::DEPTH_REVERSED )
+    #else
+        if( depthMode == Camera::DEPTH_REVERSED && !GLEW_ARB_clip_control )
+    #endif
+    {
+        std::cout << "Reversed depth is not supported, using a logarithmic depth"
+                  << std::endl;
+
+        depthMode = Camera::DEPTH_LOGARITHMIC;
+    }
+
     for( index = 0; index < 2; index++ )
     {
-        if( !m_camera[ index ].Initialize( width, height ) )
+        if( !m_camera[ index ].Initialize( width, height, depthMode ) )
         {
             printf( "Camera Failed to Initialize\n" );
             return false;
@@ -378,7 +420,7 @@ bool Graphics::Initialize
     
     score = 0;
 
-    objectCollidedSound.loadSound("sounds/Canon_Fire.wav");
+    cannonSound = objectCollidedSound.loadSound("sounds/Canon_Fire.wav");
 
     modelRegistry.clear( );
 
@@ -389,7 +431,7 @@ bool Graphics::Initialize
         modelRegistry[ modelRegistry.size( ) - 1 ].modelPath = progInfo.modelVector[ index ];
 
         successFlag = modelRegistry[ modelRegistry.size( ) - 1 ]
-                        .objModel.loadModelFromFile( progInfo.modelVector[ index ], &textReg );
+                        .objModel.loadModelFromFile( progInfo.modelVector[ index ], &textureRegistry );
         
 
         if( !successFlag )
@@ -584,6 +626,8 @@ bool Graphics::Initialize
             return false;
         }
 
+        setProgramDefines( shaderRegistry[ sIndex ] );
+
         for( index = 0; index < progInfo.shaderVector[ sIndex ].size( ); index++ )
         {
             if( !shaderRegistry[ sIndex ].AddShader( progInfo.shaderVector[ sIndex ][ index ].first, 
@@ -601,6 +645,17 @@ bool Graphics::Initialize
             }
         }
 
+        //each program is linked before any is waited on, so the driver
+        //can build them in parallel
+        if( !shaderRegistry[ sIndex ].Link( ) )
+        {
+            printf( "Program failed to Link\n" );
+            return false;
+        }
+    }
+
+    for( sIndex = 0; sIndex < shaderRegistry.size( ); sIndex++ )
+    {
         if( !shaderRegistry[ sIndex ].Finalize( ) )
         {
             printf( "Program to Finalize\n" );
@@ -614,12 +669,76 @@ bool Graphics::Initialize
         return false;
     }
 
+    //the ocean grid sits at the top of the ocean model
+    for( index = 0; index < objectRegistry.getSize( ); index++ )
+    {
+        if( objectRegistry[ index ].getName( ) == "ocean" 
+            && objectRegistry[ index ].hasObjectModel( ) )
+        {
+            tmpVec = glm::vec3( 0.0f );
+
+            for( sIndex = 0; 
+                 sIndex < objectRegistry[ index ].getObjectModel( ).getVertices( ).size( ); 
+                 sIndex++ )
+            {
+                tmpVec.y = std::max( tmpVec.y, 
+                                     objectRegistry[ index ].getObjectModel( ).getVertices( )[ sIndex ].vertex.y );
+            }
+
+            tmpVec.y = ( tmpVec.y * objectRegistry[ index ].getScale( ).y ) 
+                       + objectRegistry[ index ].getTransVec( ).y;
+
+            if( !oceanGrid.Initialize( tmpVec.y ) )
+            {
+                std::cout << "Ocean grid failed to initialize" << std::endl;
+                return false;
+            }
+        }
+    }
+
+    //frame statistics, F12 shows them
+    if( !overlay.Initialize( ) )
+    {
+        std::cout << "The metrics overlay failed to initialize" << std::endl;
+        return false;
+    }
+
+    frameMetric = metrics.addHistogram( "Frame ms" );
+    drawCallMetric = metrics.addGauge( "Draw calls" );
+    triangleMetric = metrics.addGauge( "Triangles" );
+    culledMetric = metrics.addGauge( "Culled objects" );
+    contactMetric = metrics.addGauge( "Contacts" );
+    substepMetric = metrics.addGauge( "Substeps" );
+    physicsMetric = metrics.addGauge( "Physics ms", 2 );
+    gpuMetric = metrics.addGauge( "GPU ms", 2 );
+    hitMetric = metrics.addCounter( "Hits" );
+
+#ifdef PROFILER
+    updateMetric = metrics.addGauge( "Update ms", 2 );
+    renderMetric = metrics.addGauge( "Render ms", 2 );
+#endif
+
+    if( !progInfo.metricsFile.empty( ) )
+    {
+        metrics.startDump( progInfo.metricsFile );
+    }
+
     //enable depth testing
     glEnable(GL_DEPTH_TEST);
     glEnable( GL_CULL_FACE );
     glCullFace( GL_BACK );
     glDepthFunc(GL_LESS);   
 
+    if( depthMode == Camera::DEPTH_REVERSED )
+    {
+        #if !defined(__APPLE__) && !defined(MACOSX)
+            glClipControl( GL_LOWER_LEFT, GL_ZERO_TO_ONE );
+        #endif
+
+        glClearDepth( 0.0 );
+        glDepthFunc( GL_GREATER );
+    }
+
     // INITIALIZE BULLET //////////////////////////////////////////////
     broadphasePtr = new btDbvtBroadphase( );
 
@@ -670,8 +789,13 @@ bool Graphics::Initialize
 
             tmpRigidBody = new btRigidBody( rigidBodyConstruct );
 
-            tmpRigidBody->setLinearFactor( btVector3( 1, 0, 1 ) );
-            tmpRigidBody->setAngularFactor( btVector3( 0, 1, 0 ) );
+            //float at the height the ship is placed at in the config
+            buoyancy.addShip( tmpRigidBody, 
+                              btVector3( objectRegistry[ index ].getBScale( ).x + 1, 
+                                         objectRegistry[ index ].getBScale( ).y + 1, 
+                                         objectRegistry[ index ].getBScale( ).z + 1 ),
+                              mass, 
+                              objectRegistry[ index ].getTransVec( ).y - oceanGrid.getSeaLevel( ) );
 
             tmpRigidBody->setCollisionFlags( tmpRigidBody->getCollisionFlags( ) | btCollisionObject::CF_CUSTOM_MATERIAL_CALLBACK );
 
@@ -685,8 +809,10 @@ bool Graphics::Initialize
         {
             tmpCompoundShape = new btCompoundShape( );
 
+            //the ships float on the buoyancy solver, the plane is only a floor
+            //far enough down that a pitching hull never touches it
             transform.setIdentity( );
-            transform.setOrigin( btVector3( 0, -1 * objectRegistry[ index ].getBScale( ).y / 2, 0 ) );
+            transform.setOrigin( btVector3( 0, -1 * objectRegistry[ index ].getBScale( ).y, 0 ) );
 
             tmpShapePtr = new btStaticPlaneShape( btVector3( 0, 1, 0 ), 10 );
 
@@ -778,6 +904,12 @@ bool Graphics::Initialize
 
     dynamicsWorldPtr->setInternalTickCallback( ccb::TickCallback );
 
+    //the buoyancy solver is the world's user info, set after the post tick
+    //callback since both calls overwrite it
+    buoyancy.setOcean( &oceanHeightMap, oceanGrid.getSeaLevel( ) );
+
+    dynamicsWorldPtr->setInternalTickCallback( BuoyancySolver::PreTickCallback, &buoyancy, true );
+
 
     for( sIndex = 0; sIndex < shipRegistry.size( ); sIndex++ )
     {
@@ -794,6 +926,14 @@ bool Graphics::Initialize
         }
     }
 
+    //the scene is kept to tell which of its values a reload changed
+    if( progInfo.watchFiles )
+    {
+        sceneConfig = progInfo;
+
+        hotReload.start( progInfo.configFile, progInfo.shaderVector, progInfo.modelVector );
+    }
+
 
     return true;
 }
@@ -801,19 +941,47 @@ bool Graphics::Initialize
 void Graphics::Update( unsigned int dt )
 {
     int lookAt = 0;
+    int substeps, contacts;
     unsigned int index, stop;
+    glm::mat4 listenerViews[ Sound::MAX_LISTENERS ];
+    std::chrono::steady_clock::time_point physicsStart;
+
+    PROFILE_ZONE( "Update" );
 
-    float cameraWaveDifference = 0.0f;
-    float time;
+    //advance the wave clock once per frame, the swell repeats after a full cycle
+    cumultiveTime = ( cumultiveTime + dt ) % 1000000;
+    waveTime = cumultiveTime;
+    waveTime /= 1000000.0f;
 
     //apply control forces on the ship
     applyShipForces( dt );
 
+    physicsTime = 0.0;
+
     if( playingStateFlag )
     {
+        PROFILE_ZONE( "Bullet step" );
+
+        physicsStart = std::chrono::steady_clock::now( );
+
+        buoyancy.setTime( waveTime );
+
+        substeps = dynamicsWorldPtr->stepSimulation( dt, 10 );
 
-        dynamicsWorldPtr->stepSimulation( dt, 10 );
+        physicsTime = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now( )
+                                                                 - physicsStart ).count( );
+
+        //the contact points Bullet kept after the step
+        contacts = 0;
+
+        for( index = 0; index < ( unsigned int ) dispatcherPtr->getNumManifolds( ); index++ )
+        {
+            contacts += dispatcherPtr->getManifoldByIndexInternal( index )->getNumContacts( );
+        }
 
+        metrics.set( substepMetric, substeps );
+        metrics.set( contactMetric, contacts );
+        metrics.set( physicsMetric, physicsTime );
     }
     else if( activeIdleState )
     {
@@ -821,16 +989,22 @@ void Graphics::Update( unsigned int dt )
     }
 
     // Update the objects
-    for( index = 0; index < objectRegistry.getSize( ); index++ )
     {
-        if( !objectRegistry[ index ].isChild( ) )
+        PROFILE_ZONE( "Scene graph" );
+
+        for( index = 0; index < objectRegistry.getSize( ); index++ )
         {
-            updateChildren( index, dt );
-        }        
+            if( !objectRegistry[ index ].isChild( ) )
+            {
+                updateChildren( index, dt );
+            }        
+        }
     }
 
     if( playingStateFlag )
     {
+        PROFILE_ZONE( "Camera" );
+
         //put camera stuff here /////////////////////////////////////////////////////////////////////
 
         if( splitScreen )
@@ -858,41 +1032,10 @@ void Graphics::Update( unsigned int dt )
             }
 
 
-            //wave viewing effect
-
-            srand( cumultiveTime );
-            time = ( float ) ( ( rand( ) % 1500 ) + 2500 );
-
-            if( shipRegistry[ index ].waveCycle >= 0.0f && !shipRegistry[ index ].waveUp )
-            {
-                shipRegistry[ index ].waveCycle -= std::min( ( float ) dt / time, 0.25f );
-            }
-            else if( shipRegistry[ index ].waveCycle >= 1.0f && shipRegistry[ index ].waveUp )
-            {
-                shipRegistry[ index ].waveUp = false;
-            }
-            else if( shipRegistry[ index ].waveCycle <= 1.0f && shipRegistry[ index ].waveUp )
-            {
-                shipRegistry[ index ].waveCycle += std::min( ( float ) dt / time, 0.25f );
-            }
-            else if( shipRegistry[ index ].waveCycle <= 0.00f && !shipRegistry[ index ].waveUp )
-            {
-                shipRegistry[ index ].waveUp = true;
-                shipRegistry[ index ].waveCycle = 0.0f;
-            }
-
-
-            cameraWaveDifference = glm::smoothstep( 0.0f, 1.0f, shipRegistry[ index ].waveCycle );
-
-            objectRegistry[ shipRegistry[ index ].index ].setAngle( ( 0.5f - cameraWaveDifference ) * 0.0174533f );
-
             m_camera[ index ].followShip( glm::vec3( objectRegistry[ shipRegistry[ index ].index ].getPositionInWorld( ).x - 1.5,
                                                  objectRegistry[ shipRegistry[ index ].index ].getPositionInWorld( ).y + 8.5f,
                                                  objectRegistry[ shipRegistry[ index ].index ].getPositionInWorld( ).z + 3 ),
-                                      shipRegistry[ index ].cameraPosition
-                                      + glm::vec3( -0.15f * cameraWaveDifference,
-                                                   0.35f * cameraWaveDifference,
-                                                   0.12f * cameraWaveDifference ),
+                                      shipRegistry[ index ].cameraPosition,
                                       glm::vec3( shipRegistry[ index ].leftHit.getX( ),
                                                  shipRegistry[ index ].leftHit.getY( ),
                                                  shipRegistry[ index ].leftHit.getZ( ) ),
@@ -903,6 +1046,19 @@ void Graphics::Update( unsigned int dt )
         /////////////////////////////////////////////////////////////////////////////////////////////
     }
 
+    //hear the world from every camera on screen
+    listenerViews[ 0 ] = m_camera[ 0 ].GetView( );
+
+    if( splitScreen )
+    {
+        listenerViews[ 1 ] = m_camera[ 1 ].GetView( );
+    }
+
+    objectCollidedSound.setListeners( listenerViews, splitScreen ? 2 : 1 );
+
+    //let the audio device sleep once the mixer is quiet
+    objectCollidedSound.Update( );
+
 
     for( index = 0; index < shipRegistry.size( ); index++ )
     {
@@ -955,7 +1111,7 @@ void Graphics::Update( unsigned int dt )
 
         if( shipRegistry[ index ].healthPoints <= 0 )
         {
-            std::cout << "Player " << index + 1 << " loses!" << std::endl;
+            LOG_INFO( "Player " << index + 1 << " loses!" );
             playingStateFlag = false;
             activeIdleState = true;
             gameOverStep = true;
@@ -970,12 +1126,20 @@ void Graphics::Update( unsigned int dt )
 
 void Graphics::Render( unsigned int dt )
 {
-    unsigned int index;
+    unsigned int index, viewPass;
     int lightCode = -1;
-    float normedCTime;
 
     glm::vec4 tmpVec;
- 
+    glm::vec3 cameraPosition;
+    glm::dvec3 eye;
+    glm::mat4 oceanModel;
+    glm::mat4 identity( 1.0f );
+
+    PROFILE_ZONE( "Render" );
+
+    gpuTimer.beginFrame( );
+
+    RenderStats::reset( );
     
     //clear the screen
     glClearColor(0.5, 0.5, 0.5, 1.0);
@@ -983,139 +1147,100 @@ void Graphics::Render( unsigned int dt )
 
     for( int cameraIndex = 0; cameraIndex < 2; cameraIndex++)
     {        
+        PROFILE_ZONE( "Camera pass" );
 
-        objectRegistry[ shipRegistry[ cameraIndex ].skyIndex ].setRender( false );
-
-        // Start the correct program
-        shaderRegistry[ shaderSelect ].Enable( );
-
-        // Send in the projection and view to the shader
-        glUniformMatrix4fv(m_projectionMatrix, 1, GL_FALSE, glm::value_ptr(m_camera[cameraIndex].GetProjection())); 
-        glUniformMatrix4fv(m_viewMatrix, 1, GL_FALSE, glm::value_ptr(m_camera[cameraIndex].GetView()));
+        viewPass = ( cameraIndex == 0 ) ? GpuTimer::VIEW_1 : GpuTimer::VIEW_2;
+        gpuTimer.start( viewPass );
 
-        glUniform1i( m_numLights, ( GLint ) lights.size( ) );
-        glUniform1i( m_numSpotLights, ( GLint ) spotLight.size( ) );
-
-        cumultiveTime += dt;
-        normedCTime = cumultiveTime;
-        normedCTime /= 1000000.0f;
-
-        if( cumultiveTime > 1000000 )
-        {
-            cumultiveTime = 0;
-        }
+        objectRegistry[ shipRegistry[ cameraIndex ].skyIndex ].setRender( false );
 
-        glUniform1f( m_time, normedCTime );
+        //the first object's type picks the program, then its view uniforms are set
+        viewPassCount++;
+        lightCode = -1;
 
-    
+        //the world is drawn around this camera's eye
+        eye = m_camera[ cameraIndex ].GetEyePosition( );
+        cameraPosition = glm::vec3( ( float ) eye.x, ( float ) eye.y, ( float ) eye.z );
 
-        for( index = 0; 
-             index < std::min( numberOfLights, ( unsigned int )lights.size( ) ); 
-             index++ )
+        // Render the objects
         {
-            glUniform4f( lights[ index ].ambientLoc, lights[ index ].ambient.r, 
-                         lights[ index ].ambient.g, lights[ index ].ambient.b, 
-                         lights[ index ].ambient.a );
+            PROFILE_ZONE( "Objects" );
 
-            glUniform4f( lights[ index ].incomingLoc, lights[ index ].incoming.r, 
-                         lights[ index ].incoming.g, lights[ index ].incoming.b, 
-                         lights[ index ].incoming.a );
-        } 
+            gpuTimer.start( GpuTimer::OBJECTS );
 
-        for( index = 0; index < shipRegistry.size( ); index += 1 )
-        {
-            if( 2 * index > spotLight.size( ) || ( 2 * index ) + 1 > spotLight.size( ) )
+            for( index = 0; index < objectRegistry.getSize( ); index++ )
             {
-                std::cout << "Error: too few spotLights!" << std::endl;
-            }
-
-            tmpVec = glm::vec4( shipRegistry[ index ].rightHit.getX( ), 
-                                shipRegistry[ index ].rightHit.getY( ), 
-                                shipRegistry[ index ].rightHit.getZ( ), 1.0 );
-
-            glUniform4f( spotLight[ 2 * index ].followLoc, tmpVec.x,
-                         tmpVec.y + spotLight[ 2 * index ].spotHeight, tmpVec.z, 1.0 );
-
-            glUniform4f( spotLight[ 2 * index ].ambientLoc, spotLight[ 2 * index ].ambient.r,
-                         spotLight[ 2 * index ].ambient.g, spotLight[ 2 * index ].ambient.b,
-                         spotLight[ 2 * index ].ambient.a );
-
-            glUniform3f( spotLight[ 2 * index ].incomingLoc, spotLight[ 2 * index ].incoming.r,
-                         spotLight[ 2 * index ].incoming.g, spotLight[ 2 * index ].incoming.b );
-
-            glUniform1f( spotLight[ 2 * index ].cosineLoc, spotLight[ 2 * index ].cosine );
-
-            tmpVec = glm::vec4( shipRegistry[ index ].leftHit.getX( ),
-                                shipRegistry[ index ].leftHit.getY( ),
-                                shipRegistry[ index ].leftHit.getZ( ), 1.0 );
-
-            glUniform4f( spotLight[ ( 2 * index ) + 1 ].followLoc, tmpVec.x,
-                         tmpVec.y + spotLight[ ( 2 * index ) + 1 ].spotHeight, tmpVec.z, 1.0 );
-
-            glUniform4f( spotLight[ ( 2 * index ) + 1].ambientLoc, spotLight[ ( 2 * index ) + 1 ].ambient.r,
-                         spotLight[ ( 2 * index ) + 1].ambient.g, spotLight[ ( 2 * index ) + 1 ].ambient.b,
-                         spotLight[ ( 2 * index ) + 1 ].ambient.a );
+                //switched first, the object's uniforms go to the program that draws it
+                if( lightCode != objectRegistry[ index ].LightCode( ) )
+                {
+                    lightCode = objectRegistry[ index ].LightCode( );
+                    useProgramVariant( lightCode, cameraIndex );
+                }
 
-            glUniform3f( spotLight[ ( 2 * index ) + 1 ].incomingLoc, spotLight[ ( 2 * index ) + 1 ].incoming.r,
-                         spotLight[ ( 2 * index ) + 1 ].incoming.g, spotLight[ ( 2 * index ) + 1 ].incoming.b );
+                glUniformMatrix4fv( m_modelMatrix, 1, GL_FALSE,
+                                    glm::value_ptr(objectRegistry[index].GetModel( eye )));
 
-            glUniform1f( spotLight[ ( 2 * index ) + 1 ].cosineLoc, spotLight[ ( 2 * index ) + 1 ].cosine );
+                tmpVec = objectRegistry[ index ].getObjectModel( ).getDiffuse( );  
 
-        }
+                glUniform4f( m_diffuse, tmpVec.r, tmpVec.g, tmpVec.b, tmpVec.a );
 
-        for( index  = 2 * index; 
-             index < std::min( numberOfSpotLights, (unsigned int )spotLight.size( ) ); 
-             index++ )
-        {
-            tmpVec = objectRegistry[ spotLight[ index ].oTFIndex ].getPositionInWorld( );
+                tmpVec = objectRegistry[ index ].getObjectModel( ).getSpecular( );
 
-            glUniform4f( spotLight[ index ].followLoc, tmpVec.x, 
-                         tmpVec.y + spotLight[ index ].spotHeight, tmpVec.z, 1.0 );
+                glUniform4f( m_specular, tmpVec.r, tmpVec.g, tmpVec.b, tmpVec.a );
 
-            glUniform4f( spotLight[ index ].ambientLoc, spotLight[ index ].ambient.r, 
-                         spotLight[ index ].ambient.g, spotLight[ index ].ambient.b, 
-                         spotLight[ index ].ambient.a );
+                glUniform1f( m_shininess, objectRegistry[ index ].getObjectModel( ).getShininess( ) );
 
-            glUniform3f( spotLight[ index ].incomingLoc, spotLight[ index ].incoming.r, 
-                         spotLight[ index ].incoming.g, spotLight[ index ].incoming.b );
+                if( lightCode == Object::WAVE )
+                {
+                    glUniform1i( oceanHeightMap.HeightMapUniform( ), 1 );
+                    glActiveTexture( GL_TEXTURE1 );
+                    glBindTexture( GL_TEXTURE_2D, oceanHeightMap.HeightMapTexture( ) );
 
-            glUniform1f( spotLight[ index ].cosineLoc, spotLight[ index ].cosine );
-        }    
+                    glUniform1i( oceanHeightMap.SlopeMapUniform( ), 2 );
+                    glActiveTexture( GL_TEXTURE2 );
+                    glBindTexture( GL_TEXTURE_2D, oceanHeightMap.SlopeMapTexture( ) );
 
-        // Render the objects
-        for( index = 0; index < objectRegistry.getSize( ); index++ )
-        {
-            glUniformMatrix4fv( m_modelMatrix, 1, GL_FALSE,
-                                glm::value_ptr(objectRegistry[index].GetModel()));
+                    //the ocean is drawn with the camera centred grid instead of its model
+                    oceanModel = oceanGrid.getModel( cameraPosition );
+                    oceanModel[ 3 ] = glm::vec4( ( float ) ( ( double ) oceanModel[ 3 ].x - eye.x ),
+                                                 ( float ) ( ( double ) oceanModel[ 3 ].y - eye.y ),
+                                                 ( float ) ( ( double ) oceanModel[ 3 ].z - eye.z ),
+                                                 oceanModel[ 3 ].w );
 
-            tmpVec = objectRegistry[ index ].getObjectModel( ).getDiffuse( );  
+                    glUniformMatrix4fv( m_modelMatrix, 1, GL_FALSE, glm::value_ptr( oceanModel ) );
 
-            glUniform4f( m_diffuse, tmpVec.r, tmpVec.g, tmpVec.b, tmpVec.a );
+                    if( objectRegistry[ index ].getObjectModel( ).getNumberOfTextures( ) > 0 )
+                    {
+                        glUniform1i( objectRegistry[ index ].getObjectModel( ).TextureUniformLocation( ), 0 );
+                        glActiveTexture( GL_TEXTURE0 );
+                        glBindTexture( GL_TEXTURE_2D, objectRegistry[ index ].getObjectModel( ).Texture( 0 ) );
+                    }
 
-            tmpVec = objectRegistry[ index ].getObjectModel( ).getSpecular( );
+                    gpuTimer.start( GpuTimer::OCEAN );
+                    oceanGrid.Render( );
+                    gpuTimer.stop( GpuTimer::OCEAN );
 
-            glUniform4f( m_specular, tmpVec.r, tmpVec.g, tmpVec.b, tmpVec.a );
+                    continue;
+                }
 
-            glUniform1f( m_shininess, objectRegistry[ index ].getObjectModel( ).getShininess( ) );
+                //the skies are the objects drawn without lighting
+                if( lightCode == Object::NO_LIGHTING )
+                {
+                    gpuTimer.start( GpuTimer::SKY );
+                }
 
-            if( lightCode != objectRegistry[ index ].LightCode( ) )
-            {
-                lightCode = objectRegistry[ index ].LightCode( );
-                glUniform1i( m_objectType, lightCode );
-            }
+                objectRegistry[index].Render();
 
-            if( lightCode == Object::WAVE )
-            {
-                glUniform1i( oceanHeightMap.HeightMapUniform( ), 1 );
-                glActiveTexture( GL_TEXTURE1 );
-                glBindTexture( GL_TEXTURE_2D, oceanHeightMap.HeightMapTexture( ) );
+                gpuTimer.stop( GpuTimer::SKY );
             }
 
-            objectRegistry[index].Render();
+            gpuTimer.stop( GpuTimer::OBJECTS );
         }
 
         shaderRegistry[ shaderSelect ].Disable( );
 
+        gpuTimer.stop( viewPass );
+
         if( !splitScreen )
         {
             cameraIndex++;
@@ -1150,6 +1275,9 @@ void Graphics::Render( unsigned int dt )
     //HUDs
     if( splitScreen )
     {
+        PROFILE_ZONE( "HUD" );
+
+        gpuTimer.start( GpuTimer::HUD );
 
         for( index = 0; index < hud.size( ); index++ )
         {
@@ -1170,14 +1298,19 @@ void Graphics::Render( unsigned int dt )
             if( lightCode != objectRegistry[ index ].LightCode( ) )
             {
                 lightCode = objectRegistry[ index ].LightCode( );
-                glUniform1i( m_objectType, lightCode );
+                useProgramVariant( lightCode, index );
             }
 
             glUniformMatrix4fv( m_projectionMatrix, 1, GL_FALSE, glm::value_ptr( m_camera[ index ].GetProjection( ) ) );
-            glUniformMatrix4fv( m_viewMatrix, 1, GL_FALSE, glm::value_ptr( m_camera[ index ].GetView( ) ) );
+            glUniformMatrix4fv( m_viewMatrix, 1, GL_FALSE, glm::value_ptr( m_camera[ index ].GetRelativeView( ) ) );
+
+            eye = m_camera[ index ].GetEyePosition( );
+
+            glUniform3f( m_worldOrigin, ( float ) eye.x, ( float ) eye.y, ( float ) eye.z );
+            glUniform1f( m_logDepth, m_camera[ index ].getLogDepthCoefficient( ) );
 
             glUniformMatrix4fv( m_modelMatrix, 1, GL_FALSE,
-                                glm::value_ptr( objectRegistry[ hud[ index ].windHud ].GetModel( ) ) );
+                                glm::value_ptr( objectRegistry[ hud[ index ].windHud ].GetModel( eye ) ) );
 
             objectRegistry[ hud[ index ].windHud ].setRender( true );
 
@@ -1190,11 +1323,11 @@ void Graphics::Render( unsigned int dt )
             if( lightCode != objectRegistry[ index ].LightCode( ) )
             {
                 lightCode = objectRegistry[ index ].LightCode( );
-                glUniform1i( m_objectType, lightCode );
+                useProgramVariant( lightCode, index );
             }
 
             glUniformMatrix4fv( m_modelMatrix, 1, GL_FALSE,
-                                glm::value_ptr( objectRegistry[ hud[ index ].healthBar ].GetModel( ) ) );
+                                glm::value_ptr( objectRegistry[ hud[ index ].healthBar ].GetModel( eye ) ) );
 
             objectRegistry[ hud[ index ].healthBar ].setRender( true );
 
@@ -1203,6 +1336,8 @@ void Graphics::Render( unsigned int dt )
             objectRegistry[ hud[ index ].healthBar ].setRender( false );
         }
 
+        gpuTimer.stop( GpuTimer::HUD );
+
         if( wideView )
         {
             glViewport( 0, 0, screenWidth, screenHeight / 2 );
@@ -1212,47 +1347,56 @@ void Graphics::Render( unsigned int dt )
             glViewport( 0, 0, screenWidth / 2, screenHeight );
         }
     } 
-   // Get any errors from OpenGL
-   auto error = glGetError();
-   if ( error != GL_NO_ERROR )
-   {
-      string val = ErrorString( error );
-      std::cout<< "Error initializing OpenGL! " << error << ", " << val << std::endl;
-   }
-        
-   
-}
 
-std::string Graphics::ErrorString(GLenum error)
-{
-    if(error == GL_INVALID_ENUM)
+    //metrics overlay, over the whole window
+    if( overlay.isShown( ) )
     {
-        return "GL_INVALID_ENUM: An unacceptable value is specified for an enumerated argument.";
-    }
+        PROFILE_ZONE( "Overlay" );
 
-    else if(error == GL_INVALID_VALUE)
-    {
-        return "GL_INVALID_VALUE: A numeric argument is out of range.";
-    }
+        gpuTimer.start( GpuTimer::HUD );
 
-    else if(error == GL_INVALID_OPERATION)
-    {
-        return "GL_INVALID_OPERATION: The specified operation is not allowed in the current state.";
-    }
+        glViewport( 0, 0, screenWidth, screenHeight );
 
-    else if(error == GL_INVALID_FRAMEBUFFER_OPERATION)
-    {
-        return "GL_INVALID_FRAMEBUFFER_OPERATION: The framebuffer object is not complete.";
-    }
+        glDisable( GL_DEPTH_TEST );
+        glEnable( GL_BLEND );
+        glBlendFunc( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA );
 
-    else if(error == GL_OUT_OF_MEMORY)
-    {
-        return "GL_OUT_OF_MEMORY: There is not enough memory left to execute the command.";
-    }
-    else
-    {
-        return "None";
+        if( lightCode != Object::NO_LIGHTING )
+        {
+            lightCode = Object::NO_LIGHTING;
+            useProgramVariant( lightCode, 0 );
+        }
+
+        glUniformMatrix4fv( m_projectionMatrix, 1, GL_FALSE, glm::value_ptr( identity ) );
+        glUniformMatrix4fv( m_viewMatrix, 1, GL_FALSE, glm::value_ptr( identity ) );
+        glUniformMatrix4fv( m_modelMatrix, 1, GL_FALSE,
+                            glm::value_ptr( overlay.getModel( screenWidth, screenHeight ) ) );
+        glUniform1f( m_logDepth, 0.0f );
+
+        overlay.Render( );
+
+        glDisable( GL_BLEND );
+        glEnable( GL_DEPTH_TEST );
+
+        //back to the first camera's viewport
+        if( splitScreen && wideView )
+        {
+            glViewport( 0, 0, screenWidth, screenHeight / 2 );
+        }
+        else if( splitScreen )
+        {
+            glViewport( 0, 0, screenWidth / 2, screenHeight );
+        }
+
+        gpuTimer.stop( GpuTimer::HUD );
     }
+
+    metrics.set( drawCallMetric, RenderStats::drawCalls );
+    metrics.set( triangleMetric, RenderStats::triangles );
+    metrics.set( culledMetric, RenderStats::culledObjects );
+
+    //debug builds without KHR_debug only, polling the errors waits on the driver
+    GL_CHECK_ERRORS( "Render" );
 }
 
 // UPDATE LIST //////////////////
@@ -1519,11 +1663,10 @@ void Graphics::moveBox( glm::vec3 pos )
         }
 
         pauseNotifier = true;
-        std::cout << std::endl;
-        std::cout << "The game is either paused or has not begun!" << std::endl;
-        std::cout << "Press the space bar to start the game." << std::endl;
-        std::cout << "Press p to unpause the game." << std::endl;
-        std::cout << std::endl;
+        LOG_INFO( std::endl
+                  << "The game is either paused or has not begun!" << std::endl
+                  << "Press the space bar to start the game." << std::endl
+                  << "Press p to unpause the game." << std::endl );
         return;
     }
 
@@ -1552,7 +1695,7 @@ void Graphics::cycleShaderProgram( )
         shaderSelect = 0;
     }
 
-    std::cout << "Shader Program " << shaderSelect + 1 << " selected." << std::endl;
+    LOG_INFO( "Shader Program " << shaderSelect + 1 << " selected." );
 
     linkToCurrentShaderProgram( );
 }
@@ -1612,10 +1755,10 @@ void Graphics::changeBrightness( std::string lightSelect, float redParam,
 
     else if( lightSelect == "specular" )
     {
-        std::cout << modelRegistry[ modelIndex ].modelPath << "'s specular: ";
-        std::cout << modelRegistry[ modelIndex ].objModel.getSpecular( ).r << ", ";
-        std::cout << modelRegistry[ modelIndex ].objModel.getSpecular( ).g << ", ";
-        std::cout << modelRegistry[ modelIndex ].objModel.getSpecular( ).b << "." << std::endl;
+        LOG_INFO( modelRegistry[ modelIndex ].modelPath << "'s specular: "
+                  << modelRegistry[ modelIndex ].objModel.getSpecular( ).r << ", "
+                  << modelRegistry[ modelIndex ].objModel.getSpecular( ).g << ", "
+                  << modelRegistry[ modelIndex ].objModel.getSpecular( ).b << "." );
 
         if( modelRegistry[ modelIndex ].objModel.getSpecular().r >= 0.95f && redParam > 0.0f )
         {
@@ -1667,10 +1810,10 @@ void Graphics::changeBrightness( std::string lightSelect, float redParam,
 
         for( index = 0; index < spotLight.size( ); index++ )
         {
-            std::cout << "Spot Light Brightness: ";
-            std::cout << spotLight[ index ].ambient.r << ", ";
-            std::cout << spotLight[ index ].ambient.g << ", ";
-            std::cout << spotLight[ index ].ambient.b << "." << std::endl;
+            LOG_INFO( "Spot Light Brightness: "
+                      << spotLight[ index ].ambient.r << ", "
+                      << spotLight[ index ].ambient.g << ", "
+                      << spotLight[ index ].ambient.b << "." );
 
 
             if( spotLight[ index ].ambient.r >= 0.95f && redParam > 0.0f )
@@ -1733,7 +1876,7 @@ void Graphics::changeModelRegistryIndex( int i )
         modelIndex = modelRegistry.size() - 1;
     } 
 
-    std::cout << modelRegistry[ modelIndex ].modelPath << std::endl;
+    LOG_INFO( modelRegistry[ modelIndex ].modelPath );
 }
 
 void Graphics::changeSpotLightSize( float increment )
@@ -1749,7 +1892,7 @@ void Graphics::changeSpotLightSize( float increment )
     {
         spotLight[ index ].coneAngle += increment;
 
-        std::cout << "Spot Light Angle: " << spotLight[ index ].coneAngle << std::endl;
+        LOG_INFO( "Spot Light Angle: " << spotLight[ index ].coneAngle );
 
         if( spotLight[ index ].coneAngle < 0.0f )
         {
@@ -1769,63 +1912,112 @@ void Graphics::changeSpotLightSize( float increment )
 
 //gets the location of the shader programs uniforms
 bool Graphics::linkToCurrentShaderProgram( )
+{
+    //the last program's variants are built again for this one
+    programVariants.assign( Object::WAVE + 1, ProgramVariant( ) );
+    variantSelect = -1;
+
+    if( !findUniforms( shaderRegistry[ shaderSelect ], programLocations, true ) )
+    {
+        return false;
+    }
+
+    useUniforms( programLocations );
+
+    return true;
+}
+
+// FIND UNIFORMS //////////////////
+/***************************************
+
+@brief findUniforms
+
+@details gets the location of every uniform Render sets
+
+@param in: program: the linked program
+
+@param out: locations: the locations found
+
+@param in: required: true if every uniform must be found, false for a
+           variant, which leaves out the uniforms it does not use
+
+@notes the locations are only stored, useUniforms makes them current
+
+***************************************/
+bool Graphics::findUniforms( Shader& program, ProgramLocations& locations, bool required )
 {
     unsigned int index;
-    GLint tmpTextLoc;
     std::ostringstream strStream;
 
+    locations.time = program.GetUniformLocation( "time" );
 
-    m_time = shaderRegistry[ shaderSelect ].GetUniformLocation( "time" );
-
-    if( m_time == -1 )
+    if( required && locations.time == -1 )
     {
         printf( "time not found!\n" );
         return false;
     }
 
-    tmpTextLoc = shaderRegistry[ shaderSelect ].GetUniformLocation( "waveMap" );
+    locations.oceanWave = program.GetUniformLocation( "oceanWave" );
+
+    if( required && locations.oceanWave == -1 )
+    {
+        printf( "oceanWave not found!\n" );
+        return false;
+    }
 
-    oceanHeightMap.HeightMapUniform( ) = tmpTextLoc;
+    locations.waveMap = program.GetUniformLocation( "waveMap" );
 
-    if( tmpTextLoc == -1 )
+    if( required && locations.waveMap == -1 )
     {
         printf( "waveMap not found\n" );
         return false;
     }
 
-    m_objectType = shaderRegistry[ shaderSelect ].GetUniformLocation( "typeOfObject" );
-    if( m_objectType == -1 )
+    locations.slopeMap = program.GetUniformLocation( "slopeMap" );
+
+    if( required && locations.slopeMap == -1 )
+    {
+        printf( "slopeMap not found\n" );
+        return false;
+    }
+
+    locations.objectType = program.GetUniformLocation( "typeOfObject" );
+    if( required && locations.objectType == -1 )
     {
         printf( "object type code not found\n" );
         return false;
     }
 
-    m_numLights = shaderRegistry[ shaderSelect ].GetUniformLocation( "numberOfLights" );
+    locations.numLights = program.GetUniformLocation( "numberOfLights" );
 
-    if( m_numLights == -1 )
+    if( required && locations.numLights == -1 )
     {
         printf( "number of lights not found\n" );
         return false;
     }
 
-    m_numSpotLights = shaderRegistry[ shaderSelect ].GetUniformLocation( "numberOfSpotLights" );
+    locations.numSpotLights = program.GetUniformLocation( "numberOfSpotLights" );
 
-    if( m_numSpotLights == -1 )
+    if( required && locations.numSpotLights == -1 )
     {
         printf( "number of spot lights not found\n" );
         return false;
     }
     
+    locations.spotPosition.resize( spotLight.size( ) );
+    locations.spotAmbient.resize( spotLight.size( ) );
+    locations.spotDirection.resize( spotLight.size( ) );
+    locations.spotClip.resize( spotLight.size( ) );
 
     for( index = 0; index < spotLight.size( ); index++ )
     {
         strStream << "spotLight[" << index << "].position";
 
-        spotLight[ index ].followLoc = shaderRegistry[ shaderSelect ].GetUniformLocation( strStream.str( ).c_str( ) );
+        locations.spotPosition[ index ] = program.GetUniformLocation( strStream.str( ).c_str( ) );
 
         strStream.str( std::string( ) );
 
-        if( spotLight[ index ].followLoc == -1 )
+        if( required && locations.spotPosition[ index ] == -1 )
         {
             printf( "spot light follow loc not found\n" );
             return false;
@@ -1833,69 +2025,70 @@ bool Graphics::linkToCurrentShaderProgram( )
 
         strStream << "spotLight[" << index << "].ambient";
 
-        spotLight[ index ].ambientLoc = shaderRegistry[ shaderSelect ].GetUniformLocation( strStream.str( ).c_str( ) );
+        locations.spotAmbient[ index ] = program.GetUniformLocation( strStream.str( ).c_str( ) );
 
         strStream.str( std::string( ) );
 
-        if( spotLight[ index ].ambientLoc == -1 )
+        if( required && locations.spotAmbient[ index ] == -1 )
         {
             printf( "spot light ambient loc not found\n" );
             return false;
         }
 
         strStream << "spotLight[" << index << "].direction";
-        spotLight[ index ].incomingLoc = shaderRegistry[ shaderSelect ].GetUniformLocation( strStream.str( ).c_str( ) );
+        locations.spotDirection[ index ] = program.GetUniformLocation( strStream.str( ).c_str( ) );
         strStream.str( std::string( ) );
 
-        if( spotLight[ index ].incomingLoc == -1 )
+        if( required && locations.spotDirection[ index ] == -1 )
         {
             printf( "spot light direction not found\n" );
             return false;
         }
 
         strStream << "spotLight[" << index << "].clip";
-        spotLight[ index ].cosineLoc = shaderRegistry[ shaderSelect ].GetUniformLocation( strStream.str( ).c_str( ) );
+        locations.spotClip[ index ] = program.GetUniformLocation( strStream.str( ).c_str( ) );
         strStream.str( std::string( ) );
 
-        if( spotLight[ index ].cosineLoc == -1 )
+        if( required && locations.spotClip[ index ] == -1 )
         {
             printf( "spot light clip cosine not found\n" );
             return false;
         }
     }
 
-    
-
-    m_diffuse = shaderRegistry[ shaderSelect ].GetUniformLocation( "DiffuseColor" );
-    if( m_diffuse == -1 )
+    locations.diffuse = program.GetUniformLocation( "DiffuseColor" );
+    if( required && locations.diffuse == -1 )
     {
         printf( "diffuse color not found\n" );
         return false;
     }
 
-    m_specular = shaderRegistry[ shaderSelect ].GetUniformLocation( "SpecularColor" );
-    if( m_specular == -1 )
+    locations.specular = program.GetUniformLocation( "SpecularColor" );
+    if( required && locations.specular == -1 )
     {
         printf( "specular color not found\n" );
         return false;
     }
 
-    m_shininess = shaderRegistry[ shaderSelect ].GetUniformLocation( "Shininess" );
-    if( m_shininess == -1 )
+    locations.shininess = program.GetUniformLocation( "Shininess" );
+    if( required && locations.shininess == -1 )
     {
         printf( "shininess not found\n" );
         return false;
     }
 
+    locations.lightAmbient.resize( lights.size( ) );
+    locations.lightPosition.resize( lights.size( ) );
+
     for( index = 0; index < lights.size( ); index++ )
     {
         strStream << "light[" << index << "].ambient";
 
-        lights[ index ].ambientLoc  = shaderRegistry[ shaderSelect ].GetUniformLocation( strStream.str( ).c_str( ) );
+        locations.lightAmbient[ index ] = program.GetUniformLocation( strStream.str( ).c_str( ) );
 
         strStream.str( std::string( ) );
 
-        if( lights[ index ].ambientLoc == -1 )
+        if( required && locations.lightAmbient[ index ] == -1 )
         {
             printf( "light ambient not found\n" );
             return false;
@@ -1903,11 +2096,11 @@ bool Graphics::linkToCurrentShaderProgram( )
 
         strStream << "light[" << index << "].position";
 
-        lights[ index ].incomingLoc = shaderRegistry[ shaderSelect ].GetUniformLocation( strStream.str( ).c_str( ) );
+        locations.lightPosition[ index ] = program.GetUniformLocation( strStream.str( ).c_str( ) );
 
         strStream.str( std::string( ) );
 
-        if( lights[ index ].incomingLoc == -1 )
+        if( required && locations.lightPosition[ index ] == -1 )
         {
             printf( "light position not found\n" );
             return false;
@@ -1915,43 +2108,323 @@ bool Graphics::linkToCurrentShaderProgram( )
     }    
 
     // Locate the projection matrix in the shader
-    m_projectionMatrix = shaderRegistry[ shaderSelect ].GetUniformLocation( "projectionMatrix" );
-    if( m_projectionMatrix == -1 )
+    locations.projectionMatrix = program.GetUniformLocation( "projectionMatrix" );
+    if( locations.projectionMatrix == -1 )
     {
         printf( "m_projectionMatrix not found\n" );
         return false;
     }
 
     // Locate the view matrix in the shader
-    m_viewMatrix = shaderRegistry[ shaderSelect ].GetUniformLocation( "viewMatrix" );
-    if( m_viewMatrix == -1 )
+    locations.viewMatrix = program.GetUniformLocation( "viewMatrix" );
+    if( locations.viewMatrix == -1 )
     {
         printf( "m_viewMatrix not found\n" );
         return false;
     }
 
     // Locate the model matrix in the shader
-    m_modelMatrix = shaderRegistry[ shaderSelect ].GetUniformLocation( "modelMatrix" );
-    if( m_modelMatrix == -1 )
+    locations.modelMatrix = program.GetUniformLocation( "modelMatrix" );
+    if( locations.modelMatrix == -1 )
     {
         printf( "m_modelMatrix not found\n" );
         return false;
     }
 
-    tmpTextLoc = shaderRegistry[ shaderSelect ].GetUniformLocation( "textureSampler" );
+    //only the lighting shaders rebuild world positions
+    locations.worldOrigin = program.GetUniformLocation( "worldOrigin" );
 
-    if( tmpTextLoc == -1 )
+    //only needed for the logarithmic depth
+    locations.logDepth = program.GetUniformLocation( "logDepthCoefficient" );
+    if( depthMode == Camera::DEPTH_LOGARITHMIC && locations.logDepth == -1 )
+    {
+        printf( "logDepthCoefficient not found\n" );
+        return false;
+    }
+
+    locations.textureSampler = program.GetUniformLocation( "textureSampler" );
+
+    if( locations.textureSampler == -1 )
     {
         printf( "texture location uniform not found\n" );
         return false;
     }
 
+    return true;
+}
+
+// USE UNIFORMS //////////////////
+/***************************************
+
+@brief useUniforms
+
+@details makes a program's uniform locations the ones Render sets
+
+@param in: locations: the locations from findUniforms
+
+@notes the lights, the models, the overlay and the height map keep their
+       own copies
+
+***************************************/
+void Graphics::useUniforms( const ProgramLocations& locations )
+{
+    unsigned int index;
+
+    m_projectionMatrix = locations.projectionMatrix;
+    m_viewMatrix = locations.viewMatrix;
+    m_modelMatrix = locations.modelMatrix;
+    m_specular = locations.specular;
+    m_diffuse = locations.diffuse;
+    m_shininess = locations.shininess;
+    m_numLights = locations.numLights;
+    m_numSpotLights = locations.numSpotLights;
+    m_objectType = locations.objectType;
+    m_time = locations.time;
+    m_oceanWave = locations.oceanWave;
+    m_worldOrigin = locations.worldOrigin;
+    m_logDepth = locations.logDepth;
+
+    oceanHeightMap.HeightMapUniform( ) = locations.waveMap;
+    oceanHeightMap.SlopeMapUniform( ) = locations.slopeMap;
+
+    for( index = 0; index < lights.size( ); index++ )
+    {
+        lights[ index ].ambientLoc = locations.lightAmbient[ index ];
+        lights[ index ].incomingLoc = locations.lightPosition[ index ];
+    }
+
+    for( index = 0; index < spotLight.size( ); index++ )
+    {
+        spotLight[ index ].followLoc = locations.spotPosition[ index ];
+        spotLight[ index ].ambientLoc = locations.spotAmbient[ index ];
+        spotLight[ index ].incomingLoc = locations.spotDirection[ index ];
+        spotLight[ index ].cosineLoc = locations.spotClip[ index ];
+    }
+
     for( index = 0; index < modelRegistry.size( ); index++ )
     {
-        modelRegistry[ index ].objModel.TextureUniformLocation( ) = tmpTextLoc;
+        modelRegistry[ index ].objModel.TextureUniformLocation( ) = locations.textureSampler;
     }
 
-    return true;
+    overlay.TextureUniformLocation( ) = locations.textureSampler;
+}
+
+// SET PROGRAM DEFINES //////////////////
+/***************************************
+
+@brief setProgramDefines
+
+@details defines what every program and its variants are built with
+
+@param out: program: a program with no shaders added yet
+
+@notes LOG_DEPTH is defined for a logarithmic depth buffer, so the
+       shaders only write gl_FragDepth then; the other depth modes keep
+       the early depth test
+
+***************************************/
+void Graphics::setProgramDefines( Shader& program ) const
+{
+    std::vector<std::pair<std::string, int>> defines;
+
+    if( depthMode == Camera::DEPTH_LOGARITHMIC )
+    {
+        defines.push_back( std::make_pair( std::string( "LOG_DEPTH" ), 1 ) );
+    }
+
+    program.SetDefines( defines );
+}
+
+// USE PROGRAM VARIANT //////////////////
+/***************************************
+
+@brief useProgramVariant
+
+@details switches to the selected program's variant for a type of object,
+         building it the first time the type is drawn
+
+@param in: objectType: the Object lighting code being drawn
+
+@param in: cameraIndex: the camera whose view uniforms the variant needs
+
+@notes the view uniforms are set once per camera pass for each variant. a
+       variant that fails to build leaves the type drawn by the selected
+       program, which branches on typeOfObject at run time
+
+***************************************/
+void Graphics::useProgramVariant( int objectType, int cameraIndex )
+{
+    ProgramVariant *variant;
+    std::vector<std::pair<std::string, int>> defines;
+
+    if( objectType < 0 || objectType >= ( int ) programVariants.size( ) )
+    {
+        objectType = Object::DEFAULT_LIGHTING;
+    }
+
+    variant = &programVariants[ objectType ];
+
+    if( variant->program == NULL )
+    {
+        PROFILE_ZONE( "Build program variant" );
+
+        defines.push_back( std::make_pair( std::string( "OBJECT_TYPE" ), objectType ) );
+        defines.push_back( std::make_pair( std::string( "NUM_LIGHTS" ),
+                                           std::min( ( int ) lights.size( ), MAX_NUM_LIGHTS ) ) );
+        defines.push_back( std::make_pair( std::string( "NUM_SPOT_LIGHTS" ),
+                                           std::min( ( int ) spotLight.size( ), MAX_NUM_LIGHTS ) ) );
+
+        variant->program = shaderRegistry[ shaderSelect ].GetVariant( defines );
+
+        if( variant->program == NULL || !findUniforms( *variant->program, variant->locations, false ) )
+        {
+            variant->program = &shaderRegistry[ shaderSelect ];
+            variant->locations = programLocations;
+        }
+    }
+
+    if( objectType != variantSelect )
+    {
+        variantSelect = objectType;
+
+        variant->program->Enable( );
+        useUniforms( variant->locations );
+    }
+
+    if( variant->viewPass != viewPassCount )
+    {
+        variant->viewPass = viewPassCount;
+        setViewUniforms( cameraIndex );
+    }
+
+    //only the selected program has the uniform, a variant has the define
+    glUniform1i( m_objectType, objectType );
+}
+
+// SET VIEW UNIFORMS //////////////////
+/***************************************
+
+@brief setViewUniforms
+
+@details sets a camera's projection, view and eye, the lights and the
+         swell in the program in use
+
+@param in: cameraIndex: the camera being drawn
+
+@notes called by useProgramVariant once per camera pass for each program
+       used in it
+
+***************************************/
+void Graphics::setViewUniforms( int cameraIndex )
+{
+    unsigned int index;
+    glm::vec4 tmpVec;
+    glm::vec3 cameraPosition;
+    glm::dvec3 eye;
+
+    //the world is drawn around this camera's eye
+    eye = m_camera[ cameraIndex ].GetEyePosition( );
+    cameraPosition = glm::vec3( ( float ) eye.x, ( float ) eye.y, ( float ) eye.z );
+
+    // Send in the projection and view to the shader
+    glUniformMatrix4fv(m_projectionMatrix, 1, GL_FALSE, glm::value_ptr(m_camera[cameraIndex].GetProjection())); 
+    glUniformMatrix4fv(m_viewMatrix, 1, GL_FALSE, glm::value_ptr(m_camera[cameraIndex].GetRelativeView()));
+
+    glUniform3f( m_worldOrigin, cameraPosition.x, cameraPosition.y, cameraPosition.z );
+    glUniform1f( m_logDepth, m_camera[ cameraIndex ].getLogDepthCoefficient( ) );
+
+    glUniform1i( m_numLights, ( GLint ) lights.size( ) );
+    glUniform1i( m_numSpotLights, ( GLint ) spotLight.size( ) );
+
+    glUniform1f( m_time, waveTime );
+
+    tmpVec = oceanHeightMap.getWaveParameters( );
+
+    glUniform4f( m_oceanWave, tmpVec.x, tmpVec.y, tmpVec.z, tmpVec.w );
+
+    {
+        PROFILE_ZONE( "Lights" );
+
+        for( index = 0; 
+             index < std::min( numberOfLights, ( unsigned int )lights.size( ) ); 
+             index++ )
+        {
+            glUniform4f( lights[ index ].ambientLoc, lights[ index ].ambient.r, 
+                         lights[ index ].ambient.g, lights[ index ].ambient.b, 
+                         lights[ index ].ambient.a );
+
+            //point lights move with the origin, directions do not
+            tmpVec = lights[ index ].incoming;
+
+            if( tmpVec.w != 0.0f )
+            {
+                tmpVec = glm::vec4( ( float ) ( tmpVec.x - eye.x ), ( float ) ( tmpVec.y - eye.y ),
+                                    ( float ) ( tmpVec.z - eye.z ), tmpVec.w );
+            }
+
+            glUniform4f( lights[ index ].incomingLoc, tmpVec.x, tmpVec.y, tmpVec.z, tmpVec.w );
+        } 
+
+        for( index = 0; index < shipRegistry.size( ); index += 1 )
+        {
+            if( 2 * index > spotLight.size( ) || ( 2 * index ) + 1 > spotLight.size( ) )
+            {
+                LOG_ERROR( "Error: too few spotLights!" );
+            }
+
+            tmpVec = glm::vec4( shipRegistry[ index ].rightHit.getX( ), 
+                                shipRegistry[ index ].rightHit.getY( ), 
+                                shipRegistry[ index ].rightHit.getZ( ), 1.0 );
+
+            glUniform4f( spotLight[ 2 * index ].followLoc, tmpVec.x,
+                         tmpVec.y + spotLight[ 2 * index ].spotHeight, tmpVec.z, 1.0 );
+
+            glUniform4f( spotLight[ 2 * index ].ambientLoc, spotLight[ 2 * index ].ambient.r,
+                         spotLight[ 2 * index ].ambient.g, spotLight[ 2 * index ].ambient.b,
+                         spotLight[ 2 * index ].ambient.a );
+
+            glUniform3f( spotLight[ 2 * index ].incomingLoc, spotLight[ 2 * index ].incoming.r,
+                         spotLight[ 2 * index ].incoming.g, spotLight[ 2 * index ].incoming.b );
+
+            glUniform1f( spotLight[ 2 * index ].cosineLoc, spotLight[ 2 * index ].cosine );
+
+            tmpVec = glm::vec4( shipRegistry[ index ].leftHit.getX( ),
+                                shipRegistry[ index ].leftHit.getY( ),
+                                shipRegistry[ index ].leftHit.getZ( ), 1.0 );
+
+            glUniform4f( spotLight[ ( 2 * index ) + 1 ].followLoc, tmpVec.x,
+                         tmpVec.y + spotLight[ ( 2 * index ) + 1 ].spotHeight, tmpVec.z, 1.0 );
+
+            glUniform4f( spotLight[ ( 2 * index ) + 1].ambientLoc, spotLight[ ( 2 * index ) + 1 ].ambient.r,
+                         spotLight[ ( 2 * index ) + 1].ambient.g, spotLight[ ( 2 * index ) + 1 ].ambient.b,
+                         spotLight[ ( 2 * index ) + 1 ].ambient.a );
+
+            glUniform3f( spotLight[ ( 2 * index ) + 1 ].incomingLoc, spotLight[ ( 2 * index ) + 1 ].incoming.r,
+                         spotLight[ ( 2 * index ) + 1 ].incoming.g, spotLight[ ( 2 * index ) + 1 ].incoming.b );
+
+            glUniform1f( spotLight[ ( 2 * index ) + 1 ].cosineLoc, spotLight[ ( 2 * index ) + 1 ].cosine );
+
+        }
+
+        for( index  = 2 * index; 
+             index < std::min( numberOfSpotLights, (unsigned int )spotLight.size( ) ); 
+             index++ )
+        {
+            tmpVec = objectRegistry[ spotLight[ index ].oTFIndex ].getPositionInWorld( );
+
+            glUniform4f( spotLight[ index ].followLoc, tmpVec.x, 
+                         tmpVec.y + spotLight[ index ].spotHeight, tmpVec.z, 1.0 );
+
+            glUniform4f( spotLight[ index ].ambientLoc, spotLight[ index ].ambient.r, 
+                         spotLight[ index ].ambient.g, spotLight[ index ].ambient.b, 
+                         spotLight[ index ].ambient.a );
+
+            glUniform3f( spotLight[ index ].incomingLoc, spotLight[ index ].incoming.r, 
+                         spotLight[ index ].incoming.g, spotLight[ index ].incoming.b );
+
+            glUniform1f( spotLight[ index ].cosineLoc, spotLight[ index ].cosine );
+        }
+    }
 }
 
 void Graphics::togglePausedState( )
@@ -2005,8 +2478,8 @@ void Graphics::resetBall( )
         playingStateFlag = false;
         activeIdleState = true;
 
-        std::cout << "Game over!" << std::endl;
-        std::cout << "Press space to restart the game." << std::endl;
+        LOG_INFO( "Game over!" << std::endl
+                  << "Press space to restart the game." );
 
         gameOverStep = true;
         gameStarted = false;
@@ -2047,11 +2520,10 @@ void Graphics::turnPaddle( bool select )
         }
 
         pauseNotifier = true;
-        std::cout << std::endl;
-        std::cout << "The game is either paused or has not begun!" << std::endl;
-        std::cout << "Press the space bar to start the game." << std::endl;
-        std::cout << "Press p to unpause the game." << std::endl;
-        std::cout << std::endl;
+        LOG_INFO( std::endl
+                  << "The game is either paused or has not begun!" << std::endl
+                  << "Press the space bar to start the game." << std::endl
+                  << "Press p to unpause the game." << std::endl );
         return;
     }
 
@@ -2072,6 +2544,153 @@ void Graphics::resetView( )
     m_camera[0].resetView( );
 }
 
+// SET CAMERA VIEW //////////////////
+/***************************************
+
+@brief setCameraView
+
+@details puts every camera at an eye position looking at a focus point
+
+@param in: eye: the eye position in the world
+
+@param in: focus: the focus point in the world
+
+@notes the ships' cameras follow them again on the next Update, so call
+       it after Update. used by the benchmark runner to replay a camera
+       path
+
+***************************************/
+void Graphics::setCameraView( const glm::dvec3& eye, const glm::dvec3& focus )
+{
+    unsigned int index;
+
+    cameraTracking = false;
+
+    for( index = 0; index < m_camera.size( ); index++ )
+    {
+        m_camera[ index ].lookAt( eye, focus );
+    }
+}
+
+// GET PHYSICS TIME //////////////////
+/***************************************
+
+@brief getPhysicsTime
+
+@details returns the real milliseconds the last Update spent in the
+         Bullet step, buoyancy included
+
+@param None
+
+@notes 0 while the game is not being played
+
+***************************************/
+double Graphics::getPhysicsTime( ) const
+{
+    return physicsTime;
+}
+
+// UPDATE METRICS //////////////////
+/***************************************
+
+@brief updateMetrics
+
+@details adds a frame's time to the metrics, and every METRICS_PERIOD
+         redraws the overlay and writes a row to the metrics file
+
+@param in: frameMillis: the frame's real milliseconds
+
+@notes the GPU time is the views and the HUD of a frame a few frames
+       old, 0 without timer queries. built with PROFILER, the Update and
+       Render zones' averages are shown too
+
+***************************************/
+void Graphics::updateMetrics( double frameMillis )
+{
+    metrics.sample( frameMetric, frameMillis );
+
+    metrics.set( gpuMetric, gpuTimer.getTime( GpuTimer::VIEW_1 ) 
+                            + gpuTimer.getTime( GpuTimer::VIEW_2 )
+                            + gpuTimer.getTime( GpuTimer::HUD ) );
+
+    metricsMillis += frameMillis;
+
+    if( metricsMillis < METRICS_PERIOD )
+    {
+        return;
+    }
+
+    metricsSeconds += metricsMillis / 1000.0;
+    metricsMillis = 0.0;
+
+#ifdef PROFILER
+    metrics.set( updateMetric, Profiler::getAverage( "Update" ) );
+    metrics.set( renderMetric, Profiler::getAverage( "Render" ) );
+#endif
+
+    if( overlay.isShown( ) )
+    {
+        overlay.setText( metrics.getText( ) );
+    }
+
+    metrics.dump( metricsSeconds );
+}
+
+void Graphics::toggleOverlay( )
+{
+    overlay.toggleShown( );
+
+    //show the current numbers instead of the ones from when it was hidden
+    if( overlay.isShown( ) )
+    {
+        overlay.setText( metrics.getText( ) );
+    }
+}
+
+// APPLY RELOAD //////////////////
+/***************************************
+
+@brief applyReload
+
+@details swaps in the files the watcher has read since the last frame
+
+@param None
+
+@notes called by the engine between frames, the files were read on the
+       watcher thread so only the GL work is left. a file that failed
+       keeps what the scene had
+
+***************************************/
+void Graphics::applyReload( )
+{
+    ReloadBatch *batch;
+
+    if( !hotReload.hasBatch( ) )
+    {
+        return;
+    }
+
+    PROFILE_ZONE( "Hot reload" );
+
+    batch = hotReload.takeBatch( );
+
+    if( batch == NULL )
+    {
+        return;
+    }
+
+    reloadPrograms( *batch );
+
+    reloadModels( *batch );
+
+    if( batch->configChanged )
+    {
+        reloadConfig( batch->config );
+    }
+
+    delete batch;
+}
+
 void Graphics::idleSplash( unsigned int dt )
 {
     if( numberOfUpCalls < 1000 && goingUp )
@@ -2145,7 +2764,7 @@ void Graphics::slowShipToHalt( size_t ship )
         shipRegistry[ ship ].slowDown = true;
         shipRegistry[ ship ].forceOn = false;
         shipRegistry[ ship ].shipReverseCounter = 0;
-        std::cout << "Slowing!" << std::endl;
+        LOG_INFO( "Slowing!" );
     }
 }
 
@@ -2167,13 +2786,13 @@ void Graphics::stopShipsRotation( size_t ship )
     {
         shipRegistry[ ship ].slowRotDown = true;
         shipRegistry[ ship ].torqueOn = false;
-        std::cout << "Stopping ship rotation!" << std::endl;
+        LOG_INFO( "Stopping ship rotation!" );
     }
 }
 
 void Graphics::fireGuns( size_t ship )
 {
-    if( ship < shipRegistry.size( ) && !objectCollidedSound.SoundPlaying( ) )
+    if( ship < shipRegistry.size( ) )
     {
         if( shipRegistry[ ship ].lookingLeft )
         {
@@ -2248,6 +2867,8 @@ void Graphics::applyShipForces( unsigned int dt )
 
     btVector3 cameraPos;
 
+    PROFILE_ZONE( "Ship forces" );
+
     for( index = 0; index < shipRegistry.size( ); index++ )
     {
         shipPtr = &objectRegistry[ shipRegistry[ index ].index ];
@@ -2316,8 +2937,11 @@ void Graphics::applyShipForces( unsigned int dt )
 
             //dot product for wind power and ray testing
 
+            //heading on the water, ignoring the pitch and roll from the waves
             shipDirection = shipRot * btVector3( 1.0f, 0.0f, 0.0f );
 
+            shipDirection.setY( 0.0f );
+
             shipDirection = shipDirection.normalized( );
 
             windScalar = windDirection.dot( shipDirection );
@@ -2409,7 +3033,7 @@ void Graphics::applyShipForces( unsigned int dt )
                     else
                     {
                         shipRegistry[ index ].torque = btVector3( 0.0f, 0.0f, 0.0f );
-                        std::cout << "Error reducing speed!" << std::endl;
+                        LOG_ERROR( "Error reducing speed!" );
                     }
 
                     ccb::shipReg[ index ].maxAngSpeed 
@@ -2463,6 +3087,8 @@ void Graphics::applyShipForces( unsigned int dt )
 
                 correctedForce = shipRot * relativeForce;
 
+                correctedForce.setY( 0.0f );
+
                 shipRegistry[ index ].force = correctedForce;
 
                 shipBodyPtr->applyCentralImpulse( shipRegistry[ index ].force );
@@ -2486,13 +3112,19 @@ void Graphics::applyShipForces( unsigned int dt )
 
             if( shipRegistry[ index ].firingLeft )
             {
-                objectCollidedSound.launchSound( );
+                objectCollidedSound.playSoundAt( cannonSound, 
+                                                 glm::vec3( shipPosition.getX( ), 
+                                                            shipPosition.getY( ), 
+                                                            shipPosition.getZ( ) ) );
                 shipRegistry[ index ].leftReloadTime = ShipController::RELOAD_TIME_MS;
             }
 
             if( shipRegistry[ index ].firingRight )
             {
-                objectCollidedSound.launchSound( );
+                objectCollidedSound.playSoundAt( cannonSound, 
+                                                 glm::vec3( shipPosition.getX( ), 
+                                                            shipPosition.getY( ), 
+                                                            shipPosition.getZ( ) ) );
                 shipRegistry[ index ].rightReloadTime = ShipController::RELOAD_TIME_MS;
             }
 
@@ -2519,7 +3151,16 @@ void Graphics::applyShipForces( unsigned int dt )
                             objectRegistry[ hud[ cIndex ].healthBar ].setScale( objectRegistry[ hud[ cIndex ].healthBar ].getScale( ) 
                                                                                 * glm::vec3( 1.0f, 1.0f, ( float ) shipRegistry[ cIndex ].healthPoints / 100.0f ) );
 
-                            std::cout << "Hit!" << std::endl;
+                            //a hit is heard over any number of guns firing
+                            objectCollidedSound.playSoundAt( cannonSound, 
+                                                             glm::vec3( hitPosition.getX( ), 
+                                                                        hitPosition.getY( ), 
+                                                                        hitPosition.getZ( ) ),
+                                                             Sound::HIGH_PRIORITY, IMPACT_GAIN );
+
+                            LOG_INFO( "Hit!" );
+
+                            metrics.increment( hitMetric );
                         }
                     }
                 }
@@ -2545,7 +3186,16 @@ void Graphics::applyShipForces( unsigned int dt )
                             objectRegistry[ hud[ cIndex ].healthBar ].setScale( objectRegistry[ hud[ cIndex ].healthBar ].getScale( ) 
                                                                                 * glm::vec3( 1.0f, 1.0f, ( float ) shipRegistry[ cIndex ].healthPoints / 100.0f ) );
 
-                            std::cout << "Hit!" << std::endl;
+                            //a hit is heard over any number of guns firing
+                            objectCollidedSound.playSoundAt( cannonSound, 
+                                                             glm::vec3( hitPosition.getX( ), 
+                                                                        hitPosition.getY( ), 
+                                                                        hitPosition.getZ( ) ),
+                                                             Sound::HIGH_PRIORITY, IMPACT_GAIN );
+
+                            LOG_INFO( "Hit!" );
+
+                            metrics.increment( hitMetric );
                         }
                     }
                 }
@@ -2642,6 +3292,273 @@ bool Graphics::sameSign( float first, float second )
     return false;
 }
 
+// RELOAD PROGRAMS //////////////////
+/***************************************
+
+@brief reloadPrograms
+
+@details compiles and links the programs whose shaders changed
+
+@param in: batch: the sources read by the watcher
+
+@notes a program replaces the registry's only once it links, so a shader
+       with errors leaves the old program drawing
+
+***************************************/
+void Graphics::reloadPrograms( const ReloadBatch& batch )
+{
+    const ReloadProgram *program;
+    unsigned int index, sIndex;
+    bool built;
+
+    for( index = 0; index < batch.programs.size( ); index++ )
+    {
+        Shader rebuilt;
+
+        program = &batch.programs[ index ];
+
+        if( program->index >= shaderRegistry.size( ) )
+        {
+            continue;
+        }
+
+        built = rebuilt.Initialize( );
+
+        setProgramDefines( rebuilt );
+
+        for( sIndex = 0; sIndex < program->files.size( ) && built; sIndex++ )
+        {
+            built = rebuilt.AddShaderSource( program->files[ sIndex ].first,
+                                             program->sources[ sIndex ],
+                                             program->files[ sIndex ].second );
+        }
+
+        if( !built || !rebuilt.Finalize( ) )
+        {
+            LOG_ERROR( "Shader program " << program->index + 1
+                       << " failed to rebuild, the old program is kept" );
+            continue;
+        }
+
+        //the old program is deleted along with rebuilt
+        shaderRegistry[ program->index ].Swap( rebuilt );
+
+        LOG_INFO( "Shader program " << program->index + 1 << " reloaded" );
+
+        if( program->index == shaderSelect && !linkToCurrentShaderProgram( ) )
+        {
+            LOG_ERROR( "Shader program " << program->index + 1 << " is missing uniforms" );
+        }
+    }
+}
+
+// RELOAD MODELS //////////////////
+/***************************************
+
+@brief reloadModels
+
+@details uploads the models that changed and swaps them into the model
+         registry
+
+@param in: batch: the models read by the watcher
+
+@notes the objects point into the registry, so they draw the new model
+       without being touched. the collision shapes built from a model
+       keep its old shape
+
+***************************************/
+void Graphics::reloadModels( ReloadBatch& batch )
+{
+    unsigned int index, mIndex;
+    GLint textureLocation;
+    std::vector<GLuint> released;
+
+    for( index = 0; index < batch.models.size( ); index++ )
+    {
+        if( !batch.models[ index ].model.uploadBuffers( batch.models[ index ].path, &textureRegistry ) )
+        {
+            continue;
+        }
+
+        released.clear( );
+
+        for( mIndex = 0; mIndex < modelRegistry.size( ); mIndex++ )
+        {
+            if( modelRegistry[ mIndex ].modelPath != batch.models[ index ].path )
+            {
+                continue;
+            }
+
+            //entries of one file share their buffers after a reload, so each
+            //set is deleted once
+            if( std::find( released.begin( ), released.end( ),
+                           modelRegistry[ mIndex ].objModel.getVB( ) ) == released.end( ) )
+            {
+                released.push_back( modelRegistry[ mIndex ].objModel.getVB( ) );
+
+                modelRegistry[ mIndex ].objModel.releaseBuffers( &textureRegistry );
+            }
+
+            textureLocation = modelRegistry[ mIndex ].objModel.TextureUniformLocation( );
+
+            modelRegistry[ mIndex ].objModel = batch.models[ index ].model;
+
+            modelRegistry[ mIndex ].objModel.TextureUniformLocation( ) = textureLocation;
+        }
+
+        LOG_INFO( batch.models[ index ].path << " reloaded" );
+    }
+}
+
+// RELOAD CONFIG //////////////////
+/***************************************
+
+@brief reloadConfig
+
+@details applies the values that changed in the configuration file
+
+@param in: config: the configuration file as it is now
+
+@notes the objects and lights are matched by their place in the file.
+       an object that moved is placed there and stopped. added or removed
+       objects, models and shaders, and the collision shapes, wait for a
+       restart
+
+***************************************/
+void Graphics::reloadConfig( const GraphicsInfo& config )
+{
+    const ObjectInfo *newInfo, *oldInfo;
+    unsigned int index;
+    btRigidBody *body;
+    btTransform transform;
+    std::string configFile;
+
+    if( config.objectData.size( ) != sceneConfig.objectData.size( )
+        || config.modelVector != sceneConfig.modelVector
+        || config.shaderVector != sceneConfig.shaderVector
+        || config.lights.size( ) != sceneConfig.lights.size( )
+        || config.spotLight.size( ) != sceneConfig.spotLight.size( ) )
+    {
+        LOG_WARNING( "Objects, models, shaders or lights were added or removed in "
+                     << sceneConfig.configFile << ", restart to see them" );
+    }
+
+    for( index = 0; index < config.objectData.size( ) && index < sceneConfig.objectData.size( )
+                    && index < objectRegistry.getSize( ); index++ )
+    {
+        newInfo = &config.objectData[ index ];
+        oldInfo = &sceneConfig.objectData[ index ];
+
+        if( newInfo->name != oldInfo->name )
+        {
+            continue;
+        }
+
+        if( newInfo->scale != oldInfo->scale )
+        {
+            objectRegistry[ index ].setScale( newInfo->scale );
+        }
+
+        if( newInfo->rotationAxes != oldInfo->rotationAxes )
+        {
+            objectRegistry[ index ].setRotationVector( newInfo->rotationAxes );
+        }
+
+        if( newInfo->rotationAngles.y != oldInfo->rotationAngles.y )
+        {
+            objectRegistry[ index ].setAngle( newInfo->rotationAngles.y );
+        }
+
+        if( newInfo->position != oldInfo->position )
+        {
+            objectRegistry[ index ].setTranslationVector( newInfo->position );
+
+            body = objectRegistry[ index ].CollisionInfo( ).rigidBody;
+
+            if( body != NULL )
+            {
+                body->getMotionState( )->getWorldTransform( transform );
+
+                transform.setOrigin( btVector3( newInfo->position.x, 
+                                                newInfo->position.y, 
+                                                newInfo->position.z ) );
+
+                body->setWorldTransform( transform );
+                body->getMotionState( )->setWorldTransform( transform );
+                body->setLinearVelocity( btVector3( 0, 0, 0 ) );
+                body->setAngularVelocity( btVector3( 0, 0, 0 ) );
+                body->activate( true );
+            }
+        }
+
+        if( newInfo->bScale != oldInfo->bScale )
+        {
+            LOG_WARNING( newInfo->name << "'s collision shape keeps its size until a restart" );
+        }
+    }
+
+    //the lights keep their uniform locations
+    for( index = 0; index < lights.size( ) && index < config.lights.size( ) 
+                    && index < sceneConfig.lights.size( ); index++ )
+    {
+        if( config.lights[ index ].incoming != sceneConfig.lights[ index ].incoming )
+        {
+            lights[ index ].incoming = config.lights[ index ].incoming;
+        }
+
+        if( config.lights[ index ].ambient != sceneConfig.lights[ index ].ambient )
+        {
+            lights[ index ].ambient = config.lights[ index ].ambient;
+        }
+    }
+
+    for( index = 0; index < spotLight.size( ) && index < config.spotLight.size( ) 
+                    && index < sceneConfig.spotLight.size( ); index++ )
+    {
+        if( config.spotLight[ index ].incoming != sceneConfig.spotLight[ index ].incoming )
+        {
+            spotLight[ index ].incoming = config.spotLight[ index ].incoming;
+        }
+
+        if( config.spotLight[ index ].ambient != sceneConfig.spotLight[ index ].ambient )
+        {
+            spotLight[ index ].ambient = config.spotLight[ index ].ambient;
+        }
+
+        if( config.spotLight[ index ].coneAngle != sceneConfig.spotLight[ index ].coneAngle )
+        {
+            spotLight[ index ].coneAngle = config.spotLight[ index ].coneAngle;
+            spotLight[ index ].cosine = glm::cos( glm::radians( spotLight[ index ].coneAngle ) );
+        }
+
+        if( config.spotLight[ index ].spotHeight != sceneConfig.spotLight[ index ].spotHeight )
+        {
+            spotLight[ index ].spotHeight = config.spotLight[ index ].spotHeight;
+        }
+    }
+
+    if( config.windDirection != sceneConfig.windDirection 
+        || config.windForce != sceneConfig.windForce )
+    {
+        windDirection = btVector3( config.windDirection.x, 
+                                   config.windDirection.y, 
+                                   config.windDirection.z ).normalized( );
+
+        windForce = config.windForce <= 0.01f ? ShipController::STD_FORCE : config.windForce;
+
+        LOG_INFO( "Wind direction: " << config.windDirection.x << ", " 
+                  << config.windDirection.y << ", " << config.windDirection.z << "." );
+    }
+
+    //the next reload is compared against this one
+    configFile = sceneConfig.configFile;
+
+    sceneConfig = config;
+    sceneConfig.configFile = configFile;
+
+    LOG_INFO( configFile << " reloaded" );
+}
+
 void Graphics::updateLeftPaddle( unsigned int dt )
 {
     btTransform turn;
@@ -2814,7 +3731,7 @@ void Graphics::startSplitScreen( int width, int height )
     m_camera[0].changePerspective( width, height / 2 );
     if( !splitScreen )
     {
-        m_camera[1].Initialize(width, height / 2 );
+        m_camera[1].Initialize(width, height / 2, depthMode );
         
         splitScreen = true;
     }
@@ -2842,6 +3759,11 @@ bool Graphics::isPlaying( )
     return playingStateFlag;
 }
 
+float Graphics::getOceanHeight( float x, float z ) const
+{
+    return oceanGrid.getSeaLevel( ) + oceanHeightMap.getOceanHeight( x, z, waveTime );
+}
+
 
 
 
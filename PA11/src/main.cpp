@@ -3,9 +3,11 @@
 #include <vector>
 #include <string>
 #include <fstream>
-#include <sstream>
+#include <cstdlib>
+#include <cstring>
 #include "rapidxml/rapidxml.hpp"
 #include "engine.h"
+#include "SceneFile.h"
 
 //Global Constants //////////////////////////
 //config options
@@ -14,6 +16,19 @@ const string CONFIG_OPT = "-c";
 //help options
 const string HELP_OPT = "--h";
 
+//benchmark options
+const string HEADLESS_OPT = "--headless";
+const string FRAMES_OPT = "--frames";
+
+//profiler options
+const string PROFILE_OPT = "--profile";
+
+//metrics options
+const string METRICS_OPT = "--metrics";
+
+//hot reload options
+const string WATCH_OPT = "--watch";
+
 //general characters
 const char TAB_CHAR = '\t';
 
@@ -48,6 +63,9 @@ const string WIDTH = "width";
 const string HEIGHT = "height";
 const string WIND_DIRECTION = "Wind_Direction";
 const string ALT_MODEL = "alternateModel";
+const string DEPTH_BUFFER = "DepthBuffer";
+const string REVERSED = "reversed";
+const string LOGARITHMIC = "logarithmic";
 
 // free function prototypes ////////////////
 bool ProcessCommandLineParameters( int argCount, char **argVector, 
@@ -71,7 +89,13 @@ bool ProcessConfigAmbient( rapidxml::xml_node<> *parentNode,
 
 bool ProcessWind( rapidxml::xml_node<> *parentNode, GraphicsInfo& progInfo );
 
-bool IsObjectType( const string& type );
+bool IsObjectType( const char *type );
+
+unsigned int CountObjects( rapidxml::xml_node<> *parentNode );
+
+bool ParseFloat( const char *text, float& value );
+
+void ParseWord( const char *text, string& word );
 
 // main ///////////////////////////////////
 
@@ -79,6 +103,10 @@ bool IsObjectType( const string& type );
     #undef main
 #endif
 
+//the benchmark runner and the config tools have their own mains, built
+//with BENCHMARK_RUNNER and CONFIG_TOOL
+#if !defined( BENCHMARK_RUNNER ) && !defined( CONFIG_TOOL )
+
 int main(int argc, char **argv)
 {
     // Start an engine and run it then cleanup after
@@ -123,6 +151,8 @@ int main(int argc, char **argv)
     return 0;
 }
 
+#endif /* BENCHMARK_RUNNER, CONFIG_TOOL */
+
 // free function implementation /////////////
 // PROCESS COMMAND LINE PARAMETERS //////////
 /***************************************
@@ -168,6 +198,52 @@ bool ProcessCommandLineParameters
                 cout << "Failure processing the configuration file!" << std::endl;
                 return false;
             }
+
+            progInfo.configFile = tmpStr;
+        }
+        else if( tmpStr == HEADLESS_OPT )
+        {
+            progInfo.headless = true;
+        }
+        else if( tmpStr == FRAMES_OPT )
+        {
+            index++;
+
+            if( index >= argCount || atoi( argVector[ index ] ) <= 0 )
+            {
+                cout << FRAMES_OPT << " needs a number of frames above 0" << endl;
+                return false;
+            }
+
+            progInfo.benchmarkFrames = ( unsigned int ) atoi( argVector[ index ] );
+        }
+        else if( tmpStr == PROFILE_OPT )
+        {
+            index++;
+
+            if( index >= argCount )
+            {
+                cout << PROFILE_OPT << " needs a trace file name" << endl;
+                return false;
+            }
+
+            progInfo.profileFile = argVector[ index ];
+        }
+        else if( tmpStr == METRICS_OPT )
+        {
+            index++;
+
+            if( index >= argCount )
+            {
+                cout << METRICS_OPT << " needs a file name" << endl;
+                return false;
+            }
+
+            progInfo.metricsFile = argVector[ index ];
+        }
+        else if( tmpStr == WATCH_OPT )
+        {
+            progInfo.watchFiles = true;
         }
         else if( tmpStr == HELP_OPT )
         {
@@ -181,6 +257,16 @@ bool ProcessCommandLineParameters
             
             cout << "Options include: " <<endl;
             cout << CONFIG_OPT << " [CONFIG_FILE_PATH]" << endl <<endl;
+            cout << HEADLESS_OPT << ": draw offscreen without VSync and print the frame times"
+                 << endl << endl;
+            cout << FRAMES_OPT << " [NUMBER_OF_FRAMES]: frames a headless run draws, "
+                 << "1000 by default" << endl << endl;
+            cout << PROFILE_OPT << " [TRACE_FILE_PATH]: profile the whole run and write a "
+                 << "Chrome trace at the end, F11 profiles part of a run" << endl << endl;
+            cout << METRICS_OPT << " [CSV_FILE_PATH]: write the frame statistics every half "
+                 << "second, F12 shows them on screen" << endl << endl;
+            cout << WATCH_OPT << ": reload the configuration file, shaders and models "
+                 << "when they change" << endl << endl;
 
             cout <<"Example usage: " << endl;
             cout <<"./Pinball -c config/Bullet.xml" << endl << endl;
@@ -206,22 +292,44 @@ bool ProcessCommandLineParameters
 
 @brief ReadConfigurationFile
 
-@details Reads the configuration file using rapidxml
+@details Reads the configuration file using rapidxml, or maps it if it
+         is a compiled scene
 
 @param in: fileName: the name of the file to load
 
 @param out: progInfo: a struct containing program information
 
-@notes none
+@notes a compiled scene of another version is replaced by the
+       configuration file it was compiled from
 
 ***************************************/
 bool ReadConfigurationFile( const std::string & fileName, GraphicsInfo & progInfo )
 {
-    ifstream fileOpen( fileName.c_str( ) );
+    ifstream fileOpen;
     vector<char> buffer;
+    string sourceName;
     
     rapidxml::xml_document<> doc;
     rapidxml::xml_node<> *rootNode;  
+
+    if( SceneFile::IsScene( fileName ) )
+    {
+        if( SceneFile::Read( fileName, progInfo, sourceName ) )
+        {
+            return true;
+        }
+
+        if( sourceName.empty( ) || SceneFile::IsScene( sourceName ) )
+        {
+            return false;
+        }
+
+        std::cout << "Reading " << sourceName << " instead" << std::endl;
+
+        return ReadConfigurationFile( sourceName, progInfo );
+    }
+
+    fileOpen.open( fileName.c_str( ), ios::binary );
     
     if( fileOpen.fail( ) )
     {
@@ -232,16 +340,35 @@ bool ReadConfigurationFile( const std::string & fileName, GraphicsInfo & progInf
         return false;
     }
 
-    buffer = vector<char>( istreambuf_iterator<char>( fileOpen ),
-                           istreambuf_iterator<char>( ) );
+    //one read of the whole file, rapidxml parses it in place
+    fileOpen.seekg( 0, ios::end );
+    buffer.resize( ( size_t ) fileOpen.tellg( ) + 1 );
+    fileOpen.seekg( 0, ios::beg );
 
-    fileOpen.close( );
+    fileOpen.read( &buffer[ 0 ], buffer.size( ) - 1 );
 
-    buffer.push_back( '\0' );
+    buffer[ fileOpen.gcount( ) ] = '\0';
+
+    fileOpen.close( );
 
-    doc.parse<0>( &buffer[ 0 ] );
+    //a file being edited is read again, so its errors must not throw out
+    try
+    {
+        doc.parse<0>( &buffer[ 0 ] );
+    }
+    catch( const rapidxml::parse_error& error )
+    {
+        cout << "Error parsing " << fileName << ": " << error.what( ) << endl;
+        return false;
+    }
 
     rootNode = doc.first_node( "Configuration" );
+
+    if( rootNode == NULL )
+    {
+        cout << fileName << " has no Configuration node" << endl;
+        return false;
+    }
     
     return ProcessConfigurationFile( rootNode, progInfo );
 }
@@ -269,10 +396,12 @@ bool ProcessConfigurationFile
     rapidxml::xml_node<> *parentNode, *childNode;
     bool noError = true;
     string tempStr;
-	std::stringstream strStream;
 
     int sIndex;
 
+    //one allocation for the object table, not one per doubling
+    progInfo.objectData.reserve( progInfo.objectData.size( ) + CountObjects( rootNode ) );
+
     for( parentNode = rootNode->first_node( 0 ); 
          parentNode; parentNode = parentNode->next_sibling( ) )
     {        
@@ -298,21 +427,17 @@ bool ProcessConfigurationFile
             for( childNode = parentNode->first_node( 0 );
                  childNode; childNode = childNode->next_sibling( ) )
             {
-                tempStr = childNode->value( );
-
-                std::stringstream strStream( tempStr );
-
                 if( childNode->name( ) == CONE_ANGLE )
                 {
-                    strStream >> progInfo.spotLight[ sIndex ].coneAngle;
+                    ParseFloat( childNode->value( ), progInfo.spotLight[ sIndex ].coneAngle );
                 }
                 else if( childNode->name( ) == SPOT_HEIGHT )
                 {
-                    strStream >> progInfo.spotLight[ sIndex ].spotHeight;
+                    ParseFloat( childNode->value( ), progInfo.spotLight[ sIndex ].spotHeight );
                 }
                 else if( childNode->name( ) == FOLLOW_OBJ )
                 {
-                    strStream >> progInfo.spotLight[ sIndex ].objectToFollow;
+                    ParseWord( childNode->value( ), progInfo.spotLight[ sIndex ].objectToFollow );
                 }
                 else if( childNode->name( ) == LIGHT )
                 {
@@ -323,28 +448,14 @@ bool ProcessConfigurationFile
         }
 		else if( parentNode->name( ) == WINDOW_INFO )
 		{
-			strStream.clear( );
-			strStream.str( std::string( ) );
-
 			if( parentNode->first_attribute( WIDTH.c_str( ) ) )
 			{
-				tempStr = parentNode->first_attribute( WIDTH.c_str( ) )->value( );
-
-				strStream << tempStr;
-
-				strStream >> progInfo.windowSize.x;
+				ParseFloat( parentNode->first_attribute( WIDTH.c_str( ) )->value( ), progInfo.windowSize.x );
 			}
 
-			strStream.clear( );
-			strStream.str( std::string( ) );
-
 			if( parentNode->first_attribute( HEIGHT.c_str( ) ) )
 			{
-				tempStr = parentNode->first_attribute( HEIGHT.c_str( ) )->value( );
-
-				strStream << tempStr;
-
-				strStream >> progInfo.windowSize.y;
+				ParseFloat( parentNode->first_attribute( HEIGHT.c_str( ) )->value( ), progInfo.windowSize.y );
 			}
 
 			tempStr = parentNode->value( );
@@ -358,6 +469,21 @@ bool ProcessConfigurationFile
 		{
 			noError = ( noError && ProcessWind( parentNode, progInfo ) );
 		}
+        else if( parentNode->name( ) == DEPTH_BUFFER )
+        {
+            tempStr = parentNode->value( );
+
+            progInfo.depthMode = Camera::DEPTH_STANDARD;
+
+            if( tempStr.find( REVERSED ) != string::npos )
+            {
+                progInfo.depthMode = Camera::DEPTH_REVERSED;
+            }
+            else if( tempStr.find( LOGARITHMIC ) != string::npos )
+            {
+                progInfo.depthMode = Camera::DEPTH_LOGARITHMIC;
+            }
+        }
         else
         {
             //do nothing
@@ -401,6 +527,11 @@ bool ProcessConfigurationFileHelper
         return true;
     }
 
+    if( parentNode->first_attribute( "path" ) == NULL )
+    {
+        return false;
+    }
+
     tempStr = parentNode->first_attribute( "path" )->value( );
 
     if( tempStr.empty( ) )
@@ -408,7 +539,7 @@ bool ProcessConfigurationFileHelper
         return false;
     }
 
-    progInfo.objectData.push_back( ObjectInfo( ) );
+    progInfo.objectData.emplace_back( );
     pIndex = progInfo.objectData.size( ) - 1;
 
 	progInfo.objectData[ pIndex ].type = parentNode->name( );
@@ -437,73 +568,69 @@ bool ProcessConfigurationFileHelper
     for( childNode = parentNode->first_node( 0 ); childNode;
          childNode = childNode->next_sibling( ) )
     {
-        tempStr = childNode->value( );
-
-        std::stringstream strStream( tempStr );
-
         if( childNode->name( ) == NAME )
         {
-            strStream >> progInfo.objectData[ pIndex ].name;
+            ParseWord( childNode->value( ), progInfo.objectData[ pIndex ].name );
         }
         else if( childNode->name( ) == X_SCALE )
         {
-            strStream >> progInfo.objectData[ pIndex ].scale.x;
+            ParseFloat( childNode->value( ), progInfo.objectData[ pIndex ].scale.x );
         }
         else if( childNode->name( ) == Y_SCALE )
         {
-            strStream >> progInfo.objectData[ pIndex ].scale.y;
+            ParseFloat( childNode->value( ), progInfo.objectData[ pIndex ].scale.y );
         }
         else if( childNode->name( ) == Z_SCALE )
         {
-            strStream >> progInfo.objectData[ pIndex ].scale.z;
+            ParseFloat( childNode->value( ), progInfo.objectData[ pIndex ].scale.z );
         }
         else if( childNode->name( ) == BULLET_X_SCALE )
         {
-            strStream >> progInfo.objectData[ pIndex ].bScale.x;
+            ParseFloat( childNode->value( ), progInfo.objectData[ pIndex ].bScale.x );
         }
         else if( childNode->name( ) == BULLET_Y_SCALE )
         {
-            strStream >> progInfo.objectData[ pIndex ].bScale.y;
+            ParseFloat( childNode->value( ), progInfo.objectData[ pIndex ].bScale.y );
         }
         else if( childNode->name( ) == BULLET_Z_SCALE )
         {
-            strStream >> progInfo.objectData[ pIndex ].bScale.z;
+            ParseFloat( childNode->value( ), progInfo.objectData[ pIndex ].bScale.z );
         }
         else if( childNode->name( ) == X_POS )
         {
-            strStream >> progInfo.objectData[ pIndex ].position.x;
+            ParseFloat( childNode->value( ), progInfo.objectData[ pIndex ].position.x );
         }
         else if( childNode->name( ) == Y_POS )
         {
-            strStream >> progInfo.objectData[ pIndex ].position.y;
+            ParseFloat( childNode->value( ), progInfo.objectData[ pIndex ].position.y );
         }
         else if( childNode->name( ) == Z_POS )
         {
-            strStream >> progInfo.objectData[ pIndex ].position.z;
+            ParseFloat( childNode->value( ), progInfo.objectData[ pIndex ].position.z );
         }
         else if( childNode->name( ) == X_ROT_AXIS )
         {
-            strStream >> progInfo.objectData[ pIndex ].rotationAxes.x;
+            ParseFloat( childNode->value( ), progInfo.objectData[ pIndex ].rotationAxes.x );
         }
         else if( childNode->name( ) == Y_ROT_AXIS )
         {
-            strStream >> progInfo.objectData[ pIndex ].rotationAxes.y;
+            ParseFloat( childNode->value( ), progInfo.objectData[ pIndex ].rotationAxes.y );
         }
         else if( childNode->name( ) == Z_ROT_AXIS )
         {
-            strStream >> progInfo.objectData[ pIndex ].rotationAxes.z;
+            ParseFloat( childNode->value( ), progInfo.objectData[ pIndex ].rotationAxes.z );
         }
         else if( childNode->name( ) == X_ROT_ANGLE )
         {
-            strStream >> progInfo.objectData[ pIndex ].rotationAngles.x;
+            ParseFloat( childNode->value( ), progInfo.objectData[ pIndex ].rotationAngles.x );
         }
         else if( childNode->name( ) == Y_ROT_ANGLE )
         {
-            strStream >> progInfo.objectData[ pIndex ].rotationAngles.y;
+            ParseFloat( childNode->value( ), progInfo.objectData[ pIndex ].rotationAngles.y );
         }
         else if( childNode->name( ) == Z_ROT_ANGLE )
         {
-            strStream >> progInfo.objectData[ pIndex ].rotationAngles.z;
+            ParseFloat( childNode->value( ), progInfo.objectData[ pIndex ].rotationAngles.z );
         }
         else if( IsObjectType( childNode->name( ) ) )
         {
@@ -513,7 +640,7 @@ bool ProcessConfigurationFileHelper
         }
         else if( childNode->name( ) == ALT_MODEL )
         {
-            progInfo.modelVector.push_back( tempStr );
+            progInfo.modelVector.push_back( childNode->value( ) );
 
             progInfo.objectData[ pIndex ].modelID.push_back( progInfo.modelVector.size( ) - 1 );
         }
@@ -566,8 +693,6 @@ bool ProcessConfigLight( rapidxml::xml_node<>* parentNode, GraphicsInfo & progIn
     rapidxml::xml_node<> *childNode;
     bool lightX = false, lightY = false, lightZ = false, noError = false;
 
-    string tempStr;
-
     unsigned int pIndex = 0;
 
     if( !spotLight )
@@ -585,20 +710,16 @@ bool ProcessConfigLight( rapidxml::xml_node<>* parentNode, GraphicsInfo & progIn
     for( childNode = parentNode->first_node( 0 ); childNode;
          childNode = childNode->next_sibling( ) )
     {
-        tempStr = childNode->value( );
-
-        std::stringstream strStream( tempStr );
-
         if( childNode->name( ) == X_POS )
         {
             lightX = true;
             if( spotLight )
             {
-                strStream >> progInfo.spotLight[ pIndex ].incoming.x;
+                ParseFloat( childNode->value( ), progInfo.spotLight[ pIndex ].incoming.x );
             }
             else
             {
-                strStream >> progInfo.lights[ pIndex ].incoming.x;
+                ParseFloat( childNode->value( ), progInfo.lights[ pIndex ].incoming.x );
             }
             
         }
@@ -607,11 +728,11 @@ bool ProcessConfigLight( rapidxml::xml_node<>* parentNode, GraphicsInfo & progIn
             lightY = true;
             if( spotLight )
             {
-                strStream >> progInfo.spotLight[ pIndex ].incoming.y;
+                ParseFloat( childNode->value( ), progInfo.spotLight[ pIndex ].incoming.y );
             }
             else
             {
-                strStream >> progInfo.lights[ pIndex ].incoming.y;
+                ParseFloat( childNode->value( ), progInfo.lights[ pIndex ].incoming.y );
             }
             
         }
@@ -621,11 +742,11 @@ bool ProcessConfigLight( rapidxml::xml_node<>* parentNode, GraphicsInfo & progIn
 
             if( spotLight )
             {
-                strStream >> progInfo.spotLight[ pIndex ].incoming.z;
+                ParseFloat( childNode->value( ), progInfo.spotLight[ pIndex ].incoming.z );
             }
             else
             {
-                strStream >> progInfo.lights[ pIndex ].incoming.z;
+                ParseFloat( childNode->value( ), progInfo.lights[ pIndex ].incoming.z );
             }
 
             
@@ -645,8 +766,6 @@ bool ProcessConfigAmbient( rapidxml::xml_node<>* parentNode, GraphicsInfo & prog
     rapidxml::xml_node<> *childNode;
     bool lightX = false, lightY = false, lightZ = false;
 
-    string tempStr;
-
     unsigned int pIndex = 0;
 
     if( !spotLight )
@@ -662,21 +781,17 @@ bool ProcessConfigAmbient( rapidxml::xml_node<>* parentNode, GraphicsInfo & prog
     for( childNode = parentNode->first_node( 0 ); childNode;
          childNode = childNode->next_sibling( ) )
     {
-        tempStr = childNode->value( );
-
-        std::stringstream strStream( tempStr );
-
         if( childNode->name( ) == X_POS )
         {
 
             lightX = true;
             if( spotLight )
             {
-                strStream >> progInfo.spotLight[ pIndex ].ambient.x;
+                ParseFloat( childNode->value( ), progInfo.spotLight[ pIndex ].ambient.x );
             }
             else
             {
-                strStream >> progInfo.lights[ pIndex ].ambient.x;
+                ParseFloat( childNode->value( ), progInfo.lights[ pIndex ].ambient.x );
             }
             
         }
@@ -685,11 +800,11 @@ bool ProcessConfigAmbient( rapidxml::xml_node<>* parentNode, GraphicsInfo & prog
             lightY = true;
             if( spotLight )
             {
-                strStream >> progInfo.spotLight[ pIndex ].ambient.y;
+                ParseFloat( childNode->value( ), progInfo.spotLight[ pIndex ].ambient.y );
             }
             else
             {
-                strStream >> progInfo.lights[ pIndex ].ambient.y;
+                ParseFloat( childNode->value( ), progInfo.lights[ pIndex ].ambient.y );
             }
             
         }
@@ -698,11 +813,11 @@ bool ProcessConfigAmbient( rapidxml::xml_node<>* parentNode, GraphicsInfo & prog
             lightZ = true;
             if( spotLight )
             {
-                strStream >> progInfo.spotLight[ pIndex ].ambient.z;
+                ParseFloat( childNode->value( ), progInfo.spotLight[ pIndex ].ambient.z );
             }
             else
             {
-                strStream >> progInfo.lights[ pIndex ].ambient.z;
+                ParseFloat( childNode->value( ), progInfo.lights[ pIndex ].ambient.z );
             }
             
         }
@@ -715,40 +830,34 @@ bool ProcessWind( rapidxml::xml_node<>* parentNode, GraphicsInfo & progInfo )
 {
 	rapidxml::xml_node<> *childNode;
 
-	string tempStr;
-
 	for( childNode = parentNode->first_node( 0 ); childNode;
 		 childNode = childNode->next_sibling( ) )
 	{
-		tempStr = childNode->value( );
-
-		std::stringstream strStream( tempStr );
-
 		if( childNode->name( ) == X_POS )
 		{
-			strStream >> progInfo.windDirection.x;
+			ParseFloat( childNode->value( ), progInfo.windDirection.x );
 
 		}
 		else if( childNode->name( ) == Y_POS )
 		{
-			strStream >> progInfo.windDirection.y;
+			ParseFloat( childNode->value( ), progInfo.windDirection.y );
 
 		}
 		else if( childNode->name( ) == Z_POS )
 		{
-			strStream >> progInfo.windDirection.z;
+			ParseFloat( childNode->value( ), progInfo.windDirection.z );
 
 		}
 		else if( childNode->name( ) == X_SCALE )
 		{
-			strStream >> progInfo.windForce;
+			ParseFloat( childNode->value( ), progInfo.windForce );
 
 		}
 	}
 	return true;
 }
 
-bool IsObjectType( const string & type )
+bool IsObjectType( const char *type )
 {
 	if( ( type == OBJECT_TYPE ) 
 		|| ( type == P_OBJECT_TYPE ) 
@@ -759,3 +868,96 @@ bool IsObjectType( const string & type )
 
 	return false;
 }
+
+// COUNT OBJECTS //////////
+/***************************************
+
+@brief CountObjects
+
+@details counts the objects under a node, children included
+
+@param in: parentNode: the node in the xml doc
+
+@notes None
+
+***************************************/
+unsigned int CountObjects( rapidxml::xml_node<> *parentNode )
+{
+    rapidxml::xml_node<> *childNode;
+    unsigned int count = 0;
+
+    if( parentNode == NULL )
+    {
+        return 0;
+    }
+
+    for( childNode = parentNode->first_node( 0 ); childNode;
+         childNode = childNode->next_sibling( ) )
+    {
+        if( IsObjectType( childNode->name( ) ) )
+        {
+            count += 1 + CountObjects( childNode );
+        }
+    }
+
+    return count;
+}
+
+// PARSE FLOAT //////////
+/***************************************
+
+@brief ParseFloat
+
+@details reads a number from a node's text in place
+
+@param in: text: the node's text
+
+@param out: value: the number, 0 if the text is not a number
+
+@notes matches what a stringstream read, without building a stream and a
+       string for every value in the file
+
+***************************************/
+bool ParseFloat( const char *text, float& value )
+{
+    char *end;
+
+    value = std::strtof( text, &end );
+
+    if( end == text )
+    {
+        value = 0.0f;
+
+        return false;
+    }
+
+    return true;
+}
+
+// PARSE WORD //////////
+/***************************************
+
+@brief ParseWord
+
+@details reads the first word of a node's text
+
+@param in: text: the node's text
+
+@param out: word: the first word, left as is if there is none
+
+@notes None
+
+***************************************/
+void ParseWord( const char *text, string& word )
+{
+    const char *whiteSpace = " \t\r\n";
+    size_t start, length;
+
+    start = std::strspn( text, whiteSpace );
+    length = std::strcspn( text + start, whiteSpace );
+
+    if( length > 0 )
+    {
+        word.assign( text + start, length );
+    }
+}
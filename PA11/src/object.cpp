@@ -1,6 +1,8 @@
 #include "object.h"
 #include <algorithm>
 
+#include "RenderStats.h"
+
 Object::Object()
 {
     model = glm::mat4(1.0f);
@@ -123,6 +125,33 @@ glm::mat4 Object::GetModel()
     return model;
 }
 
+// GET MODEL //////////////////
+/***************************************
+
+@brief GetModel
+
+@details returns the model with its translation taken relative to
+         an origin
+
+@param in: origin: the world position the model is drawn relative to,
+           usually the camera's eye
+
+@notes the difference is found in double precision, so the matrix sent
+       to the shader only holds the small offset from the eye
+
+***************************************/
+glm::mat4 Object::GetModel( const glm::dvec3& origin )
+{
+    glm::mat4 relativeModel = model;
+
+    relativeModel[ 3 ] = glm::vec4( ( float ) ( ( double ) model[ 3 ].x - origin.x ),
+                                    ( float ) ( ( double ) model[ 3 ].y - origin.y ),
+                                    ( float ) ( ( double ) model[ 3 ].z - origin.z ),
+                                    model[ 3 ].w );
+
+    return relativeModel;
+}
+
 
 // GET ORIGIN //////////////////
 /***************************************
@@ -226,11 +255,17 @@ void Object::Render()
     unsigned int index;
 
     //no model, nothing to render
-    if( !hasObjectModel( ) || !render )
+    if( !hasObjectModel( ) )
     {
         return;
     }
 
+    if( !render )
+    {
+        RenderStats::addCulled( );
+        return;
+    }
+
     glEnableVertexAttribArray( 0 );
     glEnableVertexAttribArray( 1 );
     glEnableVertexAttribArray( 2 );
@@ -263,6 +298,8 @@ void Object::Render()
         glDrawElements( GL_TRIANGLES,
                         objModelPtr[ objModelSelect ]->getIndices( index ).size( ),
                         GL_UNSIGNED_INT, 0 );
+
+        RenderStats::addDraw( objModelPtr[ objModelSelect ]->getIndices( index ).size( ) );
     }
 
     glDisableVertexAttribArray( 0 );
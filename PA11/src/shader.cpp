@@ -1,13 +1,59 @@
 #include "shader.h"
+#include "GLDebug.h"
+#include <utility>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <sstream>
+#include <iomanip>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#if defined( _WIN64 ) || defined( _WIN32 )
+    #include <direct.h>
+#endif
+
+std::string Shader::cacheDirectory;
+std::string Shader::driverName;
+
+// file data //////////////////////////////
+
+//a cached program is this header, the driver's name and the driver's
+//binary. every field is four or eight bytes so the header has no padding
+struct ProgramCacheHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t sourceHash; //of the shader types and sources
+    uint32_t driverLength;
+    uint32_t binaryFormat;
+    uint32_t binaryLength;
+    uint32_t reserved;
+};
+
+// free function prototypes ///////////////
+
+static uint64_t HashBytes( uint64_t hash, const void* bytes, size_t size );
+
+static std::string DefineLines( const std::vector<std::pair<std::string, int>>& defines );
+
+static void InsertDefines( std::string& source, const std::string& defineLines );
 
 Shader::Shader()
 {
     m_shaderProg = 0;
 	inUse = false;
+    linkStarted = false;
+    fromCache = false;
 }
 
 Shader::~Shader()
 {
+    for (std::vector<Variant>::iterator it = m_variants.begin(); it != m_variants.end(); it++)
+    {
+        delete it->program;
+    }
+
     for (std::vector<GLuint>::iterator it = m_shaderObjList.begin() ; it != m_shaderObjList.end() ; it++)
     {
         glDeleteShader(*it);
@@ -33,6 +79,25 @@ bool Shader::Initialize()
     return true;
 }
 
+// SET DEFINES //////////////////
+/***************************************
+
+@brief SetDefines
+
+@details defines names after the #version line of every shader added
+         from now on
+
+@param in: defines: the names and values to define
+
+@notes call it before AddShader. the variants are built from the
+       sources with these in them, so they keep them
+
+***************************************/
+void Shader::SetDefines( const std::vector<std::pair<std::string, int>>& defines )
+{
+    m_defines = DefineLines( defines );
+}
+
 // Use this method to add shaders to the program. When finished - call finalize()
 bool Shader::AddShader(GLenum ShaderType, const std::string& fileName)
 {
@@ -44,50 +109,133 @@ bool Shader::AddShader(GLenum ShaderType, const std::string& fileName)
         return false;
     }
 
-    GLuint ShaderObj = glCreateShader( ShaderType );
+    return AddShaderSource( ShaderType, srcStr, fileName );
+}
 
-    if (ShaderObj == 0) 
+// Adds a shader already read from fileName, so the file can be read on
+// another thread and only compiled on the render thread. The shader is
+// compiled by Link, once the program's binary is known to be missing
+bool Shader::AddShaderSource(GLenum ShaderType, const std::string& srcStr, const std::string& fileName)
+{
+    if (linkStarted)
     {
-        std::cerr << "Error creating shader type " << ShaderType << std::endl;
+        std::cerr << "Error adding " << fileName << ", the program is already linked" << std::endl;
         return false;
     }
 
-    // Save the shader object - will be deleted in the destructor
-    m_shaderObjList.push_back(ShaderObj);
+    m_sources.push_back( std::make_pair( ShaderType, srcStr ) );
+    m_sourceFiles.push_back( fileName );
+
+    if( !m_defines.empty( ) )
+    {
+        InsertDefines( m_sources.back( ).second, m_defines );
+    }
+
+    //the program is named after its shaders
+    programLabel += ( programLabel.empty( ) ? "" : " + " ) + fileName;
+
+    return true;
+}
+
+// LINK //////////////////
+/***************************************
+
+@brief Link
+
+@details loads the program's cached binary, or starts compiling its
+         shaders and linking it
+
+@param None
 
+@notes nothing is waited on, so the driver can build several programs at
+       once when each is linked before any is finalized. the compile and
+       link errors are reported by Finalize
+
+***************************************/
+bool Shader::Link( )
+{
+    unsigned int index;
+    GLuint ShaderObj;
     const GLchar* p[1];
-    p[0] = srcStr.c_str();
-    GLint Lengths[1] = { (GLint)srcStr.size() };
+    GLint Lengths[1];
+
+    if( linkStarted )
+    {
+        return true;
+    }
 
-    glShaderSource(ShaderObj, 1, p, Lengths);
+    linkStarted = true;
 
-    glCompileShader(ShaderObj);
+    if( loadBinary( ) )
+    {
+        fromCache = true;
 
-    GLint success;
-    glGetShaderiv(ShaderObj, GL_COMPILE_STATUS, &success);
+        return true;
+    }
 
-    if (!success) 
+    for( index = 0; index < m_sources.size( ); index++ )
     {
-        GLchar InfoLog[1024];
-        glGetShaderInfoLog(ShaderObj, 1024, NULL, InfoLog);
-        std::cerr << "Error compiling: " << InfoLog << std::endl;
-        std::cout << "Error compiling: " << InfoLog << std::endl;
-        return false;
+        ShaderObj = glCreateShader( m_sources[ index ].first );
+
+        if (ShaderObj == 0) 
+        {
+            std::cerr << "Error creating shader type " << m_sources[ index ].first << std::endl;
+            return false;
+        }
+
+        // Save the shader object - will be deleted in the destructor
+        m_shaderObjList.push_back(ShaderObj);
+
+        GL_LABEL( GL_SHADER, ShaderObj, m_sourceFiles[ index ] );
+
+        p[0] = m_sources[ index ].second.c_str();
+        Lengths[0] = (GLint)m_sources[ index ].second.size();
+
+        glShaderSource(ShaderObj, 1, p, Lengths);
+
+        glCompileShader(ShaderObj);
+
+        glAttachShader(m_shaderProg, ShaderObj);
+    }
+
+    //asked for before linking, some drivers only keep a binary when told to
+    if( !cacheDirectory.empty( ) )
+    {
+        glProgramParameteri( m_shaderProg, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE );
     }
 
-    glAttachShader(m_shaderProg, ShaderObj);
+    glLinkProgram(m_shaderProg);
 
     return true;
 }
 
-
 // After all the shaders have been added to the program call this function
-// to link and validate the program.
+// to link and validate the program. It waits for a program started by Link,
+// and links one that was not
 bool Shader::Finalize()
 {
     GLint Success = 0;
     GLchar ErrorLog[1024] = { 0 };
-    glLinkProgram(m_shaderProg);
+    unsigned int index;
+
+    if (!Link())
+    {
+        return false;
+    }
+
+    //a compile error is reported with the file it came from
+    for (index = 0; index < m_shaderObjList.size(); index++)
+    {
+        glGetShaderiv(m_shaderObjList[index], GL_COMPILE_STATUS, &Success);
+
+        if (!Success) 
+        {
+            glGetShaderInfoLog(m_shaderObjList[index], sizeof(ErrorLog), NULL, ErrorLog);
+            std::cerr << "Error compiling " << m_sourceFiles[index] << ": " << ErrorLog << std::endl;
+            std::cout << "Error compiling " << m_sourceFiles[index] << ": " << ErrorLog << std::endl;
+            return false;
+        }
+    }
 
     glGetProgramiv(m_shaderProg, GL_LINK_STATUS, &Success);
     if (Success == 0)
@@ -97,6 +245,11 @@ bool Shader::Finalize()
         return false;
     }
 
+    GL_LABEL( GL_PROGRAM, m_shaderProg, programLabel );
+
+    // Validating checks the program against the current state and can wait
+    // on the driver, so only debug builds do it
+#ifdef GL_DEBUG
     glValidateProgram(m_shaderProg);
     glGetProgramiv(m_shaderProg, GL_VALIDATE_STATUS, &Success);
     if (!Success)
@@ -105,6 +258,12 @@ bool Shader::Finalize()
         std::cerr << "Invalid shader program: " << ErrorLog << std::endl;
         return false;
     }
+#endif
+
+    if (!fromCache)
+    {
+        saveBinary();
+    }
 
     // Delete the intermediate shader objects that have been added to the program
     for (std::vector<GLuint>::iterator it = m_shaderObjList.begin(); it != m_shaderObjList.end(); it++)
@@ -114,6 +273,8 @@ bool Shader::Finalize()
 
     m_shaderObjList.clear();
 
+    //the sources are kept for the variants
+
     return true;
 }
 
@@ -130,6 +291,90 @@ void Shader::Disable( )
 }
 
 
+// Trades programs with another shader, so a rebuilt program replaces this
+// one only once it has linked
+void Shader::Swap( Shader& other )
+{
+    std::swap( m_shaderProg, other.m_shaderProg );
+    std::swap( m_shaderObjList, other.m_shaderObjList );
+    std::swap( m_sources, other.m_sources );
+    std::swap( m_sourceFiles, other.m_sourceFiles );
+    std::swap( programLabel, other.programLabel );
+    std::swap( m_defines, other.m_defines );
+    std::swap( inUse, other.inUse );
+    std::swap( linkStarted, other.linkStarted );
+    std::swap( fromCache, other.fromCache );
+    std::swap( m_variants, other.m_variants );
+}
+
+// GET VARIANT //////////////////
+/***************************************
+
+@brief GetVariant
+
+@details returns the program built from this one's sources with defines
+         added after each #version line, building it the first time
+
+@param in: defines: the names and values to define
+
+@notes the variant belongs to this program and is deleted with it. a
+       variant that fails to build is reported once and NULL is returned
+       from then on, so the caller can keep using this program
+
+***************************************/
+Shader* Shader::GetVariant( const std::vector<std::pair<std::string, int>>& defines )
+{
+    std::ostringstream labelStream;
+    std::string source;
+    Variant variant;
+    unsigned int index;
+    bool built;
+
+    for( index = 0; index < defines.size( ); index++ )
+    {
+        labelStream << ( index == 0 ? " [" : ", " ) << defines[ index ].first << " " << defines[ index ].second;
+    }
+
+    labelStream << ( defines.empty( ) ? "" : "]" );
+
+    variant.defines = DefineLines( defines );
+
+    for( index = 0; index < m_variants.size( ); index++ )
+    {
+        if( m_variants[ index ].defines == variant.defines )
+        {
+            return m_variants[ index ].program;
+        }
+    }
+
+    variant.program = new Shader( );
+
+    built = variant.program->Initialize( );
+
+    for( index = 0; index < m_sources.size( ) && built; index++ )
+    {
+        source = m_sources[ index ].second;
+
+        InsertDefines( source, variant.defines );
+
+        built = variant.program->AddShaderSource( m_sources[ index ].first, source,
+                                                  m_sourceFiles[ index ] + labelStream.str( ) );
+    }
+
+    if( !built || !variant.program->Finalize( ) )
+    {
+        std::cerr << "Error building " << programLabel << labelStream.str( ) << std::endl;
+
+        delete variant.program;
+        variant.program = NULL;
+    }
+
+    m_variants.push_back( variant );
+
+    return variant.program;
+}
+
+
 GLint Shader::GetUniformLocation(const char* pUniformName)
 {
     GLuint Location = glGetUniformLocation(m_shaderProg, pUniformName);
@@ -141,8 +386,236 @@ GLint Shader::GetUniformLocation(const char* pUniformName)
     return Location;
 }
 
+// INITIALIZE CACHE //////////////////
+/***************************************
+
+@brief InitializeCache
+
+@details turns on the program binary cache and parallel compiling when
+         the driver has them
+
+@param in: directory: where the binaries are kept, made if it is missing
+
+@notes needs the context. returns false, and leaves the programs compiled
+       every run, without ARB_get_program_binary or a binary format
+
+***************************************/
+bool Shader::InitializeCache( const std::string& directory )
+{
+    GLint formats = 0;
+    struct stat directoryInfo;
+    const GLubyte *vendor, *renderer, *version;
+
+    cacheDirectory.clear( );
+
+#if defined(__APPLE__) || defined(MACOSX)
+    std::cout << "Program binaries are not cached on this system." << std::endl;
+
+    return false;
+#else
+    //the driver picks how many threads compile the programs
+    if( GLEW_KHR_parallel_shader_compile )
+    {
+        glMaxShaderCompilerThreadsKHR( 0xFFFFFFFF );
+    }
+
+    if( !GLEW_ARB_get_program_binary )
+    {
+        std::cout << "Program binaries are not available, the shaders are compiled every run." << std::endl;
+        return false;
+    }
+
+    glGetIntegerv( GL_NUM_PROGRAM_BINARY_FORMATS, &formats );
+
+    if( formats <= 0 )
+    {
+        std::cout << "The driver keeps no program binaries, the shaders are compiled every run." << std::endl;
+        return false;
+    }
+
+    #if defined( _WIN64 ) || defined( _WIN32 )
+        _mkdir( directory.c_str( ) );
+    #else
+        mkdir( directory.c_str( ), 0755 );
+    #endif
+
+    if( stat( directory.c_str( ), &directoryInfo ) != 0 || !( directoryInfo.st_mode & S_IFDIR ) )
+    {
+        std::cout << "Unable to make " << directory << ", the shaders are compiled every run." << std::endl;
+        return false;
+    }
+
+    vendor = glGetString( GL_VENDOR );
+    renderer = glGetString( GL_RENDERER );
+    version = glGetString( GL_VERSION );
+
+    //a binary from another driver, or another version of it, is compiled again
+    driverName = std::string( vendor != NULL ? ( const char* ) vendor : "" ) + " | "
+               + std::string( renderer != NULL ? ( const char* ) renderer : "" ) + " | "
+               + std::string( version != NULL ? ( const char* ) version : "" );
+
+    cacheDirectory = directory;
+
+    return true;
+#endif
+}
+
 // private member functions
 
+// LOAD BINARY //////////////////
+/***************************************
+
+@brief loadBinary
+
+@details loads the program from its cached binary
+
+@param None
+
+@notes returns false, and the program is compiled, if there is no binary,
+       it was written for other sources or another driver, or the driver
+       turns it down
+
+***************************************/
+bool Shader::loadBinary( )
+{
+    std::ifstream fileIn;
+    std::string contents;
+    ProgramCacheHeader header;
+    GLint Success = 0;
+
+    if( cacheDirectory.empty( ) )
+    {
+        return false;
+    }
+
+    fileIn.open( cacheFileName( ).c_str( ), std::ios::binary );
+
+    if( fileIn.fail( ) )
+    {
+        return false;
+    }
+
+    contents = std::string( std::istreambuf_iterator<char>( fileIn ),
+                            std::istreambuf_iterator<char>( ) );
+
+    fileIn.close( );
+
+    if( contents.size( ) < sizeof( header ) )
+    {
+        return false;
+    }
+
+    std::memcpy( &header, contents.data( ), sizeof( header ) );
+
+    //a file cut short is compiled again and rewritten
+    if( header.magic != CACHE_MAGIC || header.version != CACHE_VERSION
+        || header.sourceHash != sourceHash( )
+        || contents.size( ) != sizeof( header ) + header.driverLength + header.binaryLength
+        || contents.compare( sizeof( header ), header.driverLength, driverName ) != 0 )
+    {
+        return false;
+    }
+
+    glProgramBinary( m_shaderProg, header.binaryFormat,
+                     contents.data( ) + sizeof( header ) + header.driverLength,
+                     header.binaryLength );
+
+    glGetProgramiv( m_shaderProg, GL_LINK_STATUS, &Success );
+
+    return Success != 0;
+}
+
+// SAVE BINARY //////////////////
+/***************************************
+
+@brief saveBinary
+
+@details writes the linked program's binary to the cache
+
+@param None
+
+@notes a failed write is only reported, the next run compiles again
+
+***************************************/
+void Shader::saveBinary( )
+{
+    std::ofstream fileOut;
+    std::vector<char> binary;
+    ProgramCacheHeader header;
+    GLint length = 0;
+    GLenum format = 0;
+
+    if( cacheDirectory.empty( ) )
+    {
+        return;
+    }
+
+    glGetProgramiv( m_shaderProg, GL_PROGRAM_BINARY_LENGTH, &length );
+
+    if( length <= 0 )
+    {
+        return;
+    }
+
+    binary.resize( length );
+
+    glGetProgramBinary( m_shaderProg, length, &length, &format, &binary[ 0 ] );
+
+    std::memset( &header, 0, sizeof( header ) );
+
+    header.magic = CACHE_MAGIC;
+    header.version = CACHE_VERSION;
+    header.sourceHash = sourceHash( );
+    header.driverLength = driverName.size( );
+    header.binaryFormat = format;
+    header.binaryLength = length;
+
+    fileOut.open( cacheFileName( ).c_str( ), std::ios::binary | std::ios::trunc );
+
+    fileOut.write( ( const char* ) &header, sizeof( header ) );
+    fileOut.write( driverName.data( ), driverName.size( ) );
+    fileOut.write( &binary[ 0 ], length );
+
+    if( fileOut.fail( ) )
+    {
+        std::cerr << "Unable to cache the program " << programLabel << std::endl;
+    }
+}
+
+// hashes the shader types and sources, any edit gives a new hash
+uint64_t Shader::sourceHash( ) const
+{
+    uint64_t hash = 14695981039346656037ULL;
+    uint32_t type;
+    uint64_t size;
+    unsigned int index;
+
+    for( index = 0; index < m_sources.size( ); index++ )
+    {
+        type = m_sources[ index ].first;
+        size = m_sources[ index ].second.size( );
+
+        hash = HashBytes( hash, &type, sizeof( type ) );
+        hash = HashBytes( hash, &size, sizeof( size ) );
+        hash = HashBytes( hash, m_sources[ index ].second.data( ), size );
+    }
+
+    return hash;
+}
+
+// names the binary after the program's files, so an edited program
+// replaces its old binary
+std::string Shader::cacheFileName( ) const
+{
+    std::ostringstream name;
+
+    name << cacheDirectory << "/" << std::hex << std::setw( 16 ) << std::setfill( '0' )
+         << HashBytes( 14695981039346656037ULL, programLabel.data( ), programLabel.size( ) )
+         << ".bin";
+
+    return name.str( );
+}
+
 // LOAD SHADER SOURCE //////////////////
 /***************************************
 
@@ -185,3 +658,87 @@ bool Shader::loadShaderSource
 
     return true;
 }
+
+// free function implementation /////////////
+
+// HASH BYTES //////////
+/***************************************
+
+@brief HashBytes
+
+@details adds bytes to a 64 bit FNV-1a hash
+
+@param in: hash: the hash so far, 14695981039346656037 to start
+
+@param in: bytes: the bytes to add
+
+@param in: size: the number of bytes
+
+@notes not for security, only to tell sources apart
+
+***************************************/
+static uint64_t HashBytes( uint64_t hash, const void* bytes, size_t size )
+{
+    const unsigned char *data = ( const unsigned char* ) bytes;
+    size_t index;
+
+    for( index = 0; index < size; index++ )
+    {
+        hash ^= data[ index ];
+        hash *= 1099511628211ULL;
+    }
+
+    return hash;
+}
+
+// DEFINE LINES //////////
+/***************************************
+
+@brief DefineLines
+
+@details writes a #define line for each name
+
+@param in: defines: the names and values to define
+
+@notes None
+
+***************************************/
+static std::string DefineLines( const std::vector<std::pair<std::string, int>>& defines )
+{
+    std::ostringstream defineStream;
+    unsigned int index;
+
+    for( index = 0; index < defines.size( ); index++ )
+    {
+        defineStream << "#define " << defines[ index ].first << " " << defines[ index ].second << "\n";
+    }
+
+    return defineStream.str( );
+}
+
+// INSERT DEFINES //////////
+/***************************************
+
+@brief InsertDefines
+
+@details puts #define lines after a shader's #version line
+
+@param in/out: source: the shader source
+
+@param in: defineLines: the lines from DefineLines
+
+@notes a #line follows the defines, so the compiler's errors are
+       numbered as in the file
+
+***************************************/
+static void InsertDefines( std::string& source, const std::string& defineLines )
+{
+    size_t insertAt;
+
+    insertAt = source.find( "#version" );
+    insertAt = insertAt == std::string::npos ? 0 : source.find( '\n', insertAt );
+    insertAt = insertAt == std::string::npos ? source.size( ) : insertAt + 1;
+
+    source.insert( insertAt, defineLines + "#line " + std::to_string(
+                   std::count( source.begin( ), source.begin( ) + insertAt, '\n' ) + 1 ) + "\n" );
+}
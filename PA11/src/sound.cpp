@@ -1,129 +1,581 @@
 #include "sound.h"
+#include "Profiler.h"
 
-Uint8 *soundPosition;
-Uint32 soundRemaining;
-SDL_atomic_t audioCallbackLeft;
+#include <algorithm>
+#include <cmath>
 
-void myCallback( void *userData, Uint8 *stream, int length );
+const float Sound::REFERENCE_DISTANCE = 25.0f;
+const float Sound::MAX_DISTANCE = 2000.0f;
+const float Sound::AUDIBLE_GAIN = 0.01f;
 
 Sound::Sound()
 {
-	 soundLoaded = false;
-	 soundPlaying = false;
-     alive = true;
+	queueHead = 0;
+	queueTail = 0;
+	idle = true;
 
-	 threadManager = NULL;
+	listenerWrite = 0;
+	listenerReady = 1;
+	listenerRead = 2;
+
+	dev = 0;
+	devicePaused = true;
 }
+
 Sound::~Sound()
 {
-    alive = false;
-    
-    if( threadManager != NULL )
-    {
+	if( dev != 0 )
+	{
+		//stops the callback before the clips go away
+		SDL_CloseAudioDevice( dev );
+		dev = 0;
+	}
+}
+
+// LOAD SOUND //////////////////
+/***************************************
 
-        threadManager->join( );
-        delete threadManager;
-        threadManager = NULL;
-    }
+@brief loadSound
 
-    SDL_PauseAudioDevice( dev, 1 );
+@details loads a wav file and converts it to the mixer's format
 
-	SDL_CloseAudioDevice( dev );
+@param in: soundPath: the path to the wav file
 
-	if( soundLoaded )
+@notes returns the id to play the sound with, or -1 on failure
+
+***************************************/
+int Sound::loadSound( std::string soundPath )
+{
+	SDL_AudioSpec wavSpec;
+	Uint8 *wavBuffer = NULL;
+	Uint32 wavLength = 0;
+	SDL_AudioCVT converter;
+	std::vector<Sint16> samples;
+	int soundID;
+
+	if( dev == 0 && !openDevice( ) )
+	{
+		return -1;
+	}
+
+	if( SDL_LoadWAV( soundPath.c_str(), &wavSpec, &wavBuffer, &wavLength ) == NULL )
+	{
+		std::cout << "Unable to load sound" << std::endl;
+		return -1;
+	}
+
+	if( SDL_BuildAudioCVT( &converter, wavSpec.format, wavSpec.channels, wavSpec.freq,
+						   AUDIO_S16SYS, 2, deviceSpec.freq ) < 0 )
+	{
+		std::cout << "Unable to convert sound: " << SDL_GetError( ) << std::endl;
+		SDL_FreeWAV( wavBuffer );
+		return -1;
+	}
+
+	//convert in place inside a buffer large enough for the result
+	std::vector<Uint8> converted( wavLength * std::max( converter.len_mult, 1 ) );
+
+	std::copy( wavBuffer, wavBuffer + wavLength, converted.begin( ) );
+
+	SDL_FreeWAV( wavBuffer );
+
+	converter.len = wavLength;
+	converter.buf = &converted[ 0 ];
+
+	if( converter.needed )
+	{
+		SDL_ConvertAudio( &converter );
+	}
+	else
 	{
-		SDL_FreeWAV( soundBuffer );
+		converter.len_cvt = wavLength;
 	}
-  
+
+	samples.resize( converter.len_cvt / sizeof( Sint16 ) );
+
+	std::copy( converted.begin( ), converted.begin( ) + samples.size( ) * sizeof( Sint16 ),
+			   reinterpret_cast<Uint8 *>( &samples[ 0 ] ) );
+
+	//the callback reads the clip list, so it must not run while it grows
+	SDL_LockAudioDevice( dev );
+
+	clips.push_back( std::vector<Sint16>( ) );
+	clips.back( ).swap( samples );
+	soundID = clips.size( ) - 1;
+
+	SDL_UnlockAudioDevice( dev );
+
+	return soundID;
 }
 
-void Sound::loadSound( std::string soundPath )
+// PLAY SOUND //////////////////
+/***************************************
+
+@brief playSound
+
+@details queues a clip to be started by the mixer
+
+@param in: soundID: the id returned by loadSound
+
+@param in: gain: the volume of the voice, 1 is the clip's volume
+
+@param in: pan: -1 is fully left, 1 is fully right
+
+@param in: priority: how important the sound is when voices run out
+
+@notes never blocks; returns false if the queue is full
+
+***************************************/
+bool Sound::playSound( int soundID, float gain, float pan, int priority )
 {
-	if( SDL_LoadWAV( soundPath.c_str(), &soundSpec, &soundBuffer, &soundLength ) == NULL )
+	PlayCommand command;
+
+	command.clip = soundID;
+	command.priority = priority;
+	command.gain = gain;
+	command.pan = std::min( std::max( pan, -1.0f ), 1.0f );
+
+	return pushPlayCommand( command );
+}
+
+// PLAY SOUND AT //////////////////
+/***************************************
+
+@brief playSoundAt
+
+@details queues a clip that is heard from a point in the world
+
+@param in: soundID: the id returned by loadSound
+
+@param in: position: where the sound comes from in world space
+
+@param in: priority: how important the sound is when voices run out
+
+@param in: gain: the volume of the voice before attenuation
+
+@notes the mixer attenuates and pans the voice against the
+       listeners every callback
+
+***************************************/
+bool Sound::playSoundAt( int soundID, const glm::vec3& position, int priority, float gain )
+{
+	PlayCommand command;
+
+	command.clip = soundID;
+	command.priority = priority;
+	command.positional = true;
+	command.source = position;
+	command.gain = gain;
+
+	return pushPlayCommand( command );
+}
+
+// SET LISTENERS //////////////////
+/***************************************
+
+@brief setListeners
+
+@details hands the current camera views to the mixer
+
+@param in: views: the view matrix of each camera
+
+@param in: numberOfViews: the number of cameras in use
+
+@notes called once a frame from the game thread. each voice is
+       heard from the nearest listener
+
+***************************************/
+void Sound::setListeners( const glm::mat4* views, int numberOfViews )
+{
+	ListenerSet& listenerSet = listenerSets[ listenerWrite ];
+	glm::mat4 cameraToWorld;
+	int index;
+
+	listenerSet.count = std::min( numberOfViews, ( int ) MAX_LISTENERS );
+
+	for( index = 0; index < listenerSet.count; index++ )
+	{
+		cameraToWorld = glm::inverse( views[ index ] );
+
+		listenerSet.listeners[ index ].position = glm::vec3( cameraToWorld[ 3 ] );
+		listenerSet.listeners[ index ].right = glm::normalize( glm::vec3( cameraToWorld[ 0 ] ) );
+	}
+
+	//publish the set and take back the one the callback is done with
+	listenerWrite = listenerReady.exchange( listenerWrite | NEW_LISTENERS ) & ~NEW_LISTENERS;
+}
+
+void Sound::launchSound( )
+{
+	playSound( 0 );
+}
+
+// UPDATE //////////////////
+/***************************************
+
+@brief Update
+
+@details pauses the device once the mixer has gone quiet
+
+@param None
+
+@notes called once a frame from the game thread. the device lock
+       keeps the callback from running between the check and
+       the pause
+
+***************************************/
+void Sound::Update( )
+{
+	if( dev == 0 || devicePaused || !idle )
 	{
-		std::cout << "Unable to load sound" << std::endl;
 		return;
 	}
 
-	soundSpec.callback = myCallback;
-	soundSpec.userdata = NULL;
-	soundLoaded = true;
+	SDL_LockAudioDevice( dev );
+
+	if( idle && queueHead == queueTail )
+	{
+		SDL_PauseAudioDevice( dev, 1 );
+		devicePaused = true;
+	}
+
+	SDL_UnlockAudioDevice( dev );
+}
+
+bool Sound::SoundPlaying( )
+{
+	return !idle;
+}
+
+SDL_AudioDeviceID Sound::getDevice( ) const
+{
+	return dev;
+}
+
+void Sound::AudioCallback( void *userData, Uint8 *stream, int length )
+{
+	static_cast<Sound *>( userData )->mix( reinterpret_cast<Sint16 *>( stream ),
+										   length / ( 2 * sizeof( Sint16 ) ) );
+}
+
+// private member functions
 
-    dev = SDL_OpenAudioDevice( NULL, 0, &soundSpec, NULL, SDL_AUDIO_ALLOW_ANY_CHANGE );
+bool Sound::openDevice( )
+{
+	SDL_AudioSpec desired;
+
+	SDL_memset( &desired, 0, sizeof( desired ) );
+
+	desired.freq = MIX_FREQUENCY;
+	desired.format = AUDIO_S16SYS;
+	desired.channels = 2;
+	desired.samples = MIX_SAMPLES;
+	desired.callback = AudioCallback;
+	desired.userdata = this;
+
+	//no changes allowed, SDL converts to the hardware format for us
+	dev = SDL_OpenAudioDevice( NULL, 0, &desired, &deviceSpec, 0 );
 
 	if( dev == 0 )
 	{
 		std::cout << "Couldn't open audio: " << SDL_GetError( ) << std::endl;
+		return false;
+	}
+
+	mixBuffer.resize( 2 * deviceSpec.samples );
 
+	devicePaused = true;
+
+	return true;
+}
+
+// PUSH PLAY COMMAND //////////////////
+/***************************************
+
+@brief pushPlayCommand
+
+@details hands a play command to the mixer and wakes the device
+
+@param in: command: the sound to start
+
+@notes the idle flag is cleared first so Update cannot pause the
+       device before the callback has seen the command
+
+***************************************/
+bool Sound::pushPlayCommand( const PlayCommand& command )
+{
+	if( dev == 0 || command.clip < 0 || command.clip >= ( int ) clips.size( ) )
+	{
+		return false;
 	}
 
-	SDL_PauseAudioDevice(  dev, 1 );
+	idle = false;
+
+	if( !pushCommand( command ) )
+	{
+		return false;
+	}
 
-    threadManager = new std::thread( &Sound::playSound, this );
+	if( devicePaused )
+	{
+		SDL_PauseAudioDevice( dev, 0 );
+		devicePaused = false;
+	}
 
+	return true;
 }
 
+bool Sound::pushCommand( const PlayCommand& command )
+{
+	unsigned int tail = queueTail.load( std::memory_order_relaxed );
+
+	if( tail - queueHead.load( std::memory_order_acquire ) >= QUEUE_SIZE )
+	{
+		return false;
+	}
+
+	commandQueue[ tail & ( QUEUE_SIZE - 1 ) ] = command;
+
+	queueTail.store( tail + 1, std::memory_order_release );
+
+	return true;
+}
 
-void Sound::playSound()
+bool Sound::popCommand( PlayCommand& command )
 {
-    while( alive )
-    {
-        if( soundPlaying )
-        {
-            soundPosition = soundBuffer;
-            soundRemaining = soundLength;
+	unsigned int head = queueHead.load( std::memory_order_relaxed );
 
-            SDL_PauseAudioDevice( dev, 0 );
+	if( head == queueTail.load( std::memory_order_acquire ) )
+	{
+		return false;
+	}
 
-            while( soundRemaining > 0 )
-            {
-                SDL_Delay( 50 );
-            }
+	command = commandQueue[ head & ( QUEUE_SIZE - 1 ) ];
 
-            SDL_PauseAudioDevice( dev, 1 );
+	queueHead.store( head + 1, std::memory_order_release );
 
-            soundPlaying = false;
-        }
-    }
- 
+	return true;
 }
 
-void Sound::launchSound( )
-{   
-    if( soundPlaying )
-    {
-        return;
-    }
+// SPATIALIZE //////////////////
+/***************************************
+
+@brief spatialize
+
+@details sets a voice's channel gains from its sound and the listeners
+
+@param in/out: voice: the voice to update
+
+@notes positional voices use the loudest listener: inverse distance
+       attenuation that fades to silence at MAX_DISTANCE, panned by
+       the direction to the sound along the listener's right axis.
+       uses a constant power pan law
+
+***************************************/
+void Sound::spatialize( Voice& voice ) const
+{
+	const ListenerSet& listenerSet = listenerSets[ listenerRead ];
+	float pan = voice.sound.pan, attenuation = 1.0f;
+	float distance, listenerAttenuation, angle;
+	glm::vec3 toSource;
+	int index;
+
+	if( voice.sound.positional && listenerSet.count > 0 )
+	{
+		attenuation = 0.0f;
+		pan = 0.0f;
 
-    soundPlaying = true;
+		for( index = 0; index < listenerSet.count; index++ )
+		{
+			toSource = voice.sound.source - listenerSet.listeners[ index ].position;
+			distance = glm::length( toSource );
+
+			listenerAttenuation = ( REFERENCE_DISTANCE / std::max( distance, REFERENCE_DISTANCE ) )
+								  * std::max( 1.0f - ( distance / MAX_DISTANCE ), 0.0f );
+
+			if( listenerAttenuation > attenuation )
+			{
+				attenuation = listenerAttenuation;
+
+				pan = 0.0f;
+
+				if( distance > 0.0f )
+				{
+					pan = glm::dot( toSource / distance, listenerSet.listeners[ index ].right );
+				}
+			}
+		}
+	}
+
+	angle = ( pan + 1.0f ) * 0.25f * ( float ) M_PI;
+
+	voice.loudness = voice.sound.gain * attenuation;
+	voice.leftGain = voice.loudness * std::cos( angle );
+	voice.rightGain = voice.loudness * std::sin( angle );
 }
 
-bool Sound::SoundPlaying( )
+// START VOICE //////////////////
+/***************************************
+
+@brief startVoice
+
+@details assigns a play command to a voice
+
+@param in: command: the sound to play
+
+@notes when every voice is busy the lowest priority voice is
+       stolen, the quietest first and then the one closest to
+       finishing. a sound that ranks below every playing voice
+       or is too far away to hear is dropped
+
+***************************************/
+void Sound::startVoice( const PlayCommand& command )
 {
-	return soundPlaying;
+	Voice candidate;
+	int index, selected = -1;
+	size_t remaining, selectedRemaining = 0;
+
+	candidate.sound = command;
+
+	spatialize( candidate );
+
+	if( candidate.loudness < AUDIBLE_GAIN )
+	{
+		return;
+	}
+
+	for( index = 0; index < MAX_VOICES; index++ )
+	{
+		if( voices[ index ].sound.clip == -1 )
+		{
+			selected = index;
+			break;
+		}
+
+		remaining = clips[ voices[ index ].sound.clip ].size( ) - voices[ index ].position;
+
+		if( selected == -1
+			|| voices[ index ].sound.priority < voices[ selected ].sound.priority
+			|| ( voices[ index ].sound.priority == voices[ selected ].sound.priority
+				 && ( voices[ index ].loudness < voices[ selected ].loudness
+					  || ( voices[ index ].loudness == voices[ selected ].loudness
+						   && remaining < selectedRemaining ) ) ) )
+		{
+			selected = index;
+			selectedRemaining = remaining;
+		}
+	}
+
+	//every voice outranks the new sound
+	if( voices[ selected ].sound.clip != -1
+		&& ( voices[ selected ].sound.priority > candidate.sound.priority
+			 || ( voices[ selected ].sound.priority == candidate.sound.priority
+				  && voices[ selected ].loudness > candidate.loudness ) ) )
+	{
+		return;
+	}
+
+	voices[ selected ] = candidate;
 }
 
-void myCallback( void *userData, Uint8 *stream, int length)
+// MIX //////////////////
+/***************************************
+
+@brief mix
+
+@details fills an audio buffer with the sum of the active voices
+
+@param out: stream: the interleaved stereo buffer from SDL
+
+@param in: frames: the number of stereo frames to fill
+
+@notes runs on the audio thread; does not allocate or lock.
+       voices too quiet to hear keep their place in the clip
+       but are not mixed
+
+***************************************/
+void Sound::mix( Sint16 *stream, int frames )
 {
-    Sint32 localAudioCbLeft = SDL_AtomicGet( &audioCallbackLeft );
-    
-    Uint32 index;
+	PlayCommand command;
+	int index, activeVoices, block, offset;
+	size_t sample, count, blockSamples;
+	const Sint16 *clipPtr;
+	float value;
+
+	PROFILE_ZONE( "Audio mix" );
 
-    for( index = 0; index < length; index++ )
-    {
-        stream[ index ] = soundPosition[localAudioCbLeft ];
+	//pick up the newest listeners
+	if( listenerReady.load( ) & NEW_LISTENERS )
+	{
+		listenerRead = listenerReady.exchange( listenerRead ) & ~NEW_LISTENERS;
+	}
 
-        localAudioCbLeft++;
+	for( index = 0; index < MAX_VOICES; index++ )
+	{
+		if( voices[ index ].sound.clip != -1 )
+		{
+			spatialize( voices[ index ] );
+		}
+	}
 
-        if( localAudioCbLeft >= soundRemaining )
-        {
-            localAudioCbLeft = 0;
-            soundRemaining = 0;
-        }
+	while( popCommand( command ) )
+	{
+		startVoice( command );
+	}
 
-        
-    }
+	for( offset = 0; offset < frames; offset += block )
+	{
+		block = std::min( frames - offset, ( int ) mixBuffer.size( ) / 2 );
+		blockSamples = 2 * block;
+
+		std::fill( mixBuffer.begin( ), mixBuffer.begin( ) + blockSamples, 0.0f );
+
+		for( index = 0; index < MAX_VOICES; index++ )
+		{
+			if( voices[ index ].sound.clip == -1 )
+			{
+				continue;
+			}
+
+			clipPtr = &clips[ voices[ index ].sound.clip ][ 0 ] + voices[ index ].position;
+
+			count = std::min( blockSamples,
+							  clips[ voices[ index ].sound.clip ].size( ) - voices[ index ].position );
+
+			if( voices[ index ].loudness >= AUDIBLE_GAIN )
+			{
+				for( sample = 0; sample < count; sample += 2 )
+				{
+					mixBuffer[ sample ] += voices[ index ].leftGain * clipPtr[ sample ];
+					mixBuffer[ sample + 1 ] += voices[ index ].rightGain * clipPtr[ sample + 1 ];
+				}
+			}
+
+			voices[ index ].position += count;
+
+			if( voices[ index ].position >= clips[ voices[ index ].sound.clip ].size( ) )
+			{
+				voices[ index ].sound.clip = -1;
+			}
+		}
+
+		for( sample = 0; sample < blockSamples; sample++ )
+		{
+			value = std::min( std::max( mixBuffer[ sample ], -32768.0f ), 32767.0f );
+
+			stream[ ( 2 * offset ) + sample ] = ( Sint16 ) value;
+		}
+	}
+
+	activeVoices = 0;
 
-    SDL_AtomicSet( &audioCallbackLeft, localAudioCbLeft );
+	for( index = 0; index < MAX_VOICES; index++ )
+	{
+		if( voices[ index ].sound.clip != -1 )
+		{
+			activeVoices++;
+		}
+	}
 
+	idle = ( activeVoices == 0 && queueHead == queueTail );
 }
@@ -0,0 +1,286 @@
+// header files ///////////////////////////
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include "sound.h"
+
+/***************************************
+
+@file MixerTest.cpp
+
+@brief Checks the sums and the clipping of the audio mixer
+
+@note runs on SDL's dummy audio driver, so it needs no sound card.
+      the device is paused while the test mixes, and the test calls
+      the mixer's callback itself, so every buffer it checks is one
+      the dummy driver never touched
+
+***************************************/
+
+// global constants ///////////////////////
+
+static const int CLIP_FRAMES = 4096;
+
+static const Sint16 QUIET_SAMPLE = 1000;
+static const Sint16 LOUD_SAMPLE = 30000;
+
+// free function prototypes ///////////////
+
+static bool WriteWav( const std::string& fileName, int frames, Sint16 left, Sint16 right );
+
+static void Play( Sound& sound, int soundID, int voices, float pan );
+
+static void Mix( Sound& sound, std::vector<Sint16>& buffer, int frames );
+
+static bool Check( const std::string& name, const std::vector<Sint16>& buffer,
+                   int left, int right );
+
+// main ///////////////////////////////////
+
+#if defined( _WIN64 ) || ( _WIN32 )
+    #undef main
+#endif
+
+int main(int argc, char **argv)
+{
+    const std::string quietFile = "MixerTestQuiet.wav";
+    const std::string loudFile = "MixerTestLoud.wav";
+    const int centre = ( int ) ( 2.0f * QUIET_SAMPLE * std::cos( 0.25f * ( float ) M_PI ) );
+    std::vector<Sint16> buffer;
+    Sound *sound;
+    int quietID, loudID;
+    bool passed = true;
+
+    SDL_setenv( "SDL_AUDIODRIVER", "dummy", 1 );
+
+    if( SDL_Init( SDL_INIT_AUDIO ) != 0 )
+    {
+        std::cerr << "Unable to start SDL audio: " << SDL_GetError( ) << std::endl;
+        return 1;
+    }
+
+    if( !WriteWav( quietFile, CLIP_FRAMES, QUIET_SAMPLE, QUIET_SAMPLE ) ||
+        !WriteWav( loudFile, CLIP_FRAMES, LOUD_SAMPLE, -LOUD_SAMPLE ) )
+    {
+        SDL_Quit( );
+        return 1;
+    }
+
+    sound = new Sound( );
+
+    quietID = sound->loadSound( quietFile );
+    loudID = sound->loadSound( loudFile );
+
+    std::remove( quietFile.c_str( ) );
+    std::remove( loudFile.c_str( ) );
+
+    if( quietID < 0 || loudID < 0 )
+    {
+        std::cerr << "Unable to load the test clips" << std::endl;
+        delete sound;
+        SDL_Quit( );
+        return 1;
+    }
+
+    //two centred voices add up, each at the constant power pan's cos( pi / 4 )
+    Play( *sound, quietID, 2, 0.0f );
+    Mix( *sound, buffer, CLIP_FRAMES );
+    passed = Check( "Two centred voices", buffer, centre, centre ) && passed;
+
+    //the clips have ended, so the next buffer is silent
+    Mix( *sound, buffer, CLIP_FRAMES );
+    passed = Check( "Finished voices", buffer, 0, 0 ) && passed;
+
+    if( sound->SoundPlaying( ) )
+    {
+        std::cout << "FAIL Finished voices: the mixer is not idle" << std::endl;
+        passed = false;
+    }
+
+    //a voice panned fully left is silent on the right
+    Play( *sound, quietID, 1, -1.0f );
+    Mix( *sound, buffer, CLIP_FRAMES );
+    passed = Check( "Panned left", buffer, QUIET_SAMPLE, 0 ) && passed;
+
+    //three loud voices overflow both ways and are clamped, not wrapped
+    Play( *sound, loudID, 3, 0.0f );
+    Mix( *sound, buffer, CLIP_FRAMES );
+    passed = Check( "Clipping", buffer, 32767, -32768 ) && passed;
+
+    delete sound;
+
+    SDL_Quit( );
+
+    std::cout << ( passed ? "All mixer tests passed" : "Mixer tests failed" ) << std::endl;
+
+    return passed ? 0 : 1;
+}
+
+// free function implementation /////////////
+// WRITE WAV //////////
+/***************************************
+
+@brief WriteWav
+
+@details writes a 16 bit stereo wav file at the mixer's rate
+         holding one value per channel
+
+@param in: fileName: the file to write
+
+@param in: frames: the number of stereo frames
+
+@param in: left: the value of every left sample
+
+@param in: right: the value of every right sample
+
+@notes the clip matches the device format, so loadSound
+       keeps its samples as they are
+
+***************************************/
+static bool WriteWav( const std::string& fileName, int frames, Sint16 left, Sint16 right )
+{
+    std::ofstream file( fileName.c_str( ), std::ios::binary );
+    Uint32 dataSize = ( Uint32 ) frames * 2 * sizeof( Sint16 );
+    Uint32 riffSize = 36 + dataSize;
+    Uint32 formatSize = 16;
+    Uint32 rate = Sound::MIX_FREQUENCY;
+    Uint32 byteRate = rate * 2 * sizeof( Sint16 );
+    Uint16 format = 1, channels = 2, blockAlign = 2 * sizeof( Sint16 ), bits = 16;
+    Sint16 frame[ 2 ];
+    int index;
+
+    if( !file.is_open( ) )
+    {
+        std::cerr << "Unable to write " << fileName << std::endl;
+        return false;
+    }
+
+    //wav files are little endian, as is every machine this builds on
+    file.write( "RIFF", 4 );
+    file.write( reinterpret_cast<const char *>( &riffSize ), 4 );
+    file.write( "WAVEfmt ", 8 );
+    file.write( reinterpret_cast<const char *>( &formatSize ), 4 );
+    file.write( reinterpret_cast<const char *>( &format ), 2 );
+    file.write( reinterpret_cast<const char *>( &channels ), 2 );
+    file.write( reinterpret_cast<const char *>( &rate ), 4 );
+    file.write( reinterpret_cast<const char *>( &byteRate ), 4 );
+    file.write( reinterpret_cast<const char *>( &blockAlign ), 2 );
+    file.write( reinterpret_cast<const char *>( &bits ), 2 );
+    file.write( "data", 4 );
+    file.write( reinterpret_cast<const char *>( &dataSize ), 4 );
+
+    frame[ 0 ] = left;
+    frame[ 1 ] = right;
+
+    for( index = 0; index < frames; index++ )
+    {
+        file.write( reinterpret_cast<const char *>( frame ), sizeof( frame ) );
+    }
+
+    return file.good( );
+}
+
+// PLAY //////////
+/***************************************
+
+@brief Play
+
+@details queues voices of a clip and keeps the dummy driver out
+
+@param in: sound: the mixer
+
+@param in: soundID: the clip to play
+
+@param in: voices: how many voices of it to start
+
+@param in: pan: -1 is fully left, 1 is fully right
+
+@notes playSound wakes the device, so it is paused again before
+       the lock is let go; the queued voices are picked up by
+       the next Mix
+
+***************************************/
+static void Play( Sound& sound, int soundID, int voices, float pan )
+{
+    int index;
+
+    SDL_LockAudioDevice( sound.getDevice( ) );
+
+    for( index = 0; index < voices; index++ )
+    {
+        sound.playSound( soundID, 1.0f, pan );
+    }
+
+    SDL_PauseAudioDevice( sound.getDevice( ), 1 );
+
+    SDL_UnlockAudioDevice( sound.getDevice( ) );
+}
+
+// MIX //////////
+/***************************************
+
+@brief Mix
+
+@details runs the mixer's callback into a buffer of the test's own
+
+@param in: sound: the mixer
+
+@param out: buffer: the interleaved stereo samples
+
+@param in: frames: the number of stereo frames to mix
+
+@notes None
+
+***************************************/
+static void Mix( Sound& sound, std::vector<Sint16>& buffer, int frames )
+{
+    buffer.assign( 2 * frames, 0 );
+
+    Sound::AudioCallback( &sound, reinterpret_cast<Uint8 *>( &buffer[ 0 ] ),
+                          ( int ) ( buffer.size( ) * sizeof( Sint16 ) ) );
+}
+
+// CHECK //////////
+/***************************************
+
+@brief Check
+
+@details checks that every frame of a buffer holds the expected values
+
+@param in: name: the name of the check
+
+@param in: buffer: the interleaved stereo samples
+
+@param in: left: the expected left sample
+
+@param in: right: the expected right sample
+
+@notes a sample may be one off, the mixer rounds its float sum
+       toward zero
+
+***************************************/
+static bool Check( const std::string& name, const std::vector<Sint16>& buffer,
+                   int left, int right )
+{
+    size_t sample;
+
+    for( sample = 0; sample < buffer.size( ); sample += 2 )
+    {
+        if( std::abs( buffer[ sample ] - left ) > 1 ||
+            std::abs( buffer[ sample + 1 ] - right ) > 1 )
+        {
+            std::cout << "FAIL " << name << ": frame " << sample / 2 << " is ( "
+                      << buffer[ sample ] << ", " << buffer[ sample + 1 ] << " ), expected ( "
+                      << left << ", " << right << " )" << std::endl;
+            return false;
+        }
+    }
+
+    std::cout << "PASS " << name << std::endl;
+
+    return true;
+}
@@ -0,0 +1,196 @@
+// header files ///////////////////////////
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+#include "GraphicsInfo.h"
+#include "SceneFile.h"
+
+// free function prototypes ///////////////
+
+//defined in main.cpp
+bool ReadConfigurationFile( const std::string& fileName, GraphicsInfo& progInfo );
+
+static bool WriteConfig( const std::string& fileName, unsigned int objectCount );
+
+static double TimeRead( const std::string& fileName, unsigned int runs, size_t& objects );
+
+// main ///////////////////////////////////
+
+#if defined( _WIN64 ) || ( _WIN32 )
+    #undef main
+#endif
+
+int main(int argc, char **argv)
+{
+    std::string configFile = "config/Generated.xml";
+    std::string sceneFile = "config/Generated.scene";
+    unsigned int objectCount = 50000, runs = 5;
+    GraphicsInfo progInfo;
+    size_t objects = 0;
+    double millis;
+
+    if( argc > 1 )
+    {
+        objectCount = ( unsigned int ) atoi( argv[ 1 ] );
+    }
+
+    if( argc > 2 )
+    {
+        runs = ( unsigned int ) atoi( argv[ 2 ] );
+    }
+
+    if( objectCount == 0 || runs == 0 )
+    {
+        std::cout << "This program is ran as follows: " << std::endl;
+        std::cout << "./ConfigBenchmark [NUMBER_OF_OBJECTS] [NUMBER_OF_RUNS]" << std::endl;
+        std::cout << "50000 objects and 5 runs by default, the configuration is written to "
+                  << configFile << std::endl;
+        return 1;
+    }
+
+    if( !WriteConfig( configFile, objectCount ) )
+    {
+        return 1;
+    }
+
+    millis = TimeRead( configFile, runs, objects );
+
+    std::cout << configFile << ": " << objects << " objects in " << millis << " ms" << std::endl;
+
+    if( !ReadConfigurationFile( configFile, progInfo ) ||
+        !SceneFile::Write( sceneFile, progInfo, configFile ) )
+    {
+        return 1;
+    }
+
+    millis = TimeRead( sceneFile, runs, objects );
+
+    std::cout << sceneFile << ": " << objects << " objects in " << millis << " ms" << std::endl;
+
+    return 0;
+}
+
+// free function implementation /////////////
+// WRITE CONFIG //////////
+/***************************************
+
+@brief WriteConfig
+
+@details writes a configuration file of objectCount objects
+
+@param in: fileName: the file, replaced if it is there
+
+@param in: objectCount: the objects, every tenth holds a child
+
+@notes the values are made from the object's index, so every run writes
+       the same file
+
+***************************************/
+static bool WriteConfig( const std::string& fileName, unsigned int objectCount )
+{
+    const char *models[ 4 ] = { "models/Ship.obj", "models/cannonball.obj",
+                                "models/skybox.obj", "models/WindHud.obj" };
+    const char *axes[ 3 ] = { "x", "y", "z" };
+    const char *fields[ 5 ] = { "Scale", "BScale", "Position", "RotationAxis", "RotationAngle" };
+    std::ofstream file( fileName.c_str( ) );
+    unsigned int index, field, axis;
+    bool child;
+
+    if( file.fail( ) )
+    {
+        std::cout << "Failure writing the file: " << fileName << "!!!" << std::endl;
+        return false;
+    }
+
+    file << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<Configuration>\n"
+         << "  <Window width =\"1600\" height =\"900\">Generated</Window>\n"
+         << "  <Shader>\n    <Vertex>shaders/vertShader.vert</Vertex>\n"
+         << "    <Fragment>shaders/fragShader.frag</Fragment>\n  </Shader>\n"
+         << "  <Light>\n    <xPosition>0</xPosition>\n    <yPosition>100</yPosition>\n"
+         << "    <zPosition>0</zPosition>\n    <Ambient>\n      <xPosition>0.2</xPosition>\n"
+         << "      <yPosition>0.2</yPosition>\n      <zPosition>0.2</zPosition>\n"
+         << "    </Ambient>\n  </Light>\n";
+
+    for( index = 0; index < objectCount; index++ )
+    {
+        child = ( index % 10 == 9 && index + 1 < objectCount );
+
+        file << "  <PObject path =\"" << models[ index % 4 ] << "\">\n"
+             << "    <name>object" << index << "</name>\n";
+
+        for( field = 0; field < 5; field++ )
+        {
+            for( axis = 0; axis < 3; axis++ )
+            {
+                file << "    <" << axes[ axis ] << fields[ field ] << ">"
+                     << ( ( index * 7 + field * 3 + axis ) % 1000 ) * 0.125f
+                     << "</" << axes[ axis ] << fields[ field ] << ">\n";
+            }
+        }
+
+        if( child )
+        {
+            index++;
+
+            file << "    <Object path =\"" << models[ index % 4 ] << "\">\n"
+                 << "      <name>object" << index << "</name>\n"
+                 << "      <yPosition>" << index % 100 << ".5</yPosition>\n"
+                 << "    </Object>\n";
+        }
+
+        file << "  </PObject>\n";
+    }
+
+    file << "</Configuration>\n";
+
+    return !file.fail( );
+}
+
+// TIME READ //////////
+/***************************************
+
+@brief TimeRead
+
+@details reads a configuration file or scene runs times
+
+@param in: fileName: the file to read
+
+@param in: runs: the times it is read
+
+@param out: objects: the objects read on the last run
+
+@notes returns the fastest run in milliseconds
+
+***************************************/
+static double TimeRead( const std::string& fileName, unsigned int runs, size_t& objects )
+{
+    std::chrono::steady_clock::time_point start;
+    double millis, best = 0.0;
+    unsigned int run;
+
+    for( run = 0; run < runs; run++ )
+    {
+        GraphicsInfo progInfo;
+
+        start = std::chrono::steady_clock::now( );
+
+        if( !ReadConfigurationFile( fileName, progInfo ) )
+        {
+            std::cout << "Failure reading " << fileName << std::endl;
+        }
+
+        millis = std::chrono::duration<double, std::milli>(
+                     std::chrono::steady_clock::now( ) - start ).count( );
+
+        if( run == 0 || millis < best )
+        {
+            best = millis;
+        }
+
+        objects = progInfo.objectData.size( );
+    }
+
+    return best;
+}
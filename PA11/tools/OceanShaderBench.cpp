@@ -0,0 +1,352 @@
+// header files ///////////////////////////
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include "window.h"
+#include "shader.h"
+#include "HeightMap.h"
+#include "OpenSimplexNoise.h"
+
+// constants ///////////////////////////////
+
+static const long NOISE_SEED = 0;
+static const int NOISE_SIZE = 1024;
+static const int SKY_SIZE = 256;
+static const unsigned int WARMUP_FRAMES = 10;
+
+//a triangle that covers the screen, the uv spans the ocean's texture once
+static const char* VERTEX_SOURCE =
+    "#version 330\n"
+    "out vec2 uv;\n"
+    "void main( void )\n"
+    "{\n"
+    "    vec2 corner = vec2( ( gl_VertexID << 1 ) & 2, gl_VertexID & 2 );\n"
+    "    uv = corner;\n"
+    "    gl_Position = vec4( corner * 2.0 - 1.0, 0.0, 1.0 );\n"
+    "}\n";
+
+//the wave part of ProcessOcean from fLightingFragmentShader.glsl
+static const char* FRAGMENT_HEAD =
+    "#version 330\n"
+    "in vec2 uv;\n"
+    "out vec4 frag_color;\n"
+    "uniform sampler2D waveMap;\n"
+    "uniform sampler2D textureSampler;\n"
+    "uniform float time;\n"
+    "vec3 getWaveHeight( vec2 hmPos );\n"
+    "void main( void )\n"
+    "{\n"
+    "    vec3 fN = vec3( 0.0, 1.0, 0.0 );\n"
+    "    vec3 fE = normalize( vec3( uv.x - 0.5, -1.0, uv.y - 0.5 ) );\n"
+    "    vec2 waveUV = vec2( uv.x + 0.32 * time, uv.y + 0.22 * time );\n"
+    "    vec3 waveRise = normalize( fN + getWaveHeight( waveUV ) );\n"
+    "    vec3 reflection = reflect( fE, waveRise );\n"
+    "    vec4 reflColor = texture2D( textureSampler, reflection.xy );\n"
+    "    float interp = 1.0 - dot( -fE, waveRise );\n"
+    "    float mixLevel = clamp( -0.284 + pow( interp, 6.08 ), 0.0, 1.0 );\n"
+    "    frag_color = mix( vec4( 0.0, 0.32, 0.56, 1.0 ), reflColor, mixLevel );\n"
+    "}\n";
+
+//the getWaveHeight the ocean used before the octaves were baked, 20 fetches
+static const char* OCTAVE_WAVES =
+    "float getOctave( vec2 coord, float persistence, int numberOfOctaves )\n"
+    "{\n"
+    "    int index;\n"
+    "    float maxV = 0.0, totalV = 0.0, amp = 1.0, freq = 1.0;\n"
+    "    for( index = 0; index < numberOfOctaves; index++ )\n"
+    "    {\n"
+    "        totalV += texture2D( waveMap, freq * coord ).x * amp;\n"
+    "        maxV += amp;\n"
+    "        freq *= 2.0;\n"
+    "        amp *= persistence;\n"
+    "    }\n"
+    "    return totalV / maxV;\n"
+    "}\n"
+    "vec3 getWaveHeight( vec2 hmPos )\n"
+    "{\n"
+    "    vec3 height;\n"
+    "    height.y = getOctave( hmPos, 1.245, 5 );\n"
+    "    height.x = getOctave( hmPos, 6.9997, 12 );\n"
+    "    height.z = getOctave( hmPos, 9.75, 3 );\n"
+    "    return height;\n"
+    "}\n";
+
+//the getWaveHeight the ocean uses now, one fetch of HeightMap's waveMap
+static const char* BAKED_WAVES =
+    "vec3 getWaveHeight( vec2 hmPos )\n"
+    "{\n"
+    "    return texture2D( waveMap, hmPos ).xyz;\n"
+    "}\n";
+
+// free function prototypes ///////////////
+
+static bool BuildProgram( Shader& program, const char* waveSource, const std::string& name );
+
+static GLuint MakeNoiseTexture( );
+
+static GLuint MakeSkyTexture( );
+
+static double TimeProgram( Window& window, Shader& program, GLuint waveTexture,
+                           GLuint skyTexture, unsigned int frames );
+
+// main ///////////////////////////////////
+
+#if defined( _WIN64 ) || ( _WIN32 )
+    #undef main
+#endif
+
+int main(int argc, char **argv)
+{
+    Window window;
+    Shader octaveProgram, bakedProgram;
+    HeightMap oceanHeightMap( NOISE_SEED );
+    int width = 1600, height = 900;
+    unsigned int frames = 100;
+    GLuint noiseTexture, skyTexture, vertexArray;
+    double octaveMillis, bakedMillis;
+
+    if( argc > 2 )
+    {
+        width = atoi( argv[ 1 ] );
+        height = atoi( argv[ 2 ] );
+    }
+
+    if( argc > 3 )
+    {
+        frames = ( unsigned int ) atoi( argv[ 3 ] );
+    }
+
+    if( width <= 0 || height <= 0 || frames == 0 )
+    {
+        std::cout << "This program is ran as follows: " << std::endl;
+        std::cout << "./OceanShaderBench [WIDTH HEIGHT] [NUMBER_OF_FRAMES]" << std::endl;
+        std::cout << "1600 by 900 and 100 frames by default" << std::endl;
+        return 1;
+    }
+
+    if( !window.Initialize( "Ocean Shader Benchmark", &width, &height, true ) )
+    {
+        return 1;
+    }
+
+    #if !defined( __APPLE__ ) && !defined( MACOSX )
+        glewExperimental = GL_TRUE;
+
+        if( glewInit( ) != GLEW_OK )
+        {
+            std::cerr << "GLEW could not be started" << std::endl;
+            return 1;
+        }
+
+        glGetError( );
+    #endif
+
+    if( !window.createOffscreenTarget( ) ||
+        !BuildProgram( octaveProgram, OCTAVE_WAVES, "octave getWaveHeight" ) ||
+        !BuildProgram( bakedProgram, BAKED_WAVES, "baked getWaveHeight" ) ||
+        !oceanHeightMap.generateHeightMap( NOISE_SIZE, NOISE_SIZE ) )
+    {
+        return 1;
+    }
+
+    noiseTexture = MakeNoiseTexture( );
+    skyTexture = MakeSkyTexture( );
+
+    glGenVertexArrays( 1, &vertexArray );
+    glBindVertexArray( vertexArray );
+    glDisable( GL_DEPTH_TEST );
+
+    octaveMillis = TimeProgram( window, octaveProgram, noiseTexture, skyTexture, frames );
+    bakedMillis = TimeProgram( window, bakedProgram, oceanHeightMap.HeightMapTexture( ),
+                               skyTexture, frames );
+
+    std::cout << glGetString( GL_RENDERER ) << ", " << width << "x" << height
+              << ", " << frames << " frames" << std::endl;
+    std::cout << "octave getWaveHeight ( 20 fetches ): " << octaveMillis << " ms per frame" << std::endl;
+    std::cout << "baked getWaveHeight ( 1 fetch ): " << bakedMillis << " ms per frame" << std::endl;
+
+    glDeleteVertexArrays( 1, &vertexArray );
+    glDeleteTextures( 1, &noiseTexture );
+    glDeleteTextures( 1, &skyTexture );
+
+    return 0;
+}
+
+// free function implementation /////////////
+// BUILD PROGRAM //////////
+/***************************************
+
+@brief BuildProgram
+
+@details builds the ocean's wave shading with one getWaveHeight
+
+@param out: program: the shader program
+
+@param in: waveSource: the getWaveHeight to use
+
+@param in: name: the name compile errors are reported with
+
+@notes none
+
+***************************************/
+static bool BuildProgram( Shader& program, const char* waveSource, const std::string& name )
+{
+    if( !program.Initialize( ) ||
+        !program.AddShaderSource( GL_VERTEX_SHADER, VERTEX_SOURCE, name ) ||
+        !program.AddShaderSource( GL_FRAGMENT_SHADER,
+                                  std::string( FRAGMENT_HEAD ) + waveSource, name ) ||
+        !program.Finalize( ) )
+    {
+        std::cerr << "The " << name << " program could not be built" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+// MAKE NOISE TEXTURE //////////
+/***************************************
+
+@brief MakeNoiseTexture
+
+@details makes the raw noise texture the octave getWaveHeight sampled
+
+@param None
+
+@notes one float channel, linear filtering and no mipmaps, as HeightMap
+       made it before the octaves were baked
+
+***************************************/
+static GLuint MakeNoiseTexture( )
+{
+    OpenSimplexNoise noiseGen( NOISE_SEED );
+    std::vector<float> noise( NOISE_SIZE * NOISE_SIZE );
+    GLuint texture;
+    int row, col;
+
+    for( row = 0; row < NOISE_SIZE; row++ )
+    {
+        for( col = 0; col < NOISE_SIZE; col++ )
+        {
+            noise[ ( row * NOISE_SIZE ) + col ] = ( float ) noiseGen.getNoise( col, row );
+        }
+    }
+
+    glGenTextures( 1, &texture );
+    glBindTexture( GL_TEXTURE_2D, texture );
+    glTexImage2D( GL_TEXTURE_2D, 0, GL_R32F, NOISE_SIZE, NOISE_SIZE, 0,
+                  GL_RED, GL_FLOAT, noise.data( ) );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
+
+    return texture;
+}
+
+// MAKE SKY TEXTURE //////////
+/***************************************
+
+@brief MakeSkyTexture
+
+@details makes a gradient for the ocean to reflect
+
+@param None
+
+@notes both programs sample it the same way, so it only adds the
+       same fetch to each
+
+***************************************/
+static GLuint MakeSkyTexture( )
+{
+    std::vector<unsigned char> sky( SKY_SIZE * SKY_SIZE * 4 );
+    GLuint texture;
+    int row, col, index;
+
+    for( row = 0; row < SKY_SIZE; row++ )
+    {
+        for( col = 0; col < SKY_SIZE; col++ )
+        {
+            index = ( ( row * SKY_SIZE ) + col ) * 4;
+
+            sky[ index ] = ( unsigned char ) col;
+            sky[ index + 1 ] = ( unsigned char ) row;
+            sky[ index + 2 ] = 255;
+            sky[ index + 3 ] = 255;
+        }
+    }
+
+    glGenTextures( 1, &texture );
+    glBindTexture( GL_TEXTURE_2D, texture );
+    glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA8, SKY_SIZE, SKY_SIZE, 0,
+                  GL_RGBA, GL_UNSIGNED_BYTE, sky.data( ) );
+    glGenerateMipmap( GL_TEXTURE_2D );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR );
+    glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
+
+    return texture;
+}
+
+// TIME PROGRAM //////////
+/***************************************
+
+@brief TimeProgram
+
+@details shades the screen with a program and times the frames
+
+@param in: window: the headless window, its Swap waits for the frame
+
+@param in: program: the shader program
+
+@param in: waveTexture: the texture getWaveHeight samples
+
+@param in: skyTexture: the texture the ocean reflects
+
+@param in: frames: the number of frames to time
+
+@notes returns the mean milliseconds per frame, after a few frames
+       that are not timed so the driver has finished its setup
+
+***************************************/
+static double TimeProgram( Window& window, Shader& program, GLuint waveTexture,
+                           GLuint skyTexture, unsigned int frames )
+{
+    std::chrono::steady_clock::time_point start;
+    GLint timeLoc;
+    unsigned int index;
+
+    program.Enable( );
+
+    glUniform1i( program.GetUniformLocation( "waveMap" ), 0 );
+    glUniform1i( program.GetUniformLocation( "textureSampler" ), 1 );
+    timeLoc = program.GetUniformLocation( "time" );
+
+    glActiveTexture( GL_TEXTURE0 );
+    glBindTexture( GL_TEXTURE_2D, waveTexture );
+    glActiveTexture( GL_TEXTURE1 );
+    glBindTexture( GL_TEXTURE_2D, skyTexture );
+
+    for( index = 0; index < WARMUP_FRAMES + frames; index++ )
+    {
+        if( index == WARMUP_FRAMES )
+        {
+            start = std::chrono::steady_clock::now( );
+        }
+
+        glUniform1f( timeLoc, index * 0.016f );
+
+        glClear( GL_COLOR_BUFFER_BIT );
+        glDrawArrays( GL_TRIANGLES, 0, 3 );
+
+        window.Swap( );
+    }
+
+    program.Disable( );
+
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now( ) - start ).count( ) / frames;
+}
@@ -0,0 +1,132 @@
+// header files ///////////////////////////
+#include <iostream>
+#include <fstream>
+#include <string>
+#include "GraphicsInfo.h"
+#include "SceneFile.h"
+
+// free function prototypes ///////////////
+
+//defined in main.cpp
+bool ReadConfigurationFile( const std::string& fileName, GraphicsInfo& progInfo );
+
+static bool ValidateScene( const GraphicsInfo& progInfo );
+
+static void CheckFile( const std::string& fileName );
+
+// main ///////////////////////////////////
+
+#if defined( _WIN64 ) || ( _WIN32 )
+    #undef main
+#endif
+
+int main(int argc, char **argv)
+{
+    GraphicsInfo progInfo;
+    std::string configFile, sceneFile;
+
+    if( argc != 3 )
+    {
+        std::cout << "This program is ran as follows: " << std::endl;
+        std::cout << "./SceneCompiler config/Bullet.xml config/Bullet.scene" << std::endl << std::endl;
+        std::cout << "The scene is then loaded with -c config/Bullet.scene, and the"
+                  << " configuration file is read instead if the scene is out of date." << std::endl;
+        return 1;
+    }
+
+    configFile = argv[ 1 ];
+    sceneFile = argv[ 2 ];
+
+    //the defaults are left out so the command line's stay in charge
+    progInfo.windowSize = glm::vec2( 0.0f, 0.0f );
+    progInfo.windowName.clear( );
+
+    if( SceneFile::IsScene( configFile ) )
+    {
+        std::cout << configFile << " is already a compiled scene" << std::endl;
+        return 1;
+    }
+
+    if( !ReadConfigurationFile( configFile, progInfo ) || !ValidateScene( progInfo ) )
+    {
+        std::cout << "Failure processing the configuration file!" << std::endl;
+        return 1;
+    }
+
+    if( !SceneFile::Write( sceneFile, progInfo, configFile ) )
+    {
+        return 1;
+    }
+
+    std::cout << "Wrote " << progInfo.objectData.size( ) << " objects, "
+              << progInfo.modelVector.size( ) << " models, "
+              << progInfo.shaderVector.size( ) << " shader programs, "
+              << progInfo.lights.size( ) + progInfo.spotLight.size( ) << " lights to "
+              << sceneFile << std::endl;
+
+    return 0;
+}
+
+// free function implementation /////////////
+// VALIDATE SCENE //////////
+/***************************************
+
+@brief ValidateScene
+
+@details checks what the engine would otherwise find out while starting
+
+@param in: progInfo: the scene read from the configuration file
+
+@notes a missing file is only a warning, the paths are relative to where
+       the engine is run
+
+***************************************/
+static bool ValidateScene( const GraphicsInfo& progInfo )
+{
+    unsigned int index, objIndex;
+    bool found, noError = true;
+
+    for( index = 0; index < progInfo.shaderVector.size( ); index++ )
+    {
+        for( objIndex = 0; objIndex < progInfo.shaderVector[ index ].size( ); objIndex++ )
+        {
+            CheckFile( progInfo.shaderVector[ index ][ objIndex ].second );
+        }
+    }
+
+    for( index = 0; index < progInfo.modelVector.size( ); index++ )
+    {
+        CheckFile( progInfo.modelVector[ index ] );
+    }
+
+    for( index = 0; index < progInfo.spotLight.size( ); index++ )
+    {
+        found = false;
+
+        for( objIndex = 0; objIndex < progInfo.objectData.size( ) && !found; objIndex++ )
+        {
+            found = ( progInfo.objectData[ objIndex ].name == progInfo.spotLight[ index ].objectToFollow );
+        }
+
+        if( !found )
+        {
+            std::cout << "Spot light " << index + 1 << " follows "
+                      << progInfo.spotLight[ index ].objectToFollow
+                      << ", which is not an object" << std::endl;
+
+            noError = false;
+        }
+    }
+
+    return noError;
+}
+
+static void CheckFile( const std::string& fileName )
+{
+    std::ifstream file( fileName.c_str( ) );
+
+    if( file.fail( ) )
+    {
+        std::cout << "Warning: " << fileName << " was not found from here" << std::endl;
+    }
+}
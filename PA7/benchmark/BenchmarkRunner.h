@@ -0,0 +1,98 @@
+#ifndef BENCHMARKRUNNER_H
+#define BENCHMARKRUNNER_H
+
+/***************************************
+
+@file BenchmarkRunner.h
+
+@brief Replays a scripted camera path and key presses through the
+       engine and times every frame
+
+@note every frame gets the same simulation time step, so two runs of
+      one script and one configuration do the same work. the times
+      are real milliseconds from the monotonic steady_clock
+
+***************************************/
+
+// headers ////////////////////////////////
+#include <vector>
+#include <string>
+#include <ostream>
+#include "engine.h"
+
+// struct definitions /////////////////////
+
+struct CameraKey
+{
+    unsigned int frame;
+    glm::dvec3 eye;
+    glm::dvec3 focus;
+
+    CameraKey( ) : frame( 0 ), eye( 0.0 ), focus( 0.0 ) { }
+};
+
+struct InputEvent
+{
+    unsigned int frame;
+    SDL_Keycode key;
+    bool down; //a key press, false for a release
+
+    InputEvent( ) : frame( 0 ), key( SDLK_UNKNOWN ), down( true ) { }
+};
+
+struct FrameSample
+{
+    double updateTime; //Update, the physics included
+    double submitTime; //Render, until the last command is sent
+    double gpuTime; //waiting on glFinish after the submission
+    double physicsTime; //the part of the Update spent in the physics
+    unsigned long drawCalls;
+    unsigned long triangles;
+
+    FrameSample( ) : updateTime( 0.0 ), submitTime( 0.0 ), gpuTime( 0.0 ),
+                     physicsTime( 0.0 ), drawCalls( 0 ), triangles( 0 ) { }
+};
+
+// class definition ///////////////////////
+
+class BenchmarkRunner
+{
+    public:
+        static const unsigned int DEFAULT_FRAMES = 1000;
+        static const unsigned int DEFAULT_TIME_STEP = 10; //simulation milliseconds per frame
+
+        //contructors
+        BenchmarkRunner( );
+
+        //destructor
+        ~BenchmarkRunner( );
+
+        bool loadScript( const std::string& fileName );
+
+        bool run( Engine& engine );
+
+        bool writeResults( const std::string& fileName ) const;
+
+        void printSummary( ) const;
+
+    private:
+        void sendInputs( Engine& engine, unsigned int frame );
+
+        void cameraAt( unsigned int frame, glm::dvec3& eye, glm::dvec3& focus ) const;
+
+        void writeCSV( std::ostream& out ) const;
+
+        void writeJSON( std::ostream& out ) const;
+
+        std::string name;
+        unsigned int frames;
+        unsigned int timeStep;
+
+        std::vector<CameraKey> cameraPath; //in frame order
+        std::vector<InputEvent> inputs; //in frame order
+        unsigned int nextInput;
+
+        std::vector<FrameSample> samples;
+};
+
+#endif /* BENCHMARKRUNNER_H */
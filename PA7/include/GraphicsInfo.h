@@ -27,6 +27,11 @@ struct PlanetInfo
     glm::vec2 orbitRad; //radius of orbit
     float orbitRate; //rate of orbit
     glm::vec3 locLocal; //the location of the object in local space
+    double eccentricity; //eccentricity of the orbit, below 0 to use the radii
+    double ascendingNode; //longitude of the ascending node in radians
+    double argPeriapsis; //argument of periapsis in radians
+    double meanAnomaly; //mean anomaly at the start in radians
+    double mass; //in earth masses, 0 to keep to the orbit in gravity mode
 
     PlanetInfo( ) :
         modelID( -1 ),
@@ -37,7 +42,12 @@ struct PlanetInfo
         rotRate( 1.0f ),
         orbitRad( 1.0f ),
         orbitRate( 1.0f ),
-        locLocal( glm::vec3( 0.0f, 0.0f, 0.0f ) )
+        locLocal( glm::vec3( 0.0f, 0.0f, 0.0f ) ),
+        eccentricity( -1.0 ),
+        ascendingNode( 0.0 ),
+        argPeriapsis( 0.0 ),
+        meanAnomaly( 0.0 ),
+        mass( 0.0 )
     { }
     PlanetInfo( const PlanetInfo& planInfo ) :
         modelID( planInfo.modelID ),
@@ -48,7 +58,12 @@ struct PlanetInfo
         rotRate( planInfo.rotRate ),
         orbitRad( planInfo.orbitRad ),
         orbitRate( planInfo.orbitRate ),
-        locLocal( planInfo.locLocal )
+        locLocal( planInfo.locLocal ),
+        eccentricity( planInfo.eccentricity ),
+        ascendingNode( planInfo.ascendingNode ),
+        argPeriapsis( planInfo.argPeriapsis ),
+        meanAnomaly( planInfo.meanAnomaly ),
+        mass( planInfo.mass )
 
 
     {
@@ -58,22 +73,100 @@ struct PlanetInfo
 };
 
 
+struct GravityInfo
+{
+    bool enabled; //start in gravity mode
+    bool benchmark; //run the n-body benchmark instead of the program
+    double constant; //G in scene units per earth mass
+    double timeStep; //simulated seconds per step
+    double theta; //opening angle of the tree walk
+    unsigned int threads; //0 for one per core
+    unsigned int asteroids; //bodies in the generated belt
+    glm::vec2 belt; //inner and outer radius of the belt
+
+    GravityInfo( ) :
+        enabled( false ),
+        benchmark( false ),
+        constant( 1.0 ),
+        timeStep( 1.0 / 60.0 ),
+        theta( 0.5 ),
+        threads( 0 ),
+        asteroids( 0 ),
+        belt( glm::vec2( 0.0f, 0.0f ) )
+    { }
+
+    GravityInfo( const GravityInfo& src ) :
+        enabled( src.enabled ),
+        benchmark( src.benchmark ),
+        constant( src.constant ),
+        timeStep( src.timeStep ),
+        theta( src.theta ),
+        threads( src.threads ),
+        asteroids( src.asteroids ),
+        belt( src.belt )
+    { }
+};
+
+
+struct ParticleFieldInfo
+{
+    unsigned int parentID; //the object the rocks circle
+    bool ring; //true for the parent's equator, false for the ecliptic
+    unsigned int count; //number of rocks
+    glm::vec2 radius; //inner and outer radius in scene units
+    float thickness; //largest inclination from the plane in radians
+    float eccentricity; //largest eccentricity of a rock's orbit
+    float orbitRate; //rate of orbit at the inner radius
+    float size; //radius of an average rock
+
+    ParticleFieldInfo( ) :
+        parentID( 0 ),
+        ring( false ),
+        count( 0 ),
+        radius( glm::vec2( 1.0f, 1.0f ) ),
+        thickness( 0.0f ),
+        eccentricity( 0.0f ),
+        orbitRate( 1.0f ),
+        size( 0.001f )
+    { }
+
+    ParticleFieldInfo( const ParticleFieldInfo& src ) :
+        parentID( src.parentID ),
+        ring( src.ring ),
+        count( src.count ),
+        radius( src.radius ),
+        thickness( src.thickness ),
+        eccentricity( src.eccentricity ),
+        orbitRate( src.orbitRate ),
+        size( src.size )
+    { }
+};
+
+
 struct GraphicsInfo
 {
     //members
     std::vector<std::pair<GLenum, std::string>> shaderVector;
+    std::vector<std::pair<GLenum, std::string>> particleShaderVector;
     std::vector<std::string> modelVector;
     std::vector<PlanetInfo> planetData;
     std::vector<unsigned int> planetIndex;
+    GravityInfo gravity;
+    std::vector<ParticleFieldInfo> particleFields;
+    int depthMode; //one of Camera's DEPTH_ modes
 
     //constructors
-    GraphicsInfo( ) { }
+    GraphicsInfo( ) : depthMode( 0 ) { }
 
     GraphicsInfo( const GraphicsInfo& src ): 
         shaderVector( src.shaderVector ),
+        particleShaderVector( src.particleShaderVector ),
         modelVector( src.modelVector ), 
         planetData( src.planetData ),
-        planetIndex( src.planetIndex )
+        planetIndex( src.planetIndex ),
+        gravity( src.gravity ),
+        particleFields( src.particleFields ),
+        depthMode( src.depthMode )
     {
 
     }
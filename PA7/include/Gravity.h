@@ -0,0 +1,106 @@
+#ifndef GRAVITY_H
+#define GRAVITY_H
+
+/***************************************
+
+@file Gravity.h
+
+@brief A class to move bodies under their mutual gravity
+
+@note the forces are found with a Barnes-Hut octree rebuilt every step,
+      split across threads, and the bodies are moved with a kick-drift-
+      kick leapfrog, which keeps the energy bounded over long runs
+
+***************************************/
+
+// headers ////////////////////////////////
+#include<vector>
+#include"graphics_headers.h"
+
+// class definition ///////////////////////
+
+class GravitySimulation
+{
+    public:
+        static const int LEAF_SIZE = 8; //bodies in a leaf before it splits
+        static const int MAX_DEPTH = 32; //leaves this deep never split
+        static const unsigned int MIN_BODIES_PER_THREAD = 256;
+
+        static const double DEFAULT_THETA; //value defined in Gravity.cpp
+        static const double DEFAULT_SOFTENING; //value defined in Gravity.cpp
+
+        //contructors
+        GravitySimulation( );
+        GravitySimulation( const GravitySimulation& src );
+
+        //destructor
+        ~GravitySimulation( );
+
+        void setConstant( double newConstant );
+
+        void setTheta( double newTheta );
+
+        void setSoftening( double newSoftening );
+
+        void setThreadCount( unsigned int newThreadCount );
+
+        unsigned int addBody( double mass, const double position[ 3 ],
+                              const double velocity[ 3 ] );
+
+        void step( double timeStep );
+
+        glm::vec3 getPosition( unsigned int index ) const;
+
+        void getPosition( unsigned int index, double position[ 3 ] ) const;
+
+        double getEnergy( );
+
+        void removeNetMomentum( );
+
+        unsigned int getSize( ) const;
+
+        void clear( );
+
+        static void runBenchmark( );
+
+    private:
+        struct Node
+        {
+            double center[ 3 ];
+            double halfSize;
+            double mass;
+            double centerOfMass[ 3 ];
+            int firstChild; //the 8 children follow it, -1 for a leaf
+            int body; //first body in a leaf, -1 if empty
+            int count; //bodies in a leaf
+        };
+
+        void buildTree( );
+
+        void computeAccelerations( );
+
+        void accelerationRange( unsigned int begin, unsigned int end );
+
+        void potentialRange( unsigned int begin, unsigned int end );
+
+        void runThreaded( void ( GravitySimulation::*work )( unsigned int, unsigned int ) );
+
+        double constant; //G in scene units
+        double theta; //opening angle of the tree walk
+        double softening; //added to every squared distance
+        unsigned int threadCount;
+
+        //one entry per body in each vector
+        std::vector<double> mass;
+        std::vector<double> positionX, positionY, positionZ;
+        std::vector<double> velocityX, velocityY, velocityZ;
+        std::vector<double> accelerationX, accelerationY, accelerationZ;
+        std::vector<double> potential;
+        std::vector<int> nextInLeaf;
+
+        std::vector<Node> tree;
+
+        bool accelerationsValid;
+};
+
+#endif /* GRAVITY_H */
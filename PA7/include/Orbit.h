@@ -0,0 +1,106 @@
+#ifndef ORBIT_H
+#define ORBIT_H
+
+/***************************************
+
+@file Orbit.h
+
+@brief A class to move every body along its Kepler orbit at once
+
+@note the elements are kept in double precision and the mean anomaly
+      is found from the simulation time each frame, so nothing is
+      added up from one frame to the next
+
+***************************************/
+
+// headers ////////////////////////////////
+#include<vector>
+#include"graphics_headers.h"
+
+// struct definition //////////////////////
+
+struct OrbitalElements
+{
+    double semiMajorAxis; //in scene units
+    double eccentricity; //0 is a circle, must be below 1
+    double inclination; //radians from the plane of the ecliptic
+    double ascendingNode; //longitude of the ascending node in radians
+    double argPeriapsis; //argument of periapsis in radians
+    double meanAnomaly; //mean anomaly at the start in radians
+
+    OrbitalElements( ) :
+        semiMajorAxis( 0.0 ),
+        eccentricity( 0.0 ),
+        inclination( 0.0 ),
+        ascendingNode( 0.0 ),
+        argPeriapsis( 0.0 ),
+        meanAnomaly( 0.0 )
+    { }
+
+    OrbitalElements( const OrbitalElements& src ) :
+        semiMajorAxis( src.semiMajorAxis ),
+        eccentricity( src.eccentricity ),
+        inclination( src.inclination ),
+        ascendingNode( src.ascendingNode ),
+        argPeriapsis( src.argPeriapsis ),
+        meanAnomaly( src.meanAnomaly )
+    { }
+};
+
+// class definition ///////////////////////
+
+class OrbitPropagator
+{
+    public:
+        static const int KEPLER_ITERATIONS = 6; //Newton steps per solve
+
+        //contructors
+        OrbitPropagator( );
+        OrbitPropagator( const OrbitPropagator& src );
+
+        //destructor
+        ~OrbitPropagator( );
+
+        unsigned int addOrbit( const OrbitalElements& elements );
+
+        void setMeanMotion( unsigned int index, double newMeanMotion, double time );
+
+        void propagate( double time );
+
+        glm::dvec3 getPosition( unsigned int index ) const;
+
+        void getState( unsigned int index, double gravitationalParameter,
+                       double position[ 3 ], double velocity[ 3 ] ) const;
+
+        double getMeanAnomaly( unsigned int index ) const;
+
+        unsigned int getSize( ) const;
+
+        void clear( );
+
+        static void getAxes( const OrbitalElements& elements,
+                             double periapsis[ 3 ], double normal[ 3 ] );
+
+    private:
+        double getAnomalyAt( unsigned int index, double time ) const;
+
+        //one entry per body in each vector
+        std::vector<double> semiMajorAxis;
+        std::vector<double> semiMinorAxis;
+        std::vector<double> eccentricity;
+        std::vector<double> epochAnomaly; //mean anomaly at the epoch
+        std::vector<double> epochTime; //simulation seconds of the epoch
+        std::vector<double> meanMotion; //radians per simulation second
+
+        //the orbit's periapsis (p) and its normal in the plane (q),
+        //in scene coordinates
+        std::vector<double> pX, pY, pZ;
+        std::vector<double> qX, qY, qZ;
+
+        //results of the last propagate
+        std::vector<double> meanAnomaly; //kept between -pi and pi
+        std::vector<double> eccentricAnomaly;
+        std::vector<double> positionX, positionY, positionZ;
+};
+
+#endif /* ORBIT_H */
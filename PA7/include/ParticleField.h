@@ -0,0 +1,81 @@
+#ifndef PARTICLEFIELD_H
+#define PARTICLEFIELD_H
+
+/***************************************
+
+@file ParticleField.h
+
+@brief A class to draw a belt or ring of rocks with one instanced draw
+
+@note every rock's orbit is stored once in an instance buffer and the
+      vertex shader finds where it is from the time uniform, so moving
+      the rocks costs the CPU nothing per frame
+
+***************************************/
+
+// headers ////////////////////////////////
+#include<vector>
+#include"graphics_headers.h"
+
+#include"GraphicsInfo.h"
+
+// class definition ///////////////////////
+
+class ParticleField
+{
+    public:
+        //contructors
+        ParticleField( );
+
+        //destructor
+        ~ParticleField( );
+
+        bool Initialize( const ParticleFieldInfo& fieldInfo, float planeTilt,
+                         unsigned int seed );
+
+        bool Initialize( unsigned int count, float size );
+
+        void setPositions( const std::vector<glm::vec3>& positions );
+
+        void Render( unsigned int count );
+
+        unsigned int getCount( ) const;
+
+        unsigned int getParentID( ) const;
+
+        bool isRing( ) const;
+
+        float getShaderTime( double time ) const;
+
+    private:
+        //turns the slowest rock makes in one wrap of the time
+        static const unsigned int WRAP_TURNS = 64;
+
+        //three vec4 attributes per rock
+        struct Rock
+        {
+            glm::vec4 periapsis; //unit vector to periapsis, semi-major axis
+            glm::vec4 normal; //unit vector a quarter turn on, semi-minor axis
+            glm::vec4 motion; //eccentricity, mean anomaly at 0, mean motion, size
+        };
+
+        //no copies, the buffers belong to one field
+        ParticleField( const ParticleField& src );
+
+        bool createBuffers( );
+
+        std::vector<Rock> instances;
+
+        GLuint meshVB;
+        GLuint meshIB;
+        GLuint instanceVB;
+
+        unsigned int numberOfIndices;
+
+        double wrapPeriod; //every rock is back where it started, 0 if none move
+
+        unsigned int parentID;
+        bool ring;
+};
+
+#endif /* PARTICLEFIELD_H */
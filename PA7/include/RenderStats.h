@@ -0,0 +1,27 @@
+#ifndef RENDERSTATS_H
+#define RENDERSTATS_H
+
+/***************************************
+
+@file RenderStats.h
+
+@brief Counts the draw calls and triangles sent to OpenGL
+
+@note every draw in the engine adds itself here, so a frame's totals
+      can be read after Render and cleared before the next one
+
+***************************************/
+
+// struct definition //////////////////////
+
+struct RenderStats
+{
+    static unsigned long drawCalls;
+    static unsigned long triangles;
+
+    static void reset( );
+
+    static void addDraw( unsigned long indexCount, unsigned long instances = 1 );
+};
+
+#endif /* RENDERSTATS_H */
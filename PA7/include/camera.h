@@ -7,9 +7,16 @@
 class Camera
 {
     public:
+        static const int DEPTH_STANDARD = 0; //depth from the projection
+        static const int DEPTH_REVERSED = 1; //1 at the near plane, 0 at infinity
+        static const int DEPTH_LOGARITHMIC = 2; //written by the shaders
+
+        static const float NEAR_PLANE; //value defined in camera.cpp
+        static const float FAR_PLANE; //value defined in camera.cpp
+
         Camera();
         ~Camera();
-        bool Initialize(int w, int h);
+        bool Initialize(int w, int h, int depth = DEPTH_STANDARD);
         void LookTopDown();
         void LookSideToSide();
         void moveLeft();
@@ -19,13 +26,23 @@ class Camera
         void zoomIn();
         void zoomOut();
         void updateLookAt();
-        void updateCamera( bool isOn, glm::vec3 planet );
+        void updateCamera( bool isOn, glm::dvec3 planet );
         glm::mat4 GetProjection();
         glm::mat4 GetView();
+        glm::mat4 GetRelativeView();
+        glm::dvec3 GetEyePosition();
+
+        void lookAt( const glm::dvec3& eye, const glm::dvec3& focus );
+
+        int getDepthMode();
+        float getLogDepthCoefficient();
 
         void setZoomSelect( unsigned int selectVal );
 
     private:
+        void setView( const glm::dvec3& eye, const glm::dvec3& focus,
+                      const glm::vec3& up );
+
         bool topDown;
         float upDown;
         float leftRight;
@@ -36,6 +53,12 @@ class Camera
 
         glm::mat4 projection;
         glm::mat4 view;
+
+        //the view with the eye at the origin, for camera relative drawing
+        glm::mat4 relativeView;
+        glm::dvec3 eyePosition;
+
+        int depthMode;
 };
 
 #endif /* CAMERA_H */
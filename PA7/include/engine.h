@@ -13,6 +13,7 @@
 
 #include "window.h"
 #include "graphics.h"
+#include "SimClock.h"
 
 class Engine
 {
@@ -24,10 +25,14 @@ class Engine
         void Run();
         void Keyboard();
         void Mouse();
-        unsigned int getDT();
         long long GetCurrentTimeMillis();
+
+        //drives the window, input and graphics from a script
+        friend class BenchmarkRunner;
     
     private:
+        bool clockKeys( );
+
         // Window related variables
         Window *m_window;        
         string m_WINDOW_NAME;
@@ -38,7 +43,7 @@ class Engine
 
         Graphics *m_graphics;
         unsigned int m_DT;
-        long long m_currentTimeMillis;
+        SimClock m_clock; //simulation time for Update
         bool m_running;
 
 	int trackingID;
@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <vector>
+#include <algorithm>
 using namespace std;
 
 #include "graphics_headers.h"
@@ -15,6 +16,10 @@ using namespace std;
 
 #include"Instance.h"
 
+#include "Orbit.h"
+#include "Gravity.h"
+#include "ParticleField.h"
+
 class Graphics
 {
     public:
@@ -22,11 +27,17 @@ class Graphics
         static const int DECREASE_SPEED = 1;
         static const int RESET_SPEED = 2;
 
+        static const int MAX_GRAVITY_STEPS = 10; //per frame, the rest is dropped
+
+        static const int PARTICLE_REPORT_FRAMES = 120; //frames timed per report
+        static const unsigned int PARTICLE_QUERIES = 3; //timer queries in flight
+        static const unsigned int PARTICLE_SEED = 480; //first field's seed
+
         Graphics();
         ~Graphics();
         bool Initialize(int width, int height, 
                                         const GraphicsInfo& progInfo );
-        void Update(unsigned int dt);
+        void Update(unsigned int dt, double simSeconds);
         void Render();
 
         bool updateList( unsigned int objectID, unsigned int dt );
@@ -58,10 +69,29 @@ class Graphics
 
 	void startTracking( int planet );
 
+        void setCameraView( const glm::dvec3& eye, const glm::dvec3& focus );
+
+        double getPhysicsTime( ) const;
+
+        void toggleGravity( );
+
+        void cycleParticleCount( );
 
 
     private:
         std::string ErrorString(GLenum error);
+
+        void setProgramDefines( Shader& program ) const;
+
+        bool startGravity( );
+
+        void updateGravity( unsigned int dt );
+
+        bool initializeParticles( const GraphicsInfo& progInfo );
+
+        void renderParticles( const glm::dvec3& eye );
+
+        unsigned int getParticleCount( ) const;
 	
 	bool cameraTracking;
 	int planetIndex;
@@ -72,12 +102,51 @@ class Graphics
         GLint m_projectionMatrix;
         GLint m_viewMatrix;
         GLint m_modelMatrix;
+        GLint m_logDepth;
+
+        int depthMode; //one of Camera's DEPTH_ modes
 
         ObjectTable objectRegistry; //holds the scene's objects
 
         std::vector<Instance> modelRegistry;
 
         std::vector<unsigned int> planetRegistry;
+
+        OrbitPropagator orbitPropagator; //one orbit per object, same index
+
+        //position of each object relative to its parent's origin
+        std::vector<glm::dvec3> localPositions;
+
+        //n-body mode
+        GravityInfo gravitySettings;
+        GravitySimulation gravity;
+        std::vector<int> gravityBodies; //body of each object, -1 if it keeps to its orbit
+        std::vector<double> objectMass;
+        bool gravityMode;
+        double gravityTime; //simulated seconds not yet stepped
+
+        double physicsTime; //real milliseconds of the last Update's orbits and gravity
+
+        //instanced belts and rings
+        Shader *particleShader;
+        GLint particleProjectionMatrix;
+        GLint particleViewMatrix;
+        GLint particleCenter;
+        GLint particleTimeLocation;
+        GLint particleLight;
+        GLint particleLogDepth;
+        std::vector<ParticleField*> particleFields;
+        ParticleField *simulatedBelt; //the gravity mode's asteroids
+        unsigned int firstAsteroid; //body of the first simulated asteroid
+        float simulatedRockSize;
+        double particleTime; //seconds the rocks have moved, at their speed
+        float particleSpeed;
+        bool particlePaused;
+        unsigned int particleDivisor; //1 draws every rock, 2 half, 4 a quarter
+        GLuint particleQueries[ PARTICLE_QUERIES ]; //GPU time of drawing the rocks
+        unsigned int particleQueryFrame; //queries issued since the count changed
+        unsigned int particleFrames;
+        double particleGpuTime; //milliseconds over particleFrames
 };
 
 #endif /* GRAPHICS_H */
@@ -8,7 +8,7 @@
 
 struct Origin
 {
-    glm::vec3 translation;
+    glm::dvec3 translation; //double, so far objects keep their precision
     float rotation;
     glm::vec3 scale;
 
@@ -16,7 +16,7 @@ struct Origin
     float orbitTilt;
 
     Origin( ):
-        translation( glm::vec3( 0.0f ) ),
+        translation( glm::dvec3( 0.0 ) ),
         rotation( ( 0.0f ) ),
         scale( glm::vec3( 1.0f ) ),
         tilt( 0.0f ),
@@ -55,6 +55,10 @@ class Object
 
         glm::mat4 GetModel();
 
+        glm::mat4 GetModel( const glm::dvec3& origin );
+
+        glm::dvec3 getWorldPosition( );
+
         glm::mat4& ParentModel( );
 
         Origin& getOrigin( );
@@ -83,8 +87,6 @@ class Object
 
         void toggleAllPaused( );
 
-        void setOrbitalRadius( glm::vec2 radius );
-
         bool setOrigin( const Origin& newOrigin );
 
         bool addChild( unsigned int childsWorldID );
@@ -135,11 +137,9 @@ class Object
 
         void setAngle( float newAngle );
 
-        void incrementOrbitAngle( unsigned int dt );
+        double getOrbitStep( unsigned int dt );
 
-        float getOrbitAngle( );
-
-        void setOrbitAngle( float newAngle );
+        void setOrbitalPosition( const glm::dvec3& position );
 
         bool isPaused( );
 
@@ -162,9 +162,14 @@ class Object
         // model information
         glm::mat4 parentModel;
 
-        glm::mat4 model;
+        glm::mat4 model; //everything but the world translation
         ObjectModel* objModelPtr;
 
+        //world translation, kept apart from the float model matrix
+        glm::dvec3 worldPosition;
+        glm::dvec3 pendingTranslation;
+        bool translationPending;
+
         //children vector containg the worldID's of the objects children
         std::vector<unsigned int> childrenVector;
 
@@ -181,9 +186,8 @@ class Object
         //angle of rotation / orbit information (specialization)
         float angle;
         float tiltAngle;
-        float orbitalAngle;
 
-        glm::vec2 orbitalRadius;
+        glm::dvec3 orbitalPosition; //relative to the parent, from the propagator
 
         float orbitDistanceMultiplier;
 
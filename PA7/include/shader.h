@@ -4,6 +4,7 @@
 #include <vector>
 #include<fstream>
 #include <string>
+#include <utility>
 
 #include "graphics_headers.h"
 
@@ -13,6 +14,7 @@ class Shader
         Shader();
         ~Shader();
         bool Initialize();
+        void SetDefines( const std::vector<std::pair<std::string, int>>& defines );
         void Enable();
         bool AddShader(GLenum ShaderType, const std::string& fileName); 
         bool Finalize();
@@ -22,6 +24,8 @@ class Shader
         GLuint m_shaderProg;        
         std::vector<GLuint> m_shaderObjList;
 
+        std::string m_defines; //added after the #version line of every shader
+
         // private member functions
 
         bool loadShaderSource( const std::string& fileName,
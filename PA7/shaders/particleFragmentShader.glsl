@@ -0,0 +1,24 @@
+#version 330
+
+smooth in vec3 worldPosition;
+smooth in vec3 surfaceNormal;
+smooth in float logDepth;
+
+out vec4 frag_color;
+
+uniform vec3 lightPosition; // the sun, relative to the camera
+uniform float logDepthCoefficient;
+
+const vec3 ROCK_COLOR = vec3(0.55, 0.5, 0.45);
+
+void main(void)
+{
+  vec3 toSun = normalize(lightPosition - worldPosition);
+  float light = max(dot(normalize(surfaceNormal), toSun), 0.0);
+
+  frag_color = vec4(ROCK_COLOR * (0.15 + 0.85 * light), 1.0);
+
+#ifdef LOG_DEPTH
+  gl_FragDepth = log2( logDepth ) * 0.5 * logDepthCoefficient;
+#endif
+}
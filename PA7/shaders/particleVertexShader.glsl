@@ -0,0 +1,39 @@
+#version 330
+
+layout (location = 0) in vec3 v_position;
+layout (location = 2) in vec4 periapsis; // unit vector to periapsis, semi-major axis
+layout (location = 3) in vec4 normal; // unit vector a quarter turn on, semi-minor axis
+layout (location = 4) in vec4 motion; // eccentricity, mean anomaly at 0, mean motion, size
+
+smooth out vec3 worldPosition; // relative to the camera
+smooth out vec3 surfaceNormal;
+smooth out float logDepth;
+
+uniform mat4 projectionMatrix;
+uniform mat4 viewMatrix;
+uniform vec3 centerPosition; // relative to the camera
+uniform float time; // wrapped by the field, every rock turns a whole number of times in its period
+
+const float TWO_PI = 6.28318530718;
+
+void main(void)
+{
+  float e = motion.x;
+  float M = mod(motion.y + motion.z * time, TWO_PI);
+  float E = M + 0.85 * e * sign(sin(M));
+
+  // Newton's method on Kepler's equation, E - e sin E = M
+  for(int i = 0; i < 4; i++)
+  {
+    E -= (E - e * sin(E) - M) / (1.0 - e * cos(E));
+  }
+
+  vec3 orbitPosition = periapsis.w * (cos(E) - e) * periapsis.xyz
+                     + normal.w * sin(E) * normal.xyz;
+
+  worldPosition = centerPosition + orbitPosition + v_position * motion.w;
+  surfaceNormal = v_position;
+
+  gl_Position = projectionMatrix * viewMatrix * vec4(worldPosition, 1.0);
+  logDepth = 1.0 + gl_Position.w;
+}
@@ -1,12 +1,18 @@
 #version 330
 
 smooth in vec2 uv;
+smooth in float logDepth;
 
 out vec4 frag_color;
 
 uniform sampler2D textureSampler;
+uniform float logDepthCoefficient;
 
 void main(void)
 {
   frag_color = texture2D( textureSampler, uv.xy );
+
+#ifdef LOG_DEPTH
+  gl_FragDepth = log2( logDepth ) * 0.5 * logDepthCoefficient;
+#endif
 }
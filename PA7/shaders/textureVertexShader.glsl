@@ -4,13 +4,18 @@ layout (location = 0) in vec3 v_position;
 layout (location = 1) in vec2 v_UV;
 
 smooth out vec2 uv;
+smooth out float logDepth;
 
 uniform mat4 projectionMatrix;
 uniform mat4 viewMatrix;
 uniform mat4 modelMatrix;
 
+// 0 for the normal depth, else 2 / log2( far + 1 )
+uniform float logDepthCoefficient;
+
 void main(void)
 {
   gl_Position = (projectionMatrix * viewMatrix * modelMatrix) * vec4(v_position, 1.0);
   uv = v_UV;
+  logDepth = 1.0 + gl_Position.w;
 }
@@ -0,0 +1,793 @@
+#include "Gravity.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <thread>
+
+#if defined( _WIN64 ) || defined( _WIN32 )
+    #define M_PI 3.14159265358979323846264338327950288
+#endif
+
+const double GravitySimulation::DEFAULT_THETA = 0.5;
+const double GravitySimulation::DEFAULT_SOFTENING = 0.000001;
+
+GravitySimulation::GravitySimulation( ):
+    constant( 1.0 ),
+    theta( DEFAULT_THETA ),
+    softening( DEFAULT_SOFTENING ),
+    threadCount( std::max( std::thread::hardware_concurrency( ), 1u ) ),
+    accelerationsValid( false )
+{
+    //done in initializers
+}
+
+GravitySimulation::GravitySimulation( const GravitySimulation& src ):
+    constant( src.constant ),
+    theta( src.theta ),
+    softening( src.softening ),
+    threadCount( src.threadCount ),
+    mass( src.mass ),
+    positionX( src.positionX ),
+    positionY( src.positionY ),
+    positionZ( src.positionZ ),
+    velocityX( src.velocityX ),
+    velocityY( src.velocityY ),
+    velocityZ( src.velocityZ ),
+    accelerationX( src.accelerationX ),
+    accelerationY( src.accelerationY ),
+    accelerationZ( src.accelerationZ ),
+    potential( src.potential ),
+    nextInLeaf( src.nextInLeaf ),
+    tree( src.tree ),
+    accelerationsValid( src.accelerationsValid )
+{
+    //done in initializers
+}
+
+GravitySimulation::~GravitySimulation( )
+{
+    //done by class members
+}
+
+void GravitySimulation::setConstant( double newConstant )
+{
+    constant = newConstant;
+    accelerationsValid = false;
+}
+
+void GravitySimulation::setTheta( double newTheta )
+{
+    theta = newTheta;
+    accelerationsValid = false;
+}
+
+void GravitySimulation::setSoftening( double newSoftening )
+{
+    softening = newSoftening;
+    accelerationsValid = false;
+}
+
+// SET THREAD COUNT //////////////////
+/***************************************
+
+@brief setThreadCount
+
+@details sets how many threads find the forces
+
+@param in: newThreadCount: the number of threads, 0 for one per core
+
+@notes None
+
+***************************************/
+void GravitySimulation::setThreadCount( unsigned int newThreadCount )
+{
+    if( newThreadCount == 0 )
+    {
+        newThreadCount = std::max( std::thread::hardware_concurrency( ), 1u );
+    }
+
+    threadCount = newThreadCount;
+}
+
+// ADD BODY //////////////////
+/***************************************
+
+@brief addBody
+
+@details adds a body and returns its index
+
+@param in: bodyMass: the mass of the body
+
+@param in: position: the body's position
+
+@param in: velocity: the body's velocity
+
+@notes None
+
+***************************************/
+unsigned int GravitySimulation::addBody
+(
+    double bodyMass,
+    const double position[ 3 ],
+    const double velocity[ 3 ]
+)
+{
+    mass.push_back( bodyMass );
+
+    positionX.push_back( position[ 0 ] );
+    positionY.push_back( position[ 1 ] );
+    positionZ.push_back( position[ 2 ] );
+
+    velocityX.push_back( velocity[ 0 ] );
+    velocityY.push_back( velocity[ 1 ] );
+    velocityZ.push_back( velocity[ 2 ] );
+
+    accelerationX.push_back( 0.0 );
+    accelerationY.push_back( 0.0 );
+    accelerationZ.push_back( 0.0 );
+
+    potential.push_back( 0.0 );
+    nextInLeaf.push_back( -1 );
+
+    accelerationsValid = false;
+
+    return mass.size( ) - 1;
+}
+
+// STEP //////////////////
+/***************************************
+
+@brief step
+
+@details moves every body forward by one time step
+
+@param in: timeStep: the length of the step
+
+@notes kick-drift-kick leapfrog; the accelerations at the end of a step
+       are the ones at the start of the next, so there is one force
+       evaluation per step
+
+***************************************/
+void GravitySimulation::step( double timeStep )
+{
+    size_t index, size = mass.size( );
+    double halfStep = timeStep / 2.0;
+
+    if( size == 0 )
+    {
+        return;
+    }
+
+    if( !accelerationsValid )
+    {
+        computeAccelerations( );
+    }
+
+    for( index = 0; index < size; index++ )
+    {
+        velocityX[ index ] += halfStep * accelerationX[ index ];
+        velocityY[ index ] += halfStep * accelerationY[ index ];
+        velocityZ[ index ] += halfStep * accelerationZ[ index ];
+
+        positionX[ index ] += timeStep * velocityX[ index ];
+        positionY[ index ] += timeStep * velocityY[ index ];
+        positionZ[ index ] += timeStep * velocityZ[ index ];
+    }
+
+    computeAccelerations( );
+
+    for( index = 0; index < size; index++ )
+    {
+        velocityX[ index ] += halfStep * accelerationX[ index ];
+        velocityY[ index ] += halfStep * accelerationY[ index ];
+        velocityZ[ index ] += halfStep * accelerationZ[ index ];
+    }
+}
+
+glm::vec3 GravitySimulation::getPosition( unsigned int index ) const
+{
+    if( index >= mass.size( ) )
+    {
+        return glm::vec3( 0.0f );
+    }
+
+    return glm::vec3( ( float ) positionX[ index ],
+                      ( float ) positionY[ index ],
+                      ( float ) positionZ[ index ] );
+}
+
+void GravitySimulation::getPosition( unsigned int index, double position[ 3 ] ) const
+{
+    if( index >= mass.size( ) )
+    {
+        position[ 0 ] = position[ 1 ] = position[ 2 ] = 0.0;
+        return;
+    }
+
+    position[ 0 ] = positionX[ index ];
+    position[ 1 ] = positionY[ index ];
+    position[ 2 ] = positionZ[ index ];
+}
+
+// GET ENERGY //////////////////
+/***************************************
+
+@brief getEnergy
+
+@details returns the total kinetic and potential energy
+
+@param None
+
+@notes the potential comes from the same tree as the forces, so it
+       carries the same approximation error
+
+***************************************/
+double GravitySimulation::getEnergy( )
+{
+    size_t index;
+    double kinetic = 0.0, potentialSum = 0.0;
+
+    if( mass.empty( ) )
+    {
+        return 0.0;
+    }
+
+    buildTree( );
+
+    runThreaded( &GravitySimulation::potentialRange );
+
+    for( index = 0; index < mass.size( ); index++ )
+    {
+        kinetic += 0.5 * mass[ index ] * ( ( velocityX[ index ] * velocityX[ index ] )
+                                           + ( velocityY[ index ] * velocityY[ index ] )
+                                           + ( velocityZ[ index ] * velocityZ[ index ] ) );
+
+        //each pair is counted from both ends
+        potentialSum += 0.5 * mass[ index ] * potential[ index ];
+    }
+
+    return kinetic + potentialSum;
+}
+
+// REMOVE NET MOMENTUM //////////////////
+/***************************************
+
+@brief removeNetMomentum
+
+@details gives every body the same velocity change so that the
+         system's center of mass stays still
+
+@param None
+
+@notes None
+
+***************************************/
+void GravitySimulation::removeNetMomentum( )
+{
+    size_t index;
+    double total = 0.0, momentum[ 3 ] = { 0.0, 0.0, 0.0 };
+
+    for( index = 0; index < mass.size( ); index++ )
+    {
+        total += mass[ index ];
+
+        momentum[ 0 ] += mass[ index ] * velocityX[ index ];
+        momentum[ 1 ] += mass[ index ] * velocityY[ index ];
+        momentum[ 2 ] += mass[ index ] * velocityZ[ index ];
+    }
+
+    if( total <= 0.0 )
+    {
+        return;
+    }
+
+    for( index = 0; index < mass.size( ); index++ )
+    {
+        velocityX[ index ] -= momentum[ 0 ] / total;
+        velocityY[ index ] -= momentum[ 1 ] / total;
+        velocityZ[ index ] -= momentum[ 2 ] / total;
+    }
+}
+
+unsigned int GravitySimulation::getSize( ) const
+{
+    return mass.size( );
+}
+
+void GravitySimulation::clear( )
+{
+    mass.clear( );
+
+    positionX.clear( ); positionY.clear( ); positionZ.clear( );
+    velocityX.clear( ); velocityY.clear( ); velocityZ.clear( );
+    accelerationX.clear( ); accelerationY.clear( ); accelerationZ.clear( );
+
+    potential.clear( );
+    nextInLeaf.clear( );
+    tree.clear( );
+
+    accelerationsValid = false;
+}
+
+// RUN BENCHMARK //////////////////
+/***************************************
+
+@brief runBenchmark
+
+@details times steps of 1k, 10k and 100k bodies and prints the time per
+         step and the energy drift
+
+@param None
+
+@notes the bodies start on circular orbits in a disc around one heavy
+       body, from a fixed seed so every run is the same
+
+***************************************/
+void GravitySimulation::runBenchmark( )
+{
+    const unsigned int BODY_COUNTS[ ] = { 1000, 10000, 100000 };
+    const unsigned int STEP_COUNTS[ ] = { 200, 50, 10 };
+    const double TIME_STEP = 0.001;
+
+    unsigned int test, body, stepIndex;
+    double position[ 3 ], velocity[ 3 ];
+    double radius, angle, speed, startEnergy, endEnergy, milliseconds;
+    std::chrono::steady_clock::time_point start;
+
+    for( test = 0; test < 3; test++ )
+    {
+        GravitySimulation simulation;
+        std::mt19937 generator( 480 );
+        std::uniform_real_distribution<double> radii( 1.0, 3.0 );
+        std::uniform_real_distribution<double> angles( 0.0, 2.0 * M_PI );
+        std::uniform_real_distribution<double> heights( -0.01, 0.01 );
+
+        position[ 0 ] = position[ 1 ] = position[ 2 ] = 0.0;
+        velocity[ 0 ] = velocity[ 1 ] = velocity[ 2 ] = 0.0;
+
+        simulation.addBody( 1.0, position, velocity );
+
+        for( body = 1; body < BODY_COUNTS[ test ]; body++ )
+        {
+            radius = radii( generator );
+            angle = angles( generator );
+            speed = sqrt( 1.0 / radius );
+
+            position[ 0 ] = radius * cos( angle );
+            position[ 1 ] = heights( generator );
+            position[ 2 ] = radius * sin( angle );
+
+            velocity[ 0 ] = -1.0 * speed * sin( angle );
+            velocity[ 1 ] = 0.0;
+            velocity[ 2 ] = speed * cos( angle );
+
+            simulation.addBody( 0.1 / BODY_COUNTS[ test ], position, velocity );
+        }
+
+        startEnergy = simulation.getEnergy( );
+
+        //first force evaluation is not part of a step
+        simulation.computeAccelerations( );
+        simulation.accelerationsValid = true;
+
+        start = std::chrono::steady_clock::now( );
+
+        for( stepIndex = 0; stepIndex < STEP_COUNTS[ test ]; stepIndex++ )
+        {
+            simulation.step( TIME_STEP );
+        }
+
+        milliseconds = std::chrono::duration<double, std::milli>(
+                           std::chrono::steady_clock::now( ) - start ).count( );
+
+        endEnergy = simulation.getEnergy( );
+
+        std::cout << BODY_COUNTS[ test ] << " bodies, " << simulation.threadCount
+                  << " threads: " << ( milliseconds / STEP_COUNTS[ test ] )
+                  << " ms per step, energy drift "
+                  << fabs( ( endEnergy - startEnergy ) / startEnergy )
+                  << " over " << STEP_COUNTS[ test ] << " steps" << std::endl;
+    }
+}
+
+// private member functions
+
+// BUILD TREE //////////////////
+/***************************************
+
+@brief buildTree
+
+@details builds the octree over the bodies' current positions and sums
+         the mass and center of mass of every node
+
+@param None
+
+@notes children are always added after their parent, so one pass from
+       the back of the node list sums the tree from the leaves up
+
+***************************************/
+void GravitySimulation::buildTree( )
+{
+    size_t index, size = mass.size( );
+    int nodeIndex, child, octant, depth, body, moved, next;
+    double minimum[ 3 ], maximum[ 3 ], halfSize, total, weighted[ 3 ];
+    Node node;
+
+    tree.clear( );
+
+    if( size == 0 )
+    {
+        return;
+    }
+
+    minimum[ 0 ] = maximum[ 0 ] = positionX[ 0 ];
+    minimum[ 1 ] = maximum[ 1 ] = positionY[ 0 ];
+    minimum[ 2 ] = maximum[ 2 ] = positionZ[ 0 ];
+
+    for( index = 1; index < size; index++ )
+    {
+        minimum[ 0 ] = std::min( minimum[ 0 ], positionX[ index ] );
+        minimum[ 1 ] = std::min( minimum[ 1 ], positionY[ index ] );
+        minimum[ 2 ] = std::min( minimum[ 2 ], positionZ[ index ] );
+
+        maximum[ 0 ] = std::max( maximum[ 0 ], positionX[ index ] );
+        maximum[ 1 ] = std::max( maximum[ 1 ], positionY[ index ] );
+        maximum[ 2 ] = std::max( maximum[ 2 ], positionZ[ index ] );
+    }
+
+    halfSize = std::max( std::max( maximum[ 0 ] - minimum[ 0 ], maximum[ 1 ] - minimum[ 1 ] ),
+                         maximum[ 2 ] - minimum[ 2 ] ) / 2.0;
+
+    node.halfSize = ( halfSize * 1.0001 ) + 0.000001;
+    node.mass = 0.0;
+    node.firstChild = -1;
+    node.body = -1;
+    node.count = 0;
+
+    for( child = 0; child < 3; child++ )
+    {
+        node.center[ child ] = ( minimum[ child ] + maximum[ child ] ) / 2.0;
+        node.centerOfMass[ child ] = 0.0;
+    }
+
+    tree.reserve( ( 2 * size / LEAF_SIZE ) + 8 );
+    tree.push_back( node );
+
+    //insert the bodies
+    for( index = 0; index < size; index++ )
+    {
+        nodeIndex = 0;
+        depth = 0;
+        body = ( int ) index;
+
+        while( true )
+        {
+            if( tree[ nodeIndex ].firstChild != -1 )
+            {
+                octant = ( ( positionX[ body ] >= tree[ nodeIndex ].center[ 0 ] ) ? 1 : 0 )
+                         | ( ( positionY[ body ] >= tree[ nodeIndex ].center[ 1 ] ) ? 2 : 0 )
+                         | ( ( positionZ[ body ] >= tree[ nodeIndex ].center[ 2 ] ) ? 4 : 0 );
+
+                nodeIndex = tree[ nodeIndex ].firstChild + octant;
+                depth++;
+            }
+            else if( tree[ nodeIndex ].count < LEAF_SIZE || depth >= MAX_DEPTH )
+            {
+                nextInLeaf[ body ] = tree[ nodeIndex ].body;
+                tree[ nodeIndex ].body = body;
+                tree[ nodeIndex ].count++;
+                break;
+            }
+            else
+            {
+                //split the full leaf and push its bodies down a level
+                moved = tree[ nodeIndex ].body;
+
+                node.halfSize = tree[ nodeIndex ].halfSize / 2.0;
+                node.body = -1;
+                node.count = 0;
+
+                tree[ nodeIndex ].firstChild = tree.size( );
+                tree[ nodeIndex ].body = -1;
+                tree[ nodeIndex ].count = 0;
+
+                for( octant = 0; octant < 8; octant++ )
+                {
+                    node.center[ 0 ] = tree[ nodeIndex ].center[ 0 ]
+                                       + ( ( octant & 1 ) ? node.halfSize : -1.0 * node.halfSize );
+                    node.center[ 1 ] = tree[ nodeIndex ].center[ 1 ]
+                                       + ( ( octant & 2 ) ? node.halfSize : -1.0 * node.halfSize );
+                    node.center[ 2 ] = tree[ nodeIndex ].center[ 2 ]
+                                       + ( ( octant & 4 ) ? node.halfSize : -1.0 * node.halfSize );
+
+                    tree.push_back( node );
+                }
+
+                while( moved != -1 )
+                {
+                    next = nextInLeaf[ moved ];
+
+                    octant = ( ( positionX[ moved ] >= tree[ nodeIndex ].center[ 0 ] ) ? 1 : 0 )
+                             | ( ( positionY[ moved ] >= tree[ nodeIndex ].center[ 1 ] ) ? 2 : 0 )
+                             | ( ( positionZ[ moved ] >= tree[ nodeIndex ].center[ 2 ] ) ? 4 : 0 );
+
+                    child = tree[ nodeIndex ].firstChild + octant;
+
+                    nextInLeaf[ moved ] = tree[ child ].body;
+                    tree[ child ].body = moved;
+                    tree[ child ].count++;
+
+                    moved = next;
+                }
+            }
+        }
+    }
+
+    //sum the masses from the leaves up
+    for( nodeIndex = tree.size( ) - 1; nodeIndex >= 0; nodeIndex-- )
+    {
+        total = 0.0;
+        weighted[ 0 ] = weighted[ 1 ] = weighted[ 2 ] = 0.0;
+
+        if( tree[ nodeIndex ].firstChild == -1 )
+        {
+            for( body = tree[ nodeIndex ].body; body != -1; body = nextInLeaf[ body ] )
+            {
+                total += mass[ body ];
+                weighted[ 0 ] += mass[ body ] * positionX[ body ];
+                weighted[ 1 ] += mass[ body ] * positionY[ body ];
+                weighted[ 2 ] += mass[ body ] * positionZ[ body ];
+            }
+        }
+        else
+        {
+            for( octant = 0; octant < 8; octant++ )
+            {
+                child = tree[ nodeIndex ].firstChild + octant;
+
+                total += tree[ child ].mass;
+                weighted[ 0 ] += tree[ child ].mass * tree[ child ].centerOfMass[ 0 ];
+                weighted[ 1 ] += tree[ child ].mass * tree[ child ].centerOfMass[ 1 ];
+                weighted[ 2 ] += tree[ child ].mass * tree[ child ].centerOfMass[ 2 ];
+            }
+        }
+
+        tree[ nodeIndex ].mass = total;
+
+        for( child = 0; child < 3; child++ )
+        {
+            tree[ nodeIndex ].centerOfMass[ child ] = ( total > 0.0 )
+                                                      ? weighted[ child ] / total
+                                                      : tree[ nodeIndex ].center[ child ];
+        }
+    }
+}
+
+void GravitySimulation::computeAccelerations( )
+{
+    buildTree( );
+
+    runThreaded( &GravitySimulation::accelerationRange );
+
+    accelerationsValid = true;
+}
+
+// ACCELERATION RANGE //////////////////
+/***************************************
+
+@brief accelerationRange
+
+@details walks the tree for a range of bodies and stores their
+         accelerations
+
+@param in: begin: the first body
+
+@param in: end: one past the last body
+
+@notes a node is used whole when its width over its distance is below
+       theta; each thread writes only its own bodies
+
+***************************************/
+void GravitySimulation::accelerationRange( unsigned int begin, unsigned int end )
+{
+    int stack[ 8 * MAX_DEPTH + 8 ];
+    int top, nodeIndex, child, body;
+    unsigned int index;
+    double dx, dy, dz, distanceSquared, width, scale, ax, ay, az;
+    double thetaSquared = theta * theta;
+
+    for( index = begin; index < end; index++ )
+    {
+        ax = ay = az = 0.0;
+
+        top = 0;
+        stack[ top++ ] = 0;
+
+        while( top > 0 )
+        {
+            const Node& node = tree[ stack[ --top ] ];
+
+            if( node.mass == 0.0 )
+            {
+                continue;
+            }
+
+            if( node.firstChild == -1 )
+            {
+                for( body = node.body; body != -1; body = nextInLeaf[ body ] )
+                {
+                    if( body == ( int ) index )
+                    {
+                        continue;
+                    }
+
+                    dx = positionX[ body ] - positionX[ index ];
+                    dy = positionY[ body ] - positionY[ index ];
+                    dz = positionZ[ body ] - positionZ[ index ];
+
+                    distanceSquared = ( dx * dx ) + ( dy * dy ) + ( dz * dz ) + softening;
+                    scale = mass[ body ] / ( distanceSquared * sqrt( distanceSquared ) );
+
+                    ax += scale * dx;
+                    ay += scale * dy;
+                    az += scale * dz;
+                }
+
+                continue;
+            }
+
+            dx = node.centerOfMass[ 0 ] - positionX[ index ];
+            dy = node.centerOfMass[ 1 ] - positionY[ index ];
+            dz = node.centerOfMass[ 2 ] - positionZ[ index ];
+
+            distanceSquared = ( dx * dx ) + ( dy * dy ) + ( dz * dz );
+            width = 2.0 * node.halfSize;
+
+            if( ( width * width ) < ( thetaSquared * distanceSquared ) )
+            {
+                distanceSquared += softening;
+                scale = node.mass / ( distanceSquared * sqrt( distanceSquared ) );
+
+                ax += scale * dx;
+                ay += scale * dy;
+                az += scale * dz;
+            }
+            else
+            {
+                for( child = 0; child < 8; child++ )
+                {
+                    nodeIndex = node.firstChild + child;
+                    stack[ top++ ] = nodeIndex;
+                }
+            }
+        }
+
+        accelerationX[ index ] = constant * ax;
+        accelerationY[ index ] = constant * ay;
+        accelerationZ[ index ] = constant * az;
+    }
+}
+
+// POTENTIAL RANGE //////////////////
+/***************************************
+
+@brief potentialRange
+
+@details walks the tree for a range of bodies and stores the potential
+         at each of them
+
+@param in: begin: the first body
+
+@param in: end: one past the last body
+
+@notes same walk as accelerationRange
+
+***************************************/
+void GravitySimulation::potentialRange( unsigned int begin, unsigned int end )
+{
+    int stack[ 8 * MAX_DEPTH + 8 ];
+    int top, child, body;
+    unsigned int index;
+    double dx, dy, dz, distanceSquared, width, sum;
+    double thetaSquared = theta * theta;
+
+    for( index = begin; index < end; index++ )
+    {
+        sum = 0.0;
+
+        top = 0;
+        stack[ top++ ] = 0;
+
+        while( top > 0 )
+        {
+            const Node& node = tree[ stack[ --top ] ];
+
+            if( node.mass == 0.0 )
+            {
+                continue;
+            }
+
+            if( node.firstChild == -1 )
+            {
+                for( body = node.body; body != -1; body = nextInLeaf[ body ] )
+                {
+                    if( body == ( int ) index )
+                    {
+                        continue;
+                    }
+
+                    dx = positionX[ body ] - positionX[ index ];
+                    dy = positionY[ body ] - positionY[ index ];
+                    dz = positionZ[ body ] - positionZ[ index ];
+
+                    sum -= mass[ body ] / sqrt( ( dx * dx ) + ( dy * dy ) + ( dz * dz ) + softening );
+                }
+
+                continue;
+            }
+
+            dx = node.centerOfMass[ 0 ] - positionX[ index ];
+            dy = node.centerOfMass[ 1 ] - positionY[ index ];
+            dz = node.centerOfMass[ 2 ] - positionZ[ index ];
+
+            distanceSquared = ( dx * dx ) + ( dy * dy ) + ( dz * dz );
+            width = 2.0 * node.halfSize;
+
+            if( ( width * width ) < ( thetaSquared * distanceSquared ) )
+            {
+                sum -= node.mass / sqrt( distanceSquared + softening );
+            }
+            else
+            {
+                for( child = 0; child < 8; child++ )
+                {
+                    stack[ top++ ] = node.firstChild + child;
+                }
+            }
+        }
+
+        potential[ index ] = constant * sum;
+    }
+}
+
+// RUN THREADED //////////////////
+/***************************************
+
+@brief runThreaded
+
+@details splits the bodies into even ranges and runs a tree walk over
+         each range on its own thread
+
+@param in: work: the range function to run
+
+@notes the calling thread takes the last range; small systems run on
+       the calling thread alone
+
+***************************************/
+void GravitySimulation::runThreaded
+(
+    void ( GravitySimulation::*work )( unsigned int, unsigned int )
+)
+{
+    unsigned int size = mass.size( );
+    unsigned int workers, worker, rangeSize;
+    std::vector<std::thread> threads;
+
+    workers = std::min( threadCount, std::max( size / MIN_BODIES_PER_THREAD, 1u ) );
+    rangeSize = ( size + workers - 1 ) / workers;
+
+    for( worker = 0; worker + 1 < workers; worker++ )
+    {
+        threads.push_back( std::thread( work, this, worker * rangeSize,
+                                        std::min( ( worker + 1 ) * rangeSize, size ) ) );
+    }
+
+    ( this->*work )( std::min( worker * rangeSize, size ), size );
+
+    for( worker = 0; worker < threads.size( ); worker++ )
+    {
+        threads[ worker ].join( );
+    }
+}
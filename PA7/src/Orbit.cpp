@@ -0,0 +1,352 @@
+#include "Orbit.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined( _WIN64 ) || defined( _WIN32 )
+    #define M_PI 3.14159265358979323846264338327950288
+#endif
+
+OrbitPropagator::OrbitPropagator( )
+{
+    //done by class members
+}
+
+OrbitPropagator::OrbitPropagator( const OrbitPropagator& src ):
+    semiMajorAxis( src.semiMajorAxis ),
+    semiMinorAxis( src.semiMinorAxis ),
+    eccentricity( src.eccentricity ),
+    epochAnomaly( src.epochAnomaly ),
+    epochTime( src.epochTime ),
+    meanMotion( src.meanMotion ),
+    pX( src.pX ), pY( src.pY ), pZ( src.pZ ),
+    qX( src.qX ), qY( src.qY ), qZ( src.qZ ),
+    meanAnomaly( src.meanAnomaly ),
+    eccentricAnomaly( src.eccentricAnomaly ),
+    positionX( src.positionX ),
+    positionY( src.positionY ),
+    positionZ( src.positionZ )
+{
+    //done in initializers
+}
+
+OrbitPropagator::~OrbitPropagator( )
+{
+    //done by class members
+}
+
+// ADD ORBIT //////////////////
+/***************************************
+
+@brief addOrbit
+
+@details adds a body and returns its index
+
+@param in: elements: the body's orbital elements
+
+@notes the elements are turned into the two axes of the ellipse here,
+       so propagate never needs the angles again. the body stands still
+       at its starting mean anomaly until it is given a mean motion
+
+***************************************/
+unsigned int OrbitPropagator::addOrbit( const OrbitalElements& elements )
+{
+    double periapsis[ 3 ], normal[ 3 ];
+    double ecc = std::min( std::max( elements.eccentricity, 0.0 ), 0.99 );
+
+    getAxes( elements, periapsis, normal );
+
+    semiMajorAxis.push_back( elements.semiMajorAxis );
+    semiMinorAxis.push_back( elements.semiMajorAxis * sqrt( 1.0 - ( ecc * ecc ) ) );
+    eccentricity.push_back( ecc );
+    epochAnomaly.push_back( elements.meanAnomaly );
+    epochTime.push_back( 0.0 );
+    meanMotion.push_back( 0.0 );
+
+    pX.push_back( periapsis[ 0 ] );
+    pY.push_back( periapsis[ 1 ] );
+    pZ.push_back( periapsis[ 2 ] );
+
+    qX.push_back( normal[ 0 ] );
+    qY.push_back( normal[ 1 ] );
+    qZ.push_back( normal[ 2 ] );
+
+    meanAnomaly.push_back( 0.0 );
+    eccentricAnomaly.push_back( 0.0 );
+    positionX.push_back( 0.0 );
+    positionY.push_back( 0.0 );
+    positionZ.push_back( 0.0 );
+
+    //wrapped between -pi and pi like every other mean anomaly
+    epochAnomaly.back( ) = getAnomalyAt( meanAnomaly.size( ) - 1, 0.0 );
+    meanAnomaly.back( ) = epochAnomaly.back( );
+
+    return meanAnomaly.size( ) - 1;
+}
+
+// SET MEAN MOTION //////////////////
+/***************************************
+
+@brief setMeanMotion
+
+@details sets how fast a body moves along its orbit
+
+@param in: index: the body's index
+
+@param in: newMeanMotion: the mean motion in radians per simulation second
+
+@param in: time: the simulation seconds the new motion starts at
+
+@notes a change moves the epoch to the time given, so the body keeps
+       its place and only the motion after it changes. call it as
+       often as needed, an unchanged motion leaves the epoch alone
+
+***************************************/
+void OrbitPropagator::setMeanMotion( unsigned int index, double newMeanMotion, double time )
+{
+    if( index >= meanMotion.size( ) || meanMotion[ index ] == newMeanMotion )
+    {
+        return;
+    }
+
+    epochAnomaly[ index ] = getAnomalyAt( index, time );
+    epochTime[ index ] = time;
+    meanMotion[ index ] = newMeanMotion;
+}
+
+// PROPAGATE //////////////////
+/***************************************
+
+@brief propagate
+
+@details solves Kepler's equation for every body and finds its position
+
+@param in: time: the simulation seconds to find the positions at
+
+@notes every body gets the same number of Newton steps from Danby's
+       starting guess, which converges for any eccentricity below one,
+       so the loops have no branches and the compiler can vectorize them
+
+***************************************/
+void OrbitPropagator::propagate( double time )
+{
+    size_t index, size = meanAnomaly.size( );
+    int iteration;
+    double anomaly, ecc, cosE, sinE, alongP, alongQ;
+
+    for( index = 0; index < size; index++ )
+    {
+        meanAnomaly[ index ] = getAnomalyAt( index, time );
+    }
+
+    for( index = 0; index < size; index++ )
+    {
+        ecc = eccentricity[ index ];
+        anomaly = meanAnomaly[ index ];
+
+        eccentricAnomaly[ index ] = anomaly
+                                    + ( 0.85 * ecc * copysign( 1.0, sin( anomaly ) ) );
+    }
+
+    for( iteration = 0; iteration < KEPLER_ITERATIONS; iteration++ )
+    {
+        for( index = 0; index < size; index++ )
+        {
+            ecc = eccentricity[ index ];
+            anomaly = eccentricAnomaly[ index ];
+
+            eccentricAnomaly[ index ] = anomaly
+                          - ( ( anomaly - ( ecc * sin( anomaly ) ) - meanAnomaly[ index ] )
+                              / ( 1.0 - ( ecc * cos( anomaly ) ) ) );
+        }
+    }
+
+    for( index = 0; index < size; index++ )
+    {
+        cosE = cos( eccentricAnomaly[ index ] );
+        sinE = sin( eccentricAnomaly[ index ] );
+
+        //position in the plane of the orbit, with the parent at a focus
+        alongP = semiMajorAxis[ index ] * ( cosE - eccentricity[ index ] );
+        alongQ = semiMinorAxis[ index ] * sinE;
+
+        positionX[ index ] = ( alongP * pX[ index ] ) + ( alongQ * qX[ index ] );
+        positionY[ index ] = ( alongP * pY[ index ] ) + ( alongQ * qY[ index ] );
+        positionZ[ index ] = ( alongP * pZ[ index ] ) + ( alongQ * qZ[ index ] );
+    }
+}
+
+// GET POSITION //////////////////
+/***************************************
+
+@brief getPosition
+
+@details returns a body's position relative to its parent
+
+@param in: index: the body's index
+
+@notes as of the last call to propagate, kept in double precision
+       so the transforms can rebase it on the camera
+
+***************************************/
+glm::dvec3 OrbitPropagator::getPosition( unsigned int index ) const
+{
+    if( index >= positionX.size( ) )
+    {
+        return glm::dvec3( 0.0 );
+    }
+
+    return glm::dvec3( positionX[ index ], positionY[ index ], positionZ[ index ] );
+}
+
+// GET STATE //////////////////
+/***************************************
+
+@brief getState
+
+@details returns a body's position and velocity relative to its parent
+
+@param in: index: the body's index
+
+@param in: gravitationalParameter: G times the mass the body orbits
+
+@param out: position: the position as of the last propagate
+
+@param out: velocity: the velocity a body on this orbit would have
+
+@notes the orbit's period is not stored, so the speed comes from the
+       gravitational parameter passed in
+
+***************************************/
+void OrbitPropagator::getState
+(
+    unsigned int index,
+    double gravitationalParameter,
+    double position[ 3 ],
+    double velocity[ 3 ]
+) const
+{
+    double cosE, sinE, speed, alongP, alongQ;
+
+    position[ 0 ] = position[ 1 ] = position[ 2 ] = 0.0;
+    velocity[ 0 ] = velocity[ 1 ] = velocity[ 2 ] = 0.0;
+
+    if( index >= positionX.size( ) || semiMajorAxis[ index ] <= 0.0 )
+    {
+        return;
+    }
+
+    position[ 0 ] = positionX[ index ];
+    position[ 1 ] = positionY[ index ];
+    position[ 2 ] = positionZ[ index ];
+
+    cosE = cos( eccentricAnomaly[ index ] );
+    sinE = sin( eccentricAnomaly[ index ] );
+
+    speed = sqrt( gravitationalParameter / semiMajorAxis[ index ] )
+            / ( 1.0 - ( eccentricity[ index ] * cosE ) );
+
+    alongP = -1.0 * speed * sinE;
+    alongQ = speed * ( semiMinorAxis[ index ] / semiMajorAxis[ index ] ) * cosE;
+
+    velocity[ 0 ] = ( alongP * pX[ index ] ) + ( alongQ * qX[ index ] );
+    velocity[ 1 ] = ( alongP * pY[ index ] ) + ( alongQ * qY[ index ] );
+    velocity[ 2 ] = ( alongP * pZ[ index ] ) + ( alongQ * qZ[ index ] );
+}
+
+double OrbitPropagator::getMeanAnomaly( unsigned int index ) const
+{
+    if( index >= meanAnomaly.size( ) )
+    {
+        return 0.0;
+    }
+
+    return meanAnomaly[ index ];
+}
+
+unsigned int OrbitPropagator::getSize( ) const
+{
+    return meanAnomaly.size( );
+}
+
+// GET AXES //////////////////
+/***************************************
+
+@brief getAxes
+
+@details finds the unit vectors of an orbit's plane in scene coordinates
+
+@param in: elements: the orbital elements
+
+@param out: periapsis: points from the focus to the periapsis
+
+@param out: normal: in the plane, a quarter turn ahead of periapsis
+
+@notes the ecliptic's north is the scene's y axis, so the ecliptic's
+       x and y are the scene's x and z
+
+***************************************/
+void OrbitPropagator::getAxes
+(
+    const OrbitalElements& elements,
+    double periapsis[ 3 ],
+    double normal[ 3 ]
+)
+{
+    double cosNode = cos( elements.ascendingNode );
+    double sinNode = sin( elements.ascendingNode );
+    double cosArg = cos( elements.argPeriapsis );
+    double sinArg = sin( elements.argPeriapsis );
+    double cosInc = cos( elements.inclination );
+    double sinInc = sin( elements.inclination );
+
+    periapsis[ 0 ] = ( cosNode * cosArg ) - ( sinNode * sinArg * cosInc );
+    periapsis[ 1 ] = sinArg * sinInc;
+    periapsis[ 2 ] = ( sinNode * cosArg ) + ( cosNode * sinArg * cosInc );
+
+    normal[ 0 ] = -1.0 * ( ( cosNode * sinArg ) + ( sinNode * cosArg * cosInc ) );
+    normal[ 1 ] = cosArg * sinInc;
+    normal[ 2 ] = ( cosNode * cosArg * cosInc ) - ( sinNode * sinArg );
+}
+
+// GET ANOMALY AT //////////////////
+/***************************************
+
+@brief getAnomalyAt
+
+@details finds a body's mean anomaly at a simulation time
+
+@param in: index: the body's index
+
+@param in: time: the simulation seconds
+
+@notes M = M0 + n ( t - t0 ), wrapped back between -pi and pi. it is
+       found from the time and never added up, so a long run or a large
+       time warp does not drift
+
+***************************************/
+double OrbitPropagator::getAnomalyAt( unsigned int index, double time ) const
+{
+    double angle = epochAnomaly[ index ]
+                   + ( meanMotion[ index ] * ( time - epochTime[ index ] ) );
+
+    return angle - ( 2.0 * M_PI * floor( ( angle + M_PI ) / ( 2.0 * M_PI ) ) );
+}
+
+void OrbitPropagator::clear( )
+{
+    semiMajorAxis.clear( );
+    semiMinorAxis.clear( );
+    eccentricity.clear( );
+    epochAnomaly.clear( );
+    epochTime.clear( );
+    meanMotion.clear( );
+
+    pX.clear( ); pY.clear( ); pZ.clear( );
+    qX.clear( ); qY.clear( ); qZ.clear( );
+
+    meanAnomaly.clear( );
+    eccentricAnomaly.clear( );
+    positionX.clear( );
+    positionY.clear( );
+    positionZ.clear( );
+}
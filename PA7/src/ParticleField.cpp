@@ -0,0 +1,386 @@
+#include "ParticleField.h"
+#include <cmath>
+#include <random>
+#include <algorithm>
+
+#include "Orbit.h"
+#include "RenderStats.h"
+
+#if defined( _WIN64 ) || defined( _WIN32 )
+    #define M_PI 3.14159265358979323846264338327950288
+#endif
+
+ParticleField::ParticleField( )
+{
+    meshVB = 0;
+    meshIB = 0;
+    instanceVB = 0;
+
+    numberOfIndices = 0;
+
+    wrapPeriod = 0.0;
+
+    parentID = 0;
+    ring = false;
+}
+
+ParticleField::~ParticleField( )
+{
+    if( instanceVB != 0 )
+    {
+        glDeleteBuffers( 1, &instanceVB );
+    }
+
+    if( meshIB != 0 )
+    {
+        glDeleteBuffers( 1, &meshIB );
+    }
+
+    if( meshVB != 0 )
+    {
+        glDeleteBuffers( 1, &meshVB );
+    }
+}
+
+// INITIALIZE //////////////////
+/***************************************
+
+@brief Initialize
+
+@details scatters the field's rocks on orbits around its parent and
+         uploads them
+
+@param in: fieldInfo: the field's settings
+
+@param in: planeTilt: the tilt of the parent, used by rings
+
+@param in: seed: the random seed, so a field is the same every run
+
+@notes a ring lies in its parent's equator, a belt in the ecliptic.
+       the rocks are spread evenly over the area between the radii and
+       turn like the planets, slower the farther out they are. each
+       mean motion is rounded to a whole number of turns per wrap
+       period, so the shader can be given the time modulo that period
+
+***************************************/
+bool ParticleField::Initialize
+(
+    const ParticleFieldInfo& fieldInfo,
+    float planeTilt,
+    unsigned int seed
+)
+{
+    unsigned int index;
+    double periapsis[ 3 ], normal[ 3 ], area, meanMotion, turns;
+    OrbitalElements elements;
+    Rock rock;
+
+    std::mt19937 generator( seed );
+    std::uniform_real_distribution<double> unit( 0.0, 1.0 );
+    std::uniform_real_distribution<double> angles( 0.0, 2.0 * M_PI );
+    std::uniform_real_distribution<double> spread( -1.0 * fieldInfo.thickness,
+                                                   fieldInfo.thickness );
+
+    if( fieldInfo.radius.x <= 0.0f || fieldInfo.radius.y < fieldInfo.radius.x )
+    {
+        std::cout << "Invalid particle field radii!" << std::endl;
+        return false;
+    }
+
+    parentID = fieldInfo.parentID;
+    ring = fieldInfo.ring;
+
+    //the outer edge turns slowest
+    meanMotion = fabs( fieldInfo.orbitRate * M_PI
+                       * pow( fieldInfo.radius.x / fieldInfo.radius.y, 1.5 ) );
+
+    wrapPeriod = ( meanMotion > 0.0 ) ? WRAP_TURNS * 2.0 * M_PI / meanMotion : 0.0;
+
+    instances.clear( );
+    instances.reserve( fieldInfo.count );
+
+    for( index = 0; index < fieldInfo.count; index++ )
+    {
+        area = ( fieldInfo.radius.x * fieldInfo.radius.x )
+               + ( unit( generator ) * ( ( fieldInfo.radius.y * fieldInfo.radius.y )
+                                         - ( fieldInfo.radius.x * fieldInfo.radius.x ) ) );
+
+        elements.semiMajorAxis = sqrt( area );
+        elements.eccentricity = unit( generator ) * fieldInfo.eccentricity;
+        elements.argPeriapsis = angles( generator );
+        elements.meanAnomaly = angles( generator );
+
+        if( ring )
+        {
+            //the tilt turns the equator about the scene's z axis
+            elements.inclination = spread( generator ) - planeTilt;
+            elements.ascendingNode = M_PI / 2.0;
+        }
+        else
+        {
+            elements.inclination = spread( generator );
+            elements.ascendingNode = angles( generator );
+        }
+
+        OrbitPropagator::getAxes( elements, periapsis, normal );
+
+        rock.periapsis = glm::vec4( periapsis[ 0 ], periapsis[ 1 ], periapsis[ 2 ],
+                                    elements.semiMajorAxis );
+
+        rock.normal = glm::vec4( normal[ 0 ], normal[ 1 ], normal[ 2 ],
+                                 elements.semiMajorAxis
+                                 * sqrt( 1.0 - ( elements.eccentricity * elements.eccentricity ) ) );
+
+        //same sense as the planets, Kepler's third law from the inner edge
+        meanMotion = -1.0 * fieldInfo.orbitRate * M_PI
+                     * pow( fieldInfo.radius.x / elements.semiMajorAxis, 1.5 );
+
+        if( wrapPeriod > 0.0 )
+        {
+            turns = std::max( 1.0, floor( ( fabs( meanMotion ) * wrapPeriod
+                                            / ( 2.0 * M_PI ) ) + 0.5 ) );
+
+            meanMotion = ( meanMotion < 0.0 ? -1.0 : 1.0 ) * turns * 2.0 * M_PI / wrapPeriod;
+        }
+
+        rock.motion = glm::vec4( elements.eccentricity,
+                                 elements.meanAnomaly,
+                                 meanMotion,
+                                 fieldInfo.size * ( 0.5 + unit( generator ) ) );
+
+        instances.push_back( rock );
+    }
+
+    return createBuffers( );
+}
+
+// INITIALIZE //////////////////
+/***************************************
+
+@brief Initialize
+
+@details makes a field whose rocks are placed by setPositions
+
+@param in: count: the number of rocks
+
+@param in: size: the size of a rock
+
+@notes each rock gets an orbit with no size or motion, so the shader
+       puts it at its periapsis vector, which setPositions fills in
+
+***************************************/
+bool ParticleField::Initialize( unsigned int count, float size )
+{
+    Rock rock;
+
+    parentID = 0;
+    ring = false;
+    wrapPeriod = 0.0;
+
+    rock.periapsis = glm::vec4( 0.0f, 0.0f, 0.0f, 1.0f );
+    rock.normal = glm::vec4( 0.0f, 0.0f, 0.0f, 0.0f );
+    rock.motion = glm::vec4( 0.0f, 0.0f, 0.0f, size );
+
+    instances.assign( count, rock );
+
+    return createBuffers( );
+}
+
+// SET POSITIONS //////////////////
+/***************************************
+
+@brief setPositions
+
+@details moves the rocks of a field made for set positions
+
+@param in: positions: one position per rock
+
+@notes extra positions are ignored
+
+***************************************/
+void ParticleField::setPositions( const std::vector<glm::vec3>& positions )
+{
+    unsigned int index;
+
+    if( instanceVB == 0 )
+    {
+        return;
+    }
+
+    for( index = 0; index < instances.size( ) && index < positions.size( ); index++ )
+    {
+        instances[ index ].periapsis = glm::vec4( positions[ index ], 1.0f );
+    }
+
+    glBindBuffer( GL_ARRAY_BUFFER, instanceVB );
+    glBufferSubData( GL_ARRAY_BUFFER, 0, sizeof( Rock ) * instances.size( ),
+                     &instances[ 0 ] );
+}
+
+// RENDER //////////////////
+/***************************************
+
+@brief Render
+
+@details draws the field's rocks with one instanced draw call
+
+@param in: count: how many of the rocks to draw
+
+@notes the particle shader must be enabled with its time, center,
+       projection and view uniforms set. the instance attributes'
+       divisors are put back so the objects' draws are not affected
+
+***************************************/
+void ParticleField::Render( unsigned int count )
+{
+    unsigned int attribute;
+
+    count = std::min( count, ( unsigned int ) instances.size( ) );
+
+    if( instanceVB == 0 || count == 0 )
+    {
+        return;
+    }
+
+    glEnableVertexAttribArray( 0 );
+
+    glBindBuffer( GL_ARRAY_BUFFER, meshVB );
+    glVertexAttribPointer( 0, 3, GL_FLOAT, GL_FALSE, sizeof( glm::vec3 ), 0 );
+
+    glBindBuffer( GL_ARRAY_BUFFER, instanceVB );
+
+    for( attribute = 0; attribute < 3; attribute++ )
+    {
+        glEnableVertexAttribArray( 2 + attribute );
+        glVertexAttribPointer( 2 + attribute, 4, GL_FLOAT, GL_FALSE, sizeof( Rock ),
+                               ( void* ) ( attribute * sizeof( glm::vec4 ) ) );
+        glVertexAttribDivisor( 2 + attribute, 1 );
+    }
+
+    glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, meshIB );
+
+    glDrawElementsInstanced( GL_TRIANGLES, numberOfIndices, GL_UNSIGNED_INT, 0, count );
+
+    RenderStats::addDraw( numberOfIndices, count );
+
+    for( attribute = 0; attribute < 3; attribute++ )
+    {
+        glVertexAttribDivisor( 2 + attribute, 0 );
+        glDisableVertexAttribArray( 2 + attribute );
+    }
+
+    glDisableVertexAttribArray( 0 );
+}
+
+unsigned int ParticleField::getCount( ) const
+{
+    return instances.size( );
+}
+
+unsigned int ParticleField::getParentID( ) const
+{
+    return parentID;
+}
+
+bool ParticleField::isRing( ) const
+{
+    return ring;
+}
+
+// GET SHADER TIME //////////////////
+/***************************************
+
+@brief getShaderTime
+
+@details wraps the time for the shader's time uniform
+
+@param in: time: the time the rocks have moved for, in seconds
+
+@notes every rock makes a whole number of turns in wrapPeriod, so
+       wrapping in double here moves none of them, while a float of
+       the raw time would lose the phase as the time grows
+
+***************************************/
+float ParticleField::getShaderTime( double time ) const
+{
+    if( wrapPeriod <= 0.0 )
+    {
+        return 0.0f;
+    }
+
+    time = fmod( time, wrapPeriod );
+
+    if( time < 0.0 )
+    {
+        time += wrapPeriod;
+    }
+
+    return ( float ) time;
+}
+
+// private member functions
+
+// CREATE BUFFERS //////////////////
+/***************************************
+
+@brief createBuffers
+
+@details uploads the rock mesh and the instances
+
+@param None
+
+@notes the rock is an icosahedron of radius 1
+
+***************************************/
+bool ParticleField::createBuffers( )
+{
+    const float GOLDEN = 1.618034f;
+    const unsigned int ROCK_INDICES[ ] = { 0, 11, 5,   0, 5, 1,    0, 1, 7,    0, 7, 10,
+                                           0, 10, 11,  1, 5, 9,    5, 11, 4,   11, 10, 2,
+                                           10, 7, 6,   7, 1, 8,    3, 9, 4,    3, 4, 2,
+                                           3, 2, 6,    3, 6, 8,    3, 8, 9,    4, 9, 5,
+                                           2, 4, 11,   6, 2, 10,   8, 6, 7,    9, 8, 1 };
+    std::vector<glm::vec3> rockVertices;
+
+    if( instances.empty( ) )
+    {
+        return true;
+    }
+
+    rockVertices.push_back( glm::vec3( -1.0f, GOLDEN, 0.0f ) );
+    rockVertices.push_back( glm::vec3( 1.0f, GOLDEN, 0.0f ) );
+    rockVertices.push_back( glm::vec3( -1.0f, -1.0f * GOLDEN, 0.0f ) );
+    rockVertices.push_back( glm::vec3( 1.0f, -1.0f * GOLDEN, 0.0f ) );
+    rockVertices.push_back( glm::vec3( 0.0f, -1.0f, GOLDEN ) );
+    rockVertices.push_back( glm::vec3( 0.0f, 1.0f, GOLDEN ) );
+    rockVertices.push_back( glm::vec3( 0.0f, -1.0f, -1.0f * GOLDEN ) );
+    rockVertices.push_back( glm::vec3( 0.0f, 1.0f, -1.0f * GOLDEN ) );
+    rockVertices.push_back( glm::vec3( GOLDEN, 0.0f, -1.0f ) );
+    rockVertices.push_back( glm::vec3( GOLDEN, 0.0f, 1.0f ) );
+    rockVertices.push_back( glm::vec3( -1.0f * GOLDEN, 0.0f, -1.0f ) );
+    rockVertices.push_back( glm::vec3( -1.0f * GOLDEN, 0.0f, 1.0f ) );
+
+    for( unsigned int index = 0; index < rockVertices.size( ); index++ )
+    {
+        rockVertices[ index ] = glm::normalize( rockVertices[ index ] );
+    }
+
+    numberOfIndices = sizeof( ROCK_INDICES ) / sizeof( ROCK_INDICES[ 0 ] );
+
+    glGenBuffers( 1, &meshVB );
+    glBindBuffer( GL_ARRAY_BUFFER, meshVB );
+    glBufferData( GL_ARRAY_BUFFER, sizeof( glm::vec3 ) * rockVertices.size( ),
+                  &rockVertices[ 0 ], GL_STATIC_DRAW );
+
+    glGenBuffers( 1, &meshIB );
+    glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, meshIB );
+    glBufferData( GL_ELEMENT_ARRAY_BUFFER, sizeof( ROCK_INDICES ), ROCK_INDICES,
+                  GL_STATIC_DRAW );
+
+    glGenBuffers( 1, &instanceVB );
+    glBindBuffer( GL_ARRAY_BUFFER, instanceVB );
+    glBufferData( GL_ARRAY_BUFFER, sizeof( Rock ) * instances.size( ),
+                  &instances[ 0 ], GL_DYNAMIC_DRAW );
+
+    return ( meshVB != 0 && meshIB != 0 && instanceVB != 0 );
+}
@@ -0,0 +1,30 @@
+#include "RenderStats.h"
+
+unsigned long RenderStats::drawCalls = 0;
+unsigned long RenderStats::triangles = 0;
+
+void RenderStats::reset( )
+{
+    drawCalls = 0;
+    triangles = 0;
+}
+
+// ADD DRAW //////////////////
+/***************************************
+
+@brief addDraw
+
+@details counts one draw call of indexed triangles
+
+@param in: indexCount: the number of indices drawn
+
+@param in: instances: the number of instances drawn
+
+@notes None
+
+***************************************/
+void RenderStats::addDraw( unsigned long indexCount, unsigned long instances )
+{
+    drawCalls++;
+    triangles += ( indexCount / 3 ) * instances;
+}
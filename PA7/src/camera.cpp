@@ -1,4 +1,8 @@
 #include "camera.h"
+#include <cmath>
+
+const float Camera::NEAR_PLANE = 0.01f;
+const float Camera::FAR_PLANE = 1000.0f;
 
 Camera::Camera()
 {
@@ -9,6 +13,8 @@ Camera::Camera()
 	
     zoomMinimum = { 0.50f, 0.50f, 0.50f, 0.50f, 3.0f, 3.0f, 1.50f, 1.0f, 0.50f };
     zoomSelect = 0;
+
+    depthMode = DEPTH_STANDARD;
 }
 
 Camera::~Camera()
@@ -16,7 +22,7 @@ Camera::~Camera()
 
 }
 
-bool Camera::Initialize(int w, int h)
+bool Camera::Initialize(int w, int h, int depth)
 {
     //--Init the view and projection matrices
     //    if you will be having a moving camera the view matrix will need to more dynamic
@@ -25,10 +31,21 @@ bool Camera::Initialize(int w, int h)
 
     LookTopDown();
 
+    depthMode = depth;
+
     projection = glm::perspective( 45.0f, //the FoV typically 90 degrees is good which is what this is set to
                                    float(w)/float(h), //Aspect Ratio, so Circles stay Circular
-                                   0.01f, //Distance to the near plane, normally a small value like this
-                                   1000.0f); //Distance to the far plane, 
+                                   NEAR_PLANE, //Distance to the near plane, normally a small value like this
+                                   FAR_PLANE); //Distance to the far plane, 
+
+    //reversed z with no far plane, for a [0,1] clip range:
+    //depth = near / distance, so the precision follows the float's
+    if( depthMode == DEPTH_REVERSED )
+    {
+        projection[ 2 ] = glm::vec4( 0.0f, 0.0f, 0.0f, -1.0f );
+        projection[ 3 ] = glm::vec4( 0.0f, 0.0f, NEAR_PLANE, 0.0f );
+    }
+
     return true;
 }
 
@@ -41,9 +58,9 @@ void Camera::LookTopDown()
     upDown = 0.0;
     zoom = 15.0;
     topDown = true;
-    view = glm::lookAt( glm::vec3( 0.0, zoom, 0.0), //Eye Position
-                                   glm::vec3( leftRight, 0.0, upDown), //Focus point
-                                   glm::vec3(0.0, 0.0, 1.0)); //Positive Y is up
+    setView( glm::dvec3( 0.0, zoom, 0.0), //Eye Position
+             glm::dvec3( leftRight, 0.0, upDown), //Focus point
+             glm::vec3(0.0, 0.0, 1.0)); //Positive Y is up
 
 }
 
@@ -55,9 +72,9 @@ void Camera::LookSideToSide()
     upDown = 0.0;
     zoom = 15.0;
     topDown = false;
-    view = glm::lookAt( glm::vec3( 0.0, 0.80, zoom), //Eye Position
-                                   glm::vec3( leftRight, upDown, 0.0), //Focus point
-                                   glm::vec3(0.0, 1.0, 0.0)); //Positive Y is up
+    setView( glm::dvec3( 0.0, 0.80, zoom), //Eye Position
+             glm::dvec3( leftRight, upDown, 0.0), //Focus point
+             glm::vec3(0.0, 1.0, 0.0)); //Positive Y is up
 
 }
 
@@ -132,24 +149,24 @@ void Camera::updateLookAt()
 {
    if( topDown )
    {
-      view = glm::lookAt( glm::vec3( leftRight, zoom, upDown), //Eye Position
-                                   glm::vec3( leftRight, 0.0, upDown), //Focus point
-                                   glm::vec3(0.0, 0.0, 1.0)); //Positive Y is up
+      setView( glm::dvec3( leftRight, zoom, upDown), //Eye Position
+               glm::dvec3( leftRight, 0.0, upDown), //Focus point
+               glm::vec3(0.0, 0.0, 1.0)); //Positive Y is up
    }
    else
    {
-      view = glm::lookAt( glm::vec3( leftRight, 8.0 + upDown, zoom), //Eye Position
-                                   glm::vec3( leftRight, upDown, 0.0), //Focus point
-                                   glm::vec3(0.0, 1.0, 0.0)); //Positive Y is up
+      setView( glm::dvec3( leftRight, 8.0 + upDown, zoom), //Eye Position
+               glm::dvec3( leftRight, upDown, 0.0), //Focus point
+               glm::vec3(0.0, 1.0, 0.0)); //Positive Y is up
    }
 
 }
 
-void Camera::updateCamera( bool isOn, glm::vec3 planet )
+void Camera::updateCamera( bool isOn, glm::dvec3 planet )
 {
    if( isOn )
    {
-	float newZoom = 0.0;
+	double newZoom = 0.0;
 
     if( ( zoom <= 0.0f ) && ( zoom > ( -1.0f * zoomMinimum[ zoomSelect ] ) ) )
     {
@@ -166,27 +183,29 @@ void Camera::updateCamera( bool isOn, glm::vec3 planet )
 	    leftRight = planet.x;
 	    newZoom = planet.y + zoom;
 	    upDown = planet.z;
-	     view = glm::lookAt( glm::vec3( leftRight, newZoom, upDown), //Eye Position
-                                  planet, //Focus point
-                                   glm::vec3(0.0, 0.0, 1.0)); //Positive Y is up
+	     setView( glm::dvec3( planet.x, newZoom, planet.z), //Eye Position
+                      planet, //Focus point
+                      glm::vec3(0.0, 0.0, 1.0)); //Positive Y is up
 	}
 	else
 	{
-	    leftRight = planet.x;
-        upDown = planet.y;
+	    double lift = 0.0;
 
         if( ( zoomSelect == 4 )
             || ( zoomSelect == 5 )
             || ( zoomSelect == 6 )
             || ( zoomSelect == 7 ) )
         {
-            upDown += 0.13f;
+            lift = 0.13;
         }
 
+	    leftRight = planet.x;
+        upDown = planet.y + lift;
+
 	    newZoom = planet.z + zoom;
-   	    view = glm::lookAt( glm::vec3( leftRight, upDown, newZoom), //Eye Position
-                                   planet, //Focus point
-                                   glm::vec3(0.0, 1.0, 0.0)); //Positive Y is up
+   	    setView( glm::dvec3( planet.x, planet.y + lift, newZoom), //Eye Position
+                     planet, //Focus point
+                     glm::vec3(0.0, 1.0, 0.0)); //Positive Y is up
 	}
 
    }
@@ -203,6 +222,109 @@ glm::mat4 Camera::GetView()
     return view;
 }
 
+// GET RELATIVE VIEW //////////////////
+/***************************************
+
+@brief GetRelativeView
+
+@details returns the view with the eye moved to the origin
+
+@param None
+
+@notes used with models rebased on GetEyePosition, so no large
+       translation ever reaches a float matrix
+
+***************************************/
+glm::mat4 Camera::GetRelativeView()
+{
+    return relativeView;
+}
+
+glm::dvec3 Camera::GetEyePosition()
+{
+    return eyePosition;
+}
+
+// LOOK AT //////////////////
+/***************************************
+
+@brief lookAt
+
+@details points the camera from an eye position at a focus point
+
+@param in: eye: the eye position in the world
+
+@param in: focus: the focus point in the world
+
+@notes positive y is up
+
+***************************************/
+void Camera::lookAt( const glm::dvec3& eye, const glm::dvec3& focus )
+{
+    setView( eye, focus, glm::vec3( 0.0f, 1.0f, 0.0f ) );
+}
+
+int Camera::getDepthMode()
+{
+    return depthMode;
+}
+
+// GET LOG DEPTH COEFFICIENT //////////////////
+/***************************************
+
+@brief getLogDepthCoefficient
+
+@details returns the scale the shaders use for a logarithmic depth
+
+@param None
+
+@notes 0 unless the depth mode is DEPTH_LOGARITHMIC, which the shaders
+       take to mean the normal depth
+
+***************************************/
+float Camera::getLogDepthCoefficient()
+{
+    if( depthMode != DEPTH_LOGARITHMIC )
+    {
+        return 0.0f;
+    }
+
+    return 2.0f / log2( FAR_PLANE + 1.0f );
+}
+
+// SET VIEW //////////////////
+/***************************************
+
+@brief setView
+
+@details sets the view and the camera relative view from one look at
+
+@param in: eye: the eye position in the world
+
+@param in: focus: the focus point in the world
+
+@param in: up: the up direction
+
+@notes the direction is taken in double precision, so the relative
+       view is exact however far the eye is from the world's center
+
+***************************************/
+void Camera::setView( const glm::dvec3& eye, const glm::dvec3& focus, const glm::vec3& up )
+{
+    glm::dvec3 direction = focus - eye;
+
+    eyePosition = eye;
+
+    relativeView = glm::lookAt( glm::vec3( 0.0f ),
+                                glm::vec3( ( float ) direction.x, ( float ) direction.y,
+                                           ( float ) direction.z ),
+                                up );
+
+    view = glm::lookAt( glm::vec3( ( float ) eye.x, ( float ) eye.y, ( float ) eye.z ),
+                        glm::vec3( ( float ) focus.x, ( float ) focus.y, ( float ) focus.z ),
+                        up );
+}
+
 
 
 void Camera::setZoomSelect( unsigned int selectVal )
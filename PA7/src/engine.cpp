@@ -1,5 +1,6 @@
 
 #include "engine.h"
+#include "Logger.h"
 
 Engine::Engine(string name, int width, int height)
 {
@@ -38,10 +39,15 @@ Engine::~Engine()
     
     m_window = NULL;
     m_graphics = NULL;
+
+    Logger::stop( );
 }
 
 bool Engine::Initialize( const GraphicsInfo& progInfo )
 {
+    // Start the log writer
+    Logger::start( );
+
     // Start a window
     m_window = new Window();
     if(!m_window->Initialize(m_WINDOW_NAME, &m_WINDOW_WIDTH, &m_WINDOW_HEIGHT))
@@ -59,7 +65,7 @@ bool Engine::Initialize( const GraphicsInfo& progInfo )
     }
 
     // Set the time
-    m_currentTimeMillis = GetCurrentTimeMillis();
+    m_clock.start( );
 
     // No errors
     return true;
@@ -67,12 +73,14 @@ bool Engine::Initialize( const GraphicsInfo& progInfo )
 
 void Engine::Run()
 {
+    unsigned int tickDT;
+
     m_running = true;
 
     while(m_running)
     {
-        // Update the DT
-        m_DT = getDT();
+        // Start the frame on the simulation clock
+        m_clock.beginFrame( );
 
         // Check the keyboard input
         while(SDL_PollEvent(&m_event) != 0)
@@ -80,8 +88,15 @@ void Engine::Run()
             Keyboard();
         }
 
-        // Update and render the graphics
-        m_graphics->Update(m_DT);
+        // Update once per tick the clock hands out for this frame, then render
+        m_DT = 0;
+
+        while( m_clock.nextTick( tickDT ) )
+        {
+            m_graphics->Update( tickDT, m_clock.getSimSeconds( ) );
+            m_DT += tickDT;
+        }
+
         m_graphics->Render();
 
         // Swap to the Window
@@ -103,6 +118,10 @@ void Engine::Keyboard()
         {
             m_running = false;
         }
+        else if( clockKeys( ) )
+        {
+            //the simulation clock took the key
+        }
         else if( m_event.key.keysym.sym == SDLK_UP )
         {
             if( m_graphics != NULL )
@@ -218,6 +237,20 @@ void Engine::Keyboard()
                 m_graphics->toggleAllObjectsPaused( );
             }            
         }
+        else if( m_event.key.keysym.sym == SDLK_g )
+        {
+            if( m_graphics != NULL )
+            {
+                m_graphics->toggleGravity( );
+            }
+        }
+        else if( m_event.key.keysym.sym == SDLK_i )
+        {
+            if( m_graphics != NULL )
+            {
+                m_graphics->cycleParticleCount( );
+            }
+        }
 	else if( m_event.key.keysym.sym == SDLK_1 )
         {
             if( m_graphics != NULL )
@@ -321,13 +354,66 @@ void Engine::Mouse( )
     
 }
 
-unsigned int Engine::getDT()
+// CLOCK KEYS //////////////////
+/***************************************
+
+@brief clockKeys
+
+@details handles the simulation clock's keys
+
+@param None
+
+@notes F5 pauses, F6 steps a paused simulation, F7 and F8 divide and
+       multiply the time scale by ten, F9 resets it and F10 switches
+       the fixed tick mode. returns true if the key was one of these
+
+***************************************/
+bool Engine::clockKeys( )
 {
-    long long TimeNowMillis = GetCurrentTimeMillis();
-    assert(TimeNowMillis >= m_currentTimeMillis);
-    unsigned int DeltaTimeMillis = (unsigned int)(TimeNowMillis - m_currentTimeMillis);
-    m_currentTimeMillis = TimeNowMillis;
-    return DeltaTimeMillis;
+    SDL_Keycode key = m_event.key.keysym.sym;
+
+    if( key == SDLK_F5 )
+    {
+        m_clock.togglePaused( );
+
+        std::cout << ( m_clock.isPaused( ) ? "Simulation paused" : "Simulation running" )
+                  << std::endl;
+    }
+    else if( key == SDLK_F6 )
+    {
+        m_clock.step( );
+    }
+    else if( key == SDLK_F7 )
+    {
+        m_clock.setScale( m_clock.getScale( ) / 10.0 );
+
+        std::cout << "Time scale: " << m_clock.getScale( ) << "x" << std::endl;
+    }
+    else if( key == SDLK_F8 )
+    {
+        m_clock.setScale( m_clock.getScale( ) * 10.0 );
+
+        std::cout << "Time scale: " << m_clock.getScale( ) << "x" << std::endl;
+    }
+    else if( key == SDLK_F9 )
+    {
+        m_clock.setScale( 1.0 );
+
+        std::cout << "Time scale: " << m_clock.getScale( ) << "x" << std::endl;
+    }
+    else if( key == SDLK_F10 )
+    {
+        m_clock.setFixedTick( !m_clock.isFixedTick( ) );
+
+        std::cout << ( m_clock.isFixedTick( ) ? "Fixed tick on" : "Fixed tick off" )
+                  << std::endl;
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
 }
 
 long long Engine::GetCurrentTimeMillis()
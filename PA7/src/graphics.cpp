@@ -1,13 +1,67 @@
 #include "graphics.h"
+#include "Logger.h"
+#include <random>
+#include <chrono>
+
+#if defined( _WIN64 ) || defined( _WIN32 )
+    #define M_PI 3.14159265358979323846264338327950288
+#endif
 
 Graphics::Graphics()
 {
-    
+    unsigned int index;
+
+    gravityMode = false;
+    gravityTime = 0.0;
+    physicsTime = 0.0;
+
+    depthMode = Camera::DEPTH_STANDARD;
+
+    particleShader = NULL;
+    simulatedBelt = NULL;
+    firstAsteroid = 0;
+    simulatedRockSize = ParticleFieldInfo( ).size;
+    particleTime = 0.0;
+    particleSpeed = 1.0f;
+    particlePaused = false;
+    particleDivisor = 1;
+    particleQueryFrame = 0;
+    particleFrames = 0;
+    particleGpuTime = 0.0;
+
+    for( index = 0; index < PARTICLE_QUERIES; index++ )
+    {
+        particleQueries[ index ] = 0;
+    }
 }
 
 Graphics::~Graphics()
 {
+    unsigned int index;
+
+    for( index = 0; index < particleFields.size( ); index++ )
+    {
+        delete particleFields[ index ];
+    }
+
+    particleFields.clear( );
+
+    if( simulatedBelt != NULL )
+    {
+        delete simulatedBelt;
+        simulatedBelt = NULL;
+    }
+
+    if( particleShader != NULL )
+    {
+        delete particleShader;
+        particleShader = NULL;
+    }
 
+    if( particleQueries[ 0 ] != 0 )
+    {
+        glDeleteQueries( PARTICLE_QUERIES, particleQueries );
+    }
 }
 
 bool Graphics::Initialize
@@ -44,11 +98,28 @@ bool Graphics::Initialize
     bool successFlag;
     unsigned int index, pIndex;
     GLint tmpTextLoc;
+    OrbitalElements elements;
+    double periapsis, apoapsis;
 
     // Init Camera
     m_camera = new Camera();
     cameraTracking = false;
-    if(!m_camera->Initialize(width, height))
+    depthMode = progInfo.depthMode;
+
+    //reversed z needs the [0,1] clip range of GL 4.5
+    #if defined(__APPLE__) || defined(MACOSX)
+        if( depthMode == Camera::DEPTH_REVERSED )
+    #else
+        if( depthMode == Camera::DEPTH_REVERSED && !GLEW_ARB_clip_control )
+    #endif
+    {
+        std::cout << "Reversed depth is not supported, using a logarithmic depth"
+                  << std::endl;
+
+        depthMode = Camera::DEPTH_LOGARITHMIC;
+    }
+
+    if(!m_camera->Initialize(width, height, depthMode))
     {
         printf("Camera Failed to Initialize\n");
         return false;
@@ -111,9 +182,6 @@ bool Graphics::Initialize
         objectRegistry[ objectRegistry.getSize( ) - 1 
                       ].updateRotationRate( progInfo.planetData[ pIndex ].rotRate );
 
-        objectRegistry[ objectRegistry.getSize( ) - 1
-                      ].setOrbitalRadius( progInfo.planetData[ pIndex ].orbitRad );
-
         objectRegistry[ objectRegistry.getSize( ) - 1
                       ].setOrbitDistanceMultiplier( 1.0f );
 
@@ -123,8 +191,38 @@ bool Graphics::Initialize
         objectRegistry[ objectRegistry.getSize( ) - 1
                       ].getOrigin( ).orbitTilt = progInfo.planetData[ pIndex ].orbitTilt;
 
+        //the two radii are the closest and farthest the orbit goes
+        periapsis = std::min( progInfo.planetData[ pIndex ].orbitRad.x,
+                              progInfo.planetData[ pIndex ].orbitRad.y );
+        apoapsis = std::max( progInfo.planetData[ pIndex ].orbitRad.x,
+                             progInfo.planetData[ pIndex ].orbitRad.y );
+
+        elements.semiMajorAxis = ( periapsis + apoapsis ) / 2.0;
+        elements.eccentricity = progInfo.planetData[ pIndex ].eccentricity;
+
+        if( elements.eccentricity < 0.0 )
+        {
+            elements.eccentricity = 0.0;
+
+            if( elements.semiMajorAxis > 0.0 )
+            {
+                elements.eccentricity = ( apoapsis - periapsis ) / ( apoapsis + periapsis );
+            }
+        }
+
+        elements.inclination = progInfo.planetData[ pIndex ].orbitTilt;
+        elements.ascendingNode = progInfo.planetData[ pIndex ].ascendingNode;
+        elements.argPeriapsis = progInfo.planetData[ pIndex ].argPeriapsis;
+        elements.meanAnomaly = progInfo.planetData[ pIndex ].meanAnomaly;
+
+        orbitPropagator.addOrbit( elements );
+
+        objectMass.push_back( progInfo.planetData[ pIndex ].mass );
+
     }
 
+    localPositions.assign( objectRegistry.getSize( ), glm::dvec3( 0.0 ) );
+
     for( pIndex = 0; pIndex < objectRegistry.getSize( ); pIndex++ )
     {
 
@@ -143,6 +241,8 @@ bool Graphics::Initialize
         printf("Shader Failed to Initialize\n");
         return false;
     }
+
+    setProgramDefines( *m_shader );
     
     for( index = 0; index < progInfo.shaderVector.size(); index++ )
     {
@@ -192,6 +292,15 @@ bool Graphics::Initialize
         return false;
     }
 
+    //only needed for the logarithmic depth
+    m_logDepth = m_shader->GetUniformLocation( "logDepthCoefficient" );
+
+    if( depthMode == Camera::DEPTH_LOGARITHMIC && m_logDepth == INVALID_UNIFORM_LOCATION )
+    {
+        printf( "logDepthCoefficient not found\n" );
+        return false;
+    }
+
     tmpTextLoc = m_shader->GetUniformLocation( "textureSampler" );
 
     if( tmpTextLoc == INVALID_UNIFORM_LOCATION )
@@ -208,16 +317,75 @@ bool Graphics::Initialize
 
     planetIndex = 0;
 
+    if( !initializeParticles( progInfo ) )
+    {
+        return false;
+    }
+
+    gravitySettings = progInfo.gravity;
+
+    if( gravitySettings.enabled )
+    {
+        orbitPropagator.propagate( 0.0 );
+        toggleGravity( );
+    }
+
     //enable depth testing
     glEnable(GL_DEPTH_TEST);
     glDepthFunc(GL_LESS);
 
+    if( depthMode == Camera::DEPTH_REVERSED )
+    {
+        #if !defined(__APPLE__) && !defined(MACOSX)
+            glClipControl( GL_LOWER_LEFT, GL_ZERO_TO_ONE );
+        #endif
+
+        glClearDepth( 0.0 );
+        glDepthFunc( GL_GREATER );
+    }
+
     return true;
 }
 
-void Graphics::Update(unsigned int dt)
+void Graphics::Update(unsigned int dt, double simSeconds)
 {
     unsigned int index;
+    std::chrono::steady_clock::time_point physicsStart;
+
+    physicsStart = std::chrono::steady_clock::now( );
+
+    //move every orbit at once before the transforms use them. a change
+    //of the orbit controls only moves that body's epoch to now
+    for( index = 0; index < objectRegistry.getSize( ); index++ )
+    {
+        orbitPropagator.setMeanMotion( index, objectRegistry[ index ].getOrbitStep( 1000 ),
+                                       simSeconds );
+    }
+
+    orbitPropagator.propagate( simSeconds );
+
+    //the rocks only need the time, the shader moves them. it stays a
+    //double, each field wraps it to its own period before the shader
+    if( !particlePaused )
+    {
+        particleTime += particleSpeed * dt / 1000.0;
+    }
+
+    if( gravityMode )
+    {
+        updateGravity( dt );
+    }
+    else
+    {
+        for( index = 0; index < objectRegistry.getSize( ); index++ )
+        {
+            localPositions[ index ] = orbitPropagator.getPosition( index );
+        }
+    }
+
+    physicsTime = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now( )
+                                                             - physicsStart ).count( );
+
     // Update the objects
     for( index = 0; index < objectRegistry.getSize( ); index++ )
     {
@@ -229,13 +397,16 @@ void Graphics::Update(unsigned int dt)
         
     }
     m_camera->setZoomSelect( planetIndex );
-    m_camera->updateCamera( cameraTracking, objectRegistry[ planetRegistry[ planetIndex ]].getOrigin().translation  );
+    m_camera->updateCamera( cameraTracking, objectRegistry[ planetRegistry[ planetIndex ]].getWorldPosition( )  );
 }
 
 void Graphics::Render()
 {
     unsigned int index;
 
+    //the world is drawn around the eye, the origin follows the camera
+    glm::dvec3 eye = m_camera->GetEyePosition( );
+
     //clear the screen
     glClearColor(0.0, 0.0, 0.0, 1.0);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -245,16 +416,19 @@ void Graphics::Render()
 
     // Send in the projection and view to the shader
     glUniformMatrix4fv(m_projectionMatrix, 1, GL_FALSE, glm::value_ptr(m_camera->GetProjection())); 
-    glUniformMatrix4fv(m_viewMatrix, 1, GL_FALSE, glm::value_ptr(m_camera->GetView())); 
+    glUniformMatrix4fv(m_viewMatrix, 1, GL_FALSE, glm::value_ptr(m_camera->GetRelativeView())); 
+    glUniform1f( m_logDepth, m_camera->getLogDepthCoefficient( ) );
 
     // Render the objects
     for( index = 0; index < objectRegistry.getSize( ); index++ )
     {
         glUniformMatrix4fv( m_modelMatrix, 1, GL_FALSE,
-                            glm::value_ptr(objectRegistry[index].GetModel()));
+                            glm::value_ptr(objectRegistry[index].GetModel( eye )));
         objectRegistry[index].Render();
     }
 
+    renderParticles( eye );
+
     // Get any errors from OpenGL
     auto error = glGetError();
     if ( error != GL_NO_ERROR )
@@ -330,7 +504,7 @@ bool Graphics::updateList( unsigned int objectID, unsigned int dt )
 
     objectRegistry[ objectID ].commitTilt( );
 
-    objectRegistry[ objectID ].incrementOrbitAngle( dt );
+    objectRegistry[ objectID ].setOrbitalPosition( localPositions[ objectID ] );
 
     objectRegistry[ objectID ].commitOrbitalTranslation( );
 
@@ -581,9 +755,13 @@ void Graphics::toggleAllObjectsPaused( )
     //then we've paused all of them
     if( !allPausedAtCall )
     {
+        particlePaused = true;
+
         return;
     }
 
+    particlePaused = false;
+
     //however, if they all were paused
     //then we need to unpause them
     for( index = 0; index < objectRegistry.getSize( ); index++ )
@@ -600,6 +778,20 @@ void Graphics::changeOrbitSpeed( unsigned int opCode )
 {
     unsigned int index;
 
+    //the rocks follow the same steps as Object's orbit speed
+    if( opCode == INCREASE_SPEED )
+    {
+        particleSpeed += 0.10f;
+    }
+    else if( opCode == DECREASE_SPEED )
+    {
+        particleSpeed = std::max( particleSpeed - 0.10f, 0.1f );
+    }
+    else
+    {
+        particleSpeed = 1.0f;
+    }
+
     for( index = 0; index < objectRegistry.getSize( ); index++ )
     {
         if( opCode == INCREASE_SPEED )
@@ -720,3 +912,569 @@ void Graphics::startTracking( int planet )
    planetIndex = planet;
 }
 
+// SET CAMERA VIEW //////////////////
+/***************************************
+
+@brief setCameraView
+
+@details puts the camera at an eye position looking at a focus point
+
+@param in: eye: the eye position in the world
+
+@param in: focus: the focus point in the world
+
+@notes stops the tracking, so the view holds until the next camera
+       key. used by the benchmark runner to replay a camera path
+
+***************************************/
+void Graphics::setCameraView( const glm::dvec3& eye, const glm::dvec3& focus )
+{
+    cameraTracking = false;
+
+    m_camera->lookAt( eye, focus );
+}
+
+// GET PHYSICS TIME //////////////////
+/***************************************
+
+@brief getPhysicsTime
+
+@details returns the real milliseconds the last Update spent moving
+         the orbits and stepping the gravity
+
+@param None
+
+@notes the transforms and the camera are not counted
+
+***************************************/
+double Graphics::getPhysicsTime( ) const
+{
+    return physicsTime;
+}
+
+// TOGGLE GRAVITY //////////////////
+/***************************************
+
+@brief toggleGravity
+
+@details switches between the Kepler orbits and the n-body simulation
+
+@param None
+
+@notes the simulation starts from wherever the orbits are, and the
+       orbits pick up where they would have been without it
+
+***************************************/
+void Graphics::toggleGravity( )
+{
+    if( gravityMode )
+    {
+        gravityMode = false;
+
+        std::cout << "Gravity off" << std::endl;
+
+        return;
+    }
+
+    if( startGravity( ) )
+    {
+        gravityMode = true;
+
+        std::cout << "Gravity on: " << gravity.getSize( ) << " bodies" << std::endl;
+    }
+}
+
+// START GRAVITY //////////////////
+/***************************************
+
+@brief startGravity
+
+@details fills the n-body simulation from the current orbits
+
+@param None
+
+@notes objects with no mass keep to their orbits around their parent;
+       the moons are drawn far outside the reach their planets' gravity
+       would have, so they are left that way
+
+***************************************/
+bool Graphics::startGravity( )
+{
+    unsigned int index, parent, asteroid, axis, sunIndex = 0;
+    double position[ 3 ], velocity[ 3 ], parentMass, direction, beltDirection = -1.0;
+    double radius, angle, speed;
+    std::vector<double> worldPosition( 3 * objectRegistry.getSize( ), 0.0 );
+    std::vector<double> worldVelocity( 3 * objectRegistry.getSize( ), 0.0 );
+    std::mt19937 generator( 480 );
+    std::uniform_real_distribution<double> angles( 0.0, 2.0 * M_PI );
+    std::uniform_real_distribution<double> heights( -0.02, 0.02 );
+    std::uniform_real_distribution<double> radii( gravitySettings.belt.x,
+                                                  std::max( gravitySettings.belt.x,
+                                                            gravitySettings.belt.y ) );
+
+    gravity.clear( );
+    gravity.setConstant( gravitySettings.constant );
+    gravity.setTheta( gravitySettings.theta );
+    gravity.setThreadCount( gravitySettings.threads );
+
+    gravityBodies.assign( objectRegistry.getSize( ), -1 );
+
+    //parents always come before their children
+    for( index = 0; index < objectRegistry.getSize( ); index++ )
+    {
+        parent = objectRegistry[ index ].getParentsWorldID( );
+        parentMass = 0.0;
+
+        if( objectRegistry[ index ].isChild( ) && gravityBodies[ parent ] != -1 )
+        {
+            parentMass = objectMass[ parent ];
+        }
+
+        orbitPropagator.getState( index,
+                                  gravitySettings.constant * ( parentMass + objectMass[ index ] ),
+                                  position, velocity );
+
+        //match the way the orbit is turning
+        direction = ( objectRegistry[ index ].getOrbitStep( 1 ) < 0.0 ) ? -1.0 : 1.0;
+
+        for( axis = 0; axis < 3; axis++ )
+        {
+            worldPosition[ ( 3 * index ) + axis ] = position[ axis ];
+            worldVelocity[ ( 3 * index ) + axis ] = direction * velocity[ axis ];
+
+            if( objectRegistry[ index ].isChild( ) )
+            {
+                worldPosition[ ( 3 * index ) + axis ] += worldPosition[ ( 3 * parent ) + axis ];
+                worldVelocity[ ( 3 * index ) + axis ] += worldVelocity[ ( 3 * parent ) + axis ];
+            }
+        }
+
+        if( objectMass[ index ] > 0.0 )
+        {
+            gravityBodies[ index ] = gravity.addBody( objectMass[ index ],
+                                                      &worldPosition[ 3 * index ],
+                                                      &worldVelocity[ 3 * index ] );
+
+            if( objectMass[ index ] > objectMass[ sunIndex ] )
+            {
+                sunIndex = index;
+            }
+
+            if( parentMass > 0.0 )
+            {
+                beltDirection = direction;
+            }
+        }
+    }
+
+    if( gravity.getSize( ) == 0 )
+    {
+        std::cout << "No object has a Mass for the gravity mode!" << std::endl;
+        return false;
+    }
+
+    firstAsteroid = gravity.getSize( );
+
+    //the belt circles the heaviest body
+    for( asteroid = 0; asteroid < gravitySettings.asteroids; asteroid++ )
+    {
+        radius = radii( generator );
+        angle = angles( generator );
+        speed = beltDirection * sqrt( gravitySettings.constant * objectMass[ sunIndex ] / radius );
+
+        position[ 0 ] = worldPosition[ 3 * sunIndex ] + ( radius * cos( angle ) );
+        position[ 1 ] = worldPosition[ ( 3 * sunIndex ) + 1 ] + ( radius * heights( generator ) );
+        position[ 2 ] = worldPosition[ ( 3 * sunIndex ) + 2 ] + ( radius * sin( angle ) );
+
+        velocity[ 0 ] = worldVelocity[ 3 * sunIndex ] - ( speed * sin( angle ) );
+        velocity[ 1 ] = worldVelocity[ ( 3 * sunIndex ) + 1 ];
+        velocity[ 2 ] = worldVelocity[ ( 3 * sunIndex ) + 2 ] + ( speed * cos( angle ) );
+
+        //light enough not to pull on the planets
+        gravity.addBody( objectMass[ sunIndex ] * 0.000000000001, position, velocity );
+    }
+
+    gravity.removeNetMomentum( );
+
+    gravityTime = 0.0;
+
+    if( simulatedBelt == NULL && gravitySettings.asteroids > 0 )
+    {
+        simulatedBelt = new ParticleField( );
+
+        if( !simulatedBelt->Initialize( gravitySettings.asteroids, simulatedRockSize ) )
+        {
+            std::cout << "The simulated belt failed to Initialize" << std::endl;
+
+            delete simulatedBelt;
+            simulatedBelt = NULL;
+        }
+    }
+
+    return true;
+}
+
+// UPDATE GRAVITY //////////////////
+/***************************************
+
+@brief updateGravity
+
+@details steps the n-body simulation and sets the object positions
+         from it
+
+@param in: dt: the time delta in milliseconds
+
+@notes fixed steps, so the result does not depend on the frame rate;
+       a frame that needs more than MAX_GRAVITY_STEPS drops the rest
+
+***************************************/
+void Graphics::updateGravity( unsigned int dt )
+{
+    unsigned int index, parent, steps = 0;
+    double position[ 3 ];
+
+    gravityTime += dt / 1000.0;
+
+    while( gravityTime >= gravitySettings.timeStep && steps < MAX_GRAVITY_STEPS )
+    {
+        gravity.step( gravitySettings.timeStep );
+
+        gravityTime -= gravitySettings.timeStep;
+        steps++;
+    }
+
+    if( steps == MAX_GRAVITY_STEPS )
+    {
+        gravityTime = 0.0;
+    }
+
+    //an object is drawn at its position plus its parent's local position
+    for( index = 0; index < objectRegistry.getSize( ); index++ )
+    {
+        if( gravityBodies[ index ] == -1 )
+        {
+            localPositions[ index ] = orbitPropagator.getPosition( index );
+            continue;
+        }
+
+        gravity.getPosition( gravityBodies[ index ], position );
+
+        localPositions[ index ] = glm::dvec3( position[ 0 ], position[ 1 ], position[ 2 ] );
+
+        if( objectRegistry[ index ].isChild( ) )
+        {
+            parent = objectRegistry[ index ].getParentsWorldID( );
+
+            localPositions[ index ] -= localPositions[ parent ];
+        }
+    }
+
+    if( simulatedBelt != NULL )
+    {
+        std::vector<glm::vec3> rocks( simulatedBelt->getCount( ) );
+
+        for( index = 0; index < rocks.size( ) && firstAsteroid + index < gravity.getSize( );
+             index++ )
+        {
+            rocks[ index ] = gravity.getPosition( firstAsteroid + index );
+        }
+
+        simulatedBelt->setPositions( rocks );
+    }
+}
+
+// CYCLE PARTICLE COUNT //////////////////
+/***************************************
+
+@brief cycleParticleCount
+
+@details draws all, a quarter, or half of the belts' and rings' rocks
+
+@param None
+
+@notes the GPU time of drawing the rocks at each setting is logged
+       every PARTICLE_REPORT_FRAMES frames, so the cost per rock can be
+       read off
+
+***************************************/
+void Graphics::cycleParticleCount( )
+{
+    if( particleDivisor == 1 )
+    {
+        particleDivisor = 4;
+    }
+    else
+    {
+        particleDivisor /= 2;
+    }
+
+    //the queries in flight timed the old count
+    particleQueryFrame = 0;
+    particleFrames = 0;
+    particleGpuTime = 0.0;
+
+    LOG_INFO( "Drawing " << getParticleCount( ) << " rocks" );
+}
+
+// SET PROGRAM DEFINES //////////////////
+/***************************************
+
+@brief setProgramDefines
+
+@details defines what the programs are built with
+
+@param out: program: a program with no shaders added yet
+
+@notes LOG_DEPTH is defined for a logarithmic depth buffer, so the
+       shaders only write gl_FragDepth then; the other depth modes keep
+       the early depth test
+
+***************************************/
+void Graphics::setProgramDefines( Shader& program ) const
+{
+    std::vector<std::pair<std::string, int>> defines;
+
+    if( depthMode == Camera::DEPTH_LOGARITHMIC )
+    {
+        defines.push_back( std::make_pair( std::string( "LOG_DEPTH" ), 1 ) );
+    }
+
+    program.SetDefines( defines );
+}
+
+// INITIALIZE PARTICLES //////////////////
+/***************************************
+
+@brief initializeParticles
+
+@details builds the belts and rings and their shader
+
+@param in: progInfo: the program information from the config file
+
+@notes a field's rocks are the same every run, each field gets its
+       own seed
+
+***************************************/
+bool Graphics::initializeParticles( const GraphicsInfo& progInfo )
+{
+    unsigned int index, parent;
+    float planeTilt;
+
+    if( progInfo.particleShaderVector.empty( ) )
+    {
+        return true;
+    }
+
+    particleShader = new Shader( );
+
+    if( !particleShader->Initialize( ) )
+    {
+        printf( "Particle Shader Failed to Initialize\n" );
+        return false;
+    }
+
+    setProgramDefines( *particleShader );
+
+    for( index = 0; index < progInfo.particleShaderVector.size( ); index++ )
+    {
+        if( !particleShader->AddShader( progInfo.particleShaderVector[ index ].first,
+                                        progInfo.particleShaderVector[ index ].second ) )
+        {
+            printf( "Particle Shader failed to Initialize\n" );
+            return false;
+        }
+    }
+
+    if( !particleShader->Finalize( ) )
+    {
+        printf( "Particle Program to Finalize\n" );
+        return false;
+    }
+
+    particleProjectionMatrix = particleShader->GetUniformLocation( "projectionMatrix" );
+    particleViewMatrix = particleShader->GetUniformLocation( "viewMatrix" );
+    particleCenter = particleShader->GetUniformLocation( "centerPosition" );
+    particleTimeLocation = particleShader->GetUniformLocation( "time" );
+    particleLight = particleShader->GetUniformLocation( "lightPosition" );
+    particleLogDepth = particleShader->GetUniformLocation( "logDepthCoefficient" );
+
+    if( particleProjectionMatrix == INVALID_UNIFORM_LOCATION
+        || particleViewMatrix == INVALID_UNIFORM_LOCATION
+        || particleCenter == INVALID_UNIFORM_LOCATION
+        || particleTimeLocation == INVALID_UNIFORM_LOCATION
+        || particleLight == INVALID_UNIFORM_LOCATION
+        || ( depthMode == Camera::DEPTH_LOGARITHMIC
+             && particleLogDepth == INVALID_UNIFORM_LOCATION ) )
+    {
+        printf( "particle shader uniforms not found\n" );
+        return false;
+    }
+
+    for( index = 0; index < progInfo.particleFields.size( ); index++ )
+    {
+        parent = progInfo.particleFields[ index ].parentID;
+        planeTilt = 0.0f;
+
+        if( parent >= objectRegistry.getSize( ) )
+        {
+            std::cout << "Invalid particle field parent!" << std::endl;
+            return false;
+        }
+
+        if( progInfo.particleFields[ index ].ring )
+        {
+            planeTilt = progInfo.planetData[ parent ].tilt;
+        }
+        else
+        {
+            //the simulated belt looks like the drawn one
+            simulatedRockSize = progInfo.particleFields[ index ].size;
+        }
+
+        particleFields.push_back( new ParticleField( ) );
+
+        if( !particleFields.back( )->Initialize( progInfo.particleFields[ index ],
+                                                 planeTilt, PARTICLE_SEED + index ) )
+        {
+            return false;
+        }
+    }
+
+    std::cout << getParticleCount( ) << " rocks in " << particleFields.size( )
+              << " belts and rings" << std::endl;
+
+    glGenQueries( PARTICLE_QUERIES, particleQueries );
+
+    return true;
+}
+
+// RENDER PARTICLES //////////////////
+/***************************************
+
+@brief renderParticles
+
+@details draws every belt and ring, one draw call each
+
+@param None
+
+@param in: eye: the camera's position, the origin the fields are drawn around
+
+@notes a field is centered on its parent's current position. in gravity
+       mode the belts are replaced by the simulated asteroids. the draws
+       are timed on the GPU, so the report is not capped by VSync; a
+       query is read PARTICLE_QUERIES frames after it was issued, and
+       dropped if its result is still not ready then
+
+***************************************/
+void Graphics::renderParticles( const glm::dvec3& eye )
+{
+    unsigned int index, parent, query;
+    glm::dvec3 center;
+    GLuint64 gpuNanoseconds;
+    GLint ready = 0;
+
+    if( particleShader == NULL )
+    {
+        return;
+    }
+
+    query = particleQueryFrame % PARTICLE_QUERIES;
+
+    //a query that is not done yet is dropped instead of waited on, so
+    //the CPU never stalls on the GPU here
+    if( particleQueryFrame >= PARTICLE_QUERIES )
+    {
+        glGetQueryObjectiv( particleQueries[ query ], GL_QUERY_RESULT_AVAILABLE, &ready );
+    }
+
+    if( ready )
+    {
+        glGetQueryObjectui64v( particleQueries[ query ], GL_QUERY_RESULT, &gpuNanoseconds );
+
+        particleGpuTime += gpuNanoseconds / 1000000.0;
+        particleFrames++;
+
+        if( particleFrames == PARTICLE_REPORT_FRAMES )
+        {
+            LOG_INFO( getParticleCount( ) << " rocks, "
+                      << particleGpuTime / particleFrames << " ms of GPU time per frame" );
+
+            particleFrames = 0;
+            particleGpuTime = 0.0;
+        }
+    }
+
+    glBeginQuery( GL_TIME_ELAPSED, particleQueries[ query ] );
+    particleQueryFrame++;
+
+    particleShader->Enable( );
+
+    glUniformMatrix4fv( particleProjectionMatrix, 1, GL_FALSE,
+                        glm::value_ptr( m_camera->GetProjection( ) ) );
+    glUniformMatrix4fv( particleViewMatrix, 1, GL_FALSE,
+                        glm::value_ptr( m_camera->GetRelativeView( ) ) );
+    glUniform1f( particleLogDepth, m_camera->getLogDepthCoefficient( ) );
+
+    //the sun sits at the world's center
+    glUniform3f( particleLight, ( float ) -eye.x, ( float ) -eye.y, ( float ) -eye.z );
+
+    for( index = 0; index < particleFields.size( ); index++ )
+    {
+        if( gravityMode && !particleFields[ index ]->isRing( ) )
+        {
+            continue;
+        }
+
+        parent = particleFields[ index ]->getParentID( );
+        center = objectRegistry[ parent ].getWorldPosition( ) - eye;
+
+        glUniform3f( particleCenter, ( float ) center.x, ( float ) center.y,
+                     ( float ) center.z );
+        glUniform1f( particleTimeLocation, particleFields[ index ]->getShaderTime( particleTime ) );
+
+        particleFields[ index ]->Render( particleFields[ index ]->getCount( )
+                                         / particleDivisor );
+    }
+
+    if( gravityMode && simulatedBelt != NULL )
+    {
+        glUniform3f( particleCenter, ( float ) -eye.x, ( float ) -eye.y, ( float ) -eye.z );
+        glUniform1f( particleTimeLocation, simulatedBelt->getShaderTime( particleTime ) );
+
+        simulatedBelt->Render( simulatedBelt->getCount( ) / particleDivisor );
+    }
+
+    glEndQuery( GL_TIME_ELAPSED );
+}
+
+// GET PARTICLE COUNT //////////////////
+/***************************************
+
+@brief getParticleCount
+
+@details returns how many rocks are drawn each frame
+
+@param None
+
+@notes None
+
+***************************************/
+unsigned int Graphics::getParticleCount( ) const
+{
+    unsigned int index, count = 0;
+
+    for( index = 0; index < particleFields.size( ); index++ )
+    {
+        if( !gravityMode || particleFields[ index ]->isRing( ) )
+        {
+            count += particleFields[ index ]->getCount( ) / particleDivisor;
+        }
+    }
+
+    if( gravityMode && simulatedBelt != NULL )
+    {
+        count += simulatedBelt->getCount( ) / particleDivisor;
+    }
+
+    return count;
+}
@@ -54,6 +54,9 @@ const string CONFIG_OPT = "-c";
 //help options
 const string HELP_OPT = "--h";
 
+//benchmark options
+const string BENCHMARK_OPT = "-b";
+
 //general characters
 const char TAB_CHAR = '\t';
 
@@ -79,8 +82,34 @@ const string ORBIT_RATE = "OrbitRate";
 const string ORBIT_TILT = "OrbitTilt";
 const string ROTATION_RATE = "RotationRate";
 const string TILT = "Tilt";
+const string ECCENTRICITY = "Eccentricity";
+const string ASCENDING_NODE = "AscendingNode";
+const string ARG_PERIAPSIS = "ArgPeriapsis";
+const string MEAN_ANOMALY = "MeanAnomaly";
+const string MASS = "Mass";
+const string GRAVITY = "Gravity";
+const string ENABLED = "Enabled";
+const string CONSTANT = "Constant";
+const string TIME_STEP = "TimeStep";
+const string THETA = "Theta";
+const string THREADS = "Threads";
+const string ASTEROIDS = "Asteroids";
+const string BELT_INNER = "BeltInner";
+const string BELT_OUTER = "BeltOuter";
+const string ASTEROID_BELT = "AsteroidBelt";
+const string RING = "Ring";
+const string COUNT = "Count";
+const string INNER_RADIUS = "InnerRadius";
+const string OUTER_RADIUS = "OuterRadius";
+const string THICKNESS = "Thickness";
+const string SIZE = "Size";
 const string VERTEX = "Vertex";
 const string FRAGMENT = "Fragment";
+const string PARTICLE_VERTEX = "ParticleVertex";
+const string PARTICLE_FRAGMENT = "ParticleFragment";
+const string DEPTH_BUFFER = "DepthBuffer";
+const string REVERSED = "reversed";
+const string LOGARITHMIC = "logarithmic";
 
 //planet names
 const string PLANET_NAMES[ ] = { "mercury", "venus", "earth", "mars",
@@ -100,12 +129,24 @@ bool ProcessConfigurationFile( rapidxml::xml_node<> *rootNode,
 bool ProcessConfigurationFileHelper( rapidxml::xml_node<> *parentNode,
                                      GraphicsInfo& progInfo,
                                      const NormalizationData& normData );
+
+bool ProcessConfigGravity( rapidxml::xml_node<> *gravityNode,
+                           GraphicsInfo& progInfo,
+                           const NormalizationData& normData );
+
+bool ProcessConfigParticleField( rapidxml::xml_node<> *fieldNode,
+                                 GraphicsInfo& progInfo,
+                                 const NormalizationData& normData,
+                                 unsigned int parentIndex );
 // main ///////////////////////////////////
 
 #if defined( _WIN64 ) || ( _WIN32 )
     #undef main
 #endif
 
+//the benchmark runner has its own main, built with BENCHMARK_RUNNER
+#ifndef BENCHMARK_RUNNER
+
 int main(int argc, char **argv)
 {
     // Start an engine and run it then cleanup after
@@ -126,6 +167,15 @@ int main(int argc, char **argv)
         return 1;
     }
 
+    if( progInfo.gravity.benchmark )
+    {
+        GravitySimulation::runBenchmark( );
+
+        delete engine;
+        engine = NULL;
+        return 0;
+    }
+
     //initialize engine and run it
     if(!engine->Initialize(progInfo))
     {
@@ -140,6 +190,8 @@ int main(int argc, char **argv)
     return 0;
 }
 
+#endif /* BENCHMARK_RUNNER */
+
 // free function implementation /////////////
 // PROCESS COMMAND LINE PARAMETERS //////////
 /***************************************
@@ -186,6 +238,10 @@ bool ProcessCommandLineParameters
                 return false;
             }
         }
+        else if( tmpStr == BENCHMARK_OPT )
+        {
+            progInfo.gravity.benchmark = true;
+        }
         else if( tmpStr == HELP_OPT )
         {
             cout << endl << "Help selected." << endl << endl;
@@ -198,6 +254,8 @@ bool ProcessCommandLineParameters
             
             cout << "Options include: " <<endl;
             cout << CONFIG_OPT << " [CONFIG_FILE_PATH]" << endl <<endl;
+            cout << BENCHMARK_OPT << ": times the n-body gravity at 1k, 10k and 100k bodies";
+            cout << endl << endl;
 
             cout <<"Example usage: " << endl;
             cout <<"./SolarSystem -c config/SolarSystemConfig.xml" << endl << endl;
@@ -330,6 +388,25 @@ bool ProcessConfigurationFile
                                                                    progInfo, 
                                                                    normData ) );
         }
+        else if( parentNode->name( ) == GRAVITY )
+        {
+            noError = ( noError && ProcessConfigGravity( parentNode, progInfo, normData ) );
+        }
+        else if( parentNode->name( ) == DEPTH_BUFFER )
+        {
+            tempStr = parentNode->value( );
+
+            progInfo.depthMode = Camera::DEPTH_STANDARD;
+
+            if( tempStr.find( REVERSED ) != string::npos )
+            {
+                progInfo.depthMode = Camera::DEPTH_REVERSED;
+            }
+            else if( tempStr.find( LOGARITHMIC ) != string::npos )
+            {
+                progInfo.depthMode = Camera::DEPTH_LOGARITHMIC;
+            }
+        }
         else if( parentNode->name( ) == SHADER )
         {
             if( parentNode->first_attribute( "name" )->value( ) == VERTEX )
@@ -348,6 +425,18 @@ bool ProcessConfigurationFile
                 progInfo.shaderVector.push_back( 
                       std::pair<GLenum, string>( GL_FRAGMENT_SHADER, tempStr ) );
             }
+            else if( parentNode->first_attribute( "name" )->value( ) == PARTICLE_VERTEX )
+            {
+                tempStr = parentNode->value( );
+                progInfo.particleShaderVector.push_back( 
+                      std::pair<GLenum, string>( GL_VERTEX_SHADER, tempStr ) );
+            }
+            else if( parentNode->first_attribute( "name" )->value( ) == PARTICLE_FRAGMENT )
+            {
+                tempStr = parentNode->value( );
+                progInfo.particleShaderVector.push_back( 
+                      std::pair<GLenum, string>( GL_FRAGMENT_SHADER, tempStr ) );
+            }
         }
         else
         {
@@ -357,6 +446,13 @@ bool ProcessConfigurationFile
 
 
 
+    if( !progInfo.particleFields.empty( ) && progInfo.particleShaderVector.size( ) < 2 )
+    {
+        std::cout << "The particle fields need a ParticleVertex and a ParticleFragment shader!"
+                  << std::endl;
+        noError = false;
+    }
+
     return ( noError && vertShader && fragShader && !progInfo.modelVector.empty( ) );
 }
 
@@ -538,6 +634,26 @@ bool ProcessConfigurationFileHelper
         {
             strStream >> progInfo.planetData[ pIndex ].tilt;
         }
+        else if( childNode->name( ) == ECCENTRICITY )
+        {
+            strStream >> progInfo.planetData[ pIndex ].eccentricity;
+        }
+        else if( childNode->name( ) == ASCENDING_NODE )
+        {
+            strStream >> progInfo.planetData[ pIndex ].ascendingNode;
+        }
+        else if( childNode->name( ) == ARG_PERIAPSIS )
+        {
+            strStream >> progInfo.planetData[ pIndex ].argPeriapsis;
+        }
+        else if( childNode->name( ) == MEAN_ANOMALY )
+        {
+            strStream >> progInfo.planetData[ pIndex ].meanAnomaly;
+        }
+        else if( childNode->name( ) == MASS )
+        {
+            strStream >> progInfo.planetData[ pIndex ].mass;
+        }
         else if( childNode->name( ) == OBJECT )
         {
             progInfo.planetData[ pIndex ].childID.push_back( progInfo.planetData.size( ) );
@@ -546,10 +662,209 @@ bool ProcessConfigurationFileHelper
                                                                    progInfo,
                                                                    normData ) );
         }
+        else if( childNode->name( ) == ASTEROID_BELT || childNode->name( ) == RING )
+        {
+            noError = ( noError && ProcessConfigParticleField( childNode,
+                                                               progInfo,
+                                                               normData,
+                                                               pIndex ) );
+        }
     }
 
     return noError;
 }
 
+// PROCESS CONFIG GRAVITY //////////
+/***************************************
+
+@brief ProcessConfigGravity
+
+@details Processes the settings of the n-body gravity mode
+
+@param in: gravityNode: the Gravity node in the xml doc
+
+@param out: progInfo: a struct containing program information
+
+@param in: normData: a struct of normalization data
+
+@notes the belt radii are scaled like the orbit radii, so the
+       NormalizationFactors must come first in the file
+
+***************************************/
+bool ProcessConfigGravity
+(
+    rapidxml::xml_node<>* gravityNode,
+    GraphicsInfo & progInfo,
+    const NormalizationData & normData
+)
+{
+    rapidxml::xml_node<> *childNode;
+    string tempStr;
+
+    for( childNode = gravityNode->first_node( 0 ); childNode;
+         childNode = childNode->next_sibling( ) )
+    {
+        tempStr = childNode->value( );
+
+        std::stringstream strStream( tempStr );
 
+        if( childNode->name( ) == ENABLED )
+        {
+            progInfo.gravity.enabled = ( tempStr.find( "true" ) != string::npos );
+        }
+        else if( childNode->name( ) == CONSTANT )
+        {
+            strStream >> progInfo.gravity.constant;
+        }
+        else if( childNode->name( ) == TIME_STEP )
+        {
+            strStream >> progInfo.gravity.timeStep;
+        }
+        else if( childNode->name( ) == THETA )
+        {
+            strStream >> progInfo.gravity.theta;
+        }
+        else if( childNode->name( ) == THREADS )
+        {
+            strStream >> progInfo.gravity.threads;
+        }
+        else if( childNode->name( ) == ASTEROIDS )
+        {
+            strStream >> progInfo.gravity.asteroids;
+        }
+        else if( childNode->name( ) == BELT_INNER )
+        {
+            strStream >> progInfo.gravity.belt.x;
 
+            if( normData.scaleOrbit.x != 0 )
+            {
+                progInfo.gravity.belt.x /= normData.scaleOrbit.x;
+            }
+        }
+        else if( childNode->name( ) == BELT_OUTER )
+        {
+            strStream >> progInfo.gravity.belt.y;
+
+            if( normData.scaleOrbit.x != 0 )
+            {
+                progInfo.gravity.belt.y /= normData.scaleOrbit.x;
+            }
+        }
+    }
+
+    if( progInfo.gravity.timeStep <= 0.0 || progInfo.gravity.constant <= 0.0
+        || progInfo.gravity.belt.x > progInfo.gravity.belt.y )
+    {
+        std::cout << "Invalid gravity settings!" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+// PROCESS CONFIG PARTICLE FIELD //////////
+/***************************************
+
+@brief ProcessConfigParticleField
+
+@details Processes an AsteroidBelt or a Ring of an object
+
+@param in: fieldNode: the AsteroidBelt or Ring node in the xml doc
+
+@param out: progInfo: a struct containing program information
+
+@param in: normData: a struct of normalization data
+
+@param in: parentIndex: the index of the object the field circles
+
+@notes a belt's radii are given like the orbit radii and a ring's in
+       radii of its parent, so a Ring must come after its parent's scale
+
+***************************************/
+bool ProcessConfigParticleField
+(
+    rapidxml::xml_node<>* fieldNode,
+    GraphicsInfo & progInfo,
+    const NormalizationData & normData,
+    unsigned int parentIndex
+)
+{
+    rapidxml::xml_node<> *childNode;
+    string tempStr;
+    ParticleFieldInfo fieldInfo;
+    float radiusScale = 1.0f;
+
+    fieldInfo.parentID = parentIndex;
+    fieldInfo.ring = ( fieldNode->name( ) == RING );
+
+    if( fieldInfo.ring )
+    {
+        radiusScale = progInfo.planetData[ parentIndex ].scale.x;
+    }
+    else if( normData.scaleOrbit.x != 0 )
+    {
+        radiusScale = 1.0f / normData.scaleOrbit.x;
+    }
+
+    for( childNode = fieldNode->first_node( 0 ); childNode;
+         childNode = childNode->next_sibling( ) )
+    {
+        tempStr = childNode->value( );
+
+        std::stringstream strStream( tempStr );
+
+        if( childNode->name( ) == COUNT )
+        {
+            strStream >> fieldInfo.count;
+        }
+        else if( childNode->name( ) == INNER_RADIUS )
+        {
+            strStream >> fieldInfo.radius.x;
+
+            fieldInfo.radius.x *= radiusScale;
+        }
+        else if( childNode->name( ) == OUTER_RADIUS )
+        {
+            strStream >> fieldInfo.radius.y;
+
+            fieldInfo.radius.y *= radiusScale;
+        }
+        else if( childNode->name( ) == THICKNESS )
+        {
+            strStream >> fieldInfo.thickness;
+        }
+        else if( childNode->name( ) == ECCENTRICITY )
+        {
+            strStream >> fieldInfo.eccentricity;
+        }
+        else if( childNode->name( ) == ORBIT_RATE )
+        {
+            strStream >> fieldInfo.orbitRate;
+
+            if( normData.orbitDivider != 0 )
+            {
+                fieldInfo.orbitRate /= normData.orbitDivider;
+            }
+        }
+        else if( childNode->name( ) == SIZE )
+        {
+            strStream >> fieldInfo.size;
+
+            if( normData.diameter != 0 )
+            {
+                fieldInfo.size /= normData.diameter;
+            }
+        }
+    }
+
+    if( fieldInfo.radius.x <= 0.0f || fieldInfo.radius.x > fieldInfo.radius.y
+        || fieldInfo.eccentricity < 0.0f || fieldInfo.eccentricity >= 1.0f )
+    {
+        std::cout << "Invalid " << fieldNode->name( ) << " settings!" << std::endl;
+        return false;
+    }
+
+    progInfo.particleFields.push_back( fieldInfo );
+
+    return true;
+}
@@ -1,6 +1,8 @@
 #include "object.h"
 #include <algorithm>
 
+#include "RenderStats.h"
+
 #if defined( _WIN64 ) || defined( _WIN32 )
     #define M_PI 3.14159265358979323846264338327950288
 #endif
@@ -13,10 +15,12 @@ Object::Object()
 
     angle = 0.0f;
     tiltAngle = 0.0f;
-    orbitalAngle = 0.0f;
 
-    orbitalRadius.x = 1.0f;
-    orbitalRadius.y = 1.0f;
+    orbitalPosition = glm::dvec3( 0.0 );
+
+    worldPosition = glm::dvec3( 0.0 );
+    pendingTranslation = glm::dvec3( 0.0 );
+    translationPending = false;
 
     rotationRate = 1.0f;
     orbitRate = 1.0f;
@@ -53,6 +57,14 @@ void Object::Update( unsigned int dt )
 
     unsigned int index;
 
+    if( translationPending )
+    {
+        worldPosition = pendingTranslation;
+
+        pendingTranslation = glm::dvec3( 0.0 );
+        translationPending = false;
+    }
+
     if( transformVector.empty( ) )
     {
         return;
@@ -84,7 +96,49 @@ void Object::Update( unsigned int dt )
 
 glm::mat4 Object::GetModel()
 {
-    return model;
+    return GetModel( glm::dvec3( 0.0 ) );
+}
+
+// GET MODEL //////////////////
+/***************************************
+
+@brief GetModel
+
+@details returns the model matrix relative to an origin
+
+@param in: origin: the world position to rebase on, usually the camera's
+
+@notes the offset is taken in double precision before it is made a
+       float, so objects near the origin stay exact however far they
+       are from the world's center
+
+***************************************/
+glm::mat4 Object::GetModel( const glm::dvec3& origin )
+{
+    glm::mat4 relative = model;
+    glm::dvec3 offset = worldPosition - origin;
+
+    relative[ 3 ] += glm::vec4( ( float ) offset.x, ( float ) offset.y,
+                                ( float ) offset.z, 0.0f );
+
+    return relative;
+}
+
+// GET WORLD POSITION //////////////////
+/***************************************
+
+@brief getWorldPosition
+
+@details returns the world translation of the object
+
+@param None
+
+@notes as of the last Update
+
+***************************************/
+glm::dvec3 Object::getWorldPosition( )
+{
+    return worldPosition;
 }
 
 glm::mat4 & Object::ParentModel( )
@@ -219,6 +273,8 @@ void Object::Render()
         glDrawElements( GL_TRIANGLES,
                         objModelPtr->getIndices( index ).size( ), 
                         GL_UNSIGNED_INT, 0 );        
+
+        RenderStats::addDraw( objModelPtr->getIndices( index ).size( ) );
     }
 
     glDisableVertexAttribArray( 0 );
@@ -412,23 +468,6 @@ void Object::toggleAllPaused( )
     }
 }
 
-// SET ORBITAL RADIUS //////////////////
-/***************************************
-
-@brief setOrbitalRadius
-
-@details sets the object's radius of orbit
-
-@param in: radius: the radius to use.
-
-@notes None
-
-***************************************/
-void Object::setOrbitalRadius( glm::vec2 radius )
-{
-    orbitalRadius = radius;
-}
-
 // SET ORIGIN //////////////////
 /***************************************
 
@@ -739,7 +778,7 @@ void Object::setTiltAngle( float tilt )
 ***************************************/
 void Object::commitTranslation( )
 {
-    localOrigin.translation = translationVector;
+    localOrigin.translation = glm::dvec3( translationVector );
 
     transformVector.push_back( glm::translate( glm::mat4( 1.0f ),
                                                translationVector ) );
@@ -838,35 +877,28 @@ void Object::commitScale( )
 
 @brief commitOrbitalTranslation
 
-@details commits the orbital translation based off of the orbital radius
-         and the orbitalAngle
+@details commits the orbital translation based off of the position
+         set by the orbit propagator
 
 @param None
 
-@notes none
+@notes the translation is added to the world position in double
+       precision and applied after every other transform
 
 ***************************************/
 void Object::commitOrbitalTranslation( )
 {
 
-    localOrigin.translation = glm::vec3( orbitalRadius.x
-                                         * orbitDistanceMultiplier
-                                         * cos( orbitalAngle ),
-                                         ( (orbitalRadius.x 
-                                             + orbitalRadius.y ) / 2.0f ) 
-                                         * sin( localOrigin.orbitTilt * cos( orbitalAngle ) ),
-                                         orbitalRadius.y
-                                         * orbitDistanceMultiplier
-                                         * sin( orbitalAngle ) );
+    localOrigin.translation = orbitalPosition * ( double ) orbitDistanceMultiplier;
 
-    transformVector.push_back( glm::translate( glm::mat4( 1.0f ),
-                                               localOrigin.translation ) );
+    pendingTranslation += localOrigin.translation;
+    translationPending = true;
 }
 
 void Object::commitParentLocation( )
 {
-    transformVector.push_back( glm::translate( glm::mat4( 1.0f ), parentOrigin.translation ) );
-
+    pendingTranslation += parentOrigin.translation;
+    translationPending = true;
 }
 
 // INCREMENT ANGLE /////////////////////
@@ -920,55 +952,38 @@ void Object::setAngle( float newAngle )
     angle = newAngle;
 }
 
-// INCREMENT ORBIT ANGLE /////////////////////
+// GET ORBIT STEP /////////////////////
 /***************************************
 
-@brief incrementOrbitAngle 
+@brief getOrbitStep 
 
-@details increments the angle of the object's orbit
+@details gets how far the object's mean anomaly moves in a time delta
 
 @param in: dt: the delta of time
 
-@notes none
-
-***************************************/
-void Object::incrementOrbitAngle( unsigned int dt )
-{
-    orbitalAngle += orbitControlMultiplier * orbitRate * orbitSpeedControl * dt * M_PI/1000;
-}
-
-// GET ORBITAL ANGLE /////////////////////
-/***************************************
-
-@brief getOrbitalAngle 
-
-@details gets the angle of the object's orbit
-
-@param None
-
-@notes none
+@notes in radians, with the pause, direction and speed controls applied
 
 ***************************************/
-float Object::getOrbitAngle( )
+double Object::getOrbitStep( unsigned int dt )
 {
-    return orbitalAngle;
+    return ( double ) orbitControlMultiplier * orbitRate * orbitSpeedControl * dt * M_PI / 1000.0;
 }
 
-// SET ORBIT ANGLE /////////////////////
+// SET ORBITAL POSITION /////////////////////
 /***************************************
 
-@brief setOrbitAngle 
+@brief setOrbitalPosition 
 
-@details sets the angle of the object's rotation
+@details sets the object's position on its orbit
 
-@param in: newAngle: the new angle value
+@param in: position: the position relative to the parent
 
-@notes none
+@notes used by the next commitOrbitalTranslation
 
 ***************************************/
-void Object::setOrbitAngle( float newAngle )
+void Object::setOrbitalPosition( const glm::dvec3& position )
 {
-    orbitalAngle = newAngle;
+    orbitalPosition = position;
 }
 
 
@@ -1,4 +1,6 @@
 #include "shader.h"
+#include <algorithm>
+#include <sstream>
 
 Shader::Shader()
 {
@@ -32,10 +34,37 @@ bool Shader::Initialize()
     return true;
 }
 
+// SET DEFINES //////////////////
+/***************************************
+
+@brief SetDefines
+
+@details defines names after the #version line of every shader added
+         from now on
+
+@param in: defines: the names and values to define
+
+@notes call it before AddShader
+
+***************************************/
+void Shader::SetDefines( const std::vector<std::pair<std::string, int>>& defines )
+{
+    std::ostringstream defineStream;
+    unsigned int index;
+
+    for( index = 0; index < defines.size( ); index++ )
+    {
+        defineStream << "#define " << defines[ index ].first << " " << defines[ index ].second << "\n";
+    }
+
+    m_defines = defineStream.str( );
+}
+
 // Use this method to add shaders to the program. When finished - call finalize()
 bool Shader::AddShader(GLenum ShaderType, const std::string& fileName)
 {
     std::string srcStr;
+    size_t insertAt;
 
     if(!loadShaderSource( fileName, srcStr ))
     {
@@ -43,6 +72,17 @@ bool Shader::AddShader(GLenum ShaderType, const std::string& fileName)
         return false;
     }
 
+    //the defines go after #version, then the lines are numbered as in the file
+    if( !m_defines.empty( ) )
+    {
+        insertAt = srcStr.find( "#version" );
+        insertAt = insertAt == std::string::npos ? 0 : srcStr.find( '\n', insertAt );
+        insertAt = insertAt == std::string::npos ? srcStr.size( ) : insertAt + 1;
+
+        srcStr.insert( insertAt, m_defines + "#line " + std::to_string(
+                       std::count( srcStr.begin( ), srcStr.begin( ) + insertAt, '\n' ) + 1 ) + "\n" );
+    }
+
     GLuint ShaderObj = glCreateShader(ShaderType);
 
     if (ShaderObj == 0) 
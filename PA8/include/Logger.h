@@ -0,0 +1,125 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+/***************************************
+
+@file Logger.h
+
+@brief An asynchronous logger for the messages written while the game runs
+
+@note a message is formatted on the calling thread and copied into a
+      slot of a fixed size, lock free queue. a writer thread of its own
+      empties the queue, warnings and errors to std::cerr and the rest
+      to std::cout, so a frame never waits on the console. a call site
+      writes at most RATE_LIMIT messages in a RATE_WINDOW, the rest are
+      counted and the count is added to the next message it writes. a
+      full queue drops the message instead of waiting. the levels under
+      LOG_LEVEL are compiled out
+
+***************************************/
+
+// headers ////////////////////////////////
+#include <atomic>
+#include <sstream>
+
+// macros /////////////////////////////////
+
+#define LOG_LEVEL_DEBUG 0
+#define LOG_LEVEL_INFO 1
+#define LOG_LEVEL_WARNING 2
+#define LOG_LEVEL_ERROR 3
+#define LOG_LEVEL_NONE 4
+
+//the least severe level compiled in
+#ifndef LOG_LEVEL
+    #define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+//the message is streamed, as in LOG_INFO( "Score: " << score )
+#define LOG_AT( level, message ) \
+    do \
+    { \
+        static LogSite logSite; \
+        if( logSite.allow( ) ) \
+        { \
+            Logger::stream( ) << message; \
+            Logger::write( level, logSite ); \
+        } \
+    } while( 0 )
+
+#if LOG_LEVEL <= LOG_LEVEL_DEBUG
+    #define LOG_DEBUG( message ) LOG_AT( LOG_LEVEL_DEBUG, message )
+#else
+    #define LOG_DEBUG( message )
+#endif
+
+#if LOG_LEVEL <= LOG_LEVEL_INFO
+    #define LOG_INFO( message ) LOG_AT( LOG_LEVEL_INFO, message )
+#else
+    #define LOG_INFO( message )
+#endif
+
+#if LOG_LEVEL <= LOG_LEVEL_WARNING
+    #define LOG_WARNING( message ) LOG_AT( LOG_LEVEL_WARNING, message )
+#else
+    #define LOG_WARNING( message )
+#endif
+
+#if LOG_LEVEL <= LOG_LEVEL_ERROR
+    #define LOG_ERROR( message ) LOG_AT( LOG_LEVEL_ERROR, message )
+#else
+    #define LOG_ERROR( message )
+#endif
+
+// class definitions //////////////////////
+
+class LogSite
+{
+    public:
+        static const unsigned int RATE_LIMIT = 20; //messages a call site writes per window
+        static const long long RATE_WINDOW = 1000; //milliseconds
+
+        LogSite( ) : windowStart( 0 ), count( 0 ), dropped( 0 )
+        {
+
+        }
+
+        bool allow( );
+
+        unsigned int takeDropped( )
+        {
+            return dropped.exchange( 0 );
+        }
+
+    private:
+        std::atomic<long long> windowStart;
+        std::atomic<unsigned int> count;
+        std::atomic<unsigned int> dropped;
+};
+
+class Logger
+{
+    public:
+        static const unsigned int QUEUE_SIZE = 1024; //a power of two
+        static const unsigned int MESSAGE_SIZE = 256; //longer messages are cut
+        static const unsigned int WRITER_SLEEP = 2; //milliseconds the writer waits on an empty queue
+
+        static bool start( );
+
+        static void stop( );
+
+        static void flush( );
+
+        static std::ostringstream& stream( );
+
+        static void write( unsigned int level, LogSite& site );
+
+    private:
+        static void writerLoop( );
+
+        static bool drain( );
+
+        static std::atomic<bool> running;
+};
+
+#endif /* LOGGER_H */
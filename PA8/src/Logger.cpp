@@ -0,0 +1,318 @@
+#include "Logger.h"
+#include <chrono>
+#include <thread>
+#include <string>
+#include <cstring>
+#include <iostream>
+
+// file data //////////////////////////////
+
+struct LogSlot
+{
+    std::atomic<unsigned int> sequence; //the position the slot is ready for
+    unsigned int level;
+    char text[ Logger::MESSAGE_SIZE ];
+};
+
+static LogSlot slots[ Logger::QUEUE_SIZE ];
+static std::atomic<unsigned int> enqueuePosition( 0 ); //claimed by the logging threads
+static std::atomic<unsigned int> dequeuePosition( 0 ); //moved by the writer alone
+static std::atomic<unsigned int> queueDropped( 0 ); //messages a full queue dropped
+static std::thread writer;
+
+std::atomic<bool> Logger::running( false );
+
+// ALLOW //////////////////
+/***************************************
+
+@brief allow
+
+@details returns true if the call site is under its rate
+
+@param None
+
+@notes the window restarts on the first message after RATE_WINDOW, a
+       message over the rate is only counted
+
+***************************************/
+bool LogSite::allow( )
+{
+    long long now;
+    long long start;
+
+    now = std::chrono::duration_cast<std::chrono::milliseconds>(
+              std::chrono::steady_clock::now( ).time_since_epoch( ) ).count( );
+
+    start = windowStart.load( std::memory_order_relaxed );
+
+    if( now - start >= RATE_WINDOW &&
+        windowStart.compare_exchange_strong( start, now, std::memory_order_relaxed ) )
+    {
+        count.store( 0, std::memory_order_relaxed );
+    }
+
+    if( count.fetch_add( 1, std::memory_order_relaxed ) < RATE_LIMIT )
+    {
+        return true;
+    }
+
+    dropped.fetch_add( 1, std::memory_order_relaxed );
+
+    return false;
+}
+
+// START //////////////////
+/***************************************
+
+@brief start
+
+@details empties the queue and starts the writer thread
+
+@param None
+
+@notes until start is called, and after stop, the messages are written
+       straight from the calling thread
+
+***************************************/
+bool Logger::start( )
+{
+    unsigned int index;
+
+    if( running.load( ) )
+    {
+        return false;
+    }
+
+    for( index = 0; index < QUEUE_SIZE; index++ )
+    {
+        slots[ index ].sequence.store( index, std::memory_order_relaxed );
+    }
+
+    enqueuePosition.store( 0 );
+    dequeuePosition.store( 0 );
+
+    running.store( true );
+
+    writer = std::thread( writerLoop );
+
+    return true;
+}
+
+// STOP //////////////////
+/***************************************
+
+@brief stop
+
+@details writes what is left in the queue and joins the writer thread
+
+@param None
+
+@notes None
+
+***************************************/
+void Logger::stop( )
+{
+    if( !running.exchange( false ) )
+    {
+        return;
+    }
+
+    writer.join( );
+
+    //messages queued while the writer was finishing
+    drain( );
+}
+
+// FLUSH //////////////////
+/***************************************
+
+@brief flush
+
+@details waits until the writer has written every message queued so far
+
+@param None
+
+@notes for the rare output that has to follow the queued messages, not
+       for a frame
+
+***************************************/
+void Logger::flush( )
+{
+    unsigned int target;
+
+    if( !running.load( ) )
+    {
+        return;
+    }
+
+    target = enqueuePosition.load( );
+
+    while( ( int ) ( target - dequeuePosition.load( ) ) > 0 )
+    {
+        std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+    }
+}
+
+// STREAM //////////////////
+/***************************************
+
+@brief stream
+
+@details returns the calling thread's message stream
+
+@param None
+
+@notes the stream is kept and emptied by write, so a message does not
+       build a stream of its own
+
+***************************************/
+std::ostringstream& Logger::stream( )
+{
+    static thread_local std::ostringstream message;
+
+    return message;
+}
+
+// WRITE //////////////////
+/***************************************
+
+@brief write
+
+@details queues the message in the calling thread's stream
+
+@param in: level: the message's level
+
+@param in: site: the call site, for the messages it dropped
+
+@notes never waits, a full queue drops the message
+
+***************************************/
+void Logger::write( unsigned int level, LogSite& site )
+{
+    std::ostringstream& message = stream( );
+    std::string text;
+    unsigned int dropped;
+    unsigned int position;
+    LogSlot *slot;
+    int difference;
+
+    dropped = site.takeDropped( );
+
+    if( dropped > 0 )
+    {
+        message << " (" << dropped << " more dropped)";
+    }
+
+    text = message.str( );
+    message.str( "" );
+
+    if( !running.load( std::memory_order_acquire ) )
+    {
+        ( level >= LOG_LEVEL_WARNING ? std::cerr : std::cout ) << text << std::endl;
+        return;
+    }
+
+    position = enqueuePosition.load( std::memory_order_relaxed );
+
+    //claim a slot, the slot's sequence says whether it was emptied
+    while( true )
+    {
+        slot = &slots[ position & ( QUEUE_SIZE - 1 ) ];
+        difference = ( int ) ( slot->sequence.load( std::memory_order_acquire ) - position );
+
+        if( difference == 0 )
+        {
+            if( enqueuePosition.compare_exchange_weak( position, position + 1,
+                                                       std::memory_order_relaxed ) )
+            {
+                break;
+            }
+        }
+        else if( difference < 0 )
+        {
+            queueDropped.fetch_add( 1, std::memory_order_relaxed );
+            return;
+        }
+        else
+        {
+            position = enqueuePosition.load( std::memory_order_relaxed );
+        }
+    }
+
+    slot->level = level;
+
+    std::strncpy( slot->text, text.c_str( ), MESSAGE_SIZE - 1 );
+    slot->text[ MESSAGE_SIZE - 1 ] = '\0';
+
+    //hand the slot to the writer
+    slot->sequence.store( position + 1, std::memory_order_release );
+}
+
+// private member functions
+
+void Logger::writerLoop( )
+{
+    while( running.load( ) )
+    {
+        if( !drain( ) )
+        {
+            std::this_thread::sleep_for( std::chrono::milliseconds( ( long long ) WRITER_SLEEP ) );
+        }
+    }
+
+    drain( );
+}
+
+// DRAIN //////////////////
+/***************************************
+
+@brief drain
+
+@details writes every message that is ready, then flushes once
+
+@param None
+
+@notes returns false if there was nothing to write. only the writer
+       thread drains while it runs
+
+***************************************/
+bool Logger::drain( )
+{
+    unsigned int position;
+    unsigned int dropped;
+    LogSlot *slot;
+    bool wrote = false;
+
+    position = dequeuePosition.load( std::memory_order_relaxed );
+    slot = &slots[ position & ( QUEUE_SIZE - 1 ) ];
+
+    while( slot->sequence.load( std::memory_order_acquire ) == position + 1 )
+    {
+        ( slot->level >= LOG_LEVEL_WARNING ? std::cerr : std::cout ) << slot->text << '\n';
+
+        //the slot is free a lap later
+        slot->sequence.store( position + QUEUE_SIZE, std::memory_order_release );
+
+        position++;
+        dequeuePosition.store( position, std::memory_order_release );
+
+        slot = &slots[ position & ( QUEUE_SIZE - 1 ) ];
+        wrote = true;
+    }
+
+    dropped = queueDropped.exchange( 0 );
+
+    if( dropped > 0 )
+    {
+        std::cerr << dropped << " log messages were dropped, the queue was full" << '\n';
+        wrote = true;
+    }
+
+    if( wrote )
+    {
+        std::cout.flush( );
+        std::cerr.flush( );
+    }
+
+    return wrote;
+}
@@ -1,5 +1,6 @@
 
 #include "engine.h"
+#include "Logger.h"
 
 Engine::Engine(string name, int width, int height)
 {
@@ -38,10 +39,16 @@ Engine::~Engine()
     
     m_window = NULL;
     m_graphics = NULL;
+
+    Logger::stop( );
 }
 
 bool Engine::Initialize( const GraphicsInfo& progInfo )
 {
+    // Start the log writer
+
+    Logger::start( );
+
     // Start a window
     
     m_window = new Window();
@@ -62,19 +69,21 @@ bool Engine::Initialize( const GraphicsInfo& progInfo )
     }
 
     // Set the time
-    m_currentTimeMillis = GetCurrentTimeMillis();
+    m_clock.start( );
     // No errors
     return true;
 }
 
 void Engine::Run()
 {
+    unsigned int tickDT;
+
     m_running = true;
 
     while(m_running)
     {
-        // Update the DT
-        m_DT = getDT();
+        // Start the frame on the simulation clock
+        m_clock.beginFrame( );
 
         // Check the keyboard input
 
@@ -85,8 +94,15 @@ void Engine::Run()
         }
 
 
-        // Update and render the graphics
-        m_graphics->Update(m_DT);
+        // Update once per tick the clock hands out for this frame, then render
+        m_DT = 0;
+
+        while( m_clock.nextTick( tickDT ) )
+        {
+            m_graphics->Update( tickDT );
+            m_DT += tickDT;
+        }
+
         m_graphics->Render();
 
         // Swap to the Window
@@ -108,6 +124,10 @@ void Engine::Keyboard()
         {
             m_running = false;
         }
+        else if( clockKeys( ) )
+        {
+            //the simulation clock took the key
+        }
         else if( m_event.key.keysym.sym == SDLK_UP )
         {
             if( m_graphics != NULL )
@@ -295,7 +315,7 @@ void Engine::Mouse( )
             {
                 if( SDL_SetRelativeMouseMode( SDL_TRUE ) )
                 {
-                    printf( "The mouse is in Relative Mode. \n" );
+                    LOG_INFO( "The mouse is in Relative Mode." );
                 }
             } 
         }
@@ -305,7 +325,7 @@ void Engine::Mouse( )
             {
                 if( SDL_SetRelativeMouseMode( SDL_FALSE ) )
                 {
-                    printf( "The mouse is in Relative Mode. \n" );
+                    LOG_INFO( "The mouse is in Relative Mode." );
                 }
             } 
         }
@@ -339,7 +359,7 @@ void Engine::Mouse( )
             {
                 if( SDL_SetRelativeMouseMode( SDL_TRUE ) )
                 {
-                    printf( "The mouse is in Relative Mode. \n" );
+                    LOG_INFO( "The mouse is in Relative Mode." );
                 }
 
                 mouse_initialized = true;
@@ -359,13 +379,64 @@ void Engine::Mouse( )
     
 }
 
-unsigned int Engine::getDT()
+// CLOCK KEYS //////////////////
+/***************************************
+
+@brief clockKeys
+
+@details handles the simulation clock's keys
+
+@param None
+
+@notes F5 pauses, F6 steps a paused simulation, F7 and F8 divide and
+       multiply the time scale by ten, F9 resets it and F10 switches
+       the fixed tick mode. returns true if the key was one of these
+
+***************************************/
+bool Engine::clockKeys( )
 {
-    long long TimeNowMillis = GetCurrentTimeMillis();
-    assert(TimeNowMillis >= m_currentTimeMillis);
-    unsigned int DeltaTimeMillis = (unsigned int)(TimeNowMillis - m_currentTimeMillis);
-    m_currentTimeMillis = TimeNowMillis;
-    return DeltaTimeMillis;
+    SDL_Keycode key = m_event.key.keysym.sym;
+
+    if( key == SDLK_F5 )
+    {
+        m_clock.togglePaused( );
+
+        LOG_INFO( ( m_clock.isPaused( ) ? "Simulation paused" : "Simulation running" ) );
+    }
+    else if( key == SDLK_F6 )
+    {
+        m_clock.step( );
+    }
+    else if( key == SDLK_F7 )
+    {
+        m_clock.setScale( m_clock.getScale( ) / 10.0 );
+
+        LOG_INFO( "Time scale: " << m_clock.getScale( ) << "x" );
+    }
+    else if( key == SDLK_F8 )
+    {
+        m_clock.setScale( m_clock.getScale( ) * 10.0 );
+
+        LOG_INFO( "Time scale: " << m_clock.getScale( ) << "x" );
+    }
+    else if( key == SDLK_F9 )
+    {
+        m_clock.setScale( 1.0 );
+
+        LOG_INFO( "Time scale: " << m_clock.getScale( ) << "x" );
+    }
+    else if( key == SDLK_F10 )
+    {
+        m_clock.setFixedTick( !m_clock.isFixedTick( ) );
+
+        LOG_INFO( ( m_clock.isFixedTick( ) ? "Fixed tick on" : "Fixed tick off" ) );
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
 }
 
 long long Engine::GetCurrentTimeMillis()
@@ -1,4 +1,5 @@
 #include "graphics.h"
+#include "Logger.h"
 #include <algorithm>
 
 namespace
@@ -305,7 +306,7 @@ bool Graphics::Initialize
 
     if( tmpTextLoc == INVALID_UNIFORM_LOCATION )
     {
-        printf( "texture location uniform not found!!!\n" );
+        LOG_ERROR( "texture location uniform not found!!!" );
         return false;
     }
 
@@ -560,7 +561,7 @@ void Graphics::Render()
     if ( error != GL_NO_ERROR )
     {
         string val = ErrorString( error );
-        std::cout<< "Error initializing OpenGL! " << error << ", " << val << std::endl;
+        LOG_ERROR( "Error initializing OpenGL! " << error << ", " << val );
     }
 }
 
@@ -0,0 +1,82 @@
+#ifndef SIMCLOCK_H
+#define SIMCLOCK_H
+
+/***************************************
+
+@file SimClock.h
+
+@brief A clock that turns real frame time into simulation time
+
+@note the frame time is read from the monotonic steady_clock and
+      scaled, so the whole simulation can be sped up, slowed down,
+      paused or stepped without touching any object. in the fixed tick
+      mode every update gets the same time step, so a run can be
+      repeated exactly
+
+***************************************/
+
+// headers ////////////////////////////////
+#include<chrono>
+
+// class definition ///////////////////////
+
+class SimClock
+{
+    public:
+        static const unsigned int FIXED_TICK_MILLIS = 10; //time step of the fixed tick mode
+        static const unsigned int MAX_TICKS_PER_FRAME = 100; //beyond it the ticks get longer
+
+        static const double MIN_SCALE; //value defined in SimClock.cpp
+        static const double MAX_SCALE; //value defined in SimClock.cpp
+        static const double MAX_FRAME_SECONDS; //value defined in SimClock.cpp
+
+        //contructors
+        SimClock( );
+
+        //destructor
+        ~SimClock( );
+
+        void start( );
+
+        void beginFrame( );
+
+        bool nextTick( unsigned int& dt );
+
+        void setScale( double newScale );
+
+        double getScale( ) const;
+
+        void togglePaused( );
+
+        bool isPaused( ) const;
+
+        void step( );
+
+        void setFixedTick( bool fixed );
+
+        bool isFixedTick( ) const;
+
+        double getFrameSeconds( ) const;
+
+        double getSimSeconds( ) const;
+
+    private:
+        typedef std::chrono::steady_clock Clock;
+
+        Clock::time_point lastFrame;
+
+        double frameSeconds; //real time of the last frame
+        double simSeconds; //simulation time handed out so far
+
+        double scale;
+        bool paused;
+        bool stepPending;
+        bool fixedTick;
+
+        double carryMillis; //scaled time not yet handed out
+        unsigned int frameMillis; //the step of this frame's tick in the variable mode
+        unsigned int tickMillis; //the step of this frame's fixed ticks
+        unsigned int ticksLeft; //ticks still to hand out this frame
+};
+
+#endif /* SIMCLOCK_H */
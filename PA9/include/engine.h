@@ -13,6 +13,7 @@
 
 #include "window.h"
 #include "graphics.h"
+#include "SimClock.h"
 
 struct Coord
 {
@@ -57,10 +58,11 @@ class Engine
         void Run();
         void Keyboard();
         void Mouse();
-        unsigned int getDT();
         long long GetCurrentTimeMillis();
     
     private:
+        bool clockKeys( );
+
         // Window related variables
         Window *m_window;        
         string m_WINDOW_NAME;
@@ -71,7 +73,7 @@ class Engine
 
         Graphics *m_graphics;
         unsigned int m_DT;
-        long long m_currentTimeMillis;
+        SimClock m_clock; //simulation time for Update
         bool m_running;
 
         int trackingID;
@@ -1,4 +1,5 @@
 #include "graphics.h"
+#include "Logger.h"
 #include <algorithm>
 
 namespace ballCallBack
@@ -308,63 +309,63 @@ bool Graphics::Initialize
     m_spotLight = shaderRegistry[ shaderSelect ].GetUniformLocation( "lightPosition" );
     if( m_spotLight == INVALID_UNIFORM_LOCATION )
     {
-        printf( "m_projectionMatrix not found\n" );
+        LOG_ERROR( "m_projectionMatrix not found" );
         return false;
     }
 
     m_sAmbient = shaderRegistry[ shaderSelect ].GetUniformLocation( "sAmbient" );
     if( m_sAmbient == INVALID_UNIFORM_LOCATION )
     {
-        printf( "m_projectionMatrix not found\n" );
+        LOG_ERROR( "m_projectionMatrix not found" );
         return false;
     }
 
     m_lightDir = shaderRegistry[ shaderSelect ].GetUniformLocation( "lightDir" );
     if( m_lightDir == INVALID_UNIFORM_LOCATION )
     {
-        printf( "m_projectionMatrix not found\n" );
+        LOG_ERROR( "m_projectionMatrix not found" );
         return false;
     }
 
     m_clipCosine = shaderRegistry[ shaderSelect ].GetUniformLocation( "clip" );
     if( m_clipCosine == INVALID_UNIFORM_LOCATION )
     {
-        printf( "m_projectionMatrix not found\n" );
+        LOG_ERROR( "m_projectionMatrix not found" );
         return false;
     }
 
     m_diffuse = shaderRegistry[ shaderSelect ].GetUniformLocation( "DiffuseColor" );
     if( m_diffuse == INVALID_UNIFORM_LOCATION )
     {
-        printf( "m_projectionMatrix not found\n" );
+        LOG_ERROR( "m_projectionMatrix not found" );
         return false;
     }
 
     m_specular = shaderRegistry[ shaderSelect ].GetUniformLocation( "SpecularColor" );
     if( m_specular == INVALID_UNIFORM_LOCATION )
     {
-        printf( "m_projectionMatrix not found\n" );
+        LOG_ERROR( "m_projectionMatrix not found" );
         return false;
     }
 
     m_shininess = shaderRegistry[ shaderSelect ].GetUniformLocation( "Shininess" );
     if( m_shininess == INVALID_UNIFORM_LOCATION )
     {
-        printf( "m_projectionMatrix not found\n" );
+        LOG_ERROR( "m_projectionMatrix not found" );
         return false;
     }
 
     m_ambient = shaderRegistry[ shaderSelect ].GetUniformLocation( "AmbientColor" );
     if( m_ambient == INVALID_UNIFORM_LOCATION )
     {
-        printf( "m_projectionMatrix not found\n" );
+        LOG_ERROR( "m_projectionMatrix not found" );
         return false;
     }
 
     m_light = shaderRegistry[ shaderSelect ].GetUniformLocation( "LightArray" );
     if( m_light == INVALID_UNIFORM_LOCATION )
     {
-        printf( "m_projectionMatrix not found\n" );
+        LOG_ERROR( "m_projectionMatrix not found" );
         return false;
     }
 
@@ -396,7 +397,7 @@ bool Graphics::Initialize
 
     if( tmpTextLoc == INVALID_UNIFORM_LOCATION )
     {
-        printf( "texture location uniform not found!!!\n" );
+        LOG_ERROR( "texture location uniform not found!!!" );
         return false;
     }
 
@@ -680,7 +681,7 @@ void Graphics::Render()
     if ( error != GL_NO_ERROR )
     {
         string val = ErrorString( error );
-        std::cout<< "Error initializing OpenGL! " << error << ", " << val << std::endl;
+        LOG_ERROR( "Error initializing OpenGL! " << error << ", " << val );
     }
 }
 
@@ -933,89 +934,89 @@ void Graphics::cycleShaderProgram( )
         shaderSelect = 0;
     }
 
-    std::cout << "Shader Program " << shaderSelect + 1<< " selected." << std::endl;
+    LOG_INFO( "Shader Program " << shaderSelect + 1<< " selected." );
 
 
     m_spotLight = shaderRegistry[ shaderSelect ].GetUniformLocation( "lightPosition" );
     if( m_spotLight == INVALID_UNIFORM_LOCATION )
     {
-        printf( "m_projectionMatrix not found\n" );
+        LOG_ERROR( "m_projectionMatrix not found" );
     }
 
     m_sAmbient = shaderRegistry[ shaderSelect ].GetUniformLocation( "sAmbient" );
     if( m_sAmbient == INVALID_UNIFORM_LOCATION )
     {
-        printf( "m_projectionMatrix not found\n" );
+        LOG_ERROR( "m_projectionMatrix not found" );
     }
 
     m_lightDir = shaderRegistry[ shaderSelect ].GetUniformLocation( "lightDir" );
     if( m_lightDir == INVALID_UNIFORM_LOCATION )
     {
-        printf( "m_projectionMatrix not found\n" );
+        LOG_ERROR( "m_projectionMatrix not found" );
     }
 
     m_clipCosine = shaderRegistry[ shaderSelect ].GetUniformLocation( "clip" );
     if( m_clipCosine == INVALID_UNIFORM_LOCATION )
     {
-        printf( "m_projectionMatrix not found\n" );
+        LOG_ERROR( "m_projectionMatrix not found" );
     }
 
     m_diffuse = shaderRegistry[ shaderSelect ].GetUniformLocation( "DiffuseColor" );
     if( m_diffuse == INVALID_UNIFORM_LOCATION )
     {
-        printf( "m_projectionMatrix not found\n" );
+        LOG_ERROR( "m_projectionMatrix not found" );
     }
 
     m_specular = shaderRegistry[ shaderSelect ].GetUniformLocation( "SpecularColor" );
     if( m_specular == INVALID_UNIFORM_LOCATION )
     {
-        printf( "m_projectionMatrix not found\n" );
+        LOG_ERROR( "m_projectionMatrix not found" );
     }
 
     m_shininess = shaderRegistry[ shaderSelect ].GetUniformLocation( "Shininess" );
     if( m_shininess == INVALID_UNIFORM_LOCATION )
     {
-        printf( "m_projectionMatrix not found\n" );
+        LOG_ERROR( "m_projectionMatrix not found" );
     }
 
     m_ambient = shaderRegistry[ shaderSelect ].GetUniformLocation( "AmbientColor" );
     if( m_ambient == INVALID_UNIFORM_LOCATION )
     {
-        printf( "m_projectionMatrix not found\n" );
+        LOG_ERROR( "m_projectionMatrix not found" );
     }
 
     m_light = shaderRegistry[ shaderSelect ].GetUniformLocation( "LightArray" );
     if( m_light == INVALID_UNIFORM_LOCATION )
     {
-        printf( "m_projectionMatrix not found\n" );
+        LOG_ERROR( "m_projectionMatrix not found" );
     }
 
     // Locate the projection matrix in the shader
     m_projectionMatrix = shaderRegistry[ shaderSelect ].GetUniformLocation( "projectionMatrix" );
     if( m_projectionMatrix == INVALID_UNIFORM_LOCATION )
     {
-        printf( "m_projectionMatrix not found\n" );
+        LOG_ERROR( "m_projectionMatrix not found" );
     }
 
     // Locate the view matrix in the shader
     m_viewMatrix = shaderRegistry[ shaderSelect ].GetUniformLocation( "viewMatrix" );
     if( m_viewMatrix == INVALID_UNIFORM_LOCATION )
     {
-        printf( "m_viewMatrix not found\n" );
+        LOG_ERROR( "m_viewMatrix not found" );
     }
 
     // Locate the model matrix in the shader
     m_modelMatrix = shaderRegistry[ shaderSelect ].GetUniformLocation( "modelMatrix" );
     if( m_modelMatrix == INVALID_UNIFORM_LOCATION )
     {
-        printf( "m_modelMatrix not found\n" );
+        LOG_ERROR( "m_modelMatrix not found" );
     }
 
     tmpTextLoc = shaderRegistry[ shaderSelect ].GetUniformLocation( "textureSampler" );
 
     if( tmpTextLoc == INVALID_UNIFORM_LOCATION )
     {
-        printf( "texture location uniform not found!!!\n" );
+        LOG_ERROR( "texture location uniform not found!!!" );
     }
 
     for( index = 0; index < objectRegistry.getSize( ); index++ )
@@ -1077,10 +1078,10 @@ void Graphics::changeBrightness( std::string lightSelect, float redParam,
 
     else if( lightSelect == "specular" )
     {
-        std::cout << modelRegistry[ modelIndex ].modelPath << "'s specular: ";
-        std::cout << modelRegistry[ modelIndex ].objModel.getSpecular( ).r << ", ";
-        std::cout << modelRegistry[ modelIndex ].objModel.getSpecular( ).g << ", ";
-        std::cout << modelRegistry[ modelIndex ].objModel.getSpecular( ).b << "." << std::endl;
+        LOG_INFO( modelRegistry[ modelIndex ].modelPath << "'s specular: "
+                  << modelRegistry[ modelIndex ].objModel.getSpecular( ).r << ", "
+                  << modelRegistry[ modelIndex ].objModel.getSpecular( ).g << ", "
+                  << modelRegistry[ modelIndex ].objModel.getSpecular( ).b << "." );
 
         if( modelRegistry[ modelIndex ].objModel.getSpecular().r >= 0.95f && redParam > 0.0f )
         {
@@ -1129,10 +1130,10 @@ void Graphics::changeBrightness( std::string lightSelect, float redParam,
 
     else if( lightSelect == "spot" )
     {
-        std::cout << "Spot Light Brightness: ";
-        std::cout << spotLight.ambient.r << ", ";
-        std::cout << spotLight.ambient.g << ", ";
-        std::cout << spotLight.ambient.b << "." << std::endl;
+        LOG_INFO( "Spot Light Brightness: "
+                  << spotLight.ambient.r << ", "
+                  << spotLight.ambient.g << ", "
+                  << spotLight.ambient.b << "." );
 
 
         if( spotLight.ambient.r >= 0.95f && redParam > 0.0f )
@@ -1196,14 +1197,14 @@ void Graphics::changeModelRegistryIndex( int i )
         modelIndex = modelRegistry.size() - 1;
     } 
 
-    std::cout << modelRegistry[ modelIndex ].modelPath << std::endl;
+    LOG_INFO( modelRegistry[ modelIndex ].modelPath );
 }
 
 void Graphics::chanceSpotLightSize( float increment )
 {
     spotLightAngle += increment;
 
-    std::cout << "Spot Light Angle: " << spotLightAngle << std::endl;
+    LOG_INFO( "Spot Light Angle: " << spotLightAngle );
 
     if( spotLightAngle < 0.0f )
     {